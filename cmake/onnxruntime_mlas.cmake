@@ -7,7 +7,9 @@ set(mlas_common_srcs
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/sgemm.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/qgemm.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/qdwconv.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/qconv_direct.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/convolve.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/winograd.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/pooling.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/transpose.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/reorder.cpp
@@ -92,6 +94,9 @@ elseif(MSVC)
       set_source_files_properties(${mlas_common_srcs} PROPERTIES COMPILE_FLAGS "-DMLAS_AVX512F_UNSUPPORTED")
     endif()
 
+    # The AVXVNNI intrinsics are not built with MSVC.
+    set_property(SOURCE ${mlas_common_srcs} APPEND PROPERTY COMPILE_DEFINITIONS MLAS_AVXVNNI_INTRINSICS_UNSUPPORTED)
+
     set(mlas_platform_srcs
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/dgemm.cpp
       ${mlas_platform_srcs_avx}
@@ -308,9 +313,20 @@ else()
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/x86_64/ErfKernelFma3.S
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx2/qladd_avx2.cpp
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx2/qdwconv_avx2.cpp
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx2/qconv_direct_avx2.cpp
     )
     set_source_files_properties(${mlas_platform_srcs_avx2} PROPERTIES COMPILE_FLAGS "-mavx2 -mfma")
 
+    check_cxx_compiler_flag("-mavxvnni" HAS_AVXVNNI)
+    if(HAS_AVXVNNI)
+      set(mlas_platform_srcs_avxvnni
+        ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avxvnni/qconv_direct_avxvnni.cpp
+      )
+      set_source_files_properties(${mlas_platform_srcs_avxvnni} PROPERTIES COMPILE_FLAGS "-mavx2 -mfma -mavxvnni")
+    else()
+      set_property(SOURCE ${mlas_common_srcs} APPEND PROPERTY COMPILE_DEFINITIONS MLAS_AVXVNNI_INTRINSICS_UNSUPPORTED)
+    endif()
+
     # Some toolchains do not support AVX512 compiler flags but are still able
     # to build the sources. Other toolchains require the AVX512 compiler flags
     # to be specified.
@@ -393,6 +409,7 @@ else()
       ${mlas_platform_srcs_sse2}
       ${mlas_platform_srcs_avx}
       ${mlas_platform_srcs_avx2}
+      ${mlas_platform_srcs_avxvnni}
       ${mlas_platform_srcs_avx512f}
       ${mlas_platform_srcs_avx512core}
     )
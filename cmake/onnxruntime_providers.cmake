@@ -160,18 +160,19 @@ if (onnxruntime_ENABLE_TRAINING)
 
   source_group(TREE ${ORTTRAINING_ROOT}/ FILES ${onnxruntime_cpu_training_ops_srcs})
   list(APPEND onnxruntime_providers_src ${onnxruntime_cpu_training_ops_srcs})
-
-  # todo: put this in core/framework and enabled only for training
-  file(GLOB_RECURSE onnxruntime_providers_dlpack_srcs CONFIGURE_DEPENDS
-    "${ONNXRUNTIME_ROOT}/core/dlpack/dlpack_converter.cc"
-    "${ONNXRUNTIME_ROOT}/core/dlpack/dlpack_converter.h"
-  )
-  set(onnxruntime_providers_dlpack_srcs ${onnxruntime_providers_dlpack_srcs})
-  source_group(TREE ${ONNXRUNTIME_ROOT}/core FILES ${onnxruntime_providers_dlpack_srcs})
-  list(APPEND onnxruntime_providers_src ${onnxruntime_providers_dlpack_srcs})
 endif()
 
+# the DLPack conversion is used by the training framework and by the DLPack functions of the C and python APIs
+file(GLOB_RECURSE onnxruntime_providers_dlpack_srcs CONFIGURE_DEPENDS
+  "${ONNXRUNTIME_ROOT}/core/dlpack/dlpack_converter.cc"
+  "${ONNXRUNTIME_ROOT}/core/dlpack/dlpack_converter.h"
+)
+source_group(TREE ${ONNXRUNTIME_ROOT}/core FILES ${onnxruntime_providers_dlpack_srcs})
+list(APPEND onnxruntime_providers_src ${onnxruntime_providers_dlpack_srcs})
+
 onnxruntime_add_static_library(onnxruntime_providers ${onnxruntime_providers_src})
+# DLPack is a header-only dependency
+target_include_directories(onnxruntime_providers PRIVATE ${PROJECT_SOURCE_DIR}/external/dlpack/include)
 
 if (MSVC)
    target_compile_options(onnxruntime_providers PRIVATE "/bigobj")
@@ -222,10 +223,6 @@ if (onnxruntime_ENABLE_TRAINING)
     target_include_directories(onnxruntime_providers PUBLIC ${MPI_CXX_INCLUDE_DIRS})
   endif()
 
-  # DLPack is a header-only dependency
-  set(DLPACK_INCLUDE_DIR ${PROJECT_SOURCE_DIR}/external/dlpack/include)
-  target_include_directories(onnxruntime_providers PRIVATE ${DLPACK_INCLUDE_DIR})
-
   target_link_libraries(onnxruntime_providers PRIVATE nlohmann_json::nlohmann_json)
 endif()
 
@@ -15,7 +15,8 @@ onnxruntime_add_include_to_target(onnxruntime_session onnxruntime_common onnxrun
 if(onnxruntime_ENABLE_INSTRUMENT)
   target_compile_definitions(onnxruntime_session PUBLIC ONNXRUNTIME_ENABLE_INSTRUMENT)
 endif()
-target_include_directories(onnxruntime_session PRIVATE ${ONNXRUNTIME_ROOT} ${eigen_INCLUDE_DIRS})
+target_include_directories(onnxruntime_session PRIVATE ${ONNXRUNTIME_ROOT} ${eigen_INCLUDE_DIRS}
+                           ${PROJECT_SOURCE_DIR}/external/dlpack/include)
 target_link_libraries(onnxruntime_session PRIVATE nlohmann_json::nlohmann_json)
 if(onnxruntime_ENABLE_EXTENSION_CUSTOM_OPS)
   target_link_libraries(onnxruntime_session PRIVATE ortcustomops)
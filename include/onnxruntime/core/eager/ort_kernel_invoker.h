@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include <list>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "core/common/common.h"
@@ -14,6 +17,7 @@
 #include "core/session/environment.h"
 #include "core/graph/basic_types.h"
 #include "core/graph/model.h"
+#include "core/platform/ort_mutex.h"
 
 namespace onnxruntime {
 #ifdef __GNUC__
@@ -22,10 +26,15 @@ namespace onnxruntime {
 
 class ORTInvoker {
  public:
+  // Default number of kernels kept by the kernel cache.
+  static constexpr size_t kDefaultKernelCacheCapacity = 1024;
+
   ORTInvoker(std::unique_ptr<IExecutionProvider> execution_provider, 
              const logging::Logger& logger,
-             const IOnnxRuntimeOpSchemaRegistryList& custom_op_registries) : 
-      execution_provider_(std::move(execution_provider)), logger_(logger), custom_op_registries_(custom_op_registries) {
+             const IOnnxRuntimeOpSchemaRegistryList& custom_op_registries,
+             size_t kernel_cache_capacity = kDefaultKernelCacheCapacity) : 
+      execution_provider_(std::move(execution_provider)), logger_(logger), custom_op_registries_(custom_op_registries),
+      kernel_cache_capacity_(kernel_cache_capacity) {
     if (!execution_provider_) {
     ORT_THROW("Execution provider is nullptr");
     }
@@ -43,12 +52,39 @@ class ORTInvoker {
                         const std::string& domain = kOnnxDomain,
                         const int version = -1);
 
+  // Gets the number of kernels in the kernel cache.
+  size_t KernelCacheSize();
+
+  // Removes all the kernels from the kernel cache.
+  void ClearKernelCache();
+
  private:
+  // A kernel created by Invoke, with the graph and the execution frame info it refers to.
+  struct KernelEntry;
+
+  common::Status CreateKernel(const std::string& op_name,
+                              const std::vector<OrtValue>& inputs,
+                              size_t num_outputs,
+                              const NodeAttributes* attributes,
+                              const std::string& domain,
+                              int version,
+                              std::shared_ptr<KernelEntry>& entry);
+
   std::unique_ptr<IExecutionProvider> execution_provider_;
   const logging::Logger& logger_;
   // custom ops for current execution provider
   // we need the op schema to resolve the output type during invoke
   const IOnnxRuntimeOpSchemaRegistryList& custom_op_registries_;
+
+  // The kernels created by Invoke, keyed by the op, its attributes and the input types, so that the graph is only
+  // built and resolved on the first invocation. At most kernel_cache_capacity_ kernels are kept, the least recently
+  // used one is removed first. A capacity of 0 disables the cache.
+  using KernelCacheEntry = std::pair<std::string, std::shared_ptr<KernelEntry>>;
+  const size_t kernel_cache_capacity_;
+  OrtMutex kernel_cache_mutex_;
+  // Most recently used first.
+  std::list<KernelCacheEntry> kernel_cache_entries_;
+  std::unordered_map<std::string, std::list<KernelCacheEntry>::iterator> kernel_cache_;
 };
 
 #ifdef __GNUC__
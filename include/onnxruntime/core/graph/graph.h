@@ -342,7 +342,10 @@ class Node {
   bool ClearAttribute(const std::string& attr_name);
 
   /** Gets the Node's mutable attributes. */
-  NodeAttributes& GetMutableAttributes() noexcept { return attributes_; }
+  NodeAttributes& GetMutableAttributes() noexcept {
+    inferencing_key_.clear();
+    return attributes_;
+  }
 
   /** Gets the Graph instance that is instantiated from a GraphProto attribute during Graph::Resolve.
   @param attr_name Attribute name for the GraphProto attribute.
@@ -565,6 +568,10 @@ class Node {
   // This allows attribute adding and removing.
   NodeAttributes attributes_;
 
+  // Key of the input and output definitions and their types after type and shape inferencing last ran for this
+  // node. Graph::Resolve does not infer the node again while the key is unchanged. Cleared if an attribute changes.
+  std::string inferencing_key_;
+
   // Graph that contains this Node
   Graph* graph_;
 
@@ -752,6 +759,12 @@ class Graph {
   */
   int NumberOfNodes() const noexcept { return num_of_nodes_; }
 
+#if !defined(ORT_MINIMAL_BUILD)
+  /** Gets the number of nodes of this Graph whose types and shapes were inferred by the last Resolve that
+  verified the Graph. Nodes of the main graph that did not change since they were last inferred are skipped. */
+  size_t NumberOfNodesInferredByLastResolve() const noexcept { return num_nodes_inferred_by_last_resolve_; }
+#endif
+
   /** Gets the mutable NodeArg with the provided name.
   @returns Pointer to NodeArg if found, nullptr if not. */
   NodeArg* GetNodeArg(const std::string& name) {
@@ -1424,6 +1437,13 @@ class Graph {
   // node arg to its consumer nodes
   std::unordered_map<std::string, std::unordered_set<NodeIndex>> node_arg_to_consumer_nodes_;
 
+  // Initializers added or replaced since the last Resolve. Nodes consuming them are inferred again, as the type and
+  // shape inferencing of some operators depends on the values of constant inputs.
+  std::unordered_set<std::string> initializers_changed_since_resolve_;
+
+  // Number of nodes inferred by the last VerifyNodeAndOpMatch.
+  size_t num_nodes_inferred_by_last_resolve_ = 0;
+
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
   const std::unordered_map<std::string, int> domain_to_version_;
@@ -10,6 +10,9 @@
 #include "core/optimizer/graph_transformer_level.h"
 
 namespace onnxruntime {
+namespace concurrency {
+class ThreadPool;
+}
 
 /**
 @class GraphTransformer
@@ -41,11 +44,23 @@ class GraphTransformer {
 
   virtual bool ShouldOnlyApplyOnce() const { return false; }
 
+  /** Set the thread pool used to transform the subgraphs of a node (e.g. the branches of an If) in parallel.
+  @param thread_pool Thread pool to use. If nullptr, subgraphs are transformed sequentially.
+  */
+  void SetThreadPool(concurrency::ThreadPool* thread_pool) noexcept {
+    thread_pool_ = thread_pool;
+  }
+
  protected:
   /** Helper method to call ApplyImpl on any subgraphs in the Node. */
   common::Status Recurse(Node& node, bool& modified, int graph_level, const logging::Logger& logger) const {
     int subgraph_level = ++graph_level;
-    for (auto& entry : node.GetAttributeNameToMutableSubgraphMap()) {
+    auto& subgraphs = node.GetAttributeNameToMutableSubgraphMap();
+    if (subgraphs.size() > 1 && thread_pool_ != nullptr && CanTransformSubgraphsInParallel()) {
+      return RecurseInParallel(node, modified, subgraph_level, logger);
+    }
+
+    for (auto& entry : subgraphs) {
       auto& subgraph = *entry.second;
       ORT_RETURN_IF_ERROR(ApplyImpl(subgraph, modified, subgraph_level, logger));
     }
@@ -53,6 +68,11 @@ class GraphTransformer {
     return Status::OK();
   }
 
+  /** Whether ApplyImpl may run concurrently on the subgraphs of a node. Override to return false if ApplyImpl
+  modifies state outside of the graph it is called with, such as by calling Graph::Resolve.
+  */
+  virtual bool CanTransformSubgraphsInParallel() const { return true; }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(GraphTransformer);
 
@@ -66,7 +86,11 @@ class GraphTransformer {
   virtual common::Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger)
       const = 0;
 
+  common::Status RecurseInParallel(Node& node, bool& modified, int subgraph_level,
+                                   const logging::Logger& logger) const;
+
   const std::string name_;
   const std::unordered_set<std::string> compatible_provider_types_;
+  concurrency::ThreadPool* thread_pool_ = nullptr;
 };
 }  // namespace onnxruntime
@@ -24,6 +24,7 @@
 #pragma warning(disable : 4127)
 #pragma warning(disable : 4805)
 #endif
+#include <chrono>
 #include <memory>
 #include "unsupported/Eigen/CXX11/ThreadPool"
 
@@ -61,6 +62,9 @@
 //
 //   This spin-then-block behavior is configured via a flag provided
 //   when creating the thread pool, and by the constant spin_count.
+//   Optionally (ThreadOptions::adaptive_spinning), each worker also
+//   bounds the time it spins based on how soon work has recently
+//   arrived after it became idle; see AdaptiveSpinPolicy.
 //
 // - Although all tasks are simple void()->void functions,
 //   conceptually there are three different kinds:
@@ -214,6 +218,10 @@ class ThreadPoolProfiler {
   void LogCoreAndBlock(std::ptrdiff_t){};
   void LogThreadId(int){};
   void LogRun(int){};
+  void LogSpin(int){};
+  void LogPark(int){};
+  void LogWakeup(int){};
+  void LogSteal(int){};
   std::string DumpChildThreadStat() { return {}; }
 };
 #else
@@ -240,6 +248,10 @@ class ThreadPoolProfiler {
   void LogCoreAndBlock(std::ptrdiff_t block_size);  //called in main thread to log core and block size for task breakdown
   void LogThreadId(int thread_idx);                 //called in child thread to log its id
   void LogRun(int thread_idx);                      //called in child thread to log num of run
+  void LogSpin(int thread_idx);                     //called in child thread when work is found while spinning
+  void LogPark(int thread_idx);                     //called in child thread when it blocks waiting for work
+  void LogWakeup(int thread_idx);                   //called in child thread when it finds work after blocking
+  void LogSteal(int thread_idx);                    //called in child thread when it steals work from another queue
   std::string DumpChildThreadStat();                //return all child statitics collected so far
 
  private:
@@ -262,6 +274,10 @@ class ThreadPoolProfiler {
   struct ChildThreadStat {
     std::thread::id thread_id_;
     uint64_t num_run_ = 0;
+    uint64_t num_spin_ = 0;
+    uint64_t num_park_ = 0;
+    uint64_t num_wakeup_ = 0;
+    uint64_t num_steal_ = 0;
     onnxruntime::TimePoint last_logged_point_ = Clock::now();
     int32_t core_ = -1;  //core that the child thread is running on
     PaddingToAvoidFalseSharing padding_; //to prevent false sharing
@@ -651,6 +667,63 @@ class RunQueue {
   void operator=(const RunQueue&) = delete;
 };
 
+// Adaptive spin-then-block policy for a worker thread.  Spinning
+// avoids the OS wake-up latency when work arrives soon after a worker
+// becomes idle, but only burns CPU when work arrives infrequently.
+// The policy therefore tracks an exponentially-weighted moving average
+// of the time each idle period lasts, and:
+//
+// - If the average is below kMaxSpin, spins for twice the average (so
+//   that most arrivals are caught while spinning), bounded to the
+//   range [kMinSpin, kMaxSpin].
+//
+// - Otherwise, spins only for kMinSpin before blocking.
+//
+// Observed idle times are capped at 2*kMaxSpin before averaging so
+// that a single long pause between requests does not disable spinning
+// for the many short gaps that follow it.
+//
+// The policy is used only by the worker thread that owns it, and so
+// needs no synchronization.
+
+class AdaptiveSpinPolicy {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // Record the start of an idle period.
+  void StartIdle() {
+    idle_start_ = Clock::now();
+  }
+
+  // Test whether the worker should continue spinning in the current
+  // idle period.
+  bool ShouldSpin() const {
+    return Clock::now() - idle_start_ < spin_budget_;
+  }
+
+  // Record the end of an idle period (i.e., the worker found work,
+  // either while spinning or after blocking), and update the budget for
+  // the next one.
+  void EndIdle() {
+    auto idle = std::min<Clock::duration>(Clock::now() - idle_start_, 2 * kMaxSpin);
+    avg_idle_ += (idle - avg_idle_) / kSmoothing;
+    if (avg_idle_ > kMaxSpin) {
+      spin_budget_ = kMinSpin;
+    } else {
+      spin_budget_ = std::max<Clock::duration>(kMinSpin, std::min<Clock::duration>(2 * avg_idle_, kMaxSpin));
+    }
+  }
+
+ private:
+  static constexpr std::chrono::microseconds kMinSpin{10};
+  static constexpr std::chrono::microseconds kMaxSpin{1000};
+  static constexpr int kSmoothing = 8;
+
+  Clock::time_point idle_start_;
+  Clock::duration avg_idle_{Clock::duration::zero()};
+  Clock::duration spin_budget_{kMaxSpin};
+};
+
 static std::atomic<uint32_t> next_tag{1};
 
 template <typename Environment>
@@ -721,6 +794,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         env_(env),
         num_threads_(num_threads),
         allow_spinning_(allow_spinning),
+        adaptive_spinning_(allow_spinning && thread_options.adaptive_spinning),
         set_denormal_as_zero_(thread_options.set_denormal_as_zero),
         worker_data_(num_threads),
         all_coprimes_(num_threads),
@@ -1416,6 +1490,7 @@ int CurrentThreadId() const final {
   Environment& env_;
   const unsigned num_threads_;
   const bool allow_spinning_;
+  const bool adaptive_spinning_;
   const bool set_denormal_as_zero_;
   Eigen::MaxSizeVector<WorkerData> worker_data_;
   Eigen::MaxSizeVector<Eigen::MaxSizeVector<unsigned>> all_coprimes_;
@@ -1448,24 +1523,44 @@ int CurrentThreadId() const final {
     const int spin_count = allow_spinning_ ? (1ull<<log2_spin) : 0;
     const int steal_count = spin_count/100;
 
+    // With adaptive spinning, the time budget is checked once every
+    // (adaptive_check_mask+1) spin iterations to amortize clock reads.
+    const int adaptive_check_mask = 63;
+    AdaptiveSpinPolicy spin_policy;
+
     SetDenormalAsZero(set_denormal_as_zero_);
     profiler_.LogThreadId(thread_id);
 
     while (!should_exit) {
       Task t = q.PopFront();
       if (!t) {
+        if (adaptive_spinning_) {
+          spin_policy.StartIdle();
+        }
+
         // Spin waiting for work.
         for (int i = 0; i < spin_count && !t && !done_; i++) {
           if (((i+1)%steal_count == 0)) {
             t = Steal(StealAttemptKind::TRY_ONE);
+            if (t) {
+              profiler_.LogSteal(thread_id);
+            }
           } else {
             t = q.PopFront();
           }
+          if (!t && adaptive_spinning_ &&
+              (i & adaptive_check_mask) == adaptive_check_mask && !spin_policy.ShouldSpin()) {
+            break;
+          }
           onnxruntime::concurrency::SpinPause();
         }
+        if (t) {
+          profiler_.LogSpin(thread_id);
+        }
 
         // Attempt to block
         if (!t) {
+          bool parked = false;
           td.SetBlocked(// Pre-block test
                         [&]() -> bool {
                           bool should_block = true;
@@ -1521,12 +1616,28 @@ int CurrentThreadId() const final {
                         // Post-block update (executed only if we blocked)
                         [&]() {
                           blocked_--;
+                          parked = true;
                         });
           // Thread just unblocked.  Unless we picked up work while
           // blocking, or are exiting, then either work was pushed to
           // us, or it was pushed to an overloaded queue
           if (!t) t = q.PopFront();
-          if (!t) t = Steal(StealAttemptKind::TRY_ALL);
+          if (!t) {
+            t = Steal(StealAttemptKind::TRY_ALL);
+            if (t) {
+              profiler_.LogSteal(thread_id);
+            }
+          }
+          if (parked) {
+            profiler_.LogPark(thread_id);
+            if (t) {
+              profiler_.LogWakeup(thread_id);
+            }
+          }
+        }
+
+        if (t && adaptive_spinning_) {
+          spin_policy.EndIdle();
         }
       }
       if (t) {
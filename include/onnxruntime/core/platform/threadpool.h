@@ -16,6 +16,7 @@ limitations under the License.
 /* Modifications Copyright (c) Microsoft. */
 
 #pragma once
+#include <atomic>
 #include <string>
 #include <vector>
 #include <functional>
@@ -133,6 +134,8 @@ namespace concurrency {
 template <typename Environment>
 class ThreadPoolTempl;
 
+class ParallelForTuner;
+
 class ExtendedThreadPoolInterface;
 class LoopCounter;
 class ThreadPoolParallelSection;
@@ -222,6 +225,99 @@ class ThreadPool {
                   "Per-thread state should be trivially destructible");
   };
 
+  // Priority classes for the parallel work issued on behalf of a single
+  // Run() call.  See RunScope below.
+  enum class RunPriority : int {
+    kLow = 0,
+    kNormal = 1,
+    kHigh = 2,
+  };
+
+  // Per-run budgeting of the pool.  When several Run() calls share a
+  // pool (for example with global thread pools), each in-flight run
+  // that opts in via a RunScope is given a share of the pool's degree
+  // of parallelism:
+  //
+  // - A run of priority P shares the pool with the other in-flight
+  //   runs of priority >= P.  Hence a high-priority run competes only
+  //   with other high-priority runs, while a low-priority run yields
+  //   threads to every other run.
+  //
+  // - If max_degree_of_parallelism > 0 then the run's share is also
+  //   capped at that value.
+  //
+  // The budget is applied through DegreeOfParallelism, and so it
+  // affects the number of tasks that parallel loops create, as well as
+  // libraries such as MLAS that partition work based on it.  As with
+  // ParallelSection, thread-local state identifies the current run:
+  // the limits apply to parallel work initiated from the thread that
+  // created the RunScope.  Runs that do not create a RunScope are
+  // neither limited nor counted.
+  //
+  // RunScopes have no effect when using OpenMP.
+
+  class RunScope {
+   public:
+    RunScope(ThreadPool* tp, int max_degree_of_parallelism, RunPriority priority);
+    ~RunScope();
+
+   private:
+    friend class ThreadPool;
+
+    // Apply the run's budget to the pool's full degree of parallelism.
+    int LimitDegreeOfParallelism(int d_of_p) const;
+
+    ThreadPool* tp_;
+    int max_degree_of_parallelism_;
+    RunPriority priority_;
+
+    // Enclosing scope on this thread, restored on exit (e.g., for a
+    // nested Run() issued from within a kernel).
+    RunScope* prev_run_scope_;
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RunScope);
+
+    // Non-owning reference to the current thread's run scope (or
+    // nullptr outside a budgeted run).
+    static thread_local RunScope* current_run_scope;
+    static_assert(std::is_trivially_destructible<decltype(current_run_scope)>::value,
+                  "Per-thread state should be trivially destructible");
+  };
+
+  // Identify the kernel on whose behalf the calling thread issues
+  // parallel loops, so that the cost-model block size of those loops
+  // can be tuned by a ParallelForTuner (see
+  // core/common/parallel_for_tuner.h).  A TuningScope with a null
+  // tuner has no effect.  The executor creates a TuningScope around
+  // each kernel's Compute() call when tuning is enabled for the
+  // session.
+  //
+  // TuningScopes have no effect when using OpenMP.
+
+  class TuningScope {
+   public:
+    TuningScope(ParallelForTuner* tuner, const std::string& domain, const std::string& op_type);
+    ~TuningScope();
+
+   private:
+    friend class ThreadPool;
+
+    ParallelForTuner* tuner_;
+    const std::string& domain_;
+    const std::string& op_type_;
+
+    // Index of the next loop issued within this scope.
+    unsigned next_loop_idx_;
+
+    TuningScope* prev_tuning_scope_;
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(TuningScope);
+
+    // Non-owning reference to the current thread's tuning scope (or
+    // nullptr outside a tuned kernel).
+    static thread_local TuningScope* current_tuning_scope;
+    static_assert(std::is_trivially_destructible<decltype(current_tuning_scope)>::value,
+                  "Per-thread state should be trivially destructible");
+  };
+
   // Schedules fn() for execution in the pool of threads.  The function may run
   // synchronously if it cannot be enqueued.  This will occur if the thread pool's
   // degree-of-parallelism is 1, but it may also occur for implementation-dependent
@@ -443,6 +539,9 @@ class ThreadPool {
 
   // If used, underlying_threadpool_ is instantiated and owned by the ThreadPool.
   std::unique_ptr<ThreadPoolTempl<Env> > extended_eigen_threadpool_;
+
+  // Number of in-flight RunScopes for each RunPriority.
+  std::atomic<int> active_runs_[static_cast<int>(RunPriority::kHigh) + 1]{};
 };
 
 }  // namespace concurrency
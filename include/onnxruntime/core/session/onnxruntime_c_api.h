@@ -1450,6 +1450,42 @@ struct OrtApi {
   * Enable custom operators in onnxruntime-extensions: https://github.com/microsoft/onnxruntime-extensions.git
   */
   ORT_API2_STATUS(EnableOrtCustomOps, _Inout_ OrtSessionOptions* options);
+
+  /**
+   * Create a tensor that shares the data of a DLPack tensor, e.g. one exported by another framework,
+   * instead of copying it. Only CPU tensors are supported.
+   * \param dlpack_tensor - a DLManagedTensor*. On success the created tensor takes the ownership of it and calls
+   *                        its deleter when the tensor is released. On failure the caller keeps the ownership.
+   * \param is_bool_tensor - DLPack describes bool tensors as uint8 tensors. Pass 1 to create a bool tensor.
+   * \param out - Should be freed by calling ReleaseValue
+   */
+  ORT_API2_STATUS(CreateTensorFromDLPack, _Inout_ void* dlpack_tensor, int is_bool_tensor, _Outptr_ OrtValue** out);
+
+  /**
+   * Create a DLPack tensor that shares the data of a tensor, e.g. to pass it to another framework without copying it.
+   * Only CPU tensors are supported.
+   * \param value - a tensor. The DLPack tensor keeps its data alive after the value is released.
+   * \param out - a DLManagedTensor*. The caller must call its deleter once it no longer uses it.
+   */
+  ORT_API2_STATUS(CreateDLPackFromTensor, _In_ OrtValue* value, _Outptr_ void** out);
+
+  /**
+   * Mark a graph output as the next value of a graph input, e.g. the hidden state of a recurrent model that is run
+   * on a stream chunk by chunk. The session keeps the value of the output and feeds it as the input of the next
+   * Run without copying it. The input does not need to be fed, it is all zeros in the first run if its shape is
+   * fully known. Feeding it overrides the kept value, and fetching the output returns it as well.
+   * Runs of a session with states are serialized.
+   * \param input_name - name of the graph input
+   * \param output_name - name of the graph output, with the same element type as the input
+   */
+  ORT_API2_STATUS(AddStatefulInputOutput, _Inout_ OrtSessionOptions* options, _In_z_ const char* input_name,
+                  _In_z_ const char* output_name);
+
+  /**
+   * Drop the values kept for the inputs added with AddStatefulInputOutput, e.g. at the start of a new stream.
+   * The next Run starts from the initial values of the states again.
+   */
+  ORT_API2_STATUS(SessionResetStates, _In_ OrtSession* sess);
 };
 
 /*
@@ -327,6 +327,7 @@ struct SessionOptions : Base<OrtSessionOptions> {
 
   SessionOptions& AddConfigEntry(const char* config_key, const char* config_value);
   SessionOptions& AddInitializer(const char* name, const OrtValue* ort_val);
+  SessionOptions& AddStatefulInputOutput(const char* input_name, const char* output_name);
 
   SessionOptions& AppendExecutionProvider_CUDA(const OrtCUDAProviderOptions& provider_options);
   SessionOptions& AppendExecutionProvider_ROCM(const OrtROCMProviderOptions& provider_options);
@@ -363,6 +364,9 @@ struct Session : Base<OrtSession> {
 
   void Run(const RunOptions& run_options, const struct IoBinding&);
 
+  // Drops the values kept for the inputs added with SessionOptions::AddStatefulInputOutput
+  void ResetStates();
+
   size_t GetInputCount() const;
   size_t GetOutputCount() const;
   size_t GetOverridableInitializerCount() const;
@@ -431,6 +435,9 @@ struct Value : Base<OrtValue> {
   static Value CreateMap(Value& keys, Value& values);
   static Value CreateSequence(std::vector<Value>& values);
 
+  // Wraps a DLManagedTensor* without copying its data. On success the value owns it, see CreateTensorFromDLPack.
+  static Value CreateTensorFromDLPack(void* dlpack_tensor, bool is_bool_tensor = false);
+
   template <typename T>
   static Value CreateOpaque(const char* domain, const char* type_name, const T&);
 
@@ -466,6 +473,9 @@ struct Value : Base<OrtValue> {
 
   void FillStringTensor(const char* const* s, size_t s_len);
   void FillStringTensorElement(const char* s, size_t index);
+
+  // Returns a DLManagedTensor* that shares the data of the tensor. The caller must call its deleter.
+  void* ToDLPack();
 };
 
 // Represents native memory allocation
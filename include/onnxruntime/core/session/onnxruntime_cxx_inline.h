@@ -495,6 +495,11 @@ inline SessionOptions& SessionOptions::AddInitializer(const char* name, const Or
   return *this;
 }
 
+inline SessionOptions& SessionOptions::AddStatefulInputOutput(const char* input_name, const char* output_name) {
+  ThrowOnError(GetApi().AddStatefulInputOutput(p_, input_name, output_name));
+  return *this;
+}
+
 inline SessionOptions& SessionOptions::AppendExecutionProvider_CUDA(const OrtCUDAProviderOptions& provider_options) {
   ThrowOnError(GetApi().SessionOptionsAppendExecutionProvider_CUDA(p_, &provider_options));
   return *this;
@@ -549,6 +554,10 @@ inline void Session::Run(const RunOptions& run_options, const IoBinding& io_bind
   ThrowOnError(GetApi().RunWithBinding(p_, run_options, io_binding));
 }
 
+inline void Session::ResetStates() {
+  ThrowOnError(GetApi().SessionResetStates(p_));
+}
+
 inline size_t Session::GetInputCount() const {
   size_t out;
   ThrowOnError(GetApi().SessionGetInputCount(p_, &out));
@@ -780,6 +789,12 @@ inline Value Value::CreateSequence(std::vector<Value>& values) {
   return Value{out};
 }
 
+inline Value Value::CreateTensorFromDLPack(void* dlpack_tensor, bool is_bool_tensor) {
+  OrtValue* out;
+  ThrowOnError(GetApi().CreateTensorFromDLPack(dlpack_tensor, is_bool_tensor ? 1 : 0, &out));
+  return Value{out};
+}
+
 template <typename T>
 inline Value Value::CreateOpaque(const char* domain, const char* type_name, const T& data_container) {
   OrtValue* out;
@@ -838,6 +853,12 @@ inline void Value::FillStringTensorElement(const char* s, size_t index) {
   ThrowOnError(GetApi().FillStringTensorElement(p_, s, index));
 }
 
+inline void* Value::ToDLPack() {
+  void* out;
+  ThrowOnError(GetApi().CreateDLPackFromTensor(p_, &out));
+  return out;
+}
+
 template <typename T>
 T* Value::GetTensorMutableData() {
   T* out;
@@ -25,3 +25,16 @@
 // Example usage: "cpu:0;gpu:0" (or) "gpu:0"
 // By default, the value for this key is empty (i.e.) no memory arenas are shrunk
 static const char* const kOrtRunOptionsConfigEnableMemoryArenaShrinkage = "memory.enable_memory_arena_shrinkage";
+
+// Key for capping the intra-op degree of parallelism used by this run.
+// The value is an integer; "0" (the default) means no cap beyond the size of the intra-op thread pool.
+// Applies to work initiated from the thread calling Run(), i.e. with ExecutionMode::ORT_SEQUENTIAL.
+static const char* const kOrtRunOptionsConfigIntraOpMaxDegreeOfParallelism = "intra_op.max_degree_of_parallelism";
+
+// Key for the priority class of this run when several runs share an intra-op thread pool
+// (e.g. when the environment's global thread pools are used).
+// Supported values are "low", "normal" and "high".
+// Each run that sets this key, or kOrtRunOptionsConfigIntraOpMaxDegreeOfParallelism, receives a fair share of the
+// intra-op thread pool among the in-flight runs of the same or a higher priority. Runs that set neither key are
+// not budgeted. The default priority for budgeted runs is "normal".
+static const char* const kOrtRunOptionsConfigIntraOpPriority = "intra_op.priority";
@@ -60,3 +60,32 @@ static const char* const kOrtSessionOptionsUseDeviceAllocatorForInitializers = "
 // "1": default, thread will spin a number of times before blocking
 static const char* const kOrtSessionOptionsConfigAllowInterOpSpinning = "session.inter_op.allow_spinning";
 static const char* const kOrtSessionOptionsConfigAllowIntraOpSpinning = "session.intra_op.allow_spinning";
+
+// Configure whether the inter_op/intra_op threads adapt the duration of their spinning to the recently observed
+// time between items of work. Only used if spinning is allowed.
+// "0": default, thread will spin a fixed number of times before blocking
+// "1": thread will spin for up to twice the recent average idle time, and block immediately if work arrives
+//      infrequently
+static const char* const kOrtSessionOptionsConfigInterOpAdaptiveSpinning = "session.inter_op.adaptive_spinning";
+static const char* const kOrtSessionOptionsConfigIntraOpAdaptiveSpinning = "session.intra_op.adaptive_spinning";
+
+// Enable tuning of the block sizes that the intra-op thread pool uses for parallel loops.
+// "0": default, block sizes are derived from the cost estimates supplied by each kernel
+// "1": during the first runs (warm-up), several block sizes around the cost-model choice are measured for each kernel
+//      type, loop and shape bucket, and the fastest is used from then on
+// Tuning does not apply to OpenMP builds.
+static const char* const kOrtSessionOptionsConfigEnableParallelForTuning = "session.intra_op.enable_parallel_for_tuning";
+
+// Path of a file with parallel-for tuning results. If set, the results are loaded when the session is created and
+// applied even if tuning is not enabled. If tuning is enabled, new results are saved to the file when the session is
+// destroyed.
+static const char* const kOrtSessionOptionsConfigParallelForTuningFile = "session.intra_op.parallel_for_tuning_file";
+
+// Maximum number of shape specialized sessions kept for a model with dynamic input shapes.
+// "0": default, the model is optimized once for its declared input shapes
+// "N": the first run with a new combination of input shapes optimizes and initializes a copy of the model with those
+//      shapes fixed, so that shape dependent optimizations such as constant folding of Shape nodes apply. Up to N of
+//      these sessions are kept, least recently used first out. Only supported for sessions using the CPU execution
+//      provider alone without custom ops. The unoptimized model is kept in memory, and its initializers are loaded once
+//      and shared by the session and all of its shape specialized sessions.
+static const char* const kOrtSessionOptionsConfigShapeSpecializationCacheSize = "session.shape_specialization_cache_size";
@@ -243,6 +243,26 @@ public class OnnxTensor implements OnnxValue {
     }
   }
 
+  /**
+   * Returns a direct ByteBuffer of the native platform endian-ness which wraps the memory of the
+   * underlying OnnxTensor without copying it.
+   *
+   * <p>The buffer is only valid until this OnnxTensor is closed, and writes to it modify the
+   * tensor. This is intended for tensors bound to an {@link OrtSession.IoBinding}.
+   *
+   * <p>This method returns null if the OnnxTensor contains Strings as they are stored externally to
+   * the OnnxTensor.
+   *
+   * @return A ByteBuffer wrapping the OnnxTensor memory.
+   */
+  public ByteBuffer getDirectByteBuffer() {
+    if (info.type != OnnxJavaType.STRING) {
+      return getBuffer();
+    } else {
+      return null;
+    }
+  }
+
   /**
    * Wraps the OrtTensor pointer in a direct byte buffer of the native platform endian-ness. Unless
    * you really know what you're doing, you want this one rather than the native call {@link
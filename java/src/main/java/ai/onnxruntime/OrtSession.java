@@ -306,6 +306,37 @@ public class OrtSession implements AutoCloseable {
     }
   }
 
+  /**
+   * Scores the inputs bound in the supplied {@link IoBinding}, writing the outputs into the bound
+   * output tensors or into tensors allocated for outputs bound with {@link
+   * IoBinding#bindOutput(String)}.
+   *
+   * @param binding The binding holding the inputs and outputs.
+   * @throws OrtException If there was an error in native code.
+   */
+  public void run(IoBinding binding) throws OrtException {
+    run(binding, null);
+  }
+
+  /**
+   * Scores the inputs bound in the supplied {@link IoBinding}, writing the outputs into the bound
+   * output tensors or into tensors allocated for outputs bound with {@link
+   * IoBinding#bindOutput(String)}.
+   *
+   * @param binding The binding holding the inputs and outputs.
+   * @param runOptions The RunOptions to control this run.
+   * @throws OrtException If there was an error in native code.
+   */
+  public void run(IoBinding binding, RunOptions runOptions) throws OrtException {
+    if (!closed) {
+      binding.checkClosed();
+      long runOptionsHandle = runOptions == null ? 0 : runOptions.nativeHandle;
+      runWithBinding(OnnxRuntime.ortApiHandle, nativeHandle, binding.nativeHandle, runOptionsHandle);
+    } else {
+      throw new IllegalStateException("Trying to score a closed OrtSession.");
+    }
+  }
+
   /**
    * Gets the metadata for the currently loaded model.
    *
@@ -428,6 +459,10 @@ public class OrtSession implements AutoCloseable {
       long runOptionsHandle)
       throws OrtException;
 
+  private native void runWithBinding(
+      long apiHandle, long nativeHandle, long bindingHandle, long runOptionsHandle)
+      throws OrtException;
+
   private native long getProfilingStartTimeInNs(long apiHandle, long nativeHandle)
       throws OrtException;
 
@@ -1147,6 +1182,147 @@ public class OrtSession implements AutoCloseable {
     private static native void close(long apiHandle, long nativeHandle);
   }
 
+  /**
+   * Binds inputs and outputs of an {@link OrtSession} to pre-allocated tensors, so that repeated
+   * calls to {@link OrtSession#run(IoBinding)} do not copy the inputs or allocate the outputs.
+   *
+   * <p>Tensors created from direct {@link java.nio.ByteBuffer}s share the buffer memory with the
+   * native tensor, so new inputs can be written into the buffer between runs and bound outputs are
+   * written directly into their buffers. The bound tensors must not be closed while they are bound.
+   *
+   * <p>Most methods throw {@link IllegalStateException} if the IoBinding is closed.
+   */
+  public static class IoBinding implements AutoCloseable {
+
+    private final long nativeHandle;
+
+    private final OrtAllocator allocator;
+
+    private boolean closed = false;
+
+    /**
+     * Creates an IoBinding for the supplied session.
+     *
+     * <p>The session must not be closed until this binding is closed.
+     *
+     * @param session The session to bind to.
+     * @throws OrtException If the construction of the native IoBinding failed.
+     */
+    public IoBinding(OrtSession session) throws OrtException {
+      if (session.closed) {
+        throw new IllegalStateException("Trying to bind to a closed OrtSession.");
+      }
+      this.nativeHandle = createIoBinding(OnnxRuntime.ortApiHandle, session.nativeHandle);
+      this.allocator = session.allocator;
+    }
+
+    /**
+     * Binds a tensor to the named input.
+     *
+     * @param name The input name.
+     * @param tensor The tensor to bind.
+     * @throws OrtException If the native call failed.
+     */
+    public void bindInput(String name, OnnxTensor tensor) throws OrtException {
+      checkClosed();
+      bindInput(OnnxRuntime.ortApiHandle, nativeHandle, name, tensor.getNativeHandle());
+    }
+
+    /**
+     * Binds a pre-allocated tensor to the named output. The tensor must have the type and shape
+     * of the output, and receives the output on every run.
+     *
+     * @param name The output name.
+     * @param tensor The tensor to write the output into.
+     * @throws OrtException If the native call failed.
+     */
+    public void bindOutput(String name, OnnxTensor tensor) throws OrtException {
+      checkClosed();
+      bindOutput(OnnxRuntime.ortApiHandle, nativeHandle, name, tensor.getNativeHandle());
+    }
+
+    /**
+     * Binds the named output to CPU memory allocated by the session. The output is available from
+     * {@link #getOutputs()} after a run. This is useful when the output shape is not known in
+     * advance.
+     *
+     * @param name The output name.
+     * @throws OrtException If the native call failed.
+     */
+    public void bindOutput(String name) throws OrtException {
+      checkClosed();
+      bindOutputToCPU(OnnxRuntime.ortApiHandle, nativeHandle, name);
+    }
+
+    /**
+     * Gets the bound outputs in the order they were bound.
+     *
+     * <p>The returned values reference the bound output memory and must be closed by the caller.
+     *
+     * @return The bound outputs.
+     * @throws OrtException If the native call failed.
+     */
+    public Result getOutputs() throws OrtException {
+      checkClosed();
+      String[] names = getOutputNames(OnnxRuntime.ortApiHandle, nativeHandle, allocator.handle);
+      OnnxValue[] values = getOutputValues(OnnxRuntime.ortApiHandle, nativeHandle, allocator.handle);
+      return new Result(names, values);
+    }
+
+    /** Removes all the input bindings. */
+    public void clearBoundInputs() {
+      checkClosed();
+      clearBoundInputs(OnnxRuntime.ortApiHandle, nativeHandle);
+    }
+
+    /** Removes all the output bindings. */
+    public void clearBoundOutputs() {
+      checkClosed();
+      clearBoundOutputs(OnnxRuntime.ortApiHandle, nativeHandle);
+    }
+
+    /** Checks if the IoBinding is closed, if so throws {@link IllegalStateException}. */
+    private void checkClosed() {
+      if (closed) {
+        throw new IllegalStateException("Trying to use a closed IoBinding");
+      }
+    }
+
+    @Override
+    public void close() {
+      if (!closed) {
+        close(OnnxRuntime.ortApiHandle, nativeHandle);
+        closed = true;
+      } else {
+        throw new IllegalStateException("Trying to close an already closed IoBinding");
+      }
+    }
+
+    private static native long createIoBinding(long apiHandle, long sessionHandle)
+        throws OrtException;
+
+    private native void bindInput(long apiHandle, long nativeHandle, String name, long valueHandle)
+        throws OrtException;
+
+    private native void bindOutput(long apiHandle, long nativeHandle, String name, long valueHandle)
+        throws OrtException;
+
+    private native void bindOutputToCPU(long apiHandle, long nativeHandle, String name)
+        throws OrtException;
+
+    private native String[] getOutputNames(long apiHandle, long nativeHandle, long allocatorHandle)
+        throws OrtException;
+
+    private native OnnxValue[] getOutputValues(
+        long apiHandle, long nativeHandle, long allocatorHandle) throws OrtException;
+
+    private native void clearBoundInputs(long apiHandle, long nativeHandle);
+
+    private native void clearBoundOutputs(long apiHandle, long nativeHandle);
+
+    private static native void close(long apiHandle, long nativeHandle);
+  }
+
   /**
    * An {@link AutoCloseable} wrapper around a {@link Map} containing {@link OnnxValue}s.
    *
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) Microsoft Corporation. All rights reserved.
+ * Licensed under the MIT License.
+ */
+#include <jni.h>
+#include <string.h>
+#include "onnxruntime/core/session/onnxruntime_c_api.h"
+#include "OrtJniUtil.h"
+#include "ai_onnxruntime_OrtSession_IoBinding.h"
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IoBinding
+ * Method:    createIoBinding
+ * Signature: (JJ)J
+ */
+JNIEXPORT jlong JNICALL Java_ai_onnxruntime_OrtSession_00024IoBinding_createIoBinding
+  (JNIEnv * jniEnv, jclass jclazz, jlong apiHandle, jlong sessionHandle) {
+    (void) jclazz; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    OrtIoBinding* binding;
+    checkOrtStatus(jniEnv,api,api->CreateIoBinding((OrtSession*) sessionHandle,&binding));
+    return (jlong) binding;
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IoBinding
+ * Method:    bindInput
+ * Signature: (JJLjava/lang/String;J)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IoBinding_bindInput
+    (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle, jstring name, jlong valueHandle) {
+  (void) jobj; // Required JNI parameters not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  const char* nameStr = (*jniEnv)->GetStringUTFChars(jniEnv, name, NULL);
+  checkOrtStatus(jniEnv,api,api->BindInput((OrtIoBinding*) nativeHandle, nameStr, (const OrtValue*) valueHandle));
+  (*jniEnv)->ReleaseStringUTFChars(jniEnv,name,nameStr);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IoBinding
+ * Method:    bindOutput
+ * Signature: (JJLjava/lang/String;J)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IoBinding_bindOutput
+    (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle, jstring name, jlong valueHandle) {
+  (void) jobj; // Required JNI parameters not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  const char* nameStr = (*jniEnv)->GetStringUTFChars(jniEnv, name, NULL);
+  checkOrtStatus(jniEnv,api,api->BindOutput((OrtIoBinding*) nativeHandle, nameStr, (const OrtValue*) valueHandle));
+  (*jniEnv)->ReleaseStringUTFChars(jniEnv,name,nameStr);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IoBinding
+ * Method:    bindOutputToCPU
+ * Signature: (JJLjava/lang/String;)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IoBinding_bindOutputToCPU
+    (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle, jstring name) {
+  (void) jobj; // Required JNI parameters not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  OrtMemoryInfo* memoryInfo;
+  checkOrtStatus(jniEnv,api,api->CreateCpuMemoryInfo(OrtArenaAllocator, OrtMemTypeDefault, &memoryInfo));
+  const char* nameStr = (*jniEnv)->GetStringUTFChars(jniEnv, name, NULL);
+  checkOrtStatus(jniEnv,api,api->BindOutputToDevice((OrtIoBinding*) nativeHandle, nameStr, memoryInfo));
+  (*jniEnv)->ReleaseStringUTFChars(jniEnv,name,nameStr);
+  api->ReleaseMemoryInfo(memoryInfo);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IoBinding
+ * Method:    getOutputNames
+ * Signature: (JJJ)[Ljava/lang/String;
+ */
+JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_00024IoBinding_getOutputNames
+    (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle, jlong allocatorHandle) {
+  (void) jobj; // Required JNI parameters not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  OrtAllocator* allocator = (OrtAllocator*) allocatorHandle;
+
+  char* buffer = NULL;
+  size_t* lengths = NULL;
+  size_t count = 0;
+  checkOrtStatus(jniEnv,api,api->GetBoundOutputNames((OrtIoBinding*) nativeHandle, allocator, &buffer, &lengths, &count));
+
+  char* stringClassName = "java/lang/String";
+  jclass stringClazz = (*jniEnv)->FindClass(jniEnv, stringClassName);
+  jobjectArray outputArray = (*jniEnv)->NewObjectArray(jniEnv, safecast_size_t_to_jsize(count), stringClazz, NULL);
+
+  // The names are stored back to back without terminators.
+  char* name = buffer;
+  for (size_t i = 0; i < count; i++) {
+    char* nameStr;
+    checkOrtStatus(jniEnv,api,api->AllocatorAlloc(allocator, lengths[i] + 1, (void**)&nameStr));
+    memcpy(nameStr, name, lengths[i]);
+    nameStr[lengths[i]] = '\0';
+    jstring javaName = (*jniEnv)->NewStringUTF(jniEnv, nameStr);
+    (*jniEnv)->SetObjectArrayElement(jniEnv, outputArray, safecast_size_t_to_jsize(i), javaName);
+    checkOrtStatus(jniEnv,api,api->AllocatorFree(allocator, nameStr));
+    name += lengths[i];
+  }
+
+  if (count > 0) {
+    checkOrtStatus(jniEnv,api,api->AllocatorFree(allocator, buffer));
+    checkOrtStatus(jniEnv,api,api->AllocatorFree(allocator, lengths));
+  }
+
+  return outputArray;
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IoBinding
+ * Method:    getOutputValues
+ * Signature: (JJJ)[Lai/onnxruntime/OnnxValue;
+ */
+JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_00024IoBinding_getOutputValues
+    (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle, jlong allocatorHandle) {
+  (void) jobj; // Required JNI parameters not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  OrtAllocator* allocator = (OrtAllocator*) allocatorHandle;
+
+  OrtValue** outputValues = NULL;
+  size_t count = 0;
+  checkOrtStatus(jniEnv,api,api->GetBoundOutputValues((OrtIoBinding*) nativeHandle, allocator, &outputValues, &count));
+
+  char *onnxValueClassName = "ai/onnxruntime/OnnxValue";
+  jclass onnxValueClass = (*jniEnv)->FindClass(jniEnv, onnxValueClassName);
+  jobjectArray outputArray = (*jniEnv)->NewObjectArray(jniEnv, safecast_size_t_to_jsize(count), onnxValueClass, NULL);
+
+  // Each returned OrtValue is owned by the Java object that wraps it.
+  for (size_t i = 0; i < count; i++) {
+    jobject onnxValue = convertOrtValueToONNXValue(jniEnv,api,allocator,outputValues[i]);
+    (*jniEnv)->SetObjectArrayElement(jniEnv, outputArray, safecast_size_t_to_jsize(i), onnxValue);
+  }
+
+  if (count > 0) {
+    checkOrtStatus(jniEnv,api,api->AllocatorFree(allocator, outputValues));
+  }
+
+  return outputArray;
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IoBinding
+ * Method:    clearBoundInputs
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IoBinding_clearBoundInputs
+    (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle) {
+  (void) jniEnv; (void) jobj; // Required JNI parameters not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  api->ClearBoundInputs((OrtIoBinding*) nativeHandle);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IoBinding
+ * Method:    clearBoundOutputs
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IoBinding_clearBoundOutputs
+    (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle) {
+  (void) jniEnv; (void) jobj; // Required JNI parameters not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  api->ClearBoundOutputs((OrtIoBinding*) nativeHandle);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IoBinding
+ * Method:    close
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IoBinding_close
+    (JNIEnv * jniEnv, jclass jclazz, jlong apiHandle, jlong handle) {
+  (void) jniEnv; (void) jclazz; // Required JNI parameters not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  api->ReleaseIoBinding((OrtIoBinding*) handle);
+}
@@ -971,6 +971,54 @@ public class InferenceTest {
     }
   }
 
+  @Test
+  public void testIoBinding() throws OrtException {
+    // model takes 1x5 input of fixed type, echoes back
+    String modelPath = getResourcePath("/test_types_FLOAT.pb").toString();
+
+    try (OrtEnvironment env = OrtEnvironment.getEnvironment("testIoBinding");
+        SessionOptions options = new SessionOptions();
+        OrtSession session = env.createSession(modelPath, options)) {
+      String inputName = session.getInputNames().iterator().next();
+      String outputName = session.getOutputNames().iterator().next();
+      long[] shape = new long[] {1, 5};
+      FloatBuffer inputBuffer =
+          ByteBuffer.allocateDirect(5 * 4).order(ByteOrder.nativeOrder()).asFloatBuffer();
+      FloatBuffer outputBuffer =
+          ByteBuffer.allocateDirect(5 * 4).order(ByteOrder.nativeOrder()).asFloatBuffer();
+      float[] resultArray = new float[5];
+
+      try (OnnxTensor input = OnnxTensor.createTensor(env, inputBuffer, shape);
+          OnnxTensor output = OnnxTensor.createTensor(env, outputBuffer, shape);
+          OrtSession.IoBinding binding = new OrtSession.IoBinding(session)) {
+        binding.bindInput(inputName, input);
+        binding.bindOutput(outputName, output);
+
+        // The tensors wrap the direct buffers, so new inputs are picked up without rebinding.
+        for (int i = 0; i < 3; i++) {
+          float[] inputArr = new float[] {i, -2.0f * i, 3.0f, -4.0f, 5.0f * i};
+          inputBuffer.rewind();
+          inputBuffer.put(inputArr);
+          session.run(binding);
+          outputBuffer.rewind();
+          outputBuffer.get(resultArray);
+          assertArrayEquals(inputArr, resultArray, 1e-6f);
+        }
+
+        // Let the session allocate the output.
+        binding.clearBoundOutputs();
+        binding.bindOutput(outputName);
+        session.run(binding);
+        try (Result res = binding.getOutputs()) {
+          assertEquals(1, res.size());
+          OnnxTensor boundOutput = (OnnxTensor) res.get(outputName).get();
+          boundOutput.getDirectByteBuffer().asFloatBuffer().get(resultArray);
+          assertArrayEquals(new float[] {2.0f, -4.0f, 3.0f, -4.0f, 10.0f}, resultArray, 1e-6f);
+        }
+      }
+    }
+  }
+
   @Test
   public void testRunOptions() throws OrtException {
     // model takes 1x5 input of fixed type, echoes back
@@ -34,6 +34,7 @@ class Attention : public OpKernel, public AttentionCPUBase {
   BufferUniquePtr packed_weights_;
   size_t packed_weights_size_ = 0;
   TensorShape weight_shape_;
+  int chunk_size_;
 };
 
 // These ops are internal-only, so register outside of onnx
@@ -201,6 +202,9 @@ Tensor* AttentionBase::GetPresent(OpKernelContext* context,
 
 template <typename T>
 Attention<T>::Attention(const OpKernelInfo& info) : OpKernel(info), AttentionCPUBase(info) {
+  int64_t chunk_size = info.GetAttrOrDefault<int64_t>("chunk_size", 0);
+  ORT_ENFORCE(chunk_size >= 0, "chunk_size must be non-negative, got ", chunk_size);
+  chunk_size_ = static_cast<int>(chunk_size);
 }
 
 template <typename T>
@@ -395,6 +399,12 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
   }
 
   // Compute the attention score and apply the score to V
+  if (chunk_size_ > 0) {
+    return ApplyChunkedAttention(Q, K, V, mask_index, past, output,
+                                 batch_size, sequence_length,
+                                 head_size, hidden_size, chunk_size_, context);
+  }
+
   return ApplyAttention(Q, K, V, mask_index, past, output,
                         batch_size, sequence_length,
                         head_size, hidden_size, context);
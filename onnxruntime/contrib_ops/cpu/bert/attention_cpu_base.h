@@ -3,6 +3,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "attention_base.h"
 #include "attention_helper.h"
 
@@ -78,6 +82,161 @@ class AttentionCPUBase : public AttentionBase {
     return Status::OK();
   }
 
+  // Computes the same result as ApplyAttention without materializing the attention probs (B, N, S, S*).
+  // The queries of each batch and head are processed in blocks, and each block iterates over blocks of
+  // key_chunk_size keys with an online softmax: the running max and sum of every query row rescale the
+  // partial output whenever a block of keys raises the max. The scratch memory grows linearly with the
+  // sequence length, and the working set of a block stays in the cache.
+  Status ApplyChunkedAttention(const float* Q,             // Q data. Its size is BxNxSxH
+                               const float* K,             // K data. Its size is BxNxSxH
+                               const float* V,             // V value with size BxNxSxH
+                               const Tensor* mask_index,   // mask index. nullptr if no mask or its size is B
+                               const Tensor* past,         // past state
+                               Tensor* output,             // output tensor
+                               int batch_size,             // batch size
+                               int sequence_length,        // sequence length
+                               int head_size,              // head size
+                               int hidden_size,            // hidden size
+                               int key_chunk_size,         // number of keys in a block
+                               OpKernelContext* context) const {
+    AllocatorPtr allocator;
+    ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+
+    auto* tp = context->GetOperatorThreadPool();
+
+    int past_sequence_length = 0;
+    Tensor* present = GetPresent(context, past, batch_size, head_size, sequence_length, past_sequence_length);
+
+    // Total sequence length including that of past state: S* = S' + S
+    const int all_sequence_length = past_sequence_length + sequence_length;
+    const size_t past_chunk_length = static_cast<size_t>(past_sequence_length) * head_size;  // S' x H
+    const size_t input_chunk_length = static_cast<size_t>(sequence_length) * head_size;      // S x H
+    const size_t present_chunk_length = past_chunk_length + input_chunk_length;              // S* x H
+    const int loop_len = batch_size * num_heads_;
+
+    const float* past_data = past != nullptr ? past->template Data<float>() : nullptr;
+    float* present_data = present != nullptr ? present->template MutableData<float>() : nullptr;
+    const size_t v_past_offset = SafeInt<size_t>(loop_len) * past_chunk_length;
+    const size_t v_present_offset = SafeInt<size_t>(loop_len) * present_chunk_length;
+
+    // concatenate past_K and K, past_V and V: (BxNx)S'xH, (BxNx)SxH -> (BxNx)S*xH
+    // It is done before the blocks of queries since all of them read the keys and values of their head.
+    if (nullptr != present_data) {
+      ThreadPool::TryParallelFor(tp, loop_len, 2.0 * present_chunk_length, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t i = begin; i != end; ++i) {
+          ConcatStateChunk(past_data, K + input_chunk_length * i, present_data,
+                           past_chunk_length, present_chunk_length, i);
+          ConcatStateChunk(past_data != nullptr ? past_data + v_past_offset : nullptr, V + input_chunk_length * i,
+                           present_data + v_present_offset, past_chunk_length, present_chunk_length, i);
+        }
+      });
+    }
+    const float* all_keys = present_data != nullptr ? present_data : K;
+    const float* all_values = present_data != nullptr ? present_data + v_present_offset : V;
+
+    constexpr int query_chunk_size = 64;
+    const int query_chunk_count = (sequence_length + query_chunk_size - 1) / query_chunk_size;
+    const int key_chunk_length = std::max(1, std::min(key_chunk_size, all_sequence_length));
+    const int task_count = loop_len * query_chunk_count;
+
+    // Scratch buffer of each task: the scores of a block of queries and keys (64 x key_chunk_length), the partial
+    // output of the queries (64 x H), and the running max and sum of each query (2 x 64).
+    const size_t scratch_length_per_task = static_cast<size_t>(query_chunk_size) * (key_chunk_length + head_size + 2);
+    auto scratch_data = allocator->Alloc(SafeInt<size_t>(task_count) * scratch_length_per_task * sizeof(float));
+    BufferUniquePtr scratch_buffer(scratch_data, BufferDeleter(allocator));
+
+    const int32_t* mask_index_data = mask_index != nullptr ? mask_index->template Data<int32_t>() : nullptr;
+    const std::vector<int64_t>* mask_index_dims = mask_index != nullptr ? &(mask_index->Shape().GetDims()) : nullptr;
+    const bool has_mask = mask_index != nullptr || (is_unidirectional_ && sequence_length > 1);
+
+    // Without any other mask, the keys after the last query of a block are masked for all its rows by the
+    // unidirectional mask, and their probabilities underflow to 0. Those keys are skipped.
+    const bool skip_future_keys = is_unidirectional_ && mask_index == nullptr;
+
+    const float alpha = 1.0f / sqrt(static_cast<float>(head_size));
+    float* output_data = output->template MutableData<float>();
+
+    const double cost = 2.0 * head_size * query_chunk_size * all_sequence_length;
+    ThreadPool::TryParallelFor(tp, task_count, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      for (std::ptrdiff_t task = begin; task != end; ++task) {
+        const std::ptrdiff_t i = task / query_chunk_count;
+        const int batch_index = static_cast<int>(i / num_heads_);
+        const int head_index = static_cast<int>(i % num_heads_);
+        const int query_start = static_cast<int>(task % query_chunk_count) * query_chunk_size;
+        const int query_end = std::min(query_start + query_chunk_size, sequence_length);
+        const int query_count = query_end - query_start;
+
+        float* scores = static_cast<float*>(scratch_data) + scratch_length_per_task * task;
+        float* out_tmp = scores + static_cast<size_t>(query_chunk_size) * key_chunk_length;
+        float* row_max = out_tmp + static_cast<size_t>(query_chunk_size) * head_size;
+        float* row_sum = row_max + query_chunk_size;
+        std::fill_n(out_tmp, static_cast<size_t>(query_count) * head_size, 0.0f);
+        std::fill_n(row_max, query_count, -std::numeric_limits<float>::infinity());
+        std::fill_n(row_sum, query_count, 0.0f);
+
+        const float* q = Q + input_chunk_length * i + static_cast<size_t>(query_start) * head_size;
+        const float* k = all_keys + (present_data != nullptr ? present_chunk_length : input_chunk_length) * i;
+        const float* v = all_values + (present_data != nullptr ? present_chunk_length : input_chunk_length) * i;
+
+        const int key_limit = skip_future_keys ? past_sequence_length + query_end : all_sequence_length;
+        for (int key_start = 0; key_start < key_limit; key_start += key_chunk_length) {
+          const int key_end = std::min(key_start + key_chunk_length, key_limit);
+          const int key_count = key_end - key_start;
+
+          // scores(q, k) = 1/sqrt(H) x Q(q, H) x K'(k, H -> H, k) + mask(q, k)
+          math::Gemm<float, ThreadPool>(CblasNoTrans, CblasTrans, query_count, key_count, head_size, alpha,
+                                        q, k + static_cast<size_t>(key_start) * head_size, 0.0f, scores, nullptr);
+          if (has_mask) {
+            ApplyMaskChunk(scores, mask_index_data, mask_index_dims, is_unidirectional_, batch_index, batch_size,
+                           sequence_length, past_sequence_length, query_start, query_end, key_start, key_end);
+          }
+
+          // scores(q, k) = exp(scores - max), and the partial output and sum of each query are rescaled to the
+          // new max.
+          for (int r = 0; r < query_count; r++) {
+            float* row = scores + static_cast<size_t>(r) * key_count;
+            const float new_max = std::max(row_max[r], *std::max_element(row, row + key_count));
+            for (int j = 0; j < key_count; j++) {
+              row[j] -= new_max;
+            }
+            MlasComputeExp(row, row, key_count);
+
+            const float correction = std::exp(row_max[r] - new_max);
+            float sum = 0.0f;
+            for (int j = 0; j < key_count; j++) {
+              sum += row[j];
+            }
+            row_sum[r] = row_sum[r] * correction + sum;
+            row_max[r] = new_max;
+            if (correction != 1.0f) {
+              float* out_row = out_tmp + static_cast<size_t>(r) * head_size;
+              for (int h = 0; h < head_size; h++) {
+                out_row[h] *= correction;
+              }
+            }
+          }
+
+          // out_tmp(q, H) += scores(q, k) x V(k, H)
+          math::Gemm<float, ThreadPool>(CblasNoTrans, CblasNoTrans, query_count, head_size, key_count, 1.0f,
+                                        scores, v + static_cast<size_t>(key_start) * head_size, 1.0f, out_tmp, nullptr);
+        }
+
+        // normalize and transpose: out(B, S, N, H) = out_tmp(B, N, S, H) / sum
+        for (int r = 0; r < query_count; r++) {
+          const float* src = out_tmp + static_cast<size_t>(r) * head_size;
+          float* dest = output_data + (static_cast<size_t>(batch_index) * sequence_length + query_start + r) * hidden_size +
+                        static_cast<size_t>(head_index) * head_size;
+          const float inverse_sum = 1.0f / row_sum[r];
+          for (int h = 0; h < head_size; h++) {
+            dest[h] = src[h] * inverse_sum;
+          }
+        }
+      }
+    });
+
+    return Status::OK();
+  }
+
  private:
   // Helper function to compute the attention probs. It does 2 things:
   //  I. attention_probs(B, N, S, S*) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, S*, H -> B, N, H, S*) +
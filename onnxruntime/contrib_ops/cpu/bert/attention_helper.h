@@ -148,6 +148,68 @@ void PrepareMask(const int32_t* mask_index,
   }
 }
 
+// Adds the mask of one batch to a block of the attention scores with the query rows [query_start, query_end) and
+// the key columns [key_start, key_end). The values are the same as those of PrepareMask, which are computed here
+// for the block only so that the mask of the whole sequence is never materialized.
+template <typename T>
+void ApplyMaskChunk(T* scores,
+                    const int32_t* mask_index,
+                    const std::vector<int64_t>* mask_index_dims,
+                    bool is_unidirectional,
+                    int batch_index,
+                    int batch_size,
+                    int sequence_length,
+                    int past_sequence_length,
+                    int query_start,
+                    int query_end,
+                    int key_start,
+                    int key_end) {
+  const int all_sequence_length = past_sequence_length + sequence_length;
+  const int key_count = key_end - key_start;
+
+  // 4D mask in Megatron GPT2 is currently not support in CPU kernel
+  if (nullptr != mask_index_dims && mask_index_dims->size() == 4) {
+    return;
+  }
+
+  const bool is_3d_mask = nullptr != mask_index_dims && mask_index_dims->size() == 3;
+  const bool is_raw_attention_mask = nullptr != mask_index_dims && mask_index_dims->size() == 2;
+  const bool has_mask_start_position = nullptr != mask_index_dims && mask_index_dims->size() == 1 &&
+                                       static_cast<int>(mask_index_dims->at(0)) == 2 * batch_size;
+
+  int end_position = all_sequence_length;
+  int start_position = 0;
+  if (nullptr != mask_index && !is_3d_mask && !is_raw_attention_mask) {
+    end_position = mask_index[batch_index];
+    if (has_mask_start_position) {
+      start_position = std::min(mask_index[batch_index + batch_size], all_sequence_length);
+    }
+  }
+
+  for (int s_i = query_start; s_i < query_end; s_i++) {
+    T* p_scores = scores + (s_i - query_start) * key_count;
+    for (int m_i = key_start; m_i < key_end; m_i++) {
+      bool masked;
+      if (nullptr == mask_index) {
+        masked = false;
+      } else if (is_3d_mask) {
+        masked = mask_index[(static_cast<size_t>(batch_index) * sequence_length + s_i) * all_sequence_length + m_i] <= 0;
+      } else if (is_raw_attention_mask) {
+        masked = mask_index[static_cast<size_t>(batch_index) * all_sequence_length + m_i] <= 0;
+      } else {
+        masked = m_i >= end_position || m_i < start_position;
+      }
+
+      if (masked) {
+        p_scores[m_i - key_start] += static_cast<T>(-10000.0f);
+      }
+      if (is_unidirectional && m_i > past_sequence_length + s_i) {
+        p_scores[m_i - key_start] += static_cast<T>(-10000.0f);
+      }
+    }
+  }
+}
+
 // Concatenate a past state chunk S'xH with input state chunk SxH into present state chunk S*xH
 // Returns a pointer to the start of present state chunk.
 template <typename T>
@@ -0,0 +1,315 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math_cpuonly.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace {
+
+enum class ElementwiseOp {
+  Add,
+  Sub,
+  Mul,
+  Div,
+  Pow,
+  Max,
+  Min,
+  Abs,
+  Erf,
+  Exp,
+  Log,
+  Neg,
+  Reciprocal,
+  Relu,
+  Sigmoid,
+  Sqrt,
+  Tanh,
+};
+
+bool ParseElementwiseOp(const std::string& name, ElementwiseOp& op) {
+  static const std::unordered_map<std::string, ElementwiseOp> ops = {
+      {"Add", ElementwiseOp::Add},
+      {"Sub", ElementwiseOp::Sub},
+      {"Mul", ElementwiseOp::Mul},
+      {"Div", ElementwiseOp::Div},
+      {"Pow", ElementwiseOp::Pow},
+      {"Max", ElementwiseOp::Max},
+      {"Min", ElementwiseOp::Min},
+      {"Abs", ElementwiseOp::Abs},
+      {"Erf", ElementwiseOp::Erf},
+      {"Exp", ElementwiseOp::Exp},
+      {"Log", ElementwiseOp::Log},
+      {"Neg", ElementwiseOp::Neg},
+      {"Reciprocal", ElementwiseOp::Reciprocal},
+      {"Relu", ElementwiseOp::Relu},
+      {"Sigmoid", ElementwiseOp::Sigmoid},
+      {"Sqrt", ElementwiseOp::Sqrt},
+      {"Tanh", ElementwiseOp::Tanh},
+  };
+  auto it = ops.find(name);
+  if (it == ops.end()) {
+    return false;
+  }
+  op = it->second;
+  return true;
+}
+
+bool IsBinaryOp(ElementwiseOp op) {
+  return op <= ElementwiseOp::Min;
+}
+
+struct ElementwiseStep {
+  ElementwiseOp op;
+  int operand;
+  bool swap_operands;
+};
+
+// Applies a binary operator to the running result and a span of the operand with the same length.
+void ApplyBinary(ElementwiseOp op, bool swap_operands, float* data, const float* operand, std::ptrdiff_t count) {
+  EigenVectorArrayMap<float> result(data, count);
+  ConstEigenVectorArrayMap<float> other(operand, count);
+
+  switch (op) {
+    case ElementwiseOp::Add:
+      result += other;
+      break;
+    case ElementwiseOp::Sub:
+      result = swap_operands ? (other - result).eval() : (result - other).eval();
+      break;
+    case ElementwiseOp::Mul:
+      result *= other;
+      break;
+    case ElementwiseOp::Div:
+      result = swap_operands ? (other / result).eval() : (result / other).eval();
+      break;
+    case ElementwiseOp::Pow:
+      result = swap_operands ? other.pow(result).eval() : result.pow(other).eval();
+      break;
+    case ElementwiseOp::Max:
+      result = result.max(other);
+      break;
+    case ElementwiseOp::Min:
+      result = result.min(other);
+      break;
+    default:
+      ORT_THROW("Unexpected binary operator");
+  }
+}
+
+// Applies a binary operator with a scalar operand.
+void ApplyBinaryScalar(ElementwiseOp op, bool swap_operands, float* data, float operand, std::ptrdiff_t count) {
+  EigenVectorArrayMap<float> result(data, count);
+
+  switch (op) {
+    case ElementwiseOp::Add:
+      result += operand;
+      break;
+    case ElementwiseOp::Sub:
+      result = swap_operands ? (operand - result).eval() : (result - operand).eval();
+      break;
+    case ElementwiseOp::Mul:
+      result *= operand;
+      break;
+    case ElementwiseOp::Div:
+      result = swap_operands ? (operand / result).eval() : (result / operand).eval();
+      break;
+    case ElementwiseOp::Pow:
+      if (swap_operands) {
+        for (std::ptrdiff_t i = 0; i < count; i++) {
+          data[i] = std::pow(operand, data[i]);
+        }
+      } else if (operand == 2.0f) {
+        result = result.square();
+      } else {
+        result = result.pow(operand);
+      }
+      break;
+    case ElementwiseOp::Max:
+      result = result.max(operand);
+      break;
+    case ElementwiseOp::Min:
+      result = result.min(operand);
+      break;
+    default:
+      ORT_THROW("Unexpected binary operator");
+  }
+}
+
+void ApplyUnary(ElementwiseOp op, float* data, std::ptrdiff_t count) {
+  EigenVectorArrayMap<float> result(data, count);
+
+  switch (op) {
+    case ElementwiseOp::Abs:
+      result = result.abs();
+      break;
+    case ElementwiseOp::Erf:
+      MlasComputeErf(data, data, static_cast<size_t>(count));
+      break;
+    case ElementwiseOp::Exp:
+      MlasComputeExp(data, data, static_cast<size_t>(count));
+      break;
+    case ElementwiseOp::Log:
+      result = result.log();
+      break;
+    case ElementwiseOp::Neg:
+      result = -result;
+      break;
+    case ElementwiseOp::Reciprocal:
+      result = result.inverse();
+      break;
+    case ElementwiseOp::Relu:
+      result = result.max(0.0f);
+      break;
+    case ElementwiseOp::Sigmoid:
+      MlasComputeLogistic(data, data, static_cast<size_t>(count));
+      break;
+    case ElementwiseOp::Sqrt:
+      result = result.sqrt();
+      break;
+    case ElementwiseOp::Tanh:
+      MlasComputeTanh(data, data, static_cast<size_t>(count));
+      break;
+    default:
+      ORT_THROW("Unexpected unary operator");
+  }
+}
+
+}  // namespace
+
+// Evaluates a chain of elementwise operators in one pass. The output is processed in blocks that fit
+// in the cache: each block is copied from the input once and then updated in place by every step.
+class FusedElementwise final : public OpKernel {
+ public:
+  explicit FusedElementwise(const OpKernelInfo& info) : OpKernel(info) {
+    std::vector<std::string> operators = info.GetAttrsOrDefault<std::string>("operators");
+    std::vector<int64_t> operands = info.GetAttrsOrDefault<int64_t>("operands");
+    std::vector<int64_t> swap_operands = info.GetAttrsOrDefault<int64_t>("swap_operands");
+    ORT_ENFORCE(!operators.empty(), "FusedElementwise requires at least one operator");
+    ORT_ENFORCE(operands.size() == operators.size(), "operands must have one entry per operator");
+    ORT_ENFORCE(swap_operands.empty() || swap_operands.size() == operators.size(),
+                "swap_operands must have one entry per operator");
+
+    const auto input_count = static_cast<int64_t>(info.GetInputCount());
+    for (size_t i = 0; i < operators.size(); ++i) {
+      ElementwiseStep step;
+      ORT_ENFORCE(ParseElementwiseOp(operators[i], step.op), "Unsupported operator: ", operators[i]);
+      if (IsBinaryOp(step.op)) {
+        ORT_ENFORCE(operands[i] >= 0 && operands[i] < input_count, "Invalid operand index for ", operators[i]);
+      } else {
+        ORT_ENFORCE(operands[i] == -1, "Unary operator ", operators[i], " must not have an operand");
+      }
+      step.operand = static_cast<int>(operands[i]);
+      step.swap_operands = !swap_operands.empty() && swap_operands[i] != 0;
+      steps_.push_back(step);
+    }
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  std::vector<ElementwiseStep> steps_;
+};
+
+ONNX_OPERATOR_KERNEL_EX(
+    FusedElementwise,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise);
+
+Status FusedElementwise::Compute(OpKernelContext* context) const {
+  const auto* X = context->Input<Tensor>(0);
+  const auto& shape = X->Shape();
+  const float* input_data = X->Data<float>();
+  const int64_t elem_count = shape.Size();
+
+  // Each operand is read as a sequence of operand_size elements repeated along the input, which is
+  // only valid if its shape matches the trailing dimensions of the input. An operand may not have a
+  // higher rank than the input, as the output then would need its leading dimensions. The input
+  // itself may also be used as an operand.
+  const int input_count = context->InputCount();
+  std::vector<const float*> operand_data(static_cast<size_t>(input_count), nullptr);
+  std::vector<int64_t> operand_sizes(static_cast<size_t>(input_count), 0);
+  for (int i = 0; i < input_count; ++i) {
+    const auto* operand = context->Input<Tensor>(i);
+    const auto& operand_dims = operand->Shape().GetDims();
+    if (operand_dims.size() > shape.NumDimensions()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Operand ", i, " with shape ", operand->Shape(),
+                             " has a higher rank than the input shape ", shape);
+    }
+    size_t leading_ones = 0;
+    while (leading_ones < operand_dims.size() && operand_dims[leading_ones] == 1) {
+      leading_ones++;
+    }
+    const size_t trailing_rank = operand_dims.size() - leading_ones;
+    if (trailing_rank > shape.NumDimensions() ||
+        !std::equal(operand_dims.begin() + leading_ones, operand_dims.end(),
+                    shape.GetDims().end() - trailing_rank)) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Operand ", i, " with shape ", operand->Shape(),
+                             " does not broadcast to the input shape ", shape);
+    }
+    operand_data[static_cast<size_t>(i)] = operand->Data<float>();
+    operand_sizes[static_cast<size_t>(i)] = operand->Shape().Size();
+  }
+
+  Tensor* Y = context->Output(0, shape);
+  float* output_data = Y->MutableData<float>();
+  if (elem_count == 0) {
+    return Status::OK();
+  }
+
+  // 4096 floats per block keeps the running result in the L1 or L2 cache across the steps.
+  static const int64_t length_per_task = 4096;
+  const int64_t task_count = (elem_count + length_per_task - 1) / length_per_task;
+
+  concurrency::ThreadPool::TryBatchParallelFor(
+      context->GetOperatorThreadPool(), static_cast<int32_t>(task_count),
+      [&](ptrdiff_t task_idx) {
+        const int64_t start = task_idx * length_per_task;
+        const int64_t count = std::min(length_per_task, elem_count - start);
+        float* data = output_data + start;
+        std::copy_n(input_data + start, count, data);
+
+        for (const auto& step : steps_) {
+          if (!IsBinaryOp(step.op)) {
+            ApplyUnary(step.op, data, count);
+            continue;
+          }
+
+          const float* operand = operand_data[static_cast<size_t>(step.operand)];
+          const int64_t operand_size = operand_sizes[static_cast<size_t>(step.operand)];
+          if (operand_size == 1) {
+            ApplyBinaryScalar(step.op, step.swap_operands, data, *operand, count);
+            continue;
+          }
+
+          // Walk the block in runs that do not wrap around the end of the operand.
+          int64_t offset = 0;
+          while (offset < count) {
+            const int64_t operand_offset = (start + offset) % operand_size;
+            const int64_t run = std::min(count - offset, operand_size - operand_offset);
+            ApplyBinary(step.op, step.swap_operands, data + offset, operand + operand_offset, run);
+            offset += run;
+          }
+        }
+      },
+      0);
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
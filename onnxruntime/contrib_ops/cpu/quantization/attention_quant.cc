@@ -32,10 +32,15 @@ class QAttention : public OpKernel, public AttentionCPUBase {
                                    /*out*/ bool& used_shared_buffers) override;
 
  private:
+  Status ApplyIntegerAttention(const T* Q, const T* K, const T* V, const Tensor* mask_index, const Tensor* past,
+                               Tensor* output, int batch_size, int sequence_length, int head_size, int hidden_size,
+                               OpKernelContext* context) const;
+
   BufferUniquePtr packed_weights_;
   size_t packed_weights_size_;
   TensorShape weight_shape_;
   bool weights_is_signed_;
+  bool integer_attention_;
 };
 
 // These ops are internal-only, so register outside of onnx
@@ -53,7 +58,177 @@ ONNX_OPERATOR_TYPED_KERNEL_EX(
     QAttention<float>);
 
 template <typename T>
-QAttention<T>::QAttention(const OpKernelInfo& info) : OpKernel(info), AttentionCPUBase(info) {}
+QAttention<T>::QAttention(const OpKernelInfo& info) : OpKernel(info), AttentionCPUBase(info) {
+  integer_attention_ = info.GetAttrOrDefault<int64_t>("integer_attention", 0) == 1;
+}
+
+namespace {
+
+// Quantizes data to uint8 with an asymmetric range. Returns the scale and the zero point.
+float QuantizeAsymmetric(const float* data, size_t count, uint8_t* quantized, uint8_t& zero_point) {
+  float scale;
+  GetQuantizationParameter(data, static_cast<int64_t>(count), scale, zero_point, nullptr);
+  MlasQuantizeLinear<uint8_t>(data, quantized, count, scale, zero_point);
+  return scale;
+}
+
+}  // namespace
+
+// Computes the attention of the projected Q, K and V with 8-bit integer GEMMs.
+// For each batch and head:
+//   I.  attention_probs(S, S*) = Softmax(1/sqrt(H) x Q(S, H) x K'(H, S*) + mask(S, S*))
+//   II. output(S, H) = attention_probs(S, S*) x V(S*, H)
+// Q, K and V are quantized to uint8 with scales computed per batch and head, and the attention probabilities are in
+// [0, 1] and are quantized to uint8 with a fixed scale of 1/255. Both products use the u8u8 GEMM kernels: the u8s8
+// kernels for AVX2 without VNNI sum pairs of products in int16, which saturates for full range activations.
+// The softmax is computed in float between the two products.
+template <typename T>
+Status QAttention<T>::ApplyIntegerAttention(const T* Q, const T* K, const T* V, const Tensor* mask_index,
+                                            const Tensor* past, Tensor* output, int batch_size, int sequence_length,
+                                            int head_size, int hidden_size, OpKernelContext* context) const {
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+
+  auto* tp = context->GetOperatorThreadPool();
+
+  int past_sequence_length = 0;
+  Tensor* present = GetPresent(context, past, batch_size, head_size, sequence_length, past_sequence_length);
+
+  // Total sequence length including that of past state: S* = S' + S
+  const int all_sequence_length = past_sequence_length + sequence_length;
+  const size_t past_chunk_length = static_cast<size_t>(past_sequence_length) * head_size;      // S' x H
+  const size_t input_chunk_length = static_cast<size_t>(sequence_length) * head_size;          // S x H
+  const size_t present_chunk_length = past_chunk_length + input_chunk_length;                  // S* x H
+  const size_t probs_chunk_length = static_cast<size_t>(sequence_length) * all_sequence_length;  // S x S*
+
+  void* mask_data = nullptr;
+  if (mask_index != nullptr || (is_unidirectional_ && sequence_length > 1)) {
+    size_t mask_data_bytes = SafeInt<size_t>(batch_size) * probs_chunk_length * sizeof(T);
+    mask_data = allocator->Alloc(mask_data_bytes);
+    memset(mask_data, 0, mask_data_bytes);
+    PrepareMask(mask_index != nullptr ? mask_index->template Data<int32_t>() : nullptr,
+                mask_index != nullptr ? &(mask_index->Shape().GetDims()) : nullptr,
+                static_cast<T*>(mask_data), is_unidirectional_, batch_size, sequence_length, past_sequence_length);
+  }
+  BufferUniquePtr mask_data_buffer(mask_data, BufferDeleter(allocator));
+
+  const T* past_data = past != nullptr ? past->template Data<T>() : nullptr;
+  T* present_data = present != nullptr ? present->template MutableData<T>() : nullptr;
+  const size_t v_state_offset = SafeInt<size_t>(batch_size) * num_heads_ * past_chunk_length;
+  const size_t v_present_offset = SafeInt<size_t>(batch_size) * num_heads_ * present_chunk_length;
+
+  // Scratch buffer of each batch and head: the attention probs in float (S x S*) and quantized (S x S*), the
+  // quantized Q (S x H), the quantized and transposed K (H x S*) and the quantized V (S* x H). The size is
+  // rounded up so that the float buffer of every head is aligned.
+  constexpr size_t scratch_alignment = 64;
+  const size_t scratch_bytes_per_head =
+      (probs_chunk_length * (sizeof(float) + sizeof(uint8_t)) + input_chunk_length + 2 * present_chunk_length +
+       scratch_alignment - 1) /
+      scratch_alignment * scratch_alignment;
+  const int loop_len = batch_size * num_heads_;
+  auto scratch_data = allocator->Alloc(SafeInt<size_t>(loop_len) * scratch_bytes_per_head);
+  BufferUniquePtr scratch_buffer(scratch_data, BufferDeleter(allocator));
+
+  const float alpha = 1.0f / sqrt(static_cast<float>(head_size));
+
+  const double cost = 2.0 * head_size * sequence_length * all_sequence_length;
+  ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    for (std::ptrdiff_t i = begin; i != end; ++i) {
+      const int batch_index = static_cast<int>(i / num_heads_);
+      const int head_index = static_cast<int>(i % num_heads_);
+
+      auto* scratch = static_cast<uint8_t*>(scratch_data) + scratch_bytes_per_head * i;
+      float* probs = reinterpret_cast<float*>(scratch);
+      uint8_t* quantized_probs = scratch + probs_chunk_length * sizeof(float);
+      uint8_t* quantized_q = quantized_probs + probs_chunk_length;
+      uint8_t* quantized_k_transposed = quantized_q + input_chunk_length;
+      uint8_t* quantized_v = quantized_k_transposed + present_chunk_length;
+
+      const T* q = Q + input_chunk_length * i;
+      const T* k = K + input_chunk_length * i;
+      const T* v = V + input_chunk_length * i;
+      if (nullptr != present_data) {
+        // concatenate past_K and K, past_V and V : (BxNx)S'xH, (BxNx)SxH -> (BxNx)S*xH
+        k = ConcatStateChunk(past_data, k, present_data, past_chunk_length, present_chunk_length, i);
+        v = ConcatStateChunk(past_data != nullptr ? past_data + v_state_offset : nullptr, v,
+                             present_data + v_present_offset, past_chunk_length, present_chunk_length, i);
+      }
+
+      uint8_t q_zero_point;
+      const float q_scale = QuantizeAsymmetric(q, input_chunk_length, quantized_q, q_zero_point);
+
+      // K is quantized into the buffer of V before it is transposed.
+      uint8_t k_zero_point;
+      const float k_scale = QuantizeAsymmetric(k, present_chunk_length, quantized_v, k_zero_point);
+      for (int s = 0; s < all_sequence_length; s++) {
+        for (int h = 0; h < head_size; h++) {
+          quantized_k_transposed[h * all_sequence_length + s] = quantized_v[s * head_size + h];
+        }
+      }
+      uint8_t v_zero_point;
+      const float v_scale = QuantizeAsymmetric(v, present_chunk_length, quantized_v, v_zero_point);
+
+      // I. attention_probs(S, S*) = 1/sqrt(H) x Q(S, H) x K'(H, S*)
+      const float qk_scale = alpha * q_scale * k_scale;
+      MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR qk_output_processor(probs, all_sequence_length, &qk_scale, nullptr);
+
+      MLAS_GEMM_U8X8_SHAPE_PARAMS qk_shape;
+      qk_shape.M = sequence_length;
+      qk_shape.N = all_sequence_length;
+      qk_shape.K = head_size;
+      qk_shape.BIsSigned = false;
+
+      MLAS_GEMM_U8X8_DATA_PARAMS qk_params;
+      qk_params.A = quantized_q;
+      qk_params.lda = head_size;
+      qk_params.ZeroPointA = q_zero_point;
+      qk_params.B = quantized_k_transposed;
+      qk_params.ldb = all_sequence_length;
+      qk_params.ZeroPointB = &k_zero_point;
+      qk_params.C = reinterpret_cast<int32_t*>(probs);
+      qk_params.ldc = all_sequence_length;
+      qk_params.OutputProcessor = &qk_output_processor;
+      MlasGemm(qk_shape, qk_params, nullptr);
+
+      // broadcast mask data: (Bx)SxS* -> (BxNx)SxS*
+      if (mask_data != nullptr) {
+        const T* mask = static_cast<const T*>(mask_data) + batch_index * probs_chunk_length;
+        for (size_t j = 0; j < probs_chunk_length; j++) {
+          probs[j] += mask[j];
+        }
+      }
+
+      MlasComputeSoftmax(probs, probs, sequence_length, all_sequence_length, false, nullptr);
+      MlasQuantizeLinear<uint8_t>(probs, quantized_probs, probs_chunk_length, 1.0f / 255.0f, 0);
+
+      // II. output(S, H) = attention_probs(S, S*) x V(S*, H), written transposed to out(B, S, N, H)
+      const float v_output_scale = v_scale / 255.0f;
+      T* dest = output->template MutableData<T>() +
+                (static_cast<size_t>(batch_index) * sequence_length * num_heads_ + head_index) * head_size;
+      MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR v_output_processor(dest, hidden_size, &v_output_scale, nullptr);
+
+      MLAS_GEMM_U8X8_SHAPE_PARAMS v_shape;
+      v_shape.M = sequence_length;
+      v_shape.N = head_size;
+      v_shape.K = all_sequence_length;
+      v_shape.BIsSigned = false;
+
+      MLAS_GEMM_U8X8_DATA_PARAMS v_params;
+      v_params.A = quantized_probs;
+      v_params.lda = all_sequence_length;
+      v_params.ZeroPointA = 0;
+      v_params.B = quantized_v;
+      v_params.ldb = head_size;
+      v_params.ZeroPointB = &v_zero_point;
+      v_params.C = reinterpret_cast<int32_t*>(dest);
+      v_params.ldc = hidden_size;
+      v_params.OutputProcessor = &v_output_processor;
+      MlasGemm(v_shape, v_params, nullptr);
+    }
+  });
+
+  return Status::OK();
+}
 
 template <typename T>
 Status QAttention<T>::PrePack(const Tensor& weights, int input_idx, AllocatorPtr alloc,
@@ -283,6 +458,11 @@ Status QAttention<T>::Compute(OpKernelContext* context) const {
     MlasGemmBatch(gemm_shape, gemm_data_vec.data(), loop_len, tp);
   }
 
+  if (integer_attention_) {
+    return ApplyIntegerAttention(Q, K, V, mask_index, past_tensor, output,
+                                 batch_size, sequence_length, head_size, hidden_size, context);
+  }
+
   // Compute the attention score and apply the score to V
   return ApplyAttention(Q, K, V, mask_index, past_tensor, output,
                         batch_size, sequence_length,
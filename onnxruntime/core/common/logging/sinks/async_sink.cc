@@ -0,0 +1,174 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/logging/sinks/async_sink.h"
+
+#include <chrono>
+
+#include "core/common/logging/capture.h"
+#include "core/common/logging/sinks/ostream_sink.h"
+
+namespace onnxruntime {
+namespace logging {
+
+namespace {
+// the writer also wakes up periodically, so a wake-up missed by a logging thread only delays the output
+constexpr std::chrono::milliseconds kWriterIdleTimeout{100};
+
+uint64_t RoundUpToPowerOf2(size_t value) {
+  uint64_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+}  // namespace
+
+AsyncSink::AsyncSink(std::ostream& stream, size_t capacity)
+    : stream_{&stream},
+      capacity_{RoundUpToPowerOf2(capacity)},
+      slots_{new Slot[capacity_]} {
+  for (uint64_t i = 0; i < capacity_; ++i) {
+    slots_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  writer_thread_ = std::thread(&AsyncSink::WriterLoop, this);
+}
+
+AsyncSink::AsyncSink(std::unique_ptr<std::ostream> stream, size_t capacity)
+    : AsyncSink{*stream, capacity} {
+  owned_stream_ = std::move(stream);
+}
+
+AsyncSink::~AsyncSink() {
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    stop_ = true;
+    wake_writer_.notify_one();
+  }
+
+  writer_thread_.join();
+}
+
+void AsyncSink::SendImpl(const Timestamp& timestamp, const std::string& logger_id, const Capture& message) {
+  std::string line = OStreamSink::FormatLine(timestamp, logger_id, message);
+  const bool is_fatal = message.Severity() == Severity::kFATAL;
+
+  while (!TryEnqueue(line)) {
+    if (!is_fatal) {
+      dropped_messages_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    WakeWriter();
+    std::this_thread::yield();
+  }
+
+  WakeWriter();
+
+  if (is_fatal) {
+    Flush();
+  }
+}
+
+void AsyncSink::Flush() {
+  const uint64_t target = enqueue_position_.load(std::memory_order_acquire);
+
+  std::unique_lock<OrtMutex> lock(mutex_);
+  wake_writer_.notify_one();
+  messages_written_.wait(lock, [this, target]() {
+    return written_messages_.load(std::memory_order_acquire) >= target;
+  });
+}
+
+// A bounded multi-producer single-consumer queue. The producers claim a position by incrementing
+// enqueue_position_ and then publish the message by advancing the sequence of its slot.
+bool AsyncSink::TryEnqueue(std::string& message) {
+  uint64_t position = enqueue_position_.load(std::memory_order_relaxed);
+  while (true) {
+    Slot& slot = slots_[position & (capacity_ - 1)];
+    const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence == position) {
+      if (enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        slot.message = std::move(message);
+        slot.sequence.store(position + 1);
+        return true;
+      }
+    } else if (sequence < position) {
+      // the slot still holds the message from the previous lap, so the queue is full
+      return false;
+    } else {
+      position = enqueue_position_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool AsyncSink::TryDequeue(std::string& message) {
+  Slot& slot = slots_[dequeue_position_ & (capacity_ - 1)];
+  if (slot.sequence.load(std::memory_order_acquire) != dequeue_position_ + 1) {
+    return false;
+  }
+
+  message = std::move(slot.message);
+  slot.message.clear();
+  slot.sequence.store(dequeue_position_ + capacity_, std::memory_order_release);
+  ++dequeue_position_;
+  return true;
+}
+
+bool AsyncSink::HasQueuedMessage() const {
+  const Slot& slot = slots_[dequeue_position_ & (capacity_ - 1)];
+  return slot.sequence.load() == dequeue_position_ + 1;
+}
+
+void AsyncSink::WakeWriter() {
+  // only take the lock if the writer is idle
+  if (writer_waiting_.load()) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    wake_writer_.notify_one();
+  }
+}
+
+void AsyncSink::WriterLoop() {
+  std::string message;
+  uint64_t reported_dropped_messages = 0;
+
+  while (true) {
+    uint64_t num_written = 0;
+    while (TryDequeue(message)) {
+      (*stream_) << message;
+      ++num_written;
+    }
+
+    const uint64_t dropped_messages = dropped_messages_.load(std::memory_order_relaxed);
+    if (dropped_messages != reported_dropped_messages) {
+      (*stream_) << "[AsyncSink dropped " << dropped_messages - reported_dropped_messages
+                 << " log messages because the queue was full]\n";
+      reported_dropped_messages = dropped_messages;
+      stream_->flush();
+    }
+
+    std::unique_lock<OrtMutex> lock(mutex_);
+    if (num_written > 0) {
+      stream_->flush();
+      written_messages_.fetch_add(num_written, std::memory_order_release);
+      messages_written_.notify_all();
+    }
+
+    if (HasQueuedMessage()) {
+      continue;
+    }
+    if (stop_) {
+      break;
+    }
+
+    writer_waiting_.store(true);
+    if (!HasQueuedMessage()) {
+      wake_writer_.wait_for(lock, kWriterIdleTimeout);
+    }
+    writer_waiting_.store(false);
+  }
+}
+
+}  // namespace logging
+}  // namespace onnxruntime
@@ -0,0 +1,106 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <thread>
+
+#include "core/common/logging/isink.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+namespace logging {
+/// <summary>
+/// ISink that writes to a std::ostream from a background thread.
+/// </summary>
+/// <remarks>
+/// Messages are formatted by the logging thread and passed to the writer thread through a bounded
+/// lock-free queue, so logging never waits for the stream. When the queue is full the message is
+/// dropped; the number of dropped messages is counted and reported in the output.
+/// Fatal messages are never dropped and are written before Send returns.
+/// The sink is not selected by any session or environment option; pass it to the LoggingManager to use it.
+/// </remarks>
+/// <seealso cref="ISink" />
+class AsyncSink : public ISink {
+ public:
+  static constexpr size_t kDefaultCapacity = 8192;
+
+  /// <summary>
+  /// Initializes a new instance of the <see cref="AsyncSink" /> class.
+  /// </summary>
+  /// <param name="stream">The stream to write to. Must outlive the sink.</param>
+  /// <param name="capacity">The number of messages that can be queued. Rounded up to a power of 2.</param>
+  explicit AsyncSink(std::ostream& stream, size_t capacity = kDefaultCapacity);
+
+  /// <summary>
+  /// Initializes a new instance of the <see cref="AsyncSink" /> class that owns the stream.
+  /// </summary>
+  /// <param name="stream">The stream to write to.</param>
+  /// <param name="capacity">The number of messages that can be queued. Rounded up to a power of 2.</param>
+  AsyncSink(std::unique_ptr<std::ostream> stream, size_t capacity = kDefaultCapacity);
+
+  /// <summary>
+  /// Writes the queued messages and stops the writer thread.
+  /// </summary>
+  ~AsyncSink() override;
+
+  /// <summary>
+  /// Waits until the messages sent before the call are written.
+  /// </summary>
+  void Flush();
+
+  /// <summary>
+  /// Gets the number of messages dropped because the queue was full.
+  /// </summary>
+  uint64_t DroppedMessageCount() const noexcept {
+    return dropped_messages_.load(std::memory_order_relaxed);
+  }
+
+  /// <summary>
+  /// Gets the number of messages written to the stream.
+  /// </summary>
+  uint64_t WrittenMessageCount() const noexcept {
+    return written_messages_.load(std::memory_order_acquire);
+  }
+
+ private:
+  struct Slot {
+    // equals the queue position the slot can be written at, or that position + 1 once it holds a message
+    std::atomic<uint64_t> sequence;
+    std::string message;
+  };
+
+  void SendImpl(const Timestamp& timestamp, const std::string& logger_id, const Capture& message) override;
+
+  bool TryEnqueue(std::string& message);
+  bool TryDequeue(std::string& message);
+  bool HasQueuedMessage() const;
+  void WakeWriter();
+  void WriterLoop();
+
+  std::unique_ptr<std::ostream> owned_stream_;
+  std::ostream* stream_;
+
+  const uint64_t capacity_;
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<uint64_t> enqueue_position_{0};
+  // only accessed by the writer thread
+  uint64_t dequeue_position_{0};
+
+  std::atomic<uint64_t> dropped_messages_{0};
+  std::atomic<uint64_t> written_messages_{0};
+
+  OrtMutex mutex_;
+  OrtCondVar wake_writer_;
+  OrtCondVar messages_written_;
+  std::atomic<bool> writer_waiting_{false};
+  bool stop_{false};
+  std::thread writer_thread_;
+};
+}  // namespace logging
+}  // namespace onnxruntime
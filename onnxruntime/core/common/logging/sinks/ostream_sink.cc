@@ -7,10 +7,20 @@
 namespace onnxruntime {
 namespace logging {
 
-void OStreamSink::SendImpl(const Timestamp& timestamp, const std::string& logger_id, const Capture& message) {
+std::string OStreamSink::FormatLine(const Timestamp& timestamp, const std::string& logger_id,
+                                    const Capture& message) {
   // operator for formatting of timestamp in ISO8601 format including microseconds
   using date::operator<<;
 
+  std::ostringstream msg;
+
+  msg << timestamp << " [" << message.SeverityPrefix() << ":" << message.Category() << ":" << logger_id << ", "
+      << message.Location().ToString() << "] " << message.Message() << "\n";
+
+  return msg.str();
+}
+
+void OStreamSink::SendImpl(const Timestamp& timestamp, const std::string& logger_id, const Capture& message) {
   // Two options as there may be multiple calls attempting to write to the same sink at once:
   // 1) Use mutex to synchronize access to the stream.
   // 2) Create the message in an ostringstream and output in one call.
@@ -18,12 +28,7 @@ void OStreamSink::SendImpl(const Timestamp& timestamp, const std::string& logger
   // Going with #2 as it should scale better at the cost of creating the message in memory first
   // before sending to the stream.
 
-  std::ostringstream msg;
-
-  msg << timestamp << " [" << message.SeverityPrefix() << ":" << message.Category() << ":" << logger_id << ", "
-      << message.Location().ToString() << "] " << message.Message() << "\n";
-
-  (*stream_) << msg.str();
+  (*stream_) << FormatLine(timestamp, logger_id, message);
 
   if (flush_) {
     stream_->flush();
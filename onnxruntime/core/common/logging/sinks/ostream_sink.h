@@ -25,6 +25,11 @@ class OStreamSink : public ISink {
  public:
   void SendImpl(const Timestamp& timestamp, const std::string& logger_id, const Capture& message) override;
 
+  /// <summary>
+  /// Formats a message as a single line of output.
+  /// </summary>
+  static std::string FormatLine(const Timestamp& timestamp, const std::string& logger_id, const Capture& message);
+
  private:
   std::ostream* stream_;
   const bool flush_;
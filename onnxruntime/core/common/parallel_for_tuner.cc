@@ -0,0 +1,167 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/parallel_for_tuner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <sstream>
+
+namespace onnxruntime {
+namespace concurrency {
+
+namespace {
+
+// Candidate block sizes, as a power-of-two scaling of the cost-model block size.  The final
+// candidate runs the whole loop as a single block in the calling thread.
+constexpr int kCandidateLog2Scales[] = {-2, -1, 0, 1, 2};
+constexpr int kSingleBlockCandidate = 5;
+constexpr const char* kCandidateNames[] = {"x0.25", "x0.5", "x1", "x2", "x4", "single_block"};
+
+constexpr const char* kFileHeader = "# onnxruntime parallel-for tuning v2";
+
+// The key is written to the tuning file, so it must not contain whitespace. The ONNX domain is empty,
+// and is written as its alias.
+std::string MakeLoopKey(const std::string& domain, const std::string& op_type, unsigned loop_idx,
+                        int degree_of_parallelism, std::ptrdiff_t total) {
+  int bucket = 0;
+  for (std::ptrdiff_t n = total; n > 1; n >>= 1) {
+    ++bucket;
+  }
+  std::ostringstream ss;
+  ss << (domain.empty() ? "ai.onnx" : domain) << '.' << op_type << ':' << degree_of_parallelism << ':'
+     << loop_idx << ':' << bucket;
+  return ss.str();
+}
+
+std::ptrdiff_t GetCandidateBlockSize(int candidate, std::ptrdiff_t total, std::ptrdiff_t default_block_size) {
+  if (candidate == kSingleBlockCandidate) {
+    return total;
+  }
+  const int log2_scale = kCandidateLog2Scales[candidate];
+  if (log2_scale < 0) {
+    return std::max<std::ptrdiff_t>(1, default_block_size >> -log2_scale);
+  }
+  return std::min<std::ptrdiff_t>(total, default_block_size << log2_scale);
+}
+
+}  // namespace
+
+ParallelForTuner::LoopEntry::LoopEntry() {
+  std::fill(std::begin(best_ns_per_iteration), std::end(best_ns_per_iteration),
+            std::numeric_limits<double>::infinity());
+}
+
+void ParallelForTuner::Run(const std::string& domain, const std::string& op_type, unsigned loop_idx,
+                           int degree_of_parallelism, std::ptrdiff_t total, std::ptrdiff_t default_block_size,
+                           const std::function<void(std::ptrdiff_t block_size)>& run_loop) {
+  const std::string key = MakeLoopKey(domain, op_type, loop_idx, degree_of_parallelism, total);
+  int candidate = -1;
+  bool measure = false;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end() && it->second.choice >= 0) {
+      candidate = it->second.choice;
+    } else if (enable_tuning_) {
+      if (it == entries_.end()) {
+        it = entries_.emplace(key, LoopEntry{}).first;
+      }
+      candidate = it->second.trials % kNumCandidates;
+      measure = true;
+    }
+  }
+
+  if (candidate < 0) {
+    run_loop(default_block_size);
+    return;
+  }
+
+  const std::ptrdiff_t block_size = GetCandidateBlockSize(candidate, total, default_block_size);
+  if (!measure) {
+    run_loop(block_size);
+    return;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  run_loop(block_size);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  const double ns_per_iteration =
+      static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+      static_cast<double>(total);
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  LoopEntry& entry = entries_[key];
+  if (entry.choice >= 0) {
+    // another thread completed tuning concurrently
+    return;
+  }
+  entry.best_ns_per_iteration[candidate] = std::min(entry.best_ns_per_iteration[candidate], ns_per_iteration);
+  if (++entry.trials >= kNumCandidates * kTrialsPerCandidate) {
+    entry.choice = static_cast<int>(std::min_element(std::begin(entry.best_ns_per_iteration),
+                                                     std::end(entry.best_ns_per_iteration)) -
+                                    std::begin(entry.best_ns_per_iteration));
+    has_new_results_ = true;
+  }
+}
+
+bool ParallelForTuner::HasNewResults() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return has_new_results_;
+}
+
+Status ParallelForTuner::Load(const PathString& path) {
+  std::ifstream in(path);
+  ORT_RETURN_IF_NOT(in.good(), "Failed to open parallel-for tuning file.");
+
+  std::unordered_map<std::string, int> loaded;
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    std::istringstream ss(line);
+    std::string key, choice_name;
+    ORT_RETURN_IF_NOT(ss >> key >> choice_name, "Invalid entry in parallel-for tuning file: ", line);
+    auto name_it = std::find_if(std::begin(kCandidateNames), std::end(kCandidateNames),
+                                [&choice_name](const char* name) { return choice_name == name; });
+    ORT_RETURN_IF_NOT(name_it != std::end(kCandidateNames),
+                      "Invalid choice in parallel-for tuning file: ", choice_name);
+    loaded[key] = static_cast<int>(name_it - std::begin(kCandidateNames));
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  for (const auto& kv : loaded) {
+    entries_[kv.first].choice = kv.second;
+  }
+  return Status::OK();
+}
+
+Status ParallelForTuner::Save(const PathString& path) const {
+  // sort the entries so that the file contents are stable across runs
+  std::map<std::string, int> choices;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    for (const auto& kv : entries_) {
+      if (kv.second.choice >= 0) {
+        choices.emplace(kv.first, kv.second.choice);
+      }
+    }
+  }
+
+  std::ofstream out(path);
+  ORT_RETURN_IF_NOT(out.good(), "Failed to open parallel-for tuning file for writing.");
+  out << kFileHeader << "\n";
+  for (const auto& kv : choices) {
+    out << kv.first << ' ' << kCandidateNames[kv.second] << "\n";
+  }
+  out.flush();
+  ORT_RETURN_IF_NOT(out.good(), "Failed to write parallel-for tuning file.");
+  return Status::OK();
+}
+
+}  // namespace concurrency
+}  // namespace onnxruntime
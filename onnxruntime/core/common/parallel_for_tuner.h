@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/common/path_string.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+namespace concurrency {
+
+/**
+ * Learns the block size to use for ThreadPool::TryParallelFor loops, per kernel type and shape bucket.
+ *
+ * The block size derived from a kernel's TensorOpCost estimate is used as a starting point, and a
+ * small set of candidates around it (scaled by 1/4 .. 4, or running the loop as a single block) is
+ * measured over the first invocations of each loop ("warm-up").  The fastest candidate per
+ * iteration is then used for all subsequent invocations.
+ *
+ * Loops are identified by the domain and op type of the kernel, the degree of parallelism of the
+ * thread pool, the index of the loop within the kernel's Compute() call, and
+ * floor(log2(number of iterations)).
+ *
+ * Learned choices can be saved to, and loaded from, a text file with one "<loop key> <choice>" entry
+ * per line, so that later sessions can apply them without re-tuning.
+ *
+ * ParallelForTuner is thread-safe.
+ */
+class ParallelForTuner {
+ public:
+  /**
+   * @param enable_tuning If false, only choices loaded via Load() are applied, and loops without a
+   *                      choice use the cost-model block size.
+   */
+  explicit ParallelForTuner(bool enable_tuning) : enable_tuning_(enable_tuning) {}
+
+  /** Loads learned choices from `path`, replacing any existing choices for the same loops. */
+  Status Load(const PathString& path);
+
+  /** Saves the learned choices to `path`. */
+  Status Save(const PathString& path) const;
+
+  /** Whether choices were learned since construction (i.e., whether there is anything new to Save()). */
+  bool HasNewResults() const;
+
+  /**
+   * Runs a loop of `total` iterations.
+   * @param domain Domain of the kernel issuing the loop.
+   * @param op_type Op type of the kernel issuing the loop.
+   * @param loop_idx Index of the loop within the kernel's Compute() call.
+   * @param degree_of_parallelism Degree of parallelism of the thread pool running the loop.
+   * @param default_block_size Block size chosen by the cost model.
+   * @param run_loop Runs the loop with the given block size.
+   */
+  void Run(const std::string& domain, const std::string& op_type, unsigned loop_idx, int degree_of_parallelism,
+           std::ptrdiff_t total, std::ptrdiff_t default_block_size,
+           const std::function<void(std::ptrdiff_t block_size)>& run_loop);
+
+  // Number of times each candidate is measured during warm-up.
+  static constexpr int kTrialsPerCandidate = 3;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ParallelForTuner);
+
+  static constexpr int kNumCandidates = 6;
+
+  struct LoopEntry {
+    // Index of the chosen candidate, or -1 while tuning.
+    int choice = -1;
+    int trials = 0;
+    double best_ns_per_iteration[kNumCandidates];
+
+    LoopEntry();
+  };
+
+  const bool enable_tuning_;
+  mutable OrtMutex mutex_;
+  std::unordered_map<std::string, LoopEntry> entries_;
+  bool has_new_results_ = false;
+};
+
+}  // namespace concurrency
+}  // namespace onnxruntime
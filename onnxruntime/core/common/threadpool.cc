@@ -19,6 +19,8 @@ limitations under the License.
 #include "core/common/common.h"
 #include "core/common/cpuid_info.h"
 #include "core/common/eigen_common_wrapper.h"
+#include "core/common/parallel_for_tuner.h"
+#include "core/common/trace_recorder.h"
 #include "core/platform/EigenNonBlockingThreadPool.h"
 #include "core/platform/ort_mutex.h"
 #if !defined(ORT_MINIMAL_BUILD)
@@ -224,11 +226,39 @@ void ThreadPoolProfiler::LogRun(int thread_idx) {
   }
 }
 
+void ThreadPoolProfiler::LogSpin(int thread_idx) {
+  if (enabled_) {
+    child_thread_stats_[thread_idx].num_spin_++;
+  }
+}
+
+void ThreadPoolProfiler::LogPark(int thread_idx) {
+  if (enabled_) {
+    child_thread_stats_[thread_idx].num_park_++;
+  }
+}
+
+void ThreadPoolProfiler::LogWakeup(int thread_idx) {
+  if (enabled_) {
+    child_thread_stats_[thread_idx].num_wakeup_++;
+  }
+}
+
+void ThreadPoolProfiler::LogSteal(int thread_idx) {
+  if (enabled_) {
+    child_thread_stats_[thread_idx].num_steal_++;
+  }
+}
+
 std::string ThreadPoolProfiler::DumpChildThreadStat() {
   std::stringstream ss;
   for (int i = 0; i < num_threads_; ++i) {
     ss << "\"" << child_thread_stats_[i].thread_id_ << "\": {"
        << "\"num_run\": " << child_thread_stats_[i].num_run_ << ", "
+       << "\"num_spin\": " << child_thread_stats_[i].num_spin_ << ", "
+       << "\"num_park\": " << child_thread_stats_[i].num_park_ << ", "
+       << "\"num_wakeup\": " << child_thread_stats_[i].num_wakeup_ << ", "
+       << "\"num_steal\": " << child_thread_stats_[i].num_steal_ << ", "
        << "\"core\": " << child_thread_stats_[i].core_ << "}"
        << (i == num_threads_ - 1 ? "" : ",");
   }
@@ -411,8 +441,13 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
   int num_work_items = static_cast<int>(std::min(static_cast<std::ptrdiff_t>(d_of_p), num_blocks));
   assert(num_work_items > 0);
 
+  // the threads helping with the loop record events if the thread starting it does
+  const bool is_trace_recorded = profiling::TraceRecorder::IsThreadTraced();
+  static const uint32_t trace_name_id = profiling::TraceRecorder::InternName("ParallelFor");
+
   LoopCounter lc(total, d_of_p, block_size);
   std::function<void(unsigned)> run_work = [&](unsigned idx) {
+    const uint64_t trace_start_ns = is_trace_recorded ? profiling::TraceRecorder::NowNs() : 0;
     unsigned my_home_shard = lc.GetHomeShard(idx);
     unsigned my_shard = my_home_shard;
     uint64_t my_iter_start, my_iter_end;
@@ -420,6 +455,11 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
       fn(static_cast<std::ptrdiff_t>(my_iter_start),
          static_cast<std::ptrdiff_t>(my_iter_end));
     }
+    if (is_trace_recorded) {
+      profiling::TraceRecorder::RecordEvent(profiling::TraceRecorder::EventKind::kThreadPoolWork,
+                                            trace_name_id, trace_name_id,
+                                            trace_start_ns, profiling::TraceRecorder::NowNs());
+    }
   };
 
   // Run the work in the thread pool (and in the current thread).  Synchronization with helping
@@ -488,6 +528,74 @@ ThreadPool::ParallelSection::~ParallelSection() {
 #endif
 }
 
+thread_local ThreadPool::RunScope* ThreadPool::RunScope::current_run_scope{nullptr};
+
+ThreadPool::RunScope::RunScope(ThreadPool* tp, int max_degree_of_parallelism, RunPriority priority)
+    : tp_(tp),
+      max_degree_of_parallelism_(max_degree_of_parallelism),
+      priority_(priority),
+      prev_run_scope_(nullptr) {
+#ifdef _OPENMP
+  // Nothing
+#else
+  if (tp_) {
+    tp_->active_runs_[static_cast<int>(priority_)]++;
+    prev_run_scope_ = current_run_scope;
+    current_run_scope = this;
+  }
+#endif
+}
+
+ThreadPool::RunScope::~RunScope() {
+#ifdef _OPENMP
+  // Nothing
+#else
+  if (tp_) {
+    current_run_scope = prev_run_scope_;
+    tp_->active_runs_[static_cast<int>(priority_)]--;
+  }
+#endif
+}
+
+int ThreadPool::RunScope::LimitDegreeOfParallelism(int d_of_p) const {
+  // Count the in-flight runs that this run shares the pool with,
+  // including itself.
+  int contending_runs = 0;
+  for (int p = static_cast<int>(priority_); p <= static_cast<int>(RunPriority::kHigh); p++) {
+    contending_runs += tp_->active_runs_[p].load(std::memory_order_relaxed);
+  }
+  int limit = d_of_p / std::max(contending_runs, 1);
+  if (max_degree_of_parallelism_ > 0) {
+    limit = std::min(limit, max_degree_of_parallelism_);
+  }
+  return std::max(limit, 1);
+}
+
+thread_local ThreadPool::TuningScope* ThreadPool::TuningScope::current_tuning_scope{nullptr};
+
+ThreadPool::TuningScope::TuningScope(ParallelForTuner* tuner, const std::string& domain,
+                                     const std::string& op_type)
+    : tuner_(tuner),
+      domain_(domain),
+      op_type_(op_type),
+      next_loop_idx_(0),
+      prev_tuning_scope_(nullptr) {
+#ifndef _OPENMP
+  if (tuner_) {
+    prev_tuning_scope_ = current_tuning_scope;
+    current_tuning_scope = this;
+  }
+#endif
+}
+
+ThreadPool::TuningScope::~TuningScope() {
+#ifndef _OPENMP
+  if (tuner_) {
+    current_tuning_scope = prev_tuning_scope_;
+  }
+#endif
+}
+
 void ThreadPool::RunInParallel(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t block_size) {
   if (underlying_threadpool_) {
     if (ThreadPool::ParallelSection::current_parallel_section) {
@@ -596,6 +704,12 @@ void ThreadPool::ParallelFor(std::ptrdiff_t n, const TensorOpCost& c,
   }
 
   ptrdiff_t block = CalculateParallelForBlock(n, cost, nullptr, d_of_p);
+  TuningScope* ts = TuningScope::current_tuning_scope;
+  if (ts) {
+    ts->tuner_->Run(ts->domain_, ts->op_type_, ts->next_loop_idx_++, d_of_p, n, block,
+                    [&](std::ptrdiff_t tuned_block) { ParallelForFixedBlockSizeScheduling(n, tuned_block, f); });
+    return;
+  }
   ParallelForFixedBlockSizeScheduling(n, block, f);
 }
 
@@ -620,6 +734,12 @@ int ThreadPool::DegreeOfParallelism(const concurrency::ThreadPool* tp) {
   // When not using OpenMP, we parallelise over the N threads created by the pool
   // tp, plus 1 for the thread entering a loop.
   if (tp) {
+    const RunScope* rs = RunScope::current_run_scope;
+    if (rs && rs->tp_ == tp) {
+      // Budgeted run: the result bounds the number of threads used, and
+      // so we do not over-decompose work for hybrid cores.
+      return rs->LimitDegreeOfParallelism(tp->NumThreads() + 1);
+    }
     if (CPUIDInfo::GetCPUIDInfo().IsHybrid()) {
       return ((tp->NumThreads() + 1)) * TaskGranularityFactor;
     } else {
@@ -0,0 +1,393 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/trace_recorder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <signal.h>
+#include <thread>
+#include <unistd.h>
+#endif
+
+#include "core/common/logging/logging.h"
+#include "core/platform/env.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+namespace profiling {
+
+std::atomic<bool> TraceRecorder::enabled_{false};
+
+namespace {
+
+// An event is written field by field with relaxed stores, so that the buffer can be read while its
+// thread keeps recording. Torn events are detected and skipped by the reader.
+struct EventSlot {
+  std::atomic<uint64_t> start_ns;
+  std::atomic<uint64_t> duration_ns;
+  // name id in the low 32 bits, detail name id in the high 32 bits
+  std::atomic<uint64_t> name_ids;
+  // event kind in the low 32 bits, id of the recording thread in the high 32 bits
+  std::atomic<uint64_t> kind_and_thread_id;
+};
+
+// A buffer is used by one thread at a time. When its thread exits it is kept, with the events
+// already recorded, and given to the next thread that records events.
+struct ThreadBuffer {
+  explicit ThreadBuffer(uint64_t capacity) : capacity{capacity}, slots{new EventSlot[capacity]} {
+  }
+
+  const uint64_t capacity;
+  std::unique_ptr<EventSlot[]> slots;
+  std::atomic<uint64_t> num_recorded{0};
+};
+
+struct RecordedEvent {
+  uint64_t start_ns;
+  uint64_t duration_ns;
+  uint64_t name_ids;
+  uint64_t kind_and_thread_id;
+};
+
+struct RecorderState {
+  OrtMutex mutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+  // buffers of the threads that exited
+  std::vector<ThreadBuffer*> free_buffers;
+  std::vector<std::string> names;
+  std::unordered_map<std::string, uint32_t> name_ids;
+
+  std::atomic<uint64_t> events_per_thread{1 << 16};
+  std::atomic<uint32_t> sampling_interval{1};
+  std::atomic<uint64_t> num_runs{0};
+  const std::chrono::steady_clock::time_point start_time{std::chrono::steady_clock::now()};
+};
+
+// Never destroyed, as threads may record events while the process exits.
+RecorderState& GetState() {
+  static RecorderState* state = new RecorderState();
+  return *state;
+}
+
+// Returns the buffer of the thread to the free list when the thread exits.
+struct ThreadBufferOwner {
+  ~ThreadBufferOwner() {
+    if (buffer != nullptr) {
+      auto& state = GetState();
+      std::lock_guard<OrtMutex> lock(state.mutex);
+      state.free_buffers.push_back(buffer);
+    }
+  }
+
+  ThreadBuffer* buffer = nullptr;
+  uint64_t thread_id = 0;
+};
+
+thread_local ThreadBufferOwner t_buffer_owner;
+thread_local bool t_thread_traced = false;
+thread_local std::unordered_map<std::string, uint32_t> t_name_ids;
+
+uint64_t RoundUpToPowerOf2(uint64_t value) {
+  uint64_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+ThreadBufferOwner& GetThreadBufferOwner() {
+  if (t_buffer_owner.buffer == nullptr) {
+    auto& state = GetState();
+    const uint64_t capacity = state.events_per_thread.load();
+    {
+      std::lock_guard<OrtMutex> lock(state.mutex);
+      // buffers of another size were allocated before the size was changed and stay unused
+      auto free_buffer = std::find_if(state.free_buffers.begin(), state.free_buffers.end(),
+                                      [capacity](const ThreadBuffer* buffer) { return buffer->capacity == capacity; });
+      if (free_buffer != state.free_buffers.end()) {
+        t_buffer_owner.buffer = *free_buffer;
+        state.free_buffers.erase(free_buffer);
+      } else {
+        state.buffers.push_back(std::make_unique<ThreadBuffer>(capacity));
+        t_buffer_owner.buffer = state.buffers.back().get();
+      }
+    }
+    t_buffer_owner.thread_id = static_cast<uint64_t>(logging::GetThreadId());
+  }
+  return t_buffer_owner;
+}
+
+const char* GetEventCategory(uint64_t kind) {
+  switch (static_cast<TraceRecorder::EventKind>(kind)) {
+    case TraceRecorder::EventKind::kRun:
+      return "Session";
+    case TraceRecorder::EventKind::kNode:
+      return "Node";
+    case TraceRecorder::EventKind::kThreadPoolWork:
+      return "ThreadPool";
+  }
+  return "Unknown";
+}
+
+void WriteJsonString(std::ostream& out, const std::string& s) {
+  out << '"';
+  for (const char c : s) {
+    if (c == '"' || c == '\\') {
+      out << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      out << ' ';
+    } else {
+      out << c;
+    }
+  }
+  out << '"';
+}
+
+const std::string& GetName(const std::vector<std::string>& names, uint32_t name_id) {
+  static const std::string unknown_name{"unknown"};
+  return name_id < names.size() ? names[name_id] : unknown_name;
+}
+
+}  // namespace
+
+void TraceRecorder::Enable(const Options& options) {
+  auto& state = GetState();
+  state.events_per_thread.store(RoundUpToPowerOf2(std::max<size_t>(options.events_per_thread, 1)));
+  state.sampling_interval.store(std::max<uint32_t>(options.sampling_interval, 1));
+  enabled_.store(true);
+}
+
+void TraceRecorder::Disable() {
+  enabled_.store(false);
+}
+
+bool TraceRecorder::IsThreadTraced() noexcept {
+  return t_thread_traced;
+}
+
+uint32_t TraceRecorder::InternName(const std::string& name) {
+  auto cached = t_name_ids.find(name);
+  if (cached != t_name_ids.end()) {
+    return cached->second;
+  }
+
+  auto& state = GetState();
+  uint32_t name_id;
+  {
+    std::lock_guard<OrtMutex> lock(state.mutex);
+    auto inserted = state.name_ids.emplace(name, static_cast<uint32_t>(state.names.size()));
+    if (inserted.second) {
+      state.names.push_back(name);
+    }
+    name_id = inserted.first->second;
+  }
+
+  t_name_ids.emplace(name, name_id);
+  return name_id;
+}
+
+size_t TraceRecorder::GetNumThreadBuffers() {
+  auto& state = GetState();
+  std::lock_guard<OrtMutex> lock(state.mutex);
+  return state.buffers.size();
+}
+
+uint64_t TraceRecorder::NowNs() noexcept {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now() - GetState().start_time)
+                                   .count());
+}
+
+void TraceRecorder::RecordEvent(EventKind kind, uint32_t name_id, uint32_t detail_name_id,
+                                uint64_t start_ns, uint64_t end_ns) noexcept {
+  ThreadBufferOwner* owner = nullptr;
+  ORT_TRY {
+    owner = &GetThreadBufferOwner();
+  }
+  ORT_CATCH(const std::exception&) {
+    return;
+  }
+  ThreadBuffer* buffer = owner->buffer;
+
+  const uint64_t index = buffer->num_recorded.load(std::memory_order_relaxed);
+  // a reader that sees any of the stores below also sees that the slot is being overwritten
+  std::atomic_thread_fence(std::memory_order_release);
+
+  EventSlot& slot = buffer->slots[index & (buffer->capacity - 1)];
+  slot.start_ns.store(start_ns, std::memory_order_relaxed);
+  slot.duration_ns.store(end_ns - start_ns, std::memory_order_relaxed);
+  slot.name_ids.store(static_cast<uint64_t>(name_id) | (static_cast<uint64_t>(detail_name_id) << 32),
+                      std::memory_order_relaxed);
+  slot.kind_and_thread_id.store(static_cast<uint64_t>(kind) | (owner->thread_id << 32), std::memory_order_relaxed);
+
+  buffer->num_recorded.store(index + 1, std::memory_order_release);
+}
+
+std::string TraceRecorder::ExportChromeTrace() {
+  auto& state = GetState();
+
+  std::vector<ThreadBuffer*> buffers;
+  {
+    std::lock_guard<OrtMutex> lock(state.mutex);
+    for (const auto& buffer : state.buffers) {
+      buffers.push_back(buffer.get());
+    }
+  }
+
+  std::vector<std::vector<RecordedEvent>> buffer_events;
+  for (ThreadBuffer* buffer : buffers) {
+    const uint64_t end = buffer->num_recorded.load(std::memory_order_acquire);
+    const uint64_t begin = end > buffer->capacity ? end - buffer->capacity : 0;
+
+    std::vector<RecordedEvent> events;
+    events.reserve(static_cast<size_t>(end - begin));
+    for (uint64_t i = begin; i < end; ++i) {
+      const EventSlot& slot = buffer->slots[i & (buffer->capacity - 1)];
+      events.push_back({slot.start_ns.load(std::memory_order_relaxed),
+                        slot.duration_ns.load(std::memory_order_relaxed),
+                        slot.name_ids.load(std::memory_order_relaxed),
+                        slot.kind_and_thread_id.load(std::memory_order_relaxed)});
+    }
+
+    // drop the events that were overwritten while they were read
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t num_recorded = buffer->num_recorded.load(std::memory_order_relaxed);
+    const uint64_t valid_begin = num_recorded >= buffer->capacity ? num_recorded - buffer->capacity + 1 : 0;
+    if (valid_begin > begin) {
+      events.erase(events.begin(), events.begin() + static_cast<ptrdiff_t>(std::min(valid_begin, end) - begin));
+    }
+
+    buffer_events.push_back(std::move(events));
+  }
+
+  // copied after the events, so all the names they refer to are present
+  std::vector<std::string> names;
+  {
+    std::lock_guard<OrtMutex> lock(state.mutex);
+    names = state.names;
+  }
+
+  const auto pid = Env::Default().GetSelfPid();
+  std::ostringstream trace;
+  trace << std::fixed << std::setprecision(3) << "[\n";
+  bool is_first_event = true;
+  for (const auto& events : buffer_events) {
+    for (const auto& event : events) {
+      if (!is_first_event) {
+        trace << ",\n";
+      }
+      is_first_event = false;
+
+      const uint32_t name_id = static_cast<uint32_t>(event.name_ids);
+      const uint32_t detail_name_id = static_cast<uint32_t>(event.name_ids >> 32);
+      const uint64_t kind = event.kind_and_thread_id & 0xFFFFFFFF;
+      trace << R"({"cat" : ")" << GetEventCategory(kind) << "\",";
+      trace << "\"pid\" :" << pid << ",";
+      trace << "\"tid\" :" << (event.kind_and_thread_id >> 32) << ",";
+      trace << "\"dur\" :" << static_cast<double>(event.duration_ns) / 1000 << ",";
+      trace << "\"ts\" :" << static_cast<double>(event.start_ns) / 1000 << ",";
+      trace << R"("ph" : "X",)";
+      trace << "\"name\" :";
+      WriteJsonString(trace, GetName(names, name_id));
+      trace << ",\"args\" : {";
+      if (static_cast<EventKind>(kind) == EventKind::kNode) {
+        trace << "\"op_name\" : ";
+        WriteJsonString(trace, GetName(names, detail_name_id));
+      }
+      trace << "}}";
+    }
+  }
+  trace << "\n]\n";
+
+  return trace.str();
+}
+
+common::Status TraceRecorder::WriteChromeTrace(const std::string& file_path) {
+  std::ofstream file{file_path};
+  ORT_RETURN_IF_NOT(file, "Failed to open trace file: ", file_path);
+  file << ExportChromeTrace();
+  file.close();
+  ORT_RETURN_IF_NOT(file, "Failed to write trace file: ", file_path);
+  return common::Status::OK();
+}
+
+#ifndef _WIN32
+namespace {
+int g_signal_pipe[2] = {-1, -1};
+
+// only does what is async-signal-safe, the trace is written by the thread reading the pipe
+void HandleTraceSignal(int) {
+  const int saved_errno = errno;
+  const char c = 0;
+  ssize_t result = write(g_signal_pipe[1], &c, 1);
+  (void)result;
+  errno = saved_errno;
+}
+}  // namespace
+
+common::Status TraceRecorder::WriteChromeTraceOnSignal(int signal_number, const std::string& file_path) {
+  static OrtMutex mutex;
+  std::lock_guard<OrtMutex> lock(mutex);
+  ORT_RETURN_IF(g_signal_pipe[0] != -1, "A signal to write the trace on was already set.");
+  ORT_RETURN_IF(pipe(g_signal_pipe) != 0, "Failed to create the trace signal pipe, errno: ", errno);
+
+  std::thread([file_path]() {
+    while (true) {
+      char c;
+      const ssize_t result = read(g_signal_pipe[0], &c, 1);
+      if (result < 0 && errno == EINTR) {
+        continue;
+      }
+      if (result != 1) {
+        break;
+      }
+
+      const auto status = WriteChromeTrace(file_path);
+      LOGS_DEFAULT_IF(!status.IsOK(), WARNING) << "Failed to write trace: " << status.ErrorMessage();
+    }
+  }).detach();
+
+  struct sigaction action {};
+  action.sa_handler = HandleTraceSignal;
+  sigemptyset(&action.sa_mask);
+  action.sa_flags = SA_RESTART;
+  ORT_RETURN_IF(sigaction(signal_number, &action, nullptr) != 0,
+                "Failed to set the trace signal handler, errno: ", errno);
+
+  return common::Status::OK();
+}
+#endif
+
+TraceRecorder::RunScope::RunScope(uint32_t name_id) noexcept
+    : name_id_{name_id}, previous_thread_traced_{t_thread_traced} {
+  traced_ = previous_thread_traced_;
+  if (!traced_ && IsEnabled()) {
+    auto& state = GetState();
+    traced_ = state.num_runs.fetch_add(1, std::memory_order_relaxed) % state.sampling_interval.load() == 0;
+  }
+
+  if (traced_) {
+    t_thread_traced = true;
+    start_ns_ = NowNs();
+  }
+}
+
+TraceRecorder::RunScope::~RunScope() {
+  if (traced_) {
+    RecordEvent(EventKind::kRun, name_id_, name_id_, start_ns_, NowNs());
+  }
+  t_thread_traced = previous_thread_traced_;
+}
+
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -0,0 +1,135 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+namespace trace_recorder_env_vars {
+// enables the trace recorder, recording one run in every given number of runs
+static const std::string kSamplingInterval = "ORT_TRACE_RECORDER_SAMPLING_INTERVAL";
+static const std::string kEventsPerThread = "ORT_TRACE_RECORDER_EVENTS_PER_THREAD";
+// file the trace is written to when the process receives SIGUSR2
+static const std::string kSignalOutputPath = "ORT_TRACE_RECORDER_SIGNAL_OUTPUT_PATH";
+}  // namespace trace_recorder_env_vars
+
+namespace profiling {
+
+/**
+ * Low overhead recorder of execution events that can be left enabled in production.
+ *
+ * Unlike the Profiler, which keeps every event of a session until profiling ends, the events are
+ * written in a compact binary form to a fixed size ring buffer of the thread that records them,
+ * so only the latest events of each thread are kept. The buffer of a thread that exits is reused by the
+ * next thread that records events, so the memory used is bounded by the number of threads recording at
+ * the same time. The buffers can be exported in "chrome tracing" format, which Perfetto also reads, at
+ * any time, e.g. after a slow request was observed. Events are exported with the OS id of the thread
+ * that recorded them.
+ *
+ * Events are recorded for the runs selected by the sampling interval. Node events are recorded by the
+ * thread that executes the run, and thread pool events by the threads that work on the parallel loops
+ * started by it.
+ */
+class TraceRecorder {
+ public:
+  enum class EventKind : uint8_t {
+    kRun,
+    kNode,
+    kThreadPoolWork,
+  };
+
+  struct Options {
+    // number of events kept per thread, rounded up to a power of 2
+    size_t events_per_thread = 1 << 16;
+    // record the events of one run in every sampling_interval runs
+    uint32_t sampling_interval = 1;
+  };
+
+  /*
+  Enables recording. The buffer size applies to the threads that did not record events yet.
+  */
+  static void Enable(const Options& options);
+
+  /*
+  Disables recording. The recorded events are kept and can still be exported.
+  */
+  static void Disable();
+
+  static bool IsEnabled() noexcept {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  /*
+  Whether the current thread records events, i.e. whether it works on a sampled run.
+  */
+  static bool IsThreadTraced() noexcept;
+
+  /*
+  Returns the id of a name used by RecordEvent. The ids are valid for the lifetime of the process.
+  */
+  static uint32_t InternName(const std::string& name);
+
+  /*
+  Current time in nanoseconds, as used for the event times.
+  */
+  static uint64_t NowNs() noexcept;
+
+  /*
+  Records an event in the buffer of the current thread.
+  */
+  static void RecordEvent(EventKind kind, uint32_t name_id, uint32_t detail_name_id,
+                          uint64_t start_ns, uint64_t end_ns) noexcept;
+
+  /*
+  Number of event buffers allocated, including the ones kept for reuse after their thread exited.
+  */
+  static size_t GetNumThreadBuffers();
+
+  /*
+  Returns the recorded events in chrome tracing format.
+  */
+  static std::string ExportChromeTrace();
+
+  /*
+  Writes the recorded events in chrome tracing format to a file.
+  */
+  static common::Status WriteChromeTrace(const std::string& file_path);
+
+#ifndef _WIN32
+  /*
+  Writes the recorded events to file_path whenever the process receives signal_number.
+  Can only be called once.
+  */
+  static common::Status WriteChromeTraceOnSignal(int signal_number, const std::string& file_path);
+#endif
+
+  /*
+  Decides whether a run is sampled and records it. The events recorded by the current thread while
+  the scope is alive belong to the run.
+  */
+  class RunScope {
+   public:
+    explicit RunScope(uint32_t name_id) noexcept;
+    ~RunScope();
+
+   private:
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RunScope);
+
+    const uint32_t name_id_;
+    const bool previous_thread_traced_;
+    bool traced_ = false;
+    uint64_t start_ns_ = 0;
+  };
+
+ private:
+  static std::atomic<bool> enabled_;
+};
+
+}  // namespace profiling
+}  // namespace onnxruntime
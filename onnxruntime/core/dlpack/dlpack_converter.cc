@@ -75,7 +75,7 @@ DLDataType GetDlpackDataType(const OrtValue& ort_value) {
   return dtype;
 }
 
-DLContext GetDlpackContext(const OrtValue& ort_value, const int64_t& device_id) {
+DLContext GetDlpackContextImpl(const OrtValue& ort_value, const int64_t& device_id) {
   ORT_ENFORCE(ort_value.IsTensor(), "Only OrtValues that are Tensors are currently supported");
   DLContext ctx;
   ctx.device_id = static_cast<int>(device_id);
@@ -197,25 +197,31 @@ bool IsContiguousTensor(const DLTensor& tensor) {
 
 }  // namespace
 
+DLContext GetDlpackContext(const OrtValue& ort_value) {
+  ORT_ENFORCE(ort_value.IsTensor(), "Only tensor type OrtValues are supported");
+  return GetDlpackContextImpl(ort_value, ort_value.Get<Tensor>().Location().device.Id());
+}
+
 // This function returns a pointer to DLManagedTensor constructed from an OrtValue
 // The OrtValue inside OrtDLManagedTensor will increase its own buffer's ref count by one
 // When the consumer of DLManagedTensor is done with the tensor, it should invoke the deleter.
 DLManagedTensor* OrtValueToDlpack(OrtValue& ort_value) {
   ORT_ENFORCE(ort_value.IsTensor(), "Only tensor type OrtValues are supported");
-  OrtDLManagedTensor* ort_dlmanaged_tensor(new OrtDLManagedTensor);
+  // owned by a unique_ptr until it is returned, as an unsupported data type or device throws
+  auto ort_dlmanaged_tensor = std::make_unique<OrtDLManagedTensor>();
   Tensor& tensor = *ort_value.GetMutable<Tensor>();
   ort_dlmanaged_tensor->handle = ort_value;
-  ort_dlmanaged_tensor->tensor.manager_ctx = ort_dlmanaged_tensor;
+  ort_dlmanaged_tensor->tensor.manager_ctx = ort_dlmanaged_tensor.get();
   ort_dlmanaged_tensor->tensor.deleter = &DlpackDeleter;
   ort_dlmanaged_tensor->tensor.dl_tensor.data = (tensor.MutableDataRaw());
-  ort_dlmanaged_tensor->tensor.dl_tensor.ctx = GetDlpackContext(ort_value, tensor.Location().device.Id());
+  ort_dlmanaged_tensor->tensor.dl_tensor.ctx = GetDlpackContextImpl(ort_value, tensor.Location().device.Id());
   ort_dlmanaged_tensor->tensor.dl_tensor.ndim = static_cast<int>(tensor.Shape().NumDimensions());
   ort_dlmanaged_tensor->tensor.dl_tensor.dtype = GetDlpackDataType(ort_value);
   ort_dlmanaged_tensor->tensor.dl_tensor.shape =
       tensor.Shape().NumDimensions() > 0 ? const_cast<int64_t*>(&tensor.Shape()[0]) : nullptr;
   ort_dlmanaged_tensor->tensor.dl_tensor.strides = nullptr;
   ort_dlmanaged_tensor->tensor.dl_tensor.byte_offset = 0;
-  return &(ort_dlmanaged_tensor->tensor);
+  return &(ort_dlmanaged_tensor.release()->tensor);
 }
 
 OrtValue DlpackToOrtValue(DLManagedTensor* dlpack, bool is_bool_tensor) {
@@ -226,11 +232,14 @@ OrtValue DlpackToOrtValue(DLManagedTensor* dlpack, bool is_bool_tensor) {
   OrtMemoryInfo info(GetOrtDeviceName(device), OrtDeviceAllocator, device, device.Id());
   std::unique_ptr<Tensor> p_tensor = std::make_unique<Tensor>(
       data_type, TensorShape(dlpack->dl_tensor.shape, static_cast<size_t>(dlpack->dl_tensor.ndim)),
-      dlpack->dl_tensor.data, info);
+      static_cast<uint8_t*>(dlpack->dl_tensor.data) + dlpack->dl_tensor.byte_offset, info);
 
   OrtValue ort_value;
   std::function<void(void*)> deleter = [dlpack](void* p) {
-    dlpack->deleter(dlpack);
+    // the deleter is optional, e.g. when the producer owns the memory for the lifetime of the program
+    if (dlpack->deleter) {
+      dlpack->deleter(dlpack);
+    }
     DataTypeImpl::GetType<Tensor>()->GetDeleteFunc()(p);
   };
 
@@ -17,6 +17,9 @@ namespace dlpack {
 // it implies no new ownership.
 DLManagedTensor* OrtValueToDlpack(OrtValue& ort_value);
 
+// Returns the DLPack device of the tensor in an OrtValue.
+DLContext GetDlpackContext(const OrtValue& ort_value);
+
 // DLPack uses same config for both bool and unit8. Parameter is_bool_tensor is to
 // tell ORT the data type when creating OrtValue.
 OrtValue DlpackToOrtValue(DLManagedTensor* dlpack, bool is_bool_tensor = false);
@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 #include "core/eager/ort_kernel_invoker.h"
+#include <map>
+#include <sstream>
 #include "core/optimizer/optimizer_execution_frame.h"
 #include "core/common/logging/logging.h"
 #include "core/graph/model.h"
@@ -10,44 +12,85 @@
 
 namespace onnxruntime {
 
-common::Status ORTInvoker::Invoke(const std::string& op_name,
-                                  //optional inputs / outputs?
-                                  const std::vector<OrtValue>& inputs,
-                                  std::vector<OrtValue>& outputs,
-                                  const NodeAttributes* attributes,
-                                  const std::string& domain,
-                                  const int version) {
+struct ORTInvoker::KernelEntry {
+  // The kernel refers to the node in the graph of the model and to the info, so they are destroyed after it.
+  std::unique_ptr<Model> model;
+  std::unique_ptr<OptimizerExecutionFrame::Info> info;
+  std::unique_ptr<const OpKernel> kernel;
+  std::vector<int> feed_mlvalue_idxs;
+  std::vector<int> fetch_mlvalue_idxs;
+};
+
+namespace {
+
+// The kernel created for an invocation only depends on the op, its attributes, and the types of the inputs.
+std::string GetKernelCacheKey(const std::string& op_name,
+                              const std::vector<OrtValue>& inputs,
+                              size_t num_outputs,
+                              const NodeAttributes* attributes,
+                              const std::string& domain,
+                              int version) {
+  std::ostringstream key;
+  key << domain << ':' << op_name << ':' << version << ':' << num_outputs;
+  for (const auto& input : inputs) {
+    key << ':' << input.Get<Tensor>().GetElementType();
+  }
+
+  if (attributes != nullptr) {
+    // NodeAttributes is unordered, so the attributes are sorted by name to get a stable key.
+    std::map<std::string, const ONNX_NAMESPACE::AttributeProto*> sorted_attributes;
+    for (const auto& attribute : *attributes) {
+      sorted_attributes[attribute.first] = &attribute.second;
+    }
+    for (const auto& attribute : sorted_attributes) {
+      const std::string value = attribute.second->SerializeAsString();
+      key << '|' << attribute.first << '=' << value.size() << ':' << value;
+    }
+  }
+
+  return key.str();
+}
+
+}  // namespace
+
+common::Status ORTInvoker::CreateKernel(const std::string& op_name,
+                                        const std::vector<OrtValue>& inputs,
+                                        size_t num_outputs,
+                                        const NodeAttributes* attributes,
+                                        const std::string& domain,
+                                        int version,
+                                        std::shared_ptr<KernelEntry>& entry) {
+  entry = std::make_shared<KernelEntry>();
+
   //create a graph
-  Model model("test", 
-              false, 
-              ModelMetaData(),
-              "",
-              custom_op_registries_,
-              {},
-              {},
-              logger_);
+  entry->model = std::make_unique<Model>("test",
+                                         false,
+                                         ModelMetaData(),
+                                         "",
+                                         custom_op_registries_,
+                                         std::unordered_map<std::string, int>{},
+                                         std::vector<ONNX_NAMESPACE::FunctionProto>{},
+                                         logger_);
 
   std::vector<onnxruntime::NodeArg*> input_args;
   std::vector<onnxruntime::NodeArg*> output_args;
 
   input_args.reserve(inputs.size());
-  output_args.reserve(outputs.size());
+  output_args.reserve(num_outputs);
 
-  Graph& graph = model.MainGraph();
-  std::unordered_map<std::string, OrtValue> initializer_map;
+  Graph& graph = entry->model->MainGraph();
   size_t i = 0;
 
-  for (auto input : inputs) {
+  for (const auto& input : inputs) {
     std::string name = "I" + std::to_string(i++);
     const Tensor& input_tensor = input.Get<Tensor>();
     ONNX_NAMESPACE::TypeProto input_tensor_type;
     input_tensor_type.mutable_tensor_type()->set_elem_type(input_tensor.GetElementType());
     auto& arg = graph.GetOrCreateNodeArg(name, &input_tensor_type);
     input_args.push_back(&arg);
-    initializer_map[name] = input;
   }
 
-  for (i = 0; i < outputs.size(); ++i) {
+  for (i = 0; i < num_outputs; ++i) {
     auto& arg = graph.GetOrCreateNodeArg("O" + std::to_string(i), nullptr);
     output_args.push_back(&arg);
   }
@@ -56,24 +99,86 @@ common::Status ORTInvoker::Invoke(const std::string& op_name,
   ORT_RETURN_IF_ERROR(graph.Resolve());
 
   node.SetExecutionProviderType(execution_provider_->Type());
-  std::vector<const Node*> frame_nodes{&node};
 
-  OptimizerExecutionFrame::Info info({&node}, initializer_map, graph.ModelPath(), *execution_provider_);
-  auto kernel = info.CreateKernel(&node);
-  if (!kernel) {
+  // The inputs are fed to the frame of each invocation rather than being initializers of the info, so that the
+  // kernel does not treat them as constant inputs.
+  entry->info = std::make_unique<OptimizerExecutionFrame::Info>(std::vector<const Node*>{&node},
+                                                                std::unordered_map<std::string, OrtValue>{},
+                                                                graph.ModelPath(), *execution_provider_);
+  entry->kernel = entry->info->CreateKernel(&node);
+  if (!entry->kernel) {
     ORT_THROW("Could not find kernel name:", op_name, ", domain:", domain, ", version:", version);
   }
 
-  std::vector<int> fetch_mlvalue_idxs;
+  for (const auto* node_in : node.InputDefs()) {
+    entry->feed_mlvalue_idxs.push_back(entry->info->GetMLValueIndex(node_in->Name()));
+  }
   for (const auto* node_out : node.OutputDefs()) {
-    fetch_mlvalue_idxs.push_back(info.GetMLValueIndex(node_out->Name()));
+    entry->fetch_mlvalue_idxs.push_back(entry->info->GetMLValueIndex(node_out->Name()));
   }
 
-  OptimizerExecutionFrame frame(info, fetch_mlvalue_idxs, outputs);
-  OpKernelContext op_kernel_context(&frame, kernel.get(), nullptr, logger_);
-  ORT_RETURN_IF_ERROR(kernel->Compute(&op_kernel_context));
+  return Status::OK();
+}
+
+common::Status ORTInvoker::Invoke(const std::string& op_name,
+                                  //optional inputs / outputs?
+                                  const std::vector<OrtValue>& inputs,
+                                  std::vector<OrtValue>& outputs,
+                                  const NodeAttributes* attributes,
+                                  const std::string& domain,
+                                  const int version) {
+  const std::string key = GetKernelCacheKey(op_name, inputs, outputs.size(), attributes, domain, version);
+
+  // The entry is shared, so it can be used after the lock is released even if it is evicted concurrently.
+  std::shared_ptr<KernelEntry> entry;
+  {
+    std::lock_guard<OrtMutex> lock(kernel_cache_mutex_);
+    auto it = kernel_cache_.find(key);
+    if (it != kernel_cache_.end()) {
+      kernel_cache_entries_.splice(kernel_cache_entries_.begin(), kernel_cache_entries_, it->second);
+      entry = it->second->second;
+    }
+  }
+
+  if (entry == nullptr) {
+    ORT_RETURN_IF_ERROR(CreateKernel(op_name, inputs, outputs.size(), attributes, domain, version, entry));
+
+    std::lock_guard<OrtMutex> lock(kernel_cache_mutex_);
+    auto it = kernel_cache_.find(key);
+    if (it != kernel_cache_.end()) {
+      // Another thread created the same kernel in the meantime, its entry is kept and used.
+      kernel_cache_entries_.splice(kernel_cache_entries_.begin(), kernel_cache_entries_, it->second);
+      entry = it->second->second;
+    } else if (kernel_cache_capacity_ > 0) {
+      kernel_cache_entries_.emplace_front(key, entry);
+      kernel_cache_[key] = kernel_cache_entries_.begin();
+      while (kernel_cache_entries_.size() > kernel_cache_capacity_) {
+        kernel_cache_.erase(kernel_cache_entries_.back().first);
+        kernel_cache_entries_.pop_back();
+      }
+    }
+  }
+
+  OptimizerExecutionFrame frame(*entry->info, entry->feed_mlvalue_idxs, inputs, entry->fetch_mlvalue_idxs, outputs);
+  OpKernelContext op_kernel_context(&frame, entry->kernel.get(), nullptr, logger_);
+  ORT_RETURN_IF_ERROR(entry->kernel->Compute(&op_kernel_context));
 
   return frame.GetOutputs(outputs);
 }
 
+size_t ORTInvoker::KernelCacheSize() {
+  std::lock_guard<OrtMutex> lock(kernel_cache_mutex_);
+  return kernel_cache_entries_.size();
+}
+
+void ORTInvoker::ClearKernelCache() {
+  // The entries are destroyed after the lock is released, or by the invocations still using them.
+  std::list<KernelCacheEntry> entries;
+  {
+    std::lock_guard<OrtMutex> lock(kernel_cache_mutex_);
+    kernel_cache_.clear();
+    entries.swap(kernel_cache_entries_);
+  }
+}
+
 }  // namespace onnxruntime
@@ -197,6 +197,7 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
       }
 #endif
 
+      concurrency::ThreadPool::TuningScope tuning_scope(session_state.GetParallelForTuner(), node.Domain(), node.OpType());
       status = p_op_kernel->Compute(&op_kernel_context);
     }
     ORT_CATCH(const std::exception& ex) {
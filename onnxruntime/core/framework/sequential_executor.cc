@@ -9,6 +9,7 @@
 #include <sstream>
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
+#include "core/common/trace_recorder.h"
 #include "core/framework/allocation_planner.h"
 #include "core/framework/execution_frame.h"
 #include "core/framework/session_state.h"
@@ -128,6 +129,7 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
                                    const std::unordered_map<size_t, CustomAllocator>& fetch_allocators,
                                    const logging::Logger& logger) {
   const bool is_profiler_enabled = session_state.Profiler().IsEnabled();
+  const bool is_trace_recorded = profiling::TraceRecorder::IsThreadTraced();
   TimePoint tp;
   TimePoint sync_time_begin;
   TimePoint kernel_begin_time;
@@ -296,6 +298,8 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
                                input_activation_sizes, input_parameter_sizes, node_name_for_profiling);
     }
 
+    const uint64_t trace_start_ns = is_trace_recorded ? profiling::TraceRecorder::NowNs() : 0;
+
     Status compute_status;
     {
 #ifdef CONCURRENCY_VISUALIZER
@@ -313,6 +317,7 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
         }
 #endif
 
+        concurrency::ThreadPool::TuningScope tuning_scope(session_state.GetParallelForTuner(), node.Domain(), node.OpType());
         compute_status = p_op_kernel->Compute(&op_kernel_context);
       }
       ORT_CATCH(const std::exception& ex) {
@@ -326,6 +331,15 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
 #endif
     }
 
+    if (is_trace_recorded) {
+      profiling::TraceRecorder::RecordEvent(
+          profiling::TraceRecorder::EventKind::kNode,
+          profiling::TraceRecorder::InternName(node.Name().empty() ? MakeString(node.OpType(), "_", node_index)
+                                                                   : node.Name()),
+          profiling::TraceRecorder::InternName(node.OpType()),
+          trace_start_ns, profiling::TraceRecorder::NowNs());
+    }
+
     if (!compute_status.IsOK()) {
       std::ostringstream ss;
       ss << "Non-zero status code returned while running " << node.OpType() << " node. Name:'" << node.Name()
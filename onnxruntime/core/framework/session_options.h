@@ -37,6 +37,12 @@ struct FreeDimensionOverride {
   int64_t dim_value;
 };
 
+// A graph output whose value is kept by the session and fed as a graph input in the next run.
+struct StatefulInputOutput {
+  std::string input_name;
+  std::string output_name;
+};
+
 /**
   * Configuration information for a session.
   */
@@ -117,6 +123,10 @@ struct SessionOptions {
   ConfigOptions config_options;
   std::unordered_map<std::string, const OrtValue*> initializers_to_share_map;
 
+  // Graph inputs that are fed with the graph outputs of the previous run, e.g. the hidden states of a recurrent
+  // model that is run on a stream chunk by chunk. See InferenceSession::ResetStates.
+  std::vector<StatefulInputOutput> stateful_inputs_outputs;
+
   // See onnxruntime_c_api.h for detailed documentation.
   Status AddInitializer(_In_z_ const char* name, _In_ const OrtValue* val) noexcept;
 };
@@ -266,6 +266,11 @@ class SessionState {
   concurrency::ThreadPool* GetThreadPool() const noexcept { return thread_pool_; }
   concurrency::ThreadPool* GetInterOpThreadPool() const noexcept { return inter_op_thread_pool_; }
 
+  // Tuner for the block sizes of the parallel loops issued by kernels. nullptr if tuning is not enabled.
+  // Set before CreateSubgraphSessionState so that subgraphs share the tuner.
+  concurrency::ParallelForTuner* GetParallelForTuner() const noexcept { return parallel_for_tuner_; }
+  void SetParallelForTuner(concurrency::ParallelForTuner* tuner) noexcept { parallel_for_tuner_ = tuner; }
+
   bool ExportDll() const noexcept { return export_fused_dll_; }
   void SetExportDllFlag(bool flag) noexcept { export_fused_dll_ = flag; }
 
@@ -452,6 +457,7 @@ class SessionState {
   // either threadpool could be nullptr
   concurrency::ThreadPool* const thread_pool_{};
   concurrency::ThreadPool* const inter_op_thread_pool_{};
+  concurrency::ParallelForTuner* parallel_for_tuner_{};
 
   bool export_fused_dll_ = false;
   FuncManager fused_funcs_mgr_;
@@ -453,6 +453,12 @@ and present state are optional. Present state could appear in output even when p
             "Whether every token can only attend to previous tokens. Default value is 0.",
             AttributeProto::INT,
             static_cast<int64_t>(0))
+      .Attr("chunk_size",
+            "When positive, the attention is computed over blocks of chunk_size keys with an online softmax, "
+            "so that the attention probabilities of the whole sequence are not materialized. "
+            "Default value is 0, which computes the attention probabilities at once.",
+            AttributeProto::INT,
+            static_cast<int64_t>(0))
       .Input(0, "input", "3D input tensor with shape (batch_size, sequence_length, input_hidden_size)", "T")
       .Input(1, "weight", "2D input tensor with shape (input_hidden_size, 3 * hidden_size), where hidden_size = num_heads * head_size", "T")
       .Input(2, "bias", "1D input tensor with shape (3 * hidden_size)", "T")
@@ -477,6 +483,11 @@ and present state are optional. Present state could appear in output even when p
             "Whether every token can only attend to previous tokens. Default value is 0.",
             AttributeProto::INT,
             static_cast<int64_t>(0))
+      .Attr("integer_attention",
+            "Whether to compute Q x K' and the attention probabilities x V with 8-bit integer matrix multiplications. "
+            "Q, K, V and the attention probabilities are quantized dynamically. Default value is 0.",
+            AttributeProto::INT,
+            static_cast<int64_t>(0))
       .Input(
           0,
           "input",
@@ -2494,6 +2505,37 @@ It's an extension of Gelu. It takes the sum of input A and bias input B as the i
           "Constrain input and output types to float tensors.")
       .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput);
 
+  static const char* FusedElementwise_ver1_doc =
+      R"DOC(Fused chain of elementwise operators.
+Evaluates Y = op_N(...op_2(op_1(X))) in a single pass over X. Step i applies operators[i], either a unary
+operator to the running result, or a binary operator to the running result and the input at operands[i].
+The operand is the left hand side of the binary operator if swap_operands[i] is 1. Each operand must
+broadcast to the shape of X without changing it: it is a scalar, or its shape is the trailing dimensions
+of X, with optional leading dimensions of size 1.)DOC";
+  ONNX_CONTRIB_OPERATOR_SCHEMA(FusedElementwise)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(FusedElementwise_ver1_doc)
+      .Attr("operators",
+            "The operator of each step: Add, Sub, Mul, Div, Pow, Max, Min, Abs, Erf, Exp, Log, Neg, "
+            "Reciprocal, Relu, Sigmoid, Sqrt or Tanh.",
+            AttributeProto::STRINGS)
+      .Attr("operands",
+            "The index of the input used by each step, or -1 for the unary operators.",
+            AttributeProto::INTS)
+      .Attr("swap_operands",
+            "Set to 1 for the steps whose operand is the left hand side of the binary operator.",
+            AttributeProto::INTS,
+            OPTIONAL_VALUE)
+      .Input(0, "X", "The input of the first step.", "T")
+      .Input(1, "inputs", "The operands of the binary steps.", "T", OpSchema::Variadic, true, 0)
+      .Output(0, "Y", "The output, which has the shape of X.", "T")
+      .TypeConstraint(
+          "T",
+          {"tensor(float)"},
+          "Constrain input and output types to float tensors.")
+      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput);
+
   // Used to be ONNX 1.7 Inverse(12)
   // Comment out docs not to increase the binary size
   //
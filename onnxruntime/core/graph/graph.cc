@@ -741,6 +741,7 @@ void Node::CreateSubgraph(const std::string& attr_name) {
 void Node::AddAttribute(const std::string& attr_name, const AttributeProto& value) {
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
+  inferencing_key_.clear();
   attributes_[attr_name] = value;
 }
 
@@ -748,6 +749,7 @@ void Node::AddAttribute(const std::string& attr_name, const AttributeProto& valu
   void Node::AddAttribute(const std::string& attr_name, const type& value) { \
     graph_->SetGraphResolveNeeded();                                         \
     graph_->SetGraphProtoSyncNeeded();                                       \
+    inferencing_key_.clear();                                                \
     AttributeProto a;                                                        \
     a.set_name(attr_name);                                                   \
     a.set_type(enumType);                                                    \
@@ -759,6 +761,7 @@ void Node::AddAttribute(const std::string& attr_name, const AttributeProto& valu
   void Node::AddAttribute(const std::string& attr_name, const type& value) { \
     graph_->SetGraphResolveNeeded();                                         \
     graph_->SetGraphProtoSyncNeeded();                                       \
+    inferencing_key_.clear();                                                \
     AttributeProto a;                                                        \
     a.set_name(attr_name);                                                   \
     a.set_type(enumType);                                                    \
@@ -813,6 +816,7 @@ ADD_LIST_ATTR_IMPL(TypeProto, AttributeProto_AttributeType::AttributeProto_Attri
 bool Node::ClearAttribute(const std::string& attr_name) {
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
+  inferencing_key_.clear();
   return attributes_.erase(attr_name) > 0;
 }
 
@@ -2290,6 +2294,32 @@ common::Status Graph::TypeCheckInputsAndInitializers() {
   return Status::OK();
 }
 
+// Builds the key of the inputs and outputs of a node that its type and shape inferencing depends on. If the key of a
+// node has not changed since it was inferred, inferencing it again produces the same output types and shapes.
+static std::string GetInferencingKey(const Node& node) {
+  std::string key;
+  auto append_def = [&key](const NodeArg* def) {
+    key.append(reinterpret_cast<const char*>(&def), sizeof(def));
+    std::string type;
+    if (def->TypeAsProto() != nullptr) {
+      def->TypeAsProto()->SerializeToString(&type);
+    }
+    const size_t type_size = type.size();
+    key.append(reinterpret_cast<const char*>(&type_size), sizeof(type_size));
+    key.append(type);
+  };
+
+  for (const auto* def : node.InputDefs()) {
+    append_def(def);
+  }
+  key.push_back('|');
+  for (const auto* def : node.OutputDefs()) {
+    append_def(def);
+  }
+
+  return key;
+}
+
 Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
   CheckerContext ctx;
   ctx.set_ir_version(gsl::narrow_cast<int>(IrVersion()));
@@ -2314,10 +2344,30 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
   // and need to call Resolve
   lsc.output_names.insert(outer_scope_node_arg_names_.cbegin(), outer_scope_node_arg_names_.cend());
 
+  // Type and shape inferencing of the main graph is incremental. A node is skipped if it was inferred before and
+  // neither its inputs and outputs, their types, its attributes nor the values of its initializer inputs have changed.
+  // Nodes are processed in topological order, so a change of output types is seen by the downstream nodes.
+  // Subgraphs are always inferred in full, as the types of their inputs come from the node containing them.
+  const bool incremental = parent_graph_ == nullptr && !options.override_types;
+  num_nodes_inferred_by_last_resolve_ = 0;
+
   for (auto node_index : nodes_in_topological_order_) {
     // Node verification.
     auto& node = *GetNode(node_index);
 
+    if (incremental && node.Op() != nullptr && !node.ContainsSubgraph() && !node.inferencing_key_.empty() &&
+        node.inferencing_key_ == GetInferencingKey(node) &&
+        (initializers_changed_since_resolve_.empty() ||
+         std::none_of(node.InputDefs().begin(), node.InputDefs().end(), [this](const NodeArg* def) {
+           return initializers_changed_since_resolve_.count(def->Name()) > 0;
+         }))) {
+      ORT_RETURN_IF_ERROR(node.UpdateInputArgCount());
+      for (const auto* output_def : node.OutputDefs()) {
+        lsc.output_names.insert(output_def->Name());
+      }
+      continue;
+    }
+
     NodeProto node_proto;
     node.ToProto(node_proto);
     auto& node_name = node.Name();
@@ -2385,6 +2435,11 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
     }
 
     NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *p_op, options)));
+    ++num_nodes_inferred_by_last_resolve_;
+
+    if (incremental) {
+      node.inferencing_key_ = GetInferencingKey(node);
+    }
 
     // Accumulate output names of the iterated Node
     for (auto& output_name : node_proto.output()) {
@@ -2567,6 +2622,7 @@ Status Graph::Resolve(const ResolveOptions& options) {
   // perform the final steps for this graph and all subgraphs
   auto finalize_func = [&options](Graph& graph) {
             graph.CleanUnusedInitializers(options.initializer_names_to_preserve);
+            graph.initializers_changed_since_resolve_.clear();
             graph.GraphResolveNeeded(false);
 
             // if we are resolving immediately after loading from a GraphProto, we don't need to
@@ -2595,6 +2651,7 @@ void Graph::AddInitializedTensor(const TensorProto& tensor) {
   const gsl::not_null<TensorProto*> tensor_added{graph_proto_->add_initializer()};
   *(tensor_added) = tensor;
   name_to_initial_tensor_[tensor.name()] = tensor_added;
+  initializers_changed_since_resolve_.insert(tensor.name());
   SetGraphResolveNeeded();
   if (!is_loaded_from_model_file_ && GetNodeArg(tensor.name()) == nullptr) {
     // make sure there is a NodeArg for the initializer as SetGraphInputsOutputs may add it to the graph inputs.
@@ -2706,6 +2763,8 @@ Status Graph::ReplaceInitializedTensor(const ONNX_NAMESPACE::TensorProto& new_in
               "graph_proto_ is not in sync with name_to_initial_tensor_");
 
   **existing_entry = new_initializer;
+  initializers_changed_since_resolve_.insert(initializer_name);
+  SetGraphResolveNeeded();
 
   return Status::OK();
 }
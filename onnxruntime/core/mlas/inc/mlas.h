@@ -621,6 +621,7 @@ enum MLAS_CONV_ALGORITHM {
     MlasConvAlgorithmGemmDirect,
     MlasConvAlgorithmExpandThenGemm,
     MlasConvAlgorithmExpandThenGemmSegmented,
+    MlasConvAlgorithmWinograd,
 #if defined(MLAS_TARGET_WASM_SCALAR)
     MlasConvAlgorithmDepthwise,
 #endif
@@ -652,6 +653,12 @@ struct MLAS_CONV_PARAMETERS {
         struct {
             size_t ThreadStrideN;
         } ExpandThenGemmSegmented;
+        struct {
+            size_t OutputTileSize;
+            size_t TileCountHeight;
+            size_t TileCountWidth;
+            const float* PackedFilter;
+        } Winograd;
     } u;
 };
 
@@ -687,6 +694,53 @@ MlasConv(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Winograd convolution routines for 3x3 convolutions with unit strides and
+// dilations. MlasConvPrepare selects the Winograd algorithm when the output is
+// large enough to amortize transforming the filter on every call to MlasConv.
+// Callers can instead transform the filter ahead of time with
+// MlasConvWinogradPackFilter and supply it with
+// MlasConvWinogradUsePackedFilter after MlasConvPrepare.
+// MlasConvWinogradIsFilterSupported tells whether packing a filter can pay off.
+//
+
+bool
+MLASCALL
+MlasConvWinogradIsFilterSupported(
+    size_t FilterCount,
+    size_t InputChannels
+    );
+
+size_t
+MLASCALL
+MlasConvWinogradPackFilterSize(
+    size_t OutputTileSize,
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels
+    );
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t OutputTileSize,
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels,
+    const float* Filter,
+    float* PackedFilter
+    );
+
+bool
+MLASCALL
+MlasConvWinogradUsePackedFilter(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t OutputTileSize,
+    const float* PackedFilter,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 void
 MLASCALL
 MlasConvDepthwise(
@@ -701,6 +755,49 @@ MlasConvDepthwise(
     size_t KernelSize
     );
 
+//
+// Quantized direct convolution routines.
+//
+// The filter is packed ahead of time into blocks of output channels and the
+// convolution consumes a channels last input through an indirection buffer,
+// avoiding the im2col transform of the GEMM based convolution.
+//
+// MlasConvDirectU8S8PackFilterSize returns zero if the platform does not
+// provide a direct convolution kernel.
+//
+
+size_t
+MLASCALL
+MlasConvDirectU8S8PackFilterSize(
+    size_t OutputChannels,
+    size_t InputChannels,
+    size_t KernelSize
+    );
+
+void
+MLASCALL
+MlasConvDirectU8S8PackFilter(
+    size_t OutputChannels,
+    size_t InputChannels,
+    size_t KernelSize,
+    const int8_t* Filter,
+    void* PackedFilter
+    );
+
+void
+MLASCALL
+MlasConvDirectU8S8(
+    const uint8_t* const* Input,
+    uint8_t InputZeroPoint,
+    const void* PackedFilter,
+    int8_t FilterZeroPoint,
+    int32_t* Output,
+    size_t InputChannels,
+    size_t OutputChannels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
 //
 // Pooling routines.
 //
@@ -873,6 +873,15 @@ Return Value:
 
     const MLAS_CONV_ALGORITHM Algorithm = Parameters->Algorithm;
 
+    //
+    // The Winograd algorithm schedules all batches and groups at once.
+    //
+
+    if (Algorithm == MlasConvAlgorithmWinograd) {
+        MlasConvWinograd(Parameters, Input, Filter, Bias, WorkingBuffer, Output, ThreadPool);
+        return;
+    }
+
     //
     // Schedule batches of GEMMs across multiple threads.
     //
@@ -1000,6 +1009,16 @@ Return Value:
 
                     break;
                 }
+
+                case MlasConvAlgorithmWinograd:
+                {
+                    //
+                    // The Winograd algorithm is dispatched above for all batches and
+                    // groups at once, so this case is never reached.
+                    //
+
+                    break;
+                }
             }
 
             //
@@ -1203,6 +1222,14 @@ Return Value:
         }
     }
 
+    //
+    // Detect 3x3 convolutions that benefit from the Winograd algorithm.
+    //
+
+    if (MlasConvWinogradTryPrepare(Parameters, WorkingBufferSize, ThreadPool)) {
+        return;
+    }
+
     if (FilterCount > OutputSize) {
 
         //
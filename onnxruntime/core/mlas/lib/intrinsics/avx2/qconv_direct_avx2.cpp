@@ -0,0 +1,62 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qconv_direct_avx2.cpp
+
+Abstract:
+
+    This module implements the quantized integer direct convolution kernel.
+
+    This implementation uses AVX2 instructions.
+
+--*/
+
+#include "qconv_direct_avx2.h"
+
+struct MLAS_CONV_DIRECT_U8S8_DOT_PRODUCT_AVX2
+{
+    // Number of output elements computed per pass over the packed filter, which
+    // leaves registers for the intermediate products.
+    static constexpr size_t OutputBlock = 4;
+
+    static
+    MLAS_FORCEINLINE
+    __m256i
+    Accumulate(
+        __m256i Accumulator,
+        __m256i InputVector,
+        __m256i FilterVector
+        )
+    {
+        // N.B. The intermediate 16-bit sums of PMADDUBSW saturate, which
+        // matches the behavior of the AVX2 U8S8 GEMM kernel.
+        const __m256i OnesWordBroadcast = _mm256_set1_epi16(1);
+        __m256i Products = _mm256_maddubs_epi16(InputVector, FilterVector);
+        Products = _mm256_madd_epi16(Products, OnesWordBroadcast);
+        return _mm256_add_epi32(Accumulator, Products);
+    }
+};
+
+void
+MLASCALL
+MlasConvDirectU8S8KernelAvx2(
+    const uint8_t* const* Input,
+    int32_t InputZeroPoint,
+    const int8_t* PackedFilter,
+    const int32_t* FilterSums,
+    int32_t* Output,
+    size_t InputChannels,
+    size_t OutputChannels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+{
+    MlasConvDirectU8S8KernelAvx2Common<MLAS_CONV_DIRECT_U8S8_DOT_PRODUCT_AVX2>(
+        Input, InputZeroPoint, PackedFilter, FilterSums, Output, InputChannels,
+        OutputChannels, OutputCount, KernelSize);
+}
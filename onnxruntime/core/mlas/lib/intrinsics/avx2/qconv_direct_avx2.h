@@ -0,0 +1,248 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qconv_direct_avx2.h
+
+Abstract:
+
+    This module implements the common kernel for the quantized integer direct
+    convolution routines.
+
+    The kernel is shared by the AVX2 and AVXVNNI implementations, which differ
+    only in the instruction sequence used to multiply and accumulate a vector
+    of four input channels against the packed filter.
+
+--*/
+
+#pragma once
+
+#include "mlasi.h"
+
+template<size_t Count>
+MLAS_FORCEINLINE
+__m256i
+MlasConvDirectU8S8BroadcastInput(
+    const uint8_t* Input,
+    size_t RemainingCount
+    )
+/*++
+
+Routine Description:
+
+    This routine broadcasts four input channels to every 32-bit element of a
+    vector.
+
+Arguments:
+
+    Input - Supplies the input channels.
+
+    RemainingCount - Supplies the number of input channels to load (1 to 3)
+        if Count is zero, else four input channels are loaded. The input is
+        never read past the supplied number of channels.
+
+Return Value:
+
+    Returns the broadcasted input channels.
+
+--*/
+{
+    int32_t Value = 0;
+
+    if (Count == 4) {
+        memcpy(&Value, Input, sizeof(int32_t));
+    } else {
+        for (size_t i = 0; i < RemainingCount; i++) {
+            Value |= int32_t(Input[i]) << (i * 8);
+        }
+    }
+
+    return _mm256_set1_epi32(Value);
+}
+
+template<typename DotProduct, size_t OutputBlock>
+MLAS_FORCEINLINE
+void
+MlasConvDirectU8S8ComputeBlock(
+    const uint8_t* const* Input,
+    const __m256i FilterBias[2],
+    const int8_t* PackedFilter,
+    int32_t* Output,
+    size_t InputChannels,
+    size_t OutputChannels,
+    size_t OutputChannelsThisBlock,
+    size_t KernelSize
+    )
+/*++
+
+Routine Description:
+
+    This routine computes one block of output channels for OutputBlock (up to
+    six) output elements.
+
+Arguments:
+
+    Input - Supplies the indirection buffer for the output elements.
+
+    FilterBias - Supplies the initial accumulator values for the block of
+        output channels.
+
+    PackedFilter - Supplies the packed filter for the block of output channels.
+
+    Output - Supplies the output buffer for the first output element.
+
+    InputChannels - Supplies the number of input channels.
+
+    OutputChannels - Supplies the number of output channels, which is the
+        stride between output elements.
+
+    OutputChannelsThisBlock - Supplies the number of output channels to store
+        for this block.
+
+    KernelSize - Supplies the number of kernel elements.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    static_assert(OutputBlock >= 1 && OutputBlock <= 6, "unsupported output block");
+
+    __m256i Accumulators[OutputBlock][2];
+
+    for (size_t n = 0; n < OutputBlock; n++) {
+        Accumulators[n][0] = FilterBias[0];
+        Accumulators[n][1] = FilterBias[1];
+    }
+
+    const size_t InputChannelsAligned = InputChannels & ~size_t(3);
+    const size_t InputChannelsRemaining = InputChannels - InputChannelsAligned;
+    const int8_t* filter = PackedFilter;
+
+    const uint8_t* const* input = Input;
+
+    for (size_t k = 0; k < KernelSize; k++) {
+
+        const uint8_t* InputRows[OutputBlock];
+
+        for (size_t n = 0; n < OutputBlock; n++) {
+            InputRows[n] = input[n * KernelSize];
+        }
+
+#define MLAS_CONV_DIRECT_U8S8_ACCUMULATE(n, Offset, Count) \
+        if (OutputBlock > n) { \
+            const __m256i InputVector = \
+                MlasConvDirectU8S8BroadcastInput<Count>(InputRows[n] + Offset, InputChannelsRemaining); \
+            Accumulators[n][0] = DotProduct::Accumulate(Accumulators[n][0], InputVector, FilterVector0); \
+            Accumulators[n][1] = DotProduct::Accumulate(Accumulators[n][1], InputVector, FilterVector1); \
+        }
+
+#define MLAS_CONV_DIRECT_U8S8_ACCUMULATE_ALL(Offset, Count) \
+        { \
+            const __m256i FilterVector0 = _mm256_loadu_si256((const __m256i*)&filter[0]); \
+            const __m256i FilterVector1 = _mm256_loadu_si256((const __m256i*)&filter[32]); \
+            MLAS_CONV_DIRECT_U8S8_ACCUMULATE(0, Offset, Count); \
+            MLAS_CONV_DIRECT_U8S8_ACCUMULATE(1, Offset, Count); \
+            MLAS_CONV_DIRECT_U8S8_ACCUMULATE(2, Offset, Count); \
+            MLAS_CONV_DIRECT_U8S8_ACCUMULATE(3, Offset, Count); \
+            MLAS_CONV_DIRECT_U8S8_ACCUMULATE(4, Offset, Count); \
+            MLAS_CONV_DIRECT_U8S8_ACCUMULATE(5, Offset, Count); \
+            filter += 64; \
+        }
+
+        for (size_t c = 0; c < InputChannelsAligned; c += 4) {
+            MLAS_CONV_DIRECT_U8S8_ACCUMULATE_ALL(c, 4);
+        }
+
+        if (InputChannelsRemaining > 0) {
+            MLAS_CONV_DIRECT_U8S8_ACCUMULATE_ALL(InputChannelsAligned, 0);
+        }
+
+#undef MLAS_CONV_DIRECT_U8S8_ACCUMULATE_ALL
+#undef MLAS_CONV_DIRECT_U8S8_ACCUMULATE
+
+        input += 1;
+    }
+
+    for (size_t n = 0; n < OutputBlock; n++) {
+
+        int32_t* output = Output + n * OutputChannels;
+
+        if (OutputChannelsThisBlock == MLAS_CONV_DIRECT_U8S8_FILTER_BLOCK) {
+            _mm256_storeu_si256((__m256i*)&output[0], Accumulators[n][0]);
+            _mm256_storeu_si256((__m256i*)&output[8], Accumulators[n][1]);
+        } else {
+            MLAS_DECLSPEC_ALIGN(int32_t Buffer[MLAS_CONV_DIRECT_U8S8_FILTER_BLOCK], 32);
+            _mm256_store_si256((__m256i*)&Buffer[0], Accumulators[n][0]);
+            _mm256_store_si256((__m256i*)&Buffer[8], Accumulators[n][1]);
+            std::copy_n(Buffer, OutputChannelsThisBlock, output);
+        }
+    }
+}
+
+template<typename DotProduct>
+MLAS_FORCEINLINE
+void
+MlasConvDirectU8S8KernelAvx2Common(
+    const uint8_t* const* Input,
+    int32_t InputZeroPoint,
+    const int8_t* PackedFilter,
+    const int32_t* FilterSums,
+    int32_t* Output,
+    size_t InputChannels,
+    size_t OutputChannels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+{
+    const size_t InputChannelQuads = (InputChannels + 3) / 4;
+    const size_t FilterBlockStride = KernelSize * InputChannelQuads * 64;
+    const __m256i InputZeroPointVector = _mm256_set1_epi32(-InputZeroPoint);
+
+    for (size_t oc = 0; oc < OutputChannels; oc += MLAS_CONV_DIRECT_U8S8_FILTER_BLOCK) {
+
+        const size_t OutputChannelsThisBlock =
+            std::min<size_t>(OutputChannels - oc, MLAS_CONV_DIRECT_U8S8_FILTER_BLOCK);
+        const int8_t* filter = PackedFilter + (oc / MLAS_CONV_DIRECT_U8S8_FILTER_BLOCK) * FilterBlockStride;
+
+        //
+        // Fold the input zero point into the initial accumulator values:
+        // sum((x - xzp) * w) = sum(x * w) - xzp * sum(w).
+        //
+
+        __m256i FilterBias[2];
+        FilterBias[0] = _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i*)&FilterSums[oc]), InputZeroPointVector);
+        FilterBias[1] = _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i*)&FilterSums[oc + 8]), InputZeroPointVector);
+
+        const uint8_t* const* input = Input;
+        int32_t* output = Output + oc;
+        size_t OutputRemaining = OutputCount;
+
+        while (OutputRemaining >= DotProduct::OutputBlock) {
+
+            MlasConvDirectU8S8ComputeBlock<DotProduct, DotProduct::OutputBlock>(
+                input, FilterBias, filter, output, InputChannels, OutputChannels,
+                OutputChannelsThisBlock, KernelSize);
+
+            input += DotProduct::OutputBlock * KernelSize;
+            output += DotProduct::OutputBlock * OutputChannels;
+            OutputRemaining -= DotProduct::OutputBlock;
+        }
+
+        while (OutputRemaining > 0) {
+
+            MlasConvDirectU8S8ComputeBlock<DotProduct, 1>(
+                input, FilterBias, filter, output, InputChannels, OutputChannels,
+                OutputChannelsThisBlock, KernelSize);
+
+            input += KernelSize;
+            output += OutputChannels;
+            OutputRemaining -= 1;
+        }
+    }
+}
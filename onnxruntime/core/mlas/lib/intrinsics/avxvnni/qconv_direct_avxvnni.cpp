@@ -0,0 +1,56 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qconv_direct_avxvnni.cpp
+
+Abstract:
+
+    This module implements the quantized integer direct convolution kernel.
+
+    This implementation uses AVXVNNI instructions.
+
+--*/
+
+#include "../avx2/qconv_direct_avx2.h"
+
+struct MLAS_CONV_DIRECT_U8S8_DOT_PRODUCT_AVXVNNI
+{
+    // Number of output elements computed per pass over the packed filter.
+    static constexpr size_t OutputBlock = 6;
+
+    static
+    MLAS_FORCEINLINE
+    __m256i
+    Accumulate(
+        __m256i Accumulator,
+        __m256i InputVector,
+        __m256i FilterVector
+        )
+    {
+        return _mm256_dpbusd_avx_epi32(Accumulator, InputVector, FilterVector);
+    }
+};
+
+void
+MLASCALL
+MlasConvDirectU8S8KernelAvxVnni(
+    const uint8_t* const* Input,
+    int32_t InputZeroPoint,
+    const int8_t* PackedFilter,
+    const int32_t* FilterSums,
+    int32_t* Output,
+    size_t InputChannels,
+    size_t OutputChannels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+{
+    MlasConvDirectU8S8KernelAvx2Common<MLAS_CONV_DIRECT_U8S8_DOT_PRODUCT_AVXVNNI>(
+        Input, InputZeroPoint, PackedFilter, FilterSums, Output, InputChannels,
+        OutputChannels, OutputCount, KernelSize);
+}
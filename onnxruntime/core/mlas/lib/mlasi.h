@@ -482,6 +482,29 @@ struct MLAS_U8X8_KERNEL
         );
 };
 
+//
+// Define the output channel block size of the quantized direct convolution
+// filter. The filter is packed as groups of four input channels for each
+// output channel, which is the layout consumed by the PMADDUBSW and VPDPBUSD
+// instructions.
+//
+
+#define MLAS_CONV_DIRECT_U8S8_FILTER_BLOCK 16
+
+typedef
+void
+(MLASCALL MLAS_CONV_DIRECT_U8S8_KERNEL)(
+    const uint8_t* const* Input,
+    int32_t InputZeroPoint,
+    const int8_t* PackedFilter,
+    const int32_t* FilterSums,
+    int32_t* Output,
+    size_t InputChannels,
+    size_t OutputChannels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
 extern "C" {
 
 #if defined(MLAS_TARGET_AMD64_IX86)
@@ -591,6 +614,8 @@ extern "C" {
     MLAS_QLINEAR_BINARY_OP_U8_KERNEL MlasQLinearAddU8KernelAvx2;
     MLAS_QUANTIZE_LINEAR_S8_KERNEL MlasQuantizeLinearS8KernelAvx512F;
     MLAS_QUANTIZE_LINEAR_U8_KERNEL MlasQuantizeLinearU8KernelAvx512F;
+    MLAS_CONV_DIRECT_U8S8_KERNEL MlasConvDirectU8S8KernelAvx2;
+    MLAS_CONV_DIRECT_U8S8_KERNEL MlasConvDirectU8S8KernelAvxVnni;
 #endif
 
     MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL MlasReduceMaximumF32Kernel;
@@ -727,6 +752,7 @@ struct MLAS_PLATFORM {
     MLAS_QLINEAR_BINARY_OP_U8_KERNEL* QLinearAddU8Kernel;
     MLAS_U8X8_KERNEL<int8_t>::DepthwiseKernel* ConvDepthwiseU8S8Kernel;
     MLAS_U8X8_KERNEL<uint8_t>::DepthwiseKernel* ConvDepthwiseU8U8Kernel;
+    MLAS_CONV_DIRECT_U8S8_KERNEL* ConvDirectU8S8Kernel;
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL* ComputeExpF32Kernel;
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL* LogisticKernelRoutine;
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL* TanhKernelRoutine;
@@ -867,6 +893,29 @@ MlasFp32FromBits(
 }
 
 
+//
+// Winograd convolution routines.
+//
+
+bool
+MlasConvWinogradTryPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+
 #if defined(MLAS_TARGET_WASM_SCALAR)
 
 void
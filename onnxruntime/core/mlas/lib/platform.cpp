@@ -159,6 +159,7 @@ Return Value:
     this->QuantizeLinearU8Kernel = MlasQuantizeLinearU8Kernel;
     this->ConvDepthwiseU8S8Kernel = MlasConvDepthwiseKernel<int8_t>;
     this->ConvDepthwiseU8U8Kernel = MlasConvDepthwiseKernel<uint8_t>;
+    this->ConvDirectU8S8Kernel = nullptr;
 
     this->NchwcBlockSize = 8;
     this->PreferredBufferAlignment = MLAS_DEFAULT_PREFERRED_BUFFER_ALIGNMENT;
@@ -253,6 +254,7 @@ Return Value:
                 this->QLinearAddU8Kernel = MlasQLinearAddU8KernelAvx2;
                 this->ConvDepthwiseU8S8Kernel = MlasConvDepthwiseKernelAvx2<int8_t>;
                 this->ConvDepthwiseU8U8Kernel = MlasConvDepthwiseKernelAvx2<uint8_t>;
+                this->ConvDirectU8S8Kernel = MlasConvDirectU8S8KernelAvx2;
                 this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelFma3;
 
                 //
@@ -279,6 +281,9 @@ Return Value:
                     this->GemmU8U8Dispatch = &MlasGemmU8S8DispatchAvx2;
                     this->GemmU8S8Kernel = MlasGemmU8S8KernelAvxVnni;
                     this->GemvU8S8Kernel = MlasGemvU8S8KernelAvxVnni;
+#if !defined(MLAS_AVXVNNI_INTRINSICS_UNSUPPORTED)
+                    this->ConvDirectU8S8Kernel = MlasConvDirectU8S8KernelAvxVnni;
+#endif
                 }
 
 #if !defined(MLAS_AVX512F_UNSUPPORTED)
@@ -0,0 +1,291 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qconv_direct.cpp
+
+Abstract:
+
+    This module implements the quantized integer direct convolution routines.
+
+    The packed filter starts with the sums of the filter elements for each
+    output channel, padded to a multiple of the output channel block size.
+    This is followed by the filter blocks, where each block holds the filter
+    for MLAS_CONV_DIRECT_U8S8_FILTER_BLOCK output channels ordered by kernel
+    element, then by groups of four input channels. Each group is stored as
+    two 32 byte vectors holding four input channels for each of eight output
+    channels.
+
+--*/
+
+#include "mlasi.h"
+
+size_t
+MLASCALL
+MlasConvDirectU8S8PackFilterSize(
+    size_t OutputChannels,
+    size_t InputChannels,
+    size_t KernelSize
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the size of the buffer required to pack the filter
+    for MlasConvDirectU8S8.
+
+Arguments:
+
+    OutputChannels - Supplies the number of output channels.
+
+    InputChannels - Supplies the number of input channels.
+
+    KernelSize - Supplies the number of kernel elements.
+
+Return Value:
+
+    Returns the size of the packed filter buffer in bytes, or zero if the
+    platform does not support the direct convolution kernel.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+
+    if (MlasPlatform.ConvDirectU8S8Kernel == nullptr) {
+        return 0;
+    }
+
+    const size_t OutputChannelBlocks =
+        (OutputChannels + MLAS_CONV_DIRECT_U8S8_FILTER_BLOCK - 1) / MLAS_CONV_DIRECT_U8S8_FILTER_BLOCK;
+    const size_t AlignedOutputChannels = OutputChannelBlocks * MLAS_CONV_DIRECT_U8S8_FILTER_BLOCK;
+    const size_t AlignedInputChannels = (InputChannels + 3) & ~size_t(3);
+
+    return AlignedOutputChannels * sizeof(int32_t) +
+        AlignedOutputChannels * KernelSize * AlignedInputChannels;
+
+#else
+
+    MLAS_UNREFERENCED_PARAMETER(OutputChannels);
+    MLAS_UNREFERENCED_PARAMETER(InputChannels);
+    MLAS_UNREFERENCED_PARAMETER(KernelSize);
+
+    return 0;
+
+#endif
+}
+
+void
+MLASCALL
+MlasConvDirectU8S8PackFilter(
+    size_t OutputChannels,
+    size_t InputChannels,
+    size_t KernelSize,
+    const int8_t* Filter,
+    void* PackedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the filter for MlasConvDirectU8S8.
+
+Arguments:
+
+    OutputChannels - Supplies the number of output channels.
+
+    InputChannels - Supplies the number of input channels.
+
+    KernelSize - Supplies the number of kernel elements.
+
+    Filter - Supplies the filter tensor in OIHW format.
+
+    PackedFilter - Supplies the buffer to receive the packed filter. The size
+        of the buffer is returned by MlasConvDirectU8S8PackFilterSize.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t OutputChannelBlocks =
+        (OutputChannels + MLAS_CONV_DIRECT_U8S8_FILTER_BLOCK - 1) / MLAS_CONV_DIRECT_U8S8_FILTER_BLOCK;
+    const size_t AlignedOutputChannels = OutputChannelBlocks * MLAS_CONV_DIRECT_U8S8_FILTER_BLOCK;
+    const size_t AlignedInputChannels = (InputChannels + 3) & ~size_t(3);
+
+    int32_t* FilterSums = reinterpret_cast<int32_t*>(PackedFilter);
+    int8_t* packed = reinterpret_cast<int8_t*>(FilterSums + AlignedOutputChannels);
+
+    std::fill_n(FilterSums, AlignedOutputChannels, 0);
+
+    for (size_t oc = 0; oc < OutputChannels; oc++) {
+
+        const int8_t* filter = Filter + oc * InputChannels * KernelSize;
+        int32_t Sum = 0;
+
+        for (size_t i = 0; i < InputChannels * KernelSize; i++) {
+            Sum += filter[i];
+        }
+
+        FilterSums[oc] = Sum;
+    }
+
+    for (size_t ob = 0; ob < OutputChannelBlocks; ob++) {
+
+        for (size_t k = 0; k < KernelSize; k++) {
+
+            for (size_t c = 0; c < AlignedInputChannels; c += 4) {
+
+                //
+                // Each group of four input channels is stored as two vectors
+                // of eight output channels.
+                //
+
+                for (size_t n = 0; n < MLAS_CONV_DIRECT_U8S8_FILTER_BLOCK; n++) {
+
+                    const size_t oc = ob * MLAS_CONV_DIRECT_U8S8_FILTER_BLOCK + n;
+
+                    for (size_t i = 0; i < 4; i++) {
+
+                        int8_t Value = 0;
+
+                        if (oc < OutputChannels && c + i < InputChannels) {
+                            Value = Filter[(oc * InputChannels + c + i) * KernelSize + k];
+                        }
+
+                        *packed++ = Value;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void
+MLASCALL
+MlasConvDirectU8S8(
+    const uint8_t* const* Input,
+    uint8_t InputZeroPoint,
+    const void* PackedFilter,
+    int8_t FilterZeroPoint,
+    int32_t* Output,
+    size_t InputChannels,
+    size_t OutputChannels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the quantized direct convolution operation.
+
+    The input is supplied as an indirection buffer. Every pointer in the
+    indirection buffer points at an InputChannels length vector (either from
+    the input tensor or a vector of padding values). These are grouped in
+    batches of length KernelSize that are processed by the kernel to produce a
+    single output of length OutputChannels. These batches are then repeated
+    OutputCount times.
+
+Arguments:
+
+    Input - Supplies an indirection buffer to the elements of the input tensor.
+
+    InputZeroPoint - Supplies the zero point offset of the input tensor.
+
+    PackedFilter - Supplies the filter packed by MlasConvDirectU8S8PackFilter.
+
+    FilterZeroPoint - Supplies the zero point offset of the filter tensor.
+
+    Output - Supplies the output tensor in channels last format.
+
+    InputChannels - Supplies the number of input channels.
+
+    OutputChannels - Supplies the number of output channels.
+
+    OutputCount - Supplies the number of channel sized output elements to
+        produce.
+
+    KernelSize - Supplies the total number of channel sized kernel elements to
+        consume.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+
+    const size_t OutputChannelBlocks =
+        (OutputChannels + MLAS_CONV_DIRECT_U8S8_FILTER_BLOCK - 1) / MLAS_CONV_DIRECT_U8S8_FILTER_BLOCK;
+    const int32_t* FilterSums = reinterpret_cast<const int32_t*>(PackedFilter);
+    const int8_t* packed = reinterpret_cast<const int8_t*>(FilterSums + OutputChannelBlocks * MLAS_CONV_DIRECT_U8S8_FILTER_BLOCK);
+
+    MlasPlatform.ConvDirectU8S8Kernel(
+        Input,
+        InputZeroPoint,
+        packed,
+        FilterSums,
+        Output,
+        InputChannels,
+        OutputChannels,
+        OutputCount,
+        KernelSize);
+
+    //
+    // The kernel accounts for the input zero point. Adjust the output for a
+    // non-zero filter zero point using the sums of the input elements:
+    // sum((x - xzp) * (w - wzp)) = sum((x - xzp) * w) - wzp * (sum(x) - N * xzp).
+    //
+
+    if (FilterZeroPoint != 0) {
+
+        const int32_t InputZeroPointSum = int32_t(InputZeroPoint) * int32_t(InputChannels * KernelSize);
+
+        for (size_t i = 0; i < OutputCount; i++) {
+
+            int32_t InputSum = 0;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+                const uint8_t* input = Input[k];
+                for (size_t c = 0; c < InputChannels; c++) {
+                    InputSum += input[c];
+                }
+            }
+
+            const int32_t Adjustment = int32_t(FilterZeroPoint) * (InputSum - InputZeroPointSum);
+
+            for (size_t oc = 0; oc < OutputChannels; oc++) {
+                Output[oc] -= Adjustment;
+            }
+
+            Input += KernelSize;
+            Output += OutputChannels;
+        }
+    }
+
+#else
+
+    MLAS_UNREFERENCED_PARAMETER(Input);
+    MLAS_UNREFERENCED_PARAMETER(InputZeroPoint);
+    MLAS_UNREFERENCED_PARAMETER(PackedFilter);
+    MLAS_UNREFERENCED_PARAMETER(FilterZeroPoint);
+    MLAS_UNREFERENCED_PARAMETER(Output);
+    MLAS_UNREFERENCED_PARAMETER(InputChannels);
+    MLAS_UNREFERENCED_PARAMETER(OutputChannels);
+    MLAS_UNREFERENCED_PARAMETER(OutputCount);
+    MLAS_UNREFERENCED_PARAMETER(KernelSize);
+
+#ifdef MLAS_NO_EXCEPTION
+    abort();
+#else
+    throw std::runtime_error("direct convolution is not supported on this platform");
+#endif
+
+#endif
+}
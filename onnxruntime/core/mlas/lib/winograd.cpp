@@ -0,0 +1,1082 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    winograd.cpp
+
+Abstract:
+
+    This module implements the Winograd minimal filtering convolution
+    algorithms F(2x2,3x3) and F(4x4,3x3).
+
+    The output image is divided into tiles of OutputTileSize x OutputTileSize
+    elements. Each input tile and each filter are transformed to a
+    TileSize x TileSize domain where the convolution reduces to elementwise
+    products. The products for every transformed element are accumulated
+    over the input channels with a GEMM, and the result is transformed back
+    to an output tile. Compared to the direct algorithm, this reduces the
+    number of multiplications by 2.25x for F(2x2,3x3) and by 4x for
+    F(4x4,3x3).
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of output tiles that are processed by a thread at once.
+// This is the N dimension of the transformed domain GEMMs.
+//
+
+#define MLAS_CONV_WINOGRAD_TILE_BLOCK               16
+
+//
+// Define the minimum number of input and filter channels per group for the
+// Winograd algorithm to be used.
+//
+
+#define MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS         8
+
+//
+// Define the minimum number of output tiles across all batches for
+// MlasConvPrepare to select the Winograd algorithm.
+//
+
+#define MLAS_CONV_WINOGRAD_MINIMUM_TILE_COUNT       128
+
+//
+// Define the one-dimensional transforms for F(2,3).
+//
+// The input and output transforms operate on vectors holding the elements of
+// four adjacent tiles.
+//
+
+struct MLAS_WINOGRAD_F2X3
+{
+    static constexpr size_t OutputTileSize = 2;
+    static constexpr size_t TileSize = 4;
+
+    //
+    // Computes BT * d.
+    //
+
+    MLAS_FORCEINLINE
+    static
+    void
+    TransformInput(
+        const MLAS_FLOAT32X4* d,
+        size_t ds,
+        MLAS_FLOAT32X4* r,
+        size_t rs
+        )
+    {
+        const MLAS_FLOAT32X4 d0 = d[0];
+        const MLAS_FLOAT32X4 d1 = d[ds];
+        const MLAS_FLOAT32X4 d2 = d[2 * ds];
+        const MLAS_FLOAT32X4 d3 = d[3 * ds];
+
+        r[0] = MlasSubtractFloat32x4(d0, d2);
+        r[rs] = MlasAddFloat32x4(d1, d2);
+        r[2 * rs] = MlasSubtractFloat32x4(d2, d1);
+        r[3 * rs] = MlasSubtractFloat32x4(d1, d3);
+    }
+
+    //
+    // Computes G * g.
+    //
+
+    MLAS_FORCEINLINE
+    static
+    void
+    TransformFilter(
+        const float* g,
+        size_t gs,
+        float* r,
+        size_t rs
+        )
+    {
+        const float g0 = g[0];
+        const float g1 = g[gs];
+        const float g2 = g[2 * gs];
+
+        r[0] = g0;
+        r[rs] = 0.5f * (g0 + g1 + g2);
+        r[2 * rs] = 0.5f * (g0 - g1 + g2);
+        r[3 * rs] = g2;
+    }
+
+    //
+    // Computes AT * m.
+    //
+
+    MLAS_FORCEINLINE
+    static
+    void
+    TransformOutput(
+        const MLAS_FLOAT32X4* m,
+        size_t ms,
+        MLAS_FLOAT32X4* r,
+        size_t rs
+        )
+    {
+        const MLAS_FLOAT32X4 m0 = m[0];
+        const MLAS_FLOAT32X4 m1 = m[ms];
+        const MLAS_FLOAT32X4 m2 = m[2 * ms];
+        const MLAS_FLOAT32X4 m3 = m[3 * ms];
+
+        r[0] = MlasAddFloat32x4(MlasAddFloat32x4(m0, m1), m2);
+        r[rs] = MlasSubtractFloat32x4(MlasSubtractFloat32x4(m1, m2), m3);
+    }
+};
+
+//
+// Define the one-dimensional transforms for F(4,3).
+//
+
+struct MLAS_WINOGRAD_F4X3
+{
+    static constexpr size_t OutputTileSize = 4;
+    static constexpr size_t TileSize = 6;
+
+    MLAS_FORCEINLINE
+    static
+    void
+    TransformInput(
+        const MLAS_FLOAT32X4* d,
+        size_t ds,
+        MLAS_FLOAT32X4* r,
+        size_t rs
+        )
+    {
+        const MLAS_FLOAT32X4 d0 = d[0];
+        const MLAS_FLOAT32X4 d1 = d[ds];
+        const MLAS_FLOAT32X4 d2 = d[2 * ds];
+        const MLAS_FLOAT32X4 d3 = d[3 * ds];
+        const MLAS_FLOAT32X4 d4 = d[4 * ds];
+        const MLAS_FLOAT32X4 d5 = d[5 * ds];
+
+        const MLAS_FLOAT32X4 d42s = MlasSubtractFloat32x4(d4, d2);
+        const MLAS_FLOAT32X4 d13s = MlasSubtractFloat32x4(d1, d3);
+
+        r[0] = MlasMultiplyAddFloat32x4(d0, 4.0f, MlasMultiplyAddFloat32x4(d2, -5.0f, d4));
+        r[rs] = MlasMultiplyAddFloat32x4(MlasAddFloat32x4(d1, d2), -4.0f, MlasAddFloat32x4(d3, d4));
+        r[2 * rs] = MlasMultiplyAddFloat32x4(MlasSubtractFloat32x4(d1, d2), 4.0f, MlasSubtractFloat32x4(d4, d3));
+        r[3 * rs] = MlasMultiplyAddFloat32x4(d13s, -2.0f, d42s);
+        r[4 * rs] = MlasMultiplyAddFloat32x4(d13s, 2.0f, d42s);
+        r[5 * rs] = MlasMultiplyAddFloat32x4(d1, 4.0f, MlasMultiplyAddFloat32x4(d3, -5.0f, d5));
+    }
+
+    MLAS_FORCEINLINE
+    static
+    void
+    TransformFilter(
+        const float* g,
+        size_t gs,
+        float* r,
+        size_t rs
+        )
+    {
+        const float g0 = g[0];
+        const float g1 = g[gs];
+        const float g2 = g[2 * gs];
+
+        r[0] = g0 / 4.0f;
+        r[rs] = -(g0 + g1 + g2) / 6.0f;
+        r[2 * rs] = -(g0 - g1 + g2) / 6.0f;
+        r[3 * rs] = g0 / 24.0f + g1 / 12.0f + g2 / 6.0f;
+        r[4 * rs] = g0 / 24.0f - g1 / 12.0f + g2 / 6.0f;
+        r[5 * rs] = g2;
+    }
+
+    MLAS_FORCEINLINE
+    static
+    void
+    TransformOutput(
+        const MLAS_FLOAT32X4* m,
+        size_t ms,
+        MLAS_FLOAT32X4* r,
+        size_t rs
+        )
+    {
+        const MLAS_FLOAT32X4 m0 = m[0];
+        const MLAS_FLOAT32X4 m1 = m[ms];
+        const MLAS_FLOAT32X4 m2 = m[2 * ms];
+        const MLAS_FLOAT32X4 m3 = m[3 * ms];
+        const MLAS_FLOAT32X4 m4 = m[4 * ms];
+        const MLAS_FLOAT32X4 m5 = m[5 * ms];
+
+        const MLAS_FLOAT32X4 m12a = MlasAddFloat32x4(m1, m2);
+        const MLAS_FLOAT32X4 m12s = MlasSubtractFloat32x4(m1, m2);
+        const MLAS_FLOAT32X4 m34a = MlasAddFloat32x4(m3, m4);
+        const MLAS_FLOAT32X4 m34s = MlasSubtractFloat32x4(m3, m4);
+
+        r[0] = MlasAddFloat32x4(MlasAddFloat32x4(m0, m12a), m34a);
+        r[rs] = MlasMultiplyAddFloat32x4(m34s, 2.0f, m12s);
+        r[2 * rs] = MlasMultiplyAddFloat32x4(m34a, 4.0f, m12a);
+        r[3 * rs] = MlasMultiplyAddFloat32x4(m34s, 8.0f, MlasAddFloat32x4(m12s, m5));
+    }
+};
+
+//
+// Define the parameters to execute segments of a Winograd convolution on
+// worker threads.
+//
+
+struct MLAS_CONV_WINOGRAD_WORK_BLOCK {
+    const MLAS_CONV_PARAMETERS* Parameters;
+    const float* Input;
+    const float* Filter;
+    const float* Bias;
+    float* WorkingBuffer;
+    float* Output;
+    size_t WorkingBufferSizePerThread;
+};
+
+template<typename WinogradTransform>
+void
+MlasConvWinogradPackFilterKernel(
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels,
+    const float* Filter,
+    float* PackedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms the 3x3 filters to the Winograd domain.
+
+    The packed filter is stored as TileSize * TileSize matrices of shape
+    FilterCount x InputChannels per group, so that each transformed element
+    forms the A matrix of a GEMM.
+
+Arguments:
+
+    GroupCount - Supplies the number of channel groups.
+
+    FilterCount - Supplies the number of filters per group.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    Filter - Supplies the filter tensor.
+
+    PackedFilter - Supplies the buffer to receive the transformed filter.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t TileSize = WinogradTransform::TileSize;
+    constexpr size_t TransformCount = TileSize * TileSize;
+
+    const size_t MatrixSize = FilterCount * InputChannels;
+
+    for (size_t group = 0; group < GroupCount; group++) {
+
+        for (size_t f = 0; f < FilterCount; f++) {
+
+            for (size_t c = 0; c < InputChannels; c++) {
+
+                float Columns[TileSize * 3];
+                float Transformed[TransformCount];
+
+                for (size_t j = 0; j < 3; j++) {
+                    WinogradTransform::TransformFilter(Filter + j, 3, Columns + j, 3);
+                }
+
+                for (size_t i = 0; i < TileSize; i++) {
+                    WinogradTransform::TransformFilter(Columns + i * 3, 1, Transformed + i * TileSize, 1);
+                }
+
+                float* packed = PackedFilter + f * InputChannels + c;
+
+                for (size_t t = 0; t < TransformCount; t++) {
+                    packed[t * MatrixSize] = Transformed[t];
+                }
+
+                Filter += 9;
+            }
+        }
+
+        PackedFilter += TransformCount * MatrixSize;
+    }
+}
+
+template<typename WinogradTransform>
+void
+MlasConvWinogradTransformInput(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    size_t TileStart,
+    size_t TileCount,
+    size_t ld,
+    float* TransformedInput
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a block of input tiles to the Winograd domain.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor for the batch and group.
+
+    TileStart - Supplies the index of the first tile of the block.
+
+    TileCount - Supplies the number of tiles of the block.
+
+    ld - Supplies the number of elements per row of the transformed input.
+        This is TileCount rounded up to a multiple of four.
+
+    TransformedInput - Supplies the buffer to receive the transformed input,
+        stored as TileSize * TileSize matrices of shape InputChannels x ld.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t TileSize = WinogradTransform::TileSize;
+    constexpr size_t OutputTileSize = WinogradTransform::OutputTileSize;
+    constexpr size_t TransformCount = TileSize * TileSize;
+
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t InputSize = Parameters->InputSize;
+    const size_t TileCountWidth = Parameters->u.Winograd.TileCountWidth;
+
+    const size_t MatrixSize = InputChannels * ld;
+
+    //
+    // Iterate over the tiles of each channel so that the stores to each
+    // transformed matrix are sequential.
+    //
+
+    for (size_t c = 0; c < InputChannels; c++) {
+
+        const float* input = Input + c * InputSize;
+        float* transformed = TransformedInput + c * ld;
+
+        for (size_t t = 0; t < TileCount; t += 4) {
+
+            MLAS_DECLSPEC_ALIGN(float TileElements[TransformCount][4], 16);
+
+            for (size_t lane = 0; lane < 4; lane++) {
+
+                if (t + lane >= TileCount) {
+
+                    for (size_t k = 0; k < TransformCount; k++) {
+                        TileElements[k][lane] = 0.0f;
+                    }
+
+                    continue;
+                }
+
+                const size_t tile = TileStart + t + lane;
+                const size_t ih0 = (tile / TileCountWidth) * OutputTileSize - Parameters->Padding[0];
+                const size_t iw0 = (tile % TileCountWidth) * OutputTileSize - Parameters->Padding[1];
+
+                //
+                // Tiles that do not overlap the padding can be loaded without
+                // bounds checks. Tiles starting in the leading padding have
+                // wrapped around to a large unsigned value.
+                //
+
+                if ((ih0 < InputHeight && ih0 + TileSize <= InputHeight) &&
+                    (iw0 < InputWidth && iw0 + TileSize <= InputWidth)) {
+
+                    for (size_t i = 0; i < TileSize; i++) {
+                        for (size_t j = 0; j < TileSize; j++) {
+                            TileElements[i * TileSize + j][lane] = input[(ih0 + i) * InputWidth + iw0 + j];
+                        }
+                    }
+
+                } else {
+
+                    for (size_t i = 0; i < TileSize; i++) {
+                        const size_t ih = ih0 + i;
+                        for (size_t j = 0; j < TileSize; j++) {
+                            const size_t iw = iw0 + j;
+                            TileElements[i * TileSize + j][lane] = (ih < InputHeight && iw < InputWidth) ?
+                                input[ih * InputWidth + iw] : 0.0f;
+                        }
+                    }
+                }
+            }
+
+            MLAS_FLOAT32X4 Tile[TransformCount];
+            MLAS_FLOAT32X4 Columns[TransformCount];
+            MLAS_FLOAT32X4 Transformed[TransformCount];
+
+            for (size_t k = 0; k < TransformCount; k++) {
+                Tile[k] = MlasLoadFloat32x4(TileElements[k]);
+            }
+
+            for (size_t j = 0; j < TileSize; j++) {
+                WinogradTransform::TransformInput(Tile + j, TileSize, Columns + j, TileSize);
+            }
+
+            for (size_t i = 0; i < TileSize; i++) {
+                WinogradTransform::TransformInput(Columns + i * TileSize, 1, Transformed + i * TileSize, 1);
+            }
+
+            for (size_t k = 0; k < TransformCount; k++) {
+                MlasStoreFloat32x4(transformed + k * MatrixSize + t, Transformed[k]);
+            }
+        }
+    }
+}
+
+template<typename WinogradTransform>
+void
+MlasConvWinogradTransformOutput(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* TransformedOutput,
+    const float* Bias,
+    size_t TileStart,
+    size_t TileCount,
+    size_t ld,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a block of output tiles from the Winograd domain
+    and stores the elements that are inside the output image.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    TransformedOutput - Supplies the transformed output, stored as
+        TileSize * TileSize matrices of shape FilterCount x ld.
+
+    Bias - Optionally supplies the bias vector for the group.
+
+    TileStart - Supplies the index of the first tile of the block.
+
+    TileCount - Supplies the number of tiles of the block.
+
+    ld - Supplies the number of elements per row of the transformed output.
+        This is TileCount rounded up to a multiple of four.
+
+    Output - Supplies the output tensor for the batch and group.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t TileSize = WinogradTransform::TileSize;
+    constexpr size_t OutputTileSize = WinogradTransform::OutputTileSize;
+    constexpr size_t TransformCount = TileSize * TileSize;
+
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t TileCountWidth = Parameters->u.Winograd.TileCountWidth;
+
+    const size_t MatrixSize = FilterCount * ld;
+
+    for (size_t f = 0; f < FilterCount; f++) {
+
+        const float* transformed = TransformedOutput + f * ld;
+        const MLAS_FLOAT32X4 BiasVector = MlasBroadcastFloat32x4((Bias != nullptr) ? Bias[f] : 0.0f);
+
+        for (size_t t = 0; t < TileCount; t += 4) {
+
+            MLAS_FLOAT32X4 Transformed[TransformCount];
+            MLAS_FLOAT32X4 Columns[OutputTileSize * TileSize];
+            MLAS_FLOAT32X4 Tile[OutputTileSize * OutputTileSize];
+
+            for (size_t k = 0; k < TransformCount; k++) {
+                Transformed[k] = MlasLoadFloat32x4(transformed + k * MatrixSize + t);
+            }
+
+            for (size_t j = 0; j < TileSize; j++) {
+                WinogradTransform::TransformOutput(Transformed + j, TileSize, Columns + j, TileSize);
+            }
+
+            for (size_t i = 0; i < OutputTileSize; i++) {
+                WinogradTransform::TransformOutput(Columns + i * TileSize, 1, Tile + i * OutputTileSize, 1);
+            }
+
+            MLAS_DECLSPEC_ALIGN(float TileElements[OutputTileSize * OutputTileSize][4], 16);
+
+            for (size_t k = 0; k < OutputTileSize * OutputTileSize; k++) {
+                MlasStoreFloat32x4(TileElements[k], MlasAddFloat32x4(Tile[k], BiasVector));
+            }
+
+            const size_t LaneCount = std::min(size_t(4), TileCount - t);
+
+            for (size_t lane = 0; lane < LaneCount; lane++) {
+
+                const size_t tile = TileStart + t + lane;
+                const size_t oh0 = (tile / TileCountWidth) * OutputTileSize;
+                const size_t ow0 = (tile % TileCountWidth) * OutputTileSize;
+                const size_t RowCount = std::min(OutputTileSize, OutputHeight - oh0);
+                const size_t ColumnCount = std::min(OutputTileSize, OutputWidth - ow0);
+
+                float* output = Output + f * OutputSize + oh0 * OutputWidth + ow0;
+
+                for (size_t i = 0; i < RowCount; i++) {
+                    for (size_t j = 0; j < ColumnCount; j++) {
+                        output[i * OutputWidth + j] = TileElements[i * OutputTileSize + j][lane];
+                    }
+                }
+            }
+        }
+    }
+}
+
+template<typename WinogradTransform>
+void
+MlasConvWinogradThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    Winograd convolution operation.
+
+    The work is divided into blocks of MLAS_CONV_WINOGRAD_TILE_BLOCK output
+    tiles of a batch and group. Each block is transformed to the Winograd
+    domain, multiplied by the transformed filter, and transformed back using
+    the portion of the working buffer owned by this thread.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t TileSize = WinogradTransform::TileSize;
+    constexpr size_t TransformCount = TileSize * TileSize;
+
+    const auto* WorkBlock = (MLAS_CONV_WINOGRAD_WORK_BLOCK*)Context;
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t GroupCount = Parameters->GroupCount;
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+
+    const size_t TileCount = Parameters->u.Winograd.TileCountHeight * Parameters->u.Winograd.TileCountWidth;
+    const size_t TileBlockCount = (TileCount + MLAS_CONV_WINOGRAD_TILE_BLOCK - 1) / MLAS_CONV_WINOGRAD_TILE_BLOCK;
+
+    size_t WorkIndex;
+    size_t WorkRemaining;
+
+    MlasPartitionWork(Index, Parameters->ThreadCount, Parameters->BatchCount * GroupCount * TileBlockCount,
+        &WorkIndex, &WorkRemaining);
+
+    float* TransformedInput = WorkBlock->WorkingBuffer + Index * WorkBlock->WorkingBufferSizePerThread;
+    float* TransformedOutput = TransformedInput + TransformCount * InputChannels * MLAS_CONV_WINOGRAD_TILE_BLOCK;
+
+    while (WorkRemaining > 0) {
+
+        const size_t bg = WorkIndex / TileBlockCount;
+        const size_t group = bg % GroupCount;
+        const size_t TileStart = (WorkIndex % TileBlockCount) * MLAS_CONV_WINOGRAD_TILE_BLOCK;
+        const size_t CountN = std::min(size_t(MLAS_CONV_WINOGRAD_TILE_BLOCK), TileCount - TileStart);
+
+        const float* input = WorkBlock->Input + bg * InputChannels * Parameters->InputSize;
+        const float* filter = WorkBlock->Filter + group * TransformCount * FilterCount * InputChannels;
+        float* output = WorkBlock->Output + bg * FilterCount * Parameters->OutputSize;
+
+        const float* bias = WorkBlock->Bias;
+
+        if (bias != nullptr) {
+            bias += group * FilterCount;
+        }
+
+        const size_t ld = (CountN + 3) & ~size_t(3);
+
+        MlasConvWinogradTransformInput<WinogradTransform>(Parameters, input, TileStart, CountN, ld,
+            TransformedInput);
+
+        for (size_t k = 0; k < TransformCount; k++) {
+
+            MlasSgemmOperation(CblasNoTrans, CblasNoTrans, FilterCount, CountN, InputChannels, 1.0f,
+                filter + k * FilterCount * InputChannels, InputChannels,
+                TransformedInput + k * InputChannels * ld, ld, 0.0f,
+                TransformedOutput + k * FilterCount * ld, ld);
+        }
+
+        MlasConvWinogradTransformOutput<WinogradTransform>(Parameters, TransformedOutput, bias,
+            TileStart, CountN, ld, output);
+
+        WorkIndex++;
+        WorkRemaining--;
+    }
+}
+
+size_t
+MlasConvWinogradWorkingBufferSizePerThread(
+    const MLAS_CONV_PARAMETERS* Parameters
+    )
+{
+    const size_t TileSize = Parameters->u.Winograd.OutputTileSize + 2;
+
+    return TileSize * TileSize * (Parameters->InputChannels + Parameters->FilterCount) *
+        MLAS_CONV_WINOGRAD_TILE_BLOCK;
+}
+
+bool
+MLASCALL
+MlasConvWinogradIsFilterSupported(
+    size_t FilterCount,
+    size_t InputChannels
+    )
+/*++
+
+Routine Description:
+
+    This routine determines whether a 3x3 filter has enough channels for the
+    Winograd algorithm to be selected for any input shape. The transforms are
+    amortized over the input and filter channels, so both need to be large
+    enough for the reduced multiplication count to pay off.
+
+Arguments:
+
+    FilterCount - Supplies the number of filters per group.
+
+    InputChannels - Supplies the number of input channels per group.
+
+Return Value:
+
+    Returns true if the filter can be used with the Winograd algorithm.
+
+--*/
+{
+    return InputChannels >= MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS &&
+        FilterCount >= MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS;
+}
+
+bool
+MlasConvWinogradIsSupported(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    size_t OutputTileSize
+    )
+/*++
+
+Routine Description:
+
+    This routine determines whether the Winograd algorithm with the specified
+    output tile size is suitable for a convolution operation.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    OutputTileSize - Supplies the output tile size (2 or 4).
+
+Return Value:
+
+    Returns true if the Winograd algorithm can be used.
+
+--*/
+{
+    if (Parameters->Dimensions != 2) {
+        return false;
+    }
+
+    if (Parameters->KernelShape[0] != 3 || Parameters->KernelShape[1] != 3 ||
+        Parameters->StrideShape[0] != 1 || Parameters->StrideShape[1] != 1 ||
+        Parameters->DilationShape[0] != 1 || Parameters->DilationShape[1] != 1) {
+        return false;
+    }
+
+    //
+    // The transforms are amortized over the input and filter channels, so
+    // require enough of both for the reduced multiplication count to pay off.
+    //
+
+    if (!MlasConvWinogradIsFilterSupported(Parameters->FilterCount, Parameters->InputChannels)) {
+        return false;
+    }
+
+    //
+    // Require each output dimension to span at least two tiles, otherwise
+    // the elements of partial tiles that are discarded outweigh the savings.
+    //
+
+    return Parameters->OutputShape[0] >= 2 * OutputTileSize &&
+        Parameters->OutputShape[1] >= 2 * OutputTileSize;
+}
+
+void
+MlasConvWinogradPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t OutputTileSize,
+    const float* PackedFilter,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine prepares for a Winograd convolution operation.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    OutputTileSize - Supplies the output tile size (2 or 4).
+
+    PackedFilter - Optionally supplies the filter transformed by
+        MlasConvWinogradPackFilter for the output tile size.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t TileCountHeight = (Parameters->OutputShape[0] + OutputTileSize - 1) / OutputTileSize;
+    const size_t TileCountWidth = (Parameters->OutputShape[1] + OutputTileSize - 1) / OutputTileSize;
+    const size_t TileBlockCount = Parameters->BatchCount * Parameters->GroupCount *
+        ((TileCountHeight * TileCountWidth + MLAS_CONV_WINOGRAD_TILE_BLOCK - 1) / MLAS_CONV_WINOGRAD_TILE_BLOCK);
+
+    ptrdiff_t TargetThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(TargetThreadCount) >= TileBlockCount) {
+        TargetThreadCount = ptrdiff_t(TileBlockCount);
+    }
+
+    Parameters->Algorithm = MlasConvAlgorithmWinograd;
+    Parameters->ThreadCount = TargetThreadCount;
+    Parameters->u.Winograd.OutputTileSize = OutputTileSize;
+    Parameters->u.Winograd.TileCountHeight = TileCountHeight;
+    Parameters->u.Winograd.TileCountWidth = TileCountWidth;
+    Parameters->u.Winograd.PackedFilter = PackedFilter;
+
+    *WorkingBufferSize = TargetThreadCount * MlasConvWinogradWorkingBufferSizePerThread(Parameters);
+
+    //
+    // Reserve space to transform the filter on every call if the caller has
+    // not supplied a packed filter.
+    //
+
+    if (PackedFilter == nullptr) {
+        *WorkingBufferSize += MlasConvWinogradPackFilterSize(OutputTileSize, Parameters->GroupCount,
+            Parameters->FilterCount, Parameters->InputChannels);
+    }
+}
+
+bool
+MlasConvWinogradTryPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine prepares for a Winograd convolution operation if the
+    algorithm is suitable for the convolution and the filter is to be
+    transformed on every call.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    Returns true if the Winograd algorithm was selected.
+
+--*/
+{
+    size_t OutputTileSize = 4;
+
+    if (!MlasConvWinogradIsSupported(Parameters, OutputTileSize)) {
+
+        OutputTileSize = 2;
+
+        if (!MlasConvWinogradIsSupported(Parameters, OutputTileSize)) {
+            return false;
+        }
+    }
+
+    //
+    // Transforming the filter costs about as much as processing a tile of
+    // every batch, so require enough tiles to amortize it.
+    //
+
+    const size_t TileCount = ((Parameters->OutputShape[0] + OutputTileSize - 1) / OutputTileSize) *
+        ((Parameters->OutputShape[1] + OutputTileSize - 1) / OutputTileSize);
+
+    if (Parameters->BatchCount * TileCount < MLAS_CONV_WINOGRAD_MINIMUM_TILE_COUNT) {
+        return false;
+    }
+
+    MlasConvWinogradPrepare(Parameters, OutputTileSize, nullptr, WorkingBufferSize, ThreadPool);
+
+    return true;
+}
+
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the Winograd convolution operation.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor.
+
+    Filter - Supplies the filter tensor. This is ignored if the parameters
+        reference a packed filter.
+
+    Bias - Optionally supplies the bias vector.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvPrepare or MlasConvWinogradUsePackedFilter.
+
+    Output - Supplies the output tensor.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t OutputTileSize = Parameters->u.Winograd.OutputTileSize;
+
+    MLAS_CONV_WINOGRAD_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Parameters = Parameters;
+    WorkBlock.Input = Input;
+    WorkBlock.Filter = Parameters->u.Winograd.PackedFilter;
+    WorkBlock.Bias = Bias;
+    WorkBlock.Output = Output;
+    WorkBlock.WorkingBufferSizePerThread = MlasConvWinogradWorkingBufferSizePerThread(Parameters);
+
+    if (WorkBlock.Filter == nullptr) {
+
+        MlasConvWinogradPackFilter(OutputTileSize, Parameters->GroupCount, Parameters->FilterCount,
+            Parameters->InputChannels, Filter, WorkingBuffer);
+
+        WorkBlock.Filter = WorkingBuffer;
+
+        WorkingBuffer += MlasConvWinogradPackFilterSize(OutputTileSize, Parameters->GroupCount,
+            Parameters->FilterCount, Parameters->InputChannels);
+    }
+
+    WorkBlock.WorkingBuffer = WorkingBuffer;
+
+    if (OutputTileSize == MLAS_WINOGRAD_F4X3::OutputTileSize) {
+        MlasExecuteThreaded(MlasConvWinogradThreaded<MLAS_WINOGRAD_F4X3>, &WorkBlock,
+            Parameters->ThreadCount, ThreadPool);
+    } else {
+        MlasExecuteThreaded(MlasConvWinogradThreaded<MLAS_WINOGRAD_F2X3>, &WorkBlock,
+            Parameters->ThreadCount, ThreadPool);
+    }
+
+    //
+    // The bias has been applied by the output transform, so only apply the
+    // activation.
+    //
+
+    if (Parameters->Activation->ActivationKind != MlasIdentityActivation) {
+
+        const size_t FilterCount = Parameters->BatchCount * Parameters->GroupCount * Parameters->FilterCount;
+
+        MlasActivation(Parameters->Activation, Output, nullptr, FilterCount,
+            Parameters->OutputSize, Parameters->OutputSize);
+    }
+}
+
+size_t
+MLASCALL
+MlasConvWinogradPackFilterSize(
+    size_t OutputTileSize,
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of elements required to store a filter
+    transformed by MlasConvWinogradPackFilter.
+
+Arguments:
+
+    OutputTileSize - Supplies the output tile size (2 or 4).
+
+    GroupCount - Supplies the number of channel groups.
+
+    FilterCount - Supplies the number of filters per group.
+
+    InputChannels - Supplies the number of input channels per group.
+
+Return Value:
+
+    Returns the number of elements of the packed filter.
+
+--*/
+{
+    const size_t TileSize = OutputTileSize + 2;
+
+    return TileSize * TileSize * GroupCount * FilterCount * InputChannels;
+}
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t OutputTileSize,
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels,
+    const float* Filter,
+    float* PackedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a 3x3 filter tensor to the Winograd domain for
+    the specified output tile size.
+
+Arguments:
+
+    OutputTileSize - Supplies the output tile size (2 or 4).
+
+    GroupCount - Supplies the number of channel groups.
+
+    FilterCount - Supplies the number of filters per group.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    Filter - Supplies the filter tensor.
+
+    PackedFilter - Supplies the buffer to receive the transformed filter,
+        sized to the number of elements returned by
+        MlasConvWinogradPackFilterSize.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (OutputTileSize == MLAS_WINOGRAD_F4X3::OutputTileSize) {
+        MlasConvWinogradPackFilterKernel<MLAS_WINOGRAD_F4X3>(GroupCount, FilterCount,
+            InputChannels, Filter, PackedFilter);
+    } else {
+        MlasConvWinogradPackFilterKernel<MLAS_WINOGRAD_F2X3>(GroupCount, FilterCount,
+            InputChannels, Filter, PackedFilter);
+    }
+}
+
+bool
+MLASCALL
+MlasConvWinogradUsePackedFilter(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t OutputTileSize,
+    const float* PackedFilter,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine updates the parameters of a convolution operation prepared
+    by MlasConvPrepare to use the Winograd algorithm with a filter transformed
+    ahead of time by MlasConvWinogradPackFilter.
+
+    Without the cost of transforming the filter on every call, the Winograd
+    algorithm is suitable for more convolutions than MlasConvPrepare selects
+    it for.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    OutputTileSize - Supplies the output tile size used to pack the filter.
+
+    PackedFilter - Supplies the packed filter.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer if the packed filter is used.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    Returns true if the packed filter is used, else false if the parameters
+    are unchanged because the Winograd algorithm with the output tile size is
+    not suitable for the convolution.
+
+--*/
+{
+    if (!MlasConvWinogradIsSupported(Parameters, OutputTileSize)) {
+        return false;
+    }
+
+    MlasConvWinogradPrepare(Parameters, OutputTileSize, PackedFilter, WorkingBufferSize, ThreadPool);
+
+    return true;
+}
@@ -0,0 +1,253 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include "core/optimizer/elementwise_fusion.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+struct ElementwiseOpInfo {
+  bool binary;
+  std::vector<ONNX_NAMESPACE::OperatorSetVersion> versions;
+};
+
+// The operators implemented by the FusedElementwise kernel.
+const ElementwiseOpInfo* GetElementwiseOpInfo(const Node& node) {
+  static const std::unordered_map<std::string, ElementwiseOpInfo> ops = {
+      {"Add", {true, {7, 13, 14}}},
+      {"Sub", {true, {7, 13, 14}}},
+      {"Mul", {true, {7, 13, 14}}},
+      {"Div", {true, {7, 13, 14}}},
+      {"Pow", {true, {7, 12, 13, 15}}},
+      {"Max", {true, {8, 12, 13}}},
+      {"Min", {true, {8, 12, 13}}},
+      {"Abs", {false, {6, 13}}},
+      {"Erf", {false, {9, 13}}},
+      {"Exp", {false, {6, 13}}},
+      {"Log", {false, {6, 13}}},
+      {"Neg", {false, {6, 13}}},
+      {"Reciprocal", {false, {6, 13}}},
+      {"Relu", {false, {6, 13, 14}}},
+      {"Sigmoid", {false, {6, 13}}},
+      {"Sqrt", {false, {6, 13}}},
+      {"Tanh", {false, {6, 13}}},
+  };
+
+  auto it = ops.find(node.OpType());
+  if (it == ops.end() ||
+      !graph_utils::MatchesOpSetDomain(node, kOnnxDomain) ||
+      !graph_utils::MatchesOpSinceVersion(node, it->second.versions)) {
+    return nullptr;
+  }
+  // Max and Min are variadic, so only the two input form is fused.
+  if (node.InputDefs().size() != (it->second.binary ? 2u : 1u)) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+bool IsFloatTensor(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  return type != nullptr && type->has_tensor_type() &&
+         type->tensor_type().elem_type() == TensorProto_DataType_FLOAT;
+}
+
+bool SameDim(const TensorShapeProto_Dimension& a, const TensorShapeProto_Dimension& b) {
+  if (utils::HasDimValue(a) && utils::HasDimValue(b)) {
+    return a.dim_value() == b.dim_value();
+  }
+  return utils::HasDimParam(a) && utils::HasDimParam(b) && a.dim_param() == b.dim_param();
+}
+
+// Returns true if the operand broadcasts to the shape without changing it, the form supported by the
+// FusedElementwise kernel: the operand has at most the rank of the shape, and after removing its leading
+// dimensions of size 1 it has the trailing dimensions of the shape. An operand of a higher rank would
+// add leading dimensions to the result, which the fused node, taking the shape of its first input, can't.
+bool BroadcastsTo(const NodeArg& operand, const TensorShapeProto& shape) {
+  const auto* operand_shape = operand.Shape();
+  if (operand_shape == nullptr || !IsFloatTensor(operand) || operand_shape->dim_size() > shape.dim_size()) {
+    return false;
+  }
+
+  int leading_ones = 0;
+  while (leading_ones < operand_shape->dim_size() &&
+         utils::HasDimValue(operand_shape->dim(leading_ones)) &&
+         operand_shape->dim(leading_ones).dim_value() == 1) {
+    leading_ones++;
+  }
+
+  const int trailing_rank = operand_shape->dim_size() - leading_ones;
+  if (trailing_rank > shape.dim_size()) {
+    return false;
+  }
+  for (int i = 0; i < trailing_rank; ++i) {
+    if (!SameDim(operand_shape->dim(leading_ones + i), shape.dim(shape.dim_size() - trailing_rank + i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsConvNode(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Conv", {1, 11}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "FusedConv", {1}, kMSDomain);
+}
+
+// Returns true if the node may later be folded into a convolution by the layout transformers, which
+// run at Level3: an Add or Sum of a convolution output becomes the Sum input of the NCHWc Conv, and
+// an activation of the convolution (or of that Add) becomes its fused activation. Such nodes are left
+// for those transformers, since the fused convolution avoids the extra pass over the output entirely.
+bool IsConvFusionCandidate(const Node& node) {
+  for (auto it = node.InputNodesBegin(); it != node.InputNodesEnd(); ++it) {
+    const Node& producer = *it;
+    if (IsConvNode(producer)) {
+      return true;
+    }
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13, 14}) ||
+        graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6, 13}) ||
+        graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13})) {
+      if (graph_utils::IsSupportedOptypeVersionAndDomain(producer, "Add", {7, 13, 14})) {
+        for (auto add_it = producer.InputNodesBegin(); add_it != producer.InputNodesEnd(); ++add_it) {
+          if (IsConvNode(*add_it)) {
+            return true;
+          }
+        }
+      }
+    }
+  }
+  return false;
+}
+
+struct ChainStep {
+  Node* node;
+  // The input of the node that is the running result of the chain.
+  int main_input;
+};
+
+}  // namespace
+
+Status ElementwiseFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    const auto* op_info = GetElementwiseOpInfo(node);
+    if (op_info == nullptr ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) ||
+        IsConvFusionCandidate(node)) {
+      continue;
+    }
+
+    // The first node determines the shape of the chain: it is the shape of the main input, to which
+    // the other operands broadcast.
+    int main_input = -1;
+    for (int i = 0; i < static_cast<int>(node.InputDefs().size()) && main_input < 0; ++i) {
+      const auto* arg = node.InputDefs()[i];
+      if (arg->Shape() == nullptr || !IsFloatTensor(*arg)) {
+        continue;
+      }
+      if (!op_info->binary || BroadcastsTo(*node.InputDefs()[1 - i], *arg->Shape())) {
+        main_input = i;
+      }
+    }
+    if (main_input < 0) {
+      continue;
+    }
+
+    NodeArg* chain_input = node.MutableInputDefs()[main_input];
+    const TensorShapeProto& chain_shape = *chain_input->Shape();
+
+    std::vector<ChainStep> chain{{&node, main_input}};
+    while (true) {
+      Node& last = *chain.back().node;
+      if (!optimizer_utils::CheckOutputEdges(graph, last, 1)) {
+        break;
+      }
+
+      const auto edge = last.OutputEdgesBegin();
+      Node& next = *graph.GetNode(edge->GetNode().Index());
+      const auto* next_info = GetElementwiseOpInfo(next);
+      if (next_info == nullptr || next.GetExecutionProviderType() != node.GetExecutionProviderType() ||
+          IsConvFusionCandidate(next)) {
+        break;
+      }
+
+      const int next_main_input = edge->GetDstArgIndex();
+      if (next_info->binary && !BroadcastsTo(*next.InputDefs()[1 - next_main_input], chain_shape)) {
+        break;
+      }
+      chain.push_back({&next, next_main_input});
+    }
+
+    if (chain.size() < 2) {
+      continue;
+    }
+
+    // Build the inputs and the attributes of the fused node. The operands are deduplicated, and
+    // an operand that is the chain input refers to input 0.
+    std::vector<NodeArg*> inputs{chain_input};
+    std::vector<std::string> operators;
+    std::vector<int64_t> operands;
+    std::vector<int64_t> swap_operands;
+    for (const auto& step : chain) {
+      operators.push_back(step.node->OpType());
+      int64_t operand = -1;
+      int64_t swap = 0;
+      if (step.node->InputDefs().size() == 2) {
+        NodeArg* operand_arg = step.node->MutableInputDefs()[1 - step.main_input];
+        auto it = std::find(inputs.begin(), inputs.end(), operand_arg);
+        if (it == inputs.end()) {
+          it = inputs.insert(inputs.end(), operand_arg);
+        }
+        operand = static_cast<int64_t>(it - inputs.begin());
+        swap = step.main_input == 1 ? 1 : 0;
+      }
+      operands.push_back(operand);
+      swap_operands.push_back(swap);
+    }
+
+    Node& last_node = *chain.back().node;
+    std::vector<NodeArg*> outputs = last_node.MutableOutputDefs();
+    const auto provider = node.GetExecutionProviderType();
+    const std::string fused_node_name = graph.GenerateNodeName("FusedElementwise");
+
+    // Remove the chain before adding the fused node so that the output is only produced once. The
+    // edges to and from the fused node are created when the graph is resolved.
+    for (auto& step : chain) {
+      graph_utils::RemoveNodeOutputEdges(graph, *step.node);
+      graph.RemoveNode(step.node->Index());
+    }
+
+    Node& fused_node = graph.AddNode(fused_node_name,
+                                     "FusedElementwise",
+                                     "fused elementwise operators",
+                                     inputs,
+                                     outputs,
+                                     nullptr,
+                                     kMSDomain);
+    fused_node.AddAttribute("operators", operators);
+    fused_node.AddAttribute("operands", operands);
+    fused_node.AddAttribute("swap_operands", swap_operands);
+    fused_node.SetExecutionProviderType(provider);
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -3,6 +3,11 @@
 
 #include "core/optimizer/graph_transformer.h"
 
+#include <memory>
+#include <vector>
+
+#include "core/platform/threadpool.h"
+
 using namespace ::onnxruntime::common;
 
 namespace onnxruntime {
@@ -29,4 +34,37 @@ Status GraphTransformer::Apply(Graph& graph, bool& modified, const logging::Logg
   return status;
 }
 
+Status GraphTransformer::RecurseInParallel(Node& node, bool& modified, int subgraph_level,
+                                           const logging::Logger& logger) const {
+  std::vector<Graph*> subgraphs;
+  for (auto& entry : node.GetAttributeNameToMutableSubgraphMap()) {
+    subgraphs.push_back(entry.second);
+  }
+
+  // The subgraphs of a node are independent of each other, and ApplyImpl only modifies the graph it is called with.
+  const auto num_subgraphs = subgraphs.size();
+  std::vector<Status> statuses(num_subgraphs);
+  std::unique_ptr<bool[]> subgraph_modified(new bool[num_subgraphs]());
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool_, static_cast<std::ptrdiff_t>(num_subgraphs),
+      [&](std::ptrdiff_t i) {
+        ORT_TRY {
+          statuses[i] = ApplyImpl(*subgraphs[i], subgraph_modified[i], subgraph_level, logger);
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            statuses[i] = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Transforming subgraph of node ", node.Name(),
+                                          " failed: ", ex.what());
+          });
+        }
+      });
+
+  for (size_t i = 0; i < num_subgraphs; ++i) {
+    ORT_RETURN_IF_ERROR(statuses[i]);
+    modified = modified || subgraph_modified[i];
+  }
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
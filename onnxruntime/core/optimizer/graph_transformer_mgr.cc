@@ -32,8 +32,22 @@ common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, Transfor
         continue;
 
       bool modified = false;
+      const TimePoint start_time = std::chrono::high_resolution_clock::now();
       ORT_RETURN_IF_ERROR(transformer->Apply(graph, modified, logger));
       graph_changed = graph_changed || modified;
+
+      // The time includes resolving the graph if it was modified.
+      LOGS(logger, VERBOSE) << "Transformer " << transformer->Name() << " took "
+                            << std::chrono::duration_cast<std::chrono::microseconds>(
+                                   std::chrono::high_resolution_clock::now() - start_time)
+                                   .count()
+                            << " us in step " << step << (modified ? " and modified the graph" : "");
+      if (profiler_ != nullptr && profiler_->IsEnabled()) {
+        profiler_->EndTimeAndRecordEvent(profiling::SESSION_EVENT, transformer->Name(), start_time,
+                                         {{"level", std::to_string(static_cast<int>(level))},
+                                          {"step", std::to_string(step)},
+                                          {"modified", modified ? "1" : "0"}});
+      }
     }
     if (!graph_changed) {
       break;
@@ -43,12 +57,22 @@ common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, Transfor
   return Status::OK();
 }
 
+void GraphTransformerManager::SetThreadPool(concurrency::ThreadPool* thread_pool) {
+  thread_pool_ = thread_pool;
+  for (auto& entry : level_to_transformer_map_) {
+    for (auto& transformer : entry.second) {
+      transformer->SetThreadPool(thread_pool);
+    }
+  }
+}
+
 common::Status GraphTransformerManager::Register(std::unique_ptr<GraphTransformer> transformer, TransformerLevel level) {
   const auto& name = transformer->Name();
   if (transformers_info_.find(name) != transformers_info_.end()) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "This transformer is already registered " + name);
   }
 
+  transformer->SetThreadPool(thread_pool_);
   transformers_info_[name] = transformer.get();
   level_to_transformer_map_[level].push_back(std::move(transformer));
   return Status::OK();
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/common/logging/logging.h"
+#include "core/common/profiler.h"
 #include "core/optimizer/graph_transformer.h"
 #include "core/optimizer/constant_folding.h"
 #include "core/optimizer/rewrite_rule.h"
@@ -29,6 +30,14 @@ class GraphTransformerManager {
   // Apply all transformers registered for the given level on the given graph
   common::Status ApplyTransformers(Graph& graph, TransformerLevel level, const logging::Logger& logger) const;
 
+  // Set the thread pool the transformers use to transform the subgraphs of a node in parallel
+  void SetThreadPool(concurrency::ThreadPool* thread_pool);
+
+  // Set the profiler that records the time taken by each transformer if profiling is enabled
+  void SetProfiler(profiling::Profiler* profiler) noexcept {
+    profiler_ = profiler;
+  }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(GraphTransformerManager);
 
@@ -45,6 +54,9 @@ class GraphTransformerManager {
   // maximum number of graph transformation steps
   unsigned steps_;
 
+  concurrency::ThreadPool* thread_pool_ = nullptr;
+  profiling::Profiler* profiler_ = nullptr;
+
   std::unordered_map<TransformerLevel, std::vector<std::unique_ptr<GraphTransformer>>, EnumHashKey> level_to_transformer_map_;
   std::unordered_map<std::string, GraphTransformer*> transformers_info_;
 };
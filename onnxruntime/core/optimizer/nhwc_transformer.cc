@@ -62,7 +62,7 @@ class NhwcTransformerImpl {
   size_t RemoveOutputEdge(Node& node, size_t output_index);
   void CreateNhwcArgument(Node& node, Node& nhwc_node, int rank, size_t output_index);
   void CreateNhwcArgument(Node& node, Node& nhwc_node, int rank);
-  void InsertReorderInput(Node& node, int rank);
+  void InsertReorderInput(Node& node, size_t input_index, int rank);
 
   void TransformQLinearConv(Node& node);
   void TransformQLinearBinary(Node& node);
@@ -123,9 +123,9 @@ void NhwcTransformerImpl::CreateNhwcArgument(Node& node, Node& nhwc_node, int ra
   }
 }
 
-void NhwcTransformerImpl::InsertReorderInput(Node& node, int rank) {
+void NhwcTransformerImpl::InsertReorderInput(Node& node, size_t input_index, int rank) {
   auto& input_defs = node.MutableInputDefs();
-  auto* input_original_arg = input_defs[0];
+  auto* input_original_arg = input_defs[input_index];
 
   auto it = reorder_inputs_.find(input_original_arg);
   if (it == reorder_inputs_.end()) {
@@ -148,9 +148,9 @@ void NhwcTransformerImpl::InsertReorderInput(Node& node, int rank) {
     }
     reorder_input_node.AddAttribute("perm", perm);
 
-    input_defs[0] = input_nhwc_arg;
+    input_defs[input_index] = input_nhwc_arg;
   } else {
-    input_defs[0] = it->second;
+    input_defs[input_index] = it->second;
   }
 }
 
@@ -190,7 +190,7 @@ void NhwcTransformerImpl::TransformQLinearConv(Node& node) {
   nhwc_node.AddAttribute("channels_last", static_cast<int64_t>(1));
 
   if (nhwc_input == nullptr) {
-    InsertReorderInput(nhwc_node, weights_shape->dim_size());
+    InsertReorderInput(nhwc_node, 0, weights_shape->dim_size());
   } else {
     nhwc_node.MutableInputDefs()[0] = nhwc_input->nhwc_arg_;
     nhwc_input->remaining_original_uses_--;
@@ -218,18 +218,33 @@ void NhwcTransformerImpl::TransformQLinearBinary(Node& node) {
 
   auto* nhwc_input_a = LookupNhwcArgument(input_def_a);
   auto* nhwc_input_b = LookupNhwcArgument(input_def_b);
-  if (nhwc_input_a == nullptr || nhwc_input_b == nullptr) {
+  if (nhwc_input_a == nullptr && nhwc_input_b == nullptr) {
     return;
   }
 
   // Update the node to directly use the NHWC inputs and decrement the original
   // use counts of the NHWC inputs.
-  input_defs[0] = nhwc_input_a->nhwc_arg_;
-  nhwc_input_a->remaining_original_uses_--;
-  input_defs[3] = nhwc_input_b->nhwc_arg_;
-  nhwc_input_b->remaining_original_uses_--;
+  //
+  // If only one input is available in NHWC format, reorder the other input
+  // instead of reordering the NHWC input back to NCHW. This keeps the chain of
+  // quantized operators in NHWC format, so that the output does not need to
+  // be reordered again for the next NHWC consumer. This also handles the
+  // common case of a per-channel constant, such as a {1,C,1,1} tensor.
+  const int rank = input_shape_a->dim_size();
+  if (nhwc_input_a != nullptr) {
+    input_defs[0] = nhwc_input_a->nhwc_arg_;
+    nhwc_input_a->remaining_original_uses_--;
+  } else {
+    InsertReorderInput(node, 0, rank);
+  }
+  if (nhwc_input_b != nullptr) {
+    input_defs[3] = nhwc_input_b->nhwc_arg_;
+    nhwc_input_b->remaining_original_uses_--;
+  } else {
+    InsertReorderInput(node, 3, rank);
+  }
 
-  CreateNhwcArgument(node, node, nhwc_input_a->rank_);
+  CreateNhwcArgument(node, node, rank);
 }
 
 void NhwcTransformerImpl::TransformQLinearActivation(Node& node) {
@@ -83,6 +83,14 @@ class OptimizerExecutionFrame final : public IExecutionFrame {
                           const std::vector<int>& fetch_mlvalue_idxs,
                           const std::vector<OrtValue>& fetches = {});
 
+  // Creates a frame whose inputs are fed rather than taken from the initializers of info, so that the kernels
+  // created with info can be run with different inputs.
+  OptimizerExecutionFrame(const Info& info,
+                          const std::vector<int>& feed_mlvalue_idxs,
+                          const std::vector<OrtValue>& feeds,
+                          const std::vector<int>& fetch_mlvalue_idxs,
+                          const std::vector<OrtValue>& fetches);
+
   ~OptimizerExecutionFrame() override = default;
 
  private:
@@ -22,6 +22,10 @@ class PropagateCastOps : public GraphTransformer {
 
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 
+ protected:
+  // ApplyImpl resolves the graph, which starts from the main graph.
+  bool CanTransformSubgraphsInParallel() const override { return false; }
+
  private:
   size_t level_;
   GraphTransformerConfiguration::PropagateCastOpsConfiguration::Strategy strategy_;
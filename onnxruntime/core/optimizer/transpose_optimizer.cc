@@ -0,0 +1,925 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cstring>
+#include <deque>
+#include <map>
+#include <numeric>
+#include <unordered_set>
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/transpose_optimizer.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+// Permutations follow the convention of the Transpose operator: for x = Transpose(y, perm),
+// dimension i of x is dimension perm[i] of y.
+namespace {
+
+bool IsIdentityPerm(const std::vector<int64_t>& perm) {
+  for (size_t i = 0; i < perm.size(); ++i) {
+    if (perm[i] != static_cast<int64_t>(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsValidPerm(const std::vector<int64_t>& perm) {
+  std::vector<bool> seen(perm.size(), false);
+  for (auto axis : perm) {
+    if (axis < 0 || axis >= static_cast<int64_t>(perm.size()) || seen[static_cast<size_t>(axis)]) {
+      return false;
+    }
+    seen[static_cast<size_t>(axis)] = true;
+  }
+  return true;
+}
+
+std::vector<int64_t> InvertPerm(const std::vector<int64_t>& perm) {
+  std::vector<int64_t> inverse(perm.size());
+  for (size_t i = 0; i < perm.size(); ++i) {
+    inverse[static_cast<size_t>(perm[i])] = static_cast<int64_t>(i);
+  }
+  return inverse;
+}
+
+// Returns the permutation equivalent to Transpose(Transpose(y, first), second).
+std::vector<int64_t> ComposePerm(const std::vector<int64_t>& first, const std::vector<int64_t>& second) {
+  std::vector<int64_t> composed(second.size());
+  for (size_t i = 0; i < second.size(); ++i) {
+    composed[i] = first[static_cast<size_t>(second[i])];
+  }
+  return composed;
+}
+
+bool NormalizeAxis(int64_t& axis, int64_t rank) {
+  if (axis < -rank || axis >= rank) {
+    return false;
+  }
+  if (axis < 0) {
+    axis += rank;
+  }
+  return true;
+}
+
+bool NormalizeAxes(std::vector<int64_t>& axes, int64_t rank) {
+  std::vector<bool> seen(static_cast<size_t>(rank), false);
+  for (auto& axis : axes) {
+    if (!NormalizeAxis(axis, rank) || seen[static_cast<size_t>(axis)]) {
+      return false;
+    }
+    seen[static_cast<size_t>(axis)] = true;
+  }
+  return true;
+}
+
+// Maps axes of the transposed tensor to the axes of the source tensor.
+std::vector<int64_t> PermuteAxes(const std::vector<int64_t>& axes, const std::vector<int64_t>& perm) {
+  std::vector<int64_t> source_axes;
+  source_axes.reserve(axes.size());
+  for (auto axis : axes) {
+    source_axes.push_back(perm[static_cast<size_t>(axis)]);
+  }
+  return source_axes;
+}
+
+// Returns the permutation of the output of an operator that removes the given (normalized) axes
+// from an input transposed with perm, such as Squeeze or a reduction with keepdims=0.
+std::vector<int64_t> RemoveAxesFromPerm(const std::vector<int64_t>& perm, const std::vector<int64_t>& axes) {
+  const size_t rank = perm.size();
+  std::vector<bool> removed(rank, false);
+  std::vector<bool> removed_source(rank, false);
+  for (auto axis : axes) {
+    removed[static_cast<size_t>(axis)] = true;
+    removed_source[static_cast<size_t>(perm[static_cast<size_t>(axis)])] = true;
+  }
+
+  // Index of each remaining source axis once the removed axes are dropped.
+  std::vector<int64_t> source_index(rank, -1);
+  int64_t next_index = 0;
+  for (size_t i = 0; i < rank; ++i) {
+    if (!removed_source[i]) {
+      source_index[i] = next_index++;
+    }
+  }
+
+  std::vector<int64_t> result;
+  for (size_t i = 0; i < rank; ++i) {
+    if (!removed[i]) {
+      result.push_back(source_index[static_cast<size_t>(perm[i])]);
+    }
+  }
+  return result;
+}
+
+// Returns the permutation of the output of Unsqueeze with the given (normalized) axes, when both the
+// input transposed with perm and its source are unsqueezed at these axes.
+std::vector<int64_t> InsertAxesIntoPerm(const std::vector<int64_t>& perm, const std::vector<int64_t>& axes) {
+  const size_t rank = perm.size() + axes.size();
+  std::vector<bool> inserted(rank, false);
+  for (auto axis : axes) {
+    inserted[static_cast<size_t>(axis)] = true;
+  }
+
+  // Output position of each input axis.
+  std::vector<int64_t> positions;
+  for (size_t i = 0; i < rank; ++i) {
+    if (!inserted[i]) {
+      positions.push_back(static_cast<int64_t>(i));
+    }
+  }
+
+  std::vector<int64_t> result(rank);
+  for (size_t i = 0; i < rank; ++i) {
+    result[i] = static_cast<int64_t>(i);
+  }
+  for (size_t i = 0; i < perm.size(); ++i) {
+    result[static_cast<size_t>(positions[i])] = positions[static_cast<size_t>(perm[i])];
+  }
+  return result;
+}
+
+// Copies the elements of a tensor with the given dimensions into the layout of Transpose(input, perm).
+void TransposeData(const uint8_t* input, uint8_t* output, const std::vector<int64_t>& dims,
+                   const std::vector<int64_t>& perm, size_t element_size) {
+  const size_t rank = dims.size();
+  std::vector<size_t> input_strides(rank);
+  size_t stride = element_size;
+  size_t element_count = 1;
+  for (size_t i = rank; i-- > 0;) {
+    input_strides[i] = stride;
+    stride *= static_cast<size_t>(dims[i]);
+    element_count *= static_cast<size_t>(dims[i]);
+  }
+
+  std::vector<int64_t> output_dims(rank);
+  for (size_t i = 0; i < rank; ++i) {
+    output_dims[i] = dims[static_cast<size_t>(perm[i])];
+  }
+
+  std::vector<int64_t> index(rank, 0);
+  for (size_t n = 0; n < element_count; ++n) {
+    size_t offset = 0;
+    for (size_t i = 0; i < rank; ++i) {
+      offset += static_cast<size_t>(index[i]) * input_strides[static_cast<size_t>(perm[i])];
+    }
+    std::memcpy(output, input + offset, element_size);
+    output += element_size;
+
+    for (size_t i = rank; i-- > 0;) {
+      if (++index[i] < output_dims[i]) {
+        break;
+      }
+      index[i] = 0;
+    }
+  }
+}
+
+bool IsTransposableInitializer(const TensorProto& tensor, size_t rank) {
+  switch (tensor.data_type()) {
+    case TensorProto_DataType_UNDEFINED:
+    case TensorProto_DataType_STRING:
+    case TensorProto_DataType_COMPLEX64:
+    case TensorProto_DataType_COMPLEX128:
+      return false;
+    default:
+      return static_cast<size_t>(tensor.dims_size()) <= rank;
+  }
+}
+
+}  // namespace
+
+class TransposeOptimizerImpl {
+ public:
+  // When apply is false, the graph is not modified and the nodes are only processed to find out
+  // whether pushing the Transpose nodes would reduce their number.
+  TransposeOptimizerImpl(Graph& graph, bool apply) noexcept : graph_(graph), apply_(apply) {}
+
+  Status Process(Node& node);
+  bool ReducesTransposeCount() const;
+  void Finalize(bool& modified);
+
+ private:
+  // Tracks a tensor that is equal to Transpose(source_arg_, perm_).
+  struct TransposedArgument {
+    // The Transpose node producing the tensor, or null if the producing node has been pushed below
+    // or merged, in which case Finalize creates a Transpose node for any remaining uses.
+    Node* transpose_node_;
+    NodeArg* output_arg_;
+    // Null when the graph is not being modified and the source would be a new NodeArg.
+    NodeArg* source_arg_;
+    std::vector<int64_t> perm_;
+    size_t remaining_original_uses_;
+  };
+
+  TransposedArgument* LookupTransposedArgument(const NodeArg* arg) {
+    auto it = transposed_arg_map_.find(arg);
+    return (it != transposed_arg_map_.end()) ? it->second : nullptr;
+  }
+
+  void CreateTransposedArgument(Node* transpose_node, NodeArg* output_arg, NodeArg* source_arg,
+                                std::vector<int64_t> perm, size_t uses);
+  size_t CountOutputUses(Node& node, size_t output_index);
+  void UseSource(Node& node, size_t input_index, TransposedArgument& transposed_arg);
+  bool CanPushInput(const NodeArg* arg, const std::vector<int64_t>& perm);
+  Status TransposeInitializer(NodeArg& arg, const std::vector<int64_t>& perm, NodeArg*& transposed_arg);
+  Status PushTranspose(Node& node, const std::vector<size_t>& data_inputs,
+                       const std::vector<std::vector<int64_t>>& output_perms);
+  const std::vector<int64_t>* FindInputPerm(const Node& node, const std::vector<size_t>& data_inputs);
+  const TensorProto* GetConstantInput(const Node& node, size_t input_index) const;
+  NodeArg& AddInt64Initializer(const std::string& name, const std::vector<int64_t>& values);
+
+  void ProcessTranspose(Node& node);
+  Status ProcessElementwise(Node& node, bool broadcast);
+  Status ProcessQuantizeLinear(Node& node);
+  Status ProcessConcat(Node& node);
+  Status ProcessSplit(Node& node);
+  Status ProcessSoftmax(Node& node);
+  Status ProcessReduce(Node& node);
+  Status ProcessSqueeze(Node& node);
+  Status ProcessUnsqueeze(Node& node);
+  Status ProcessPad(Node& node);
+
+  Graph& graph_;
+  const bool apply_;
+
+  // Stores the transposed arguments in creation order, which is the order Finalize creates the
+  // Transpose nodes in, and a mapping from the tensors to their transposed arguments.
+  std::vector<std::unique_ptr<TransposedArgument>> transposed_args_;
+  std::unordered_map<const NodeArg*, TransposedArgument*> transposed_arg_map_;
+
+  // Stores the initializers transposed by this transform, so that nodes can share them.
+  std::map<std::pair<const NodeArg*, std::vector<int64_t>>, NodeArg*> transposed_initializers_;
+
+  // Stores a queue of nodes to be removed after walking through the graph.
+  std::deque<NodeIndex> removed_nodes_;
+
+  size_t original_transpose_count_ = 0;
+  size_t pushed_node_count_ = 0;
+};
+
+void TransposeOptimizerImpl::CreateTransposedArgument(Node* transpose_node, NodeArg* output_arg, NodeArg* source_arg,
+                                                      std::vector<int64_t> perm, size_t uses) {
+  transposed_args_.push_back(std::make_unique<TransposedArgument>(
+      TransposedArgument{transpose_node, output_arg, source_arg, std::move(perm), uses}));
+  transposed_arg_map_[output_arg] = transposed_args_.back().get();
+}
+
+// Returns the number of uses of the node output, including its use as a graph output. The output
+// edges are removed when the graph is modified, and are rebuilt for the uses left by Finalize when
+// the graph is resolved.
+size_t TransposeOptimizerImpl::CountOutputUses(Node& node, size_t output_index) {
+  size_t uses = 0;
+  if (apply_) {
+    uses = graph_utils::RemoveNodeOutputEdges(graph_, node, static_cast<int>(output_index));
+  } else {
+    for (auto it = node.OutputEdgesBegin(), end = node.OutputEdgesEnd(); it != end; ++it) {
+      if (it->GetSrcArgIndex() == static_cast<int>(output_index)) {
+        uses++;
+      }
+    }
+  }
+
+  for (auto idx : graph_.GetNodeOutputsInGraphOutputs(node)) {
+    if (idx == static_cast<int>(output_index)) {
+      uses++;
+      break;
+    }
+  }
+  return uses;
+}
+
+void TransposeOptimizerImpl::UseSource(Node& node, size_t input_index, TransposedArgument& transposed_arg) {
+  if (apply_) {
+    node.MutableInputDefs()[input_index] = transposed_arg.source_arg_;
+  }
+  transposed_arg.remaining_original_uses_--;
+}
+
+const TensorProto* TransposeOptimizerImpl::GetConstantInput(const Node& node, size_t input_index) const {
+  const auto& input_defs = node.InputDefs();
+  if (input_index >= input_defs.size() || !input_defs[input_index]->Exists()) {
+    return nullptr;
+  }
+  return graph_utils::GetConstantInitializer(graph_, input_defs[input_index]->Name());
+}
+
+NodeArg& TransposeOptimizerImpl::AddInt64Initializer(const std::string& name, const std::vector<int64_t>& values) {
+  TensorProto tensor;
+  tensor.set_name(graph_.GenerateNodeArgName(name));
+  tensor.set_data_type(TensorProto_DataType_INT64);
+  tensor.add_dims(static_cast<int64_t>(values.size()));
+  tensor.set_raw_data(values.data(), values.size() * sizeof(int64_t));
+  return graph_utils::AddInitializer(graph_, tensor);
+}
+
+// Returns true if the input can be replaced by a tensor in the layout of the source of a Transpose
+// with the given permutation: either the input is tracked with the same permutation, or it is a
+// constant that can be transposed with the inverse permutation.
+bool TransposeOptimizerImpl::CanPushInput(const NodeArg* arg, const std::vector<int64_t>& perm) {
+  auto* transposed_arg = LookupTransposedArgument(arg);
+  if (transposed_arg != nullptr) {
+    return transposed_arg->perm_ == perm;
+  }
+  const auto* tensor = graph_utils::GetConstantInitializer(graph_, arg->Name());
+  return tensor != nullptr && IsTransposableInitializer(*tensor, perm.size());
+}
+
+// Returns Transpose(arg, perm) for a constant initializer. Initializers with a lower rank are first
+// unsqueezed to the rank of perm, following the broadcasting rules.
+Status TransposeOptimizerImpl::TransposeInitializer(NodeArg& arg, const std::vector<int64_t>& perm,
+                                                   NodeArg*& transposed_arg) {
+  auto key = std::make_pair(static_cast<const NodeArg*>(&arg), perm);
+  auto it = transposed_initializers_.find(key);
+  if (it != transposed_initializers_.end()) {
+    transposed_arg = it->second;
+    return Status::OK();
+  }
+
+  const auto* tensor = graph_utils::GetConstantInitializer(graph_, arg.Name());
+  std::vector<int64_t> dims(tensor->dims().begin(), tensor->dims().end());
+  int64_t element_count = 1;
+  for (auto dim : dims) {
+    element_count *= dim;
+  }
+
+  // A scalar or a tensor with a single element broadcasts the same way in any layout.
+  NodeArg* result = &arg;
+  if (element_count > 1) {
+    dims.insert(dims.begin(), perm.size() - dims.size(), 1);
+
+    std::unique_ptr<unsigned char[]> data;
+    size_t data_size = 0;
+    ORT_RETURN_IF_ERROR(utils::UnpackInitializerData(*tensor, graph_.ModelPath(), data, data_size));
+
+    TensorProto transposed;
+    transposed.set_name(graph_.GenerateNodeArgName(arg.Name() + "_transposed"));
+    transposed.set_data_type(tensor->data_type());
+    for (auto axis : perm) {
+      transposed.add_dims(dims[static_cast<size_t>(axis)]);
+    }
+    std::string transposed_data(data_size, '\0');
+    TransposeData(data.get(), reinterpret_cast<uint8_t*>(&transposed_data[0]), dims, perm,
+                  data_size / static_cast<size_t>(element_count));
+    transposed.set_raw_data(std::move(transposed_data));
+    result = &graph_utils::AddInitializer(graph_, transposed);
+  }
+
+  transposed_initializers_[key] = result;
+  transposed_arg = result;
+  return Status::OK();
+}
+
+// Returns the permutation of the first tracked data input of the node, or null if none is tracked.
+const std::vector<int64_t>* TransposeOptimizerImpl::FindInputPerm(const Node& node,
+                                                                  const std::vector<size_t>& data_inputs) {
+  const auto& input_defs = node.InputDefs();
+  for (auto input_index : data_inputs) {
+    auto* transposed_arg = LookupTransposedArgument(input_defs[input_index]);
+    if (transposed_arg != nullptr) {
+      return &transposed_arg->perm_;
+    }
+  }
+  return nullptr;
+}
+
+// Moves the Transpose nodes of the data inputs below the node: the data inputs are replaced by the
+// sources of their Transpose nodes, and output i of the node becomes Transpose(new_output_i,
+// output_perms[i]). The caller must have updated any attributes or inputs that depend on the layout.
+Status TransposeOptimizerImpl::PushTranspose(Node& node, const std::vector<size_t>& data_inputs,
+                                             const std::vector<std::vector<int64_t>>& output_perms) {
+  const auto& input_defs = node.InputDefs();
+  const auto* perm = FindInputPerm(node, data_inputs);
+  if (perm == nullptr) {
+    return Status::OK();
+  }
+  const std::vector<int64_t> input_perm = *perm;
+  for (auto input_index : data_inputs) {
+    if (!CanPushInput(input_defs[input_index], input_perm)) {
+      return Status::OK();
+    }
+  }
+
+  const auto inverse_perm = InvertPerm(input_perm);
+  for (auto input_index : data_inputs) {
+    auto* transposed_arg = LookupTransposedArgument(input_defs[input_index]);
+    if (transposed_arg != nullptr) {
+      UseSource(node, input_index, *transposed_arg);
+    } else if (apply_) {
+      auto& input_def = node.MutableInputDefs()[input_index];
+      ORT_RETURN_IF_ERROR(TransposeInitializer(*input_def, inverse_perm, input_def));
+    }
+  }
+
+  auto& output_defs = node.MutableOutputDefs();
+  for (size_t output_index = 0; output_index < output_perms.size(); ++output_index) {
+    const auto& output_perm = output_perms[output_index];
+    if (!output_defs[output_index]->Exists() || IsIdentityPerm(output_perm)) {
+      continue;
+    }
+    size_t uses = CountOutputUses(node, output_index);
+    NodeArg* source_arg = nullptr;
+    if (apply_) {
+      source_arg = &graph_.GetOrCreateNodeArg(graph_.GenerateNodeArgName("transposed"), nullptr);
+    }
+    CreateTransposedArgument(nullptr, output_defs[output_index], source_arg, output_perm, uses);
+    if (apply_) {
+      output_defs[output_index] = source_arg;
+    }
+  }
+
+  pushed_node_count_++;
+  return Status::OK();
+}
+
+void TransposeOptimizerImpl::ProcessTranspose(Node& node) {
+  original_transpose_count_++;
+
+  auto& input_defs = node.MutableInputDefs();
+  std::vector<int64_t> perm;
+  if (!graph_utils::GetRepeatedNodeAttributeValues(node, "perm", perm)) {
+    // The default permutation reverses the dimensions, which requires the input rank.
+    const auto* shape = input_defs[0]->Shape();
+    if (shape == nullptr) {
+      return;
+    }
+    for (int64_t axis = shape->dim_size(); axis-- > 0;) {
+      perm.push_back(axis);
+    }
+  }
+  if (!IsValidPerm(perm)) {
+    return;
+  }
+
+  auto* output_arg = node.MutableOutputDefs()[0];
+  auto* transposed_input = LookupTransposedArgument(input_defs[0]);
+  if (transposed_input != nullptr) {
+    // Merge with the Transpose feeding this node.
+    if (transposed_input->perm_.size() != perm.size()) {
+      return;
+    }
+    auto composed_perm = ComposePerm(transposed_input->perm_, perm);
+    size_t uses = CountOutputUses(node, 0);
+    CreateTransposedArgument(nullptr, output_arg, transposed_input->source_arg_, std::move(composed_perm), uses);
+    transposed_input->remaining_original_uses_--;
+    removed_nodes_.push_front(node.Index());
+    return;
+  }
+
+  size_t uses = CountOutputUses(node, 0);
+  if (uses > 0) {
+    CreateTransposedArgument(&node, output_arg, input_defs[0], std::move(perm), uses);
+  }
+}
+
+Status TransposeOptimizerImpl::ProcessElementwise(Node& node, bool broadcast) {
+  // Skip the legacy broadcasting form of the binary operators.
+  if (graph_utils::GetNodeAttribute(node, "broadcast") != nullptr ||
+      graph_utils::GetNodeAttribute(node, "axis") != nullptr) {
+    return Status::OK();
+  }
+
+  std::vector<size_t> data_inputs{0};
+  if (broadcast) {
+    data_inputs.clear();
+    const auto& input_defs = node.InputDefs();
+    for (size_t i = 0; i < input_defs.size(); ++i) {
+      if (input_defs[i]->Exists()) {
+        data_inputs.push_back(i);
+      }
+    }
+  }
+
+  const auto* perm = FindInputPerm(node, data_inputs);
+  if (perm == nullptr) {
+    return Status::OK();
+  }
+  return PushTranspose(node, data_inputs, {*perm});
+}
+
+Status TransposeOptimizerImpl::ProcessQuantizeLinear(Node& node) {
+  const auto* perm = FindInputPerm(node, {0});
+  if (perm == nullptr) {
+    return Status::OK();
+  }
+  const std::vector<int64_t> input_perm = *perm;
+
+  // Opset 13 added per-axis quantization along the axis attribute.
+  int64_t axis = 1;
+  const bool has_axis = node.SinceVersion() >= 13;
+  if (has_axis) {
+    const auto* axis_attr = graph_utils::GetNodeAttribute(node, "axis");
+    if (axis_attr != nullptr) {
+      axis = axis_attr->i();
+    }
+    if (!NormalizeAxis(axis, static_cast<int64_t>(input_perm.size()))) {
+      return Status::OK();
+    }
+  }
+
+  if (!CanPushInput(node.InputDefs()[0], input_perm)) {
+    return Status::OK();
+  }
+  if (has_axis && apply_) {
+    node.AddAttribute("axis", input_perm[static_cast<size_t>(axis)]);
+  }
+  return PushTranspose(node, {0}, {input_perm});
+}
+
+Status TransposeOptimizerImpl::ProcessConcat(Node& node) {
+  std::vector<size_t> data_inputs;
+  for (size_t i = 0; i < node.InputDefs().size(); ++i) {
+    data_inputs.push_back(i);
+  }
+  const auto* perm = FindInputPerm(node, data_inputs);
+  if (perm == nullptr) {
+    return Status::OK();
+  }
+  const std::vector<int64_t> input_perm = *perm;
+
+  // Concat inputs must have the same rank, so constants are only pushed if they already do.
+  for (auto input_index : data_inputs) {
+    const auto* arg = node.InputDefs()[input_index];
+    if (!CanPushInput(arg, input_perm)) {
+      return Status::OK();
+    }
+    const auto* tensor = graph_utils::GetConstantInitializer(graph_, arg->Name());
+    if (LookupTransposedArgument(arg) == nullptr && tensor->dims_size() != static_cast<int>(input_perm.size())) {
+      return Status::OK();
+    }
+  }
+
+  const auto* axis_attr = graph_utils::GetNodeAttribute(node, "axis");
+  if (axis_attr == nullptr) {
+    return Status::OK();
+  }
+  int64_t axis = axis_attr->i();
+  if (!NormalizeAxis(axis, static_cast<int64_t>(input_perm.size()))) {
+    return Status::OK();
+  }
+  if (apply_) {
+    node.AddAttribute("axis", input_perm[static_cast<size_t>(axis)]);
+  }
+  return PushTranspose(node, data_inputs, {input_perm});
+}
+
+Status TransposeOptimizerImpl::ProcessSplit(Node& node) {
+  const auto* perm = FindInputPerm(node, {0});
+  if (perm == nullptr) {
+    return Status::OK();
+  }
+  const std::vector<int64_t> input_perm = *perm;
+
+  int64_t axis = 0;
+  const auto* axis_attr = graph_utils::GetNodeAttribute(node, "axis");
+  if (axis_attr != nullptr) {
+    axis = axis_attr->i();
+  }
+  if (!NormalizeAxis(axis, static_cast<int64_t>(input_perm.size()))) {
+    return Status::OK();
+  }
+  if (apply_) {
+    node.AddAttribute("axis", input_perm[static_cast<size_t>(axis)]);
+  }
+  return PushTranspose(node, {0}, std::vector<std::vector<int64_t>>(node.OutputDefs().size(), input_perm));
+}
+
+Status TransposeOptimizerImpl::ProcessSoftmax(Node& node) {
+  // Before opset 13, the input is coerced into a 2D tensor at the axis, so the layout matters.
+  if (node.SinceVersion() < 13) {
+    return Status::OK();
+  }
+  const auto* perm = FindInputPerm(node, {0});
+  if (perm == nullptr) {
+    return Status::OK();
+  }
+  const std::vector<int64_t> input_perm = *perm;
+
+  int64_t axis = -1;
+  const auto* axis_attr = graph_utils::GetNodeAttribute(node, "axis");
+  if (axis_attr != nullptr) {
+    axis = axis_attr->i();
+  }
+  if (!NormalizeAxis(axis, static_cast<int64_t>(input_perm.size()))) {
+    return Status::OK();
+  }
+  if (apply_) {
+    node.AddAttribute("axis", input_perm[static_cast<size_t>(axis)]);
+  }
+  return PushTranspose(node, {0}, {input_perm});
+}
+
+Status TransposeOptimizerImpl::ProcessReduce(Node& node) {
+  const auto* perm = FindInputPerm(node, {0});
+  if (perm == nullptr) {
+    return Status::OK();
+  }
+  const std::vector<int64_t> input_perm = *perm;
+  const auto rank = static_cast<int64_t>(input_perm.size());
+
+  const auto* noop_attr = graph_utils::GetNodeAttribute(node, "noop_with_empty_axes");
+  if (noop_attr != nullptr && noop_attr->i() != 0) {
+    return Status::OK();
+  }
+
+  int64_t keepdims = 1;
+  const auto* keepdims_attr = graph_utils::GetNodeAttribute(node, "keepdims");
+  if (keepdims_attr != nullptr) {
+    keepdims = keepdims_attr->i();
+  }
+
+  const bool is_arg_reduce = node.OpType() == "ArgMax" || node.OpType() == "ArgMin";
+  const bool axes_as_input = !is_arg_reduce && node.InputDefs().size() > 1;
+
+  std::vector<int64_t> axes;
+  bool all_axes = false;
+  if (is_arg_reduce) {
+    int64_t axis = 0;
+    const auto* axis_attr = graph_utils::GetNodeAttribute(node, "axis");
+    if (axis_attr != nullptr) {
+      axis = axis_attr->i();
+    }
+    axes.push_back(axis);
+  } else if (axes_as_input) {
+    if (!node.InputDefs()[1]->Exists()) {
+      all_axes = true;
+    } else {
+      const auto* axes_tensor = GetConstantInput(node, 1);
+      if (axes_tensor == nullptr) {
+        return Status::OK();
+      }
+      Initializer axes_init{*axes_tensor, graph_.ModelPath()};
+      axes.assign(axes_init.data<int64_t>(), axes_init.data<int64_t>() + axes_init.size());
+    }
+  } else if (!graph_utils::GetRepeatedNodeAttributeValues(node, "axes", axes)) {
+    all_axes = true;
+  }
+
+  // empty axes also reduce all the axes, as noop_with_empty_axes is not set
+  if (!is_arg_reduce && axes.empty()) {
+    all_axes = true;
+  }
+
+  if (all_axes) {
+    axes.resize(static_cast<size_t>(rank));
+    std::iota(axes.begin(), axes.end(), 0);
+  } else if (!NormalizeAxes(axes, rank)) {
+    return Status::OK();
+  }
+
+  if (!CanPushInput(node.InputDefs()[0], input_perm)) {
+    return Status::OK();
+  }
+
+  if (apply_ && !all_axes) {
+    auto source_axes = PermuteAxes(axes, input_perm);
+    if (is_arg_reduce) {
+      node.AddAttribute("axis", source_axes[0]);
+    } else if (axes_as_input) {
+      node.MutableInputDefs()[1] = &AddInt64Initializer("axes", source_axes);
+    } else {
+      node.AddAttribute("axes", source_axes);
+    }
+  }
+
+  return PushTranspose(node, {0}, {keepdims != 0 ? input_perm : RemoveAxesFromPerm(input_perm, axes)});
+}
+
+Status TransposeOptimizerImpl::ProcessSqueeze(Node& node) {
+  const auto* perm = FindInputPerm(node, {0});
+  if (perm == nullptr) {
+    return Status::OK();
+  }
+  const std::vector<int64_t> input_perm = *perm;
+
+  // Squeeze without axes depends on the input shape, so only explicit axes are handled.
+  std::vector<int64_t> axes;
+  const bool axes_as_input = node.SinceVersion() >= 13;
+  if (axes_as_input) {
+    const auto* axes_tensor = GetConstantInput(node, 1);
+    if (axes_tensor == nullptr) {
+      return Status::OK();
+    }
+    Initializer axes_init{*axes_tensor, graph_.ModelPath()};
+    axes.assign(axes_init.data<int64_t>(), axes_init.data<int64_t>() + axes_init.size());
+  } else if (!graph_utils::GetRepeatedNodeAttributeValues(node, "axes", axes)) {
+    return Status::OK();
+  }
+  if (axes.empty() || !NormalizeAxes(axes, static_cast<int64_t>(input_perm.size()))) {
+    return Status::OK();
+  }
+
+  if (apply_) {
+    auto source_axes = PermuteAxes(axes, input_perm);
+    if (axes_as_input) {
+      node.MutableInputDefs()[1] = &AddInt64Initializer("axes", source_axes);
+    } else {
+      node.AddAttribute("axes", source_axes);
+    }
+  }
+  return PushTranspose(node, {0}, {RemoveAxesFromPerm(input_perm, axes)});
+}
+
+Status TransposeOptimizerImpl::ProcessUnsqueeze(Node& node) {
+  const auto* perm = FindInputPerm(node, {0});
+  if (perm == nullptr) {
+    return Status::OK();
+  }
+  const std::vector<int64_t> input_perm = *perm;
+
+  std::vector<int64_t> axes;
+  if (node.SinceVersion() >= 13) {
+    const auto* axes_tensor = GetConstantInput(node, 1);
+    if (axes_tensor == nullptr) {
+      return Status::OK();
+    }
+    Initializer axes_init{*axes_tensor, graph_.ModelPath()};
+    axes.assign(axes_init.data<int64_t>(), axes_init.data<int64_t>() + axes_init.size());
+  } else if (!graph_utils::GetRepeatedNodeAttributeValues(node, "axes", axes)) {
+    return Status::OK();
+  }
+  // The axes refer to the output, so the node is left unchanged and only the output permutation
+  // differs: the new axes keep their position and the other axes are permuted like the input.
+  if (axes.empty() || !NormalizeAxes(axes, static_cast<int64_t>(input_perm.size() + axes.size()))) {
+    return Status::OK();
+  }
+  return PushTranspose(node, {0}, {InsertAxesIntoPerm(input_perm, axes)});
+}
+
+Status TransposeOptimizerImpl::ProcessPad(Node& node) {
+  const auto* perm = FindInputPerm(node, {0});
+  if (perm == nullptr) {
+    return Status::OK();
+  }
+  const std::vector<int64_t> input_perm = *perm;
+  const size_t rank = input_perm.size();
+
+  std::vector<int64_t> pads;
+  const bool pads_as_input = node.SinceVersion() >= 11;
+  if (pads_as_input) {
+    const auto* pads_tensor = GetConstantInput(node, 1);
+    if (pads_tensor == nullptr) {
+      return Status::OK();
+    }
+    Initializer pads_init{*pads_tensor, graph_.ModelPath()};
+    pads.assign(pads_init.data<int64_t>(), pads_init.data<int64_t>() + pads_init.size());
+  } else if (!graph_utils::GetRepeatedNodeAttributeValues(node, "pads", pads)) {
+    return Status::OK();
+  }
+  if (pads.size() != 2 * rank) {
+    return Status::OK();
+  }
+
+  if (apply_) {
+    // The pads are stored as [x1_begin, x2_begin, ..., x1_end, x2_end, ...].
+    std::vector<int64_t> source_pads(2 * rank);
+    for (size_t i = 0; i < rank; ++i) {
+      const auto source_axis = static_cast<size_t>(input_perm[i]);
+      source_pads[source_axis] = pads[i];
+      source_pads[rank + source_axis] = pads[rank + i];
+    }
+    if (pads_as_input) {
+      node.MutableInputDefs()[1] = &AddInt64Initializer("pads", source_pads);
+    } else {
+      node.AddAttribute("pads", source_pads);
+    }
+  }
+  return PushTranspose(node, {0}, {input_perm});
+}
+
+Status TransposeOptimizerImpl::Process(Node& node) {
+  if (!graph_utils::MatchesOpSetDomain(node, kOnnxDomain)) {
+    return Status::OK();
+  }
+
+  // Tensors that were transposed back to their original layout are used directly.
+  for (size_t i = 0; i < node.InputDefs().size(); ++i) {
+    auto* transposed_arg = LookupTransposedArgument(node.InputDefs()[i]);
+    if (transposed_arg != nullptr && IsIdentityPerm(transposed_arg->perm_)) {
+      UseSource(node, i, *transposed_arg);
+    }
+  }
+
+  static const std::unordered_set<std::string> unary_elementwise_ops = {
+      "Abs", "Cast", "Ceil", "Clip", "Cos", "Elu", "Erf", "Exp", "Floor", "HardSigmoid", "Identity",
+      "IsInf", "IsNaN", "LeakyRelu", "Log", "Neg", "Not", "Reciprocal", "Relu", "Round", "Selu",
+      "Sigmoid", "Sign", "Sin", "Softplus", "Softsign", "Sqrt", "Tanh", "ThresholdedRelu"};
+  static const std::unordered_set<std::string> broadcast_elementwise_ops = {
+      "Add", "And", "BitShift", "Div", "Equal", "Greater", "GreaterOrEqual", "Less", "LessOrEqual",
+      "Max", "Mean", "Min", "Mod", "Mul", "Or", "Pow", "PRelu", "Sub", "Sum", "Where", "Xor"};
+  static const std::unordered_set<std::string> reduce_ops = {
+      "ArgMax", "ArgMin", "ReduceL1", "ReduceL2", "ReduceLogSum", "ReduceLogSumExp", "ReduceMax",
+      "ReduceMean", "ReduceMin", "ReduceProd", "ReduceSum", "ReduceSumSquare"};
+
+  const auto& op_type = node.OpType();
+  if (op_type == "Transpose") {
+    ProcessTranspose(node);
+  } else if (unary_elementwise_ops.count(op_type) != 0) {
+    return ProcessElementwise(node, false);
+  } else if (broadcast_elementwise_ops.count(op_type) != 0) {
+    return ProcessElementwise(node, true);
+  } else if (op_type == "QuantizeLinear" || op_type == "DequantizeLinear") {
+    return ProcessQuantizeLinear(node);
+  } else if (op_type == "Concat") {
+    return ProcessConcat(node);
+  } else if (op_type == "Split") {
+    return ProcessSplit(node);
+  } else if (op_type == "Softmax" || op_type == "LogSoftmax" || op_type == "Hardmax") {
+    return ProcessSoftmax(node);
+  } else if (reduce_ops.count(op_type) != 0) {
+    return ProcessReduce(node);
+  } else if (op_type == "Squeeze") {
+    return ProcessSqueeze(node);
+  } else if (op_type == "Unsqueeze") {
+    return ProcessUnsqueeze(node);
+  } else if (op_type == "Pad") {
+    return ProcessPad(node);
+  }
+  return Status::OK();
+}
+
+bool TransposeOptimizerImpl::ReducesTransposeCount() const {
+  size_t remaining_transpose_count = original_transpose_count_ - removed_nodes_.size();
+  for (const auto& transposed_arg : transposed_args_) {
+    if (transposed_arg->transpose_node_ != nullptr) {
+      if (transposed_arg->remaining_original_uses_ == 0) {
+        remaining_transpose_count--;
+      }
+    } else if (transposed_arg->remaining_original_uses_ > 0 && !IsIdentityPerm(transposed_arg->perm_)) {
+      remaining_transpose_count++;
+    }
+  }
+  return remaining_transpose_count < original_transpose_count_;
+}
+
+void TransposeOptimizerImpl::Finalize(bool& modified) {
+  for (auto& transposed_arg : transposed_args_) {
+    if (transposed_arg->transpose_node_ != nullptr) {
+      // Remove the original Transpose nodes that no longer have any uses.
+      if (transposed_arg->remaining_original_uses_ == 0) {
+        removed_nodes_.push_front(transposed_arg->transpose_node_->Index());
+      }
+      continue;
+    }
+
+    // Create Transpose nodes for the tensors that still have uses in the original layout.
+    if (transposed_arg->remaining_original_uses_ > 0) {
+      const bool identity = IsIdentityPerm(transposed_arg->perm_);
+      Node& transpose_node = graph_.AddNode(graph_.GenerateNodeName(identity ? "Identity" : "Transpose"),
+                                            identity ? "Identity" : "Transpose",
+                                            "Created by TransposeOptimizer",
+                                            {transposed_arg->source_arg_},
+                                            {transposed_arg->output_arg_},
+                                            nullptr);
+      if (!identity) {
+        transpose_node.AddAttribute("perm", transposed_arg->perm_);
+      }
+    }
+  }
+
+  for (auto index : removed_nodes_) {
+    graph_.RemoveNode(index);
+  }
+
+  if (pushed_node_count_ > 0 || !removed_nodes_.empty()) {
+    modified = true;
+  }
+}
+
+Status TransposeOptimizer::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto index : order) {
+    auto* node = graph.GetNode(index);
+    if (node != nullptr) {
+      ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
+    }
+  }
+
+  // Walk the graph once without modifying it to find out whether pushing the Transpose nodes pays
+  // off. Pushing a Transpose that does not meet another one only moves it further down the graph.
+  {
+    TransposeOptimizerImpl impl(graph, false);
+    for (auto index : order) {
+      ORT_RETURN_IF_ERROR(impl.Process(*graph.GetNode(index)));
+    }
+    if (!impl.ReducesTransposeCount()) {
+      return Status::OK();
+    }
+  }
+
+  TransposeOptimizerImpl impl(graph, true);
+  for (auto index : order) {
+    ORT_RETURN_IF_ERROR(impl.Process(*graph.GetNode(index)));
+  }
+  impl.Finalize(modified);
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
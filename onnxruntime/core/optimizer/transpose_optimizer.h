@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class TransposeOptimizer
+
+Transformer that pushes Transpose nodes through layout agnostic operators such as
+elementwise operators, Pad, Concat, Split, Squeeze, Unsqueeze, Softmax, the reduction
+operators and QuantizeLinear/DequantizeLinear, so that pairs of Transpose nodes meet
+and can be merged or cancelled. Constant inputs of the operators are transposed in place of
+inserting Transpose nodes. The graph is only changed if the number of Transpose
+nodes is reduced.
+*/
+class TransposeOptimizer : public GraphTransformer {
+ public:
+  TransposeOptimizer() noexcept : GraphTransformer("TransposeOptimizer") {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -67,6 +67,10 @@ struct ThreadOptions {
 
   // Set or unset denormal as zero.
   bool set_denormal_as_zero = false;
+
+  // If spinning is allowed, tune each thread's spin duration from the recently observed time
+  // between items of work rather than always spinning for the maximum duration before blocking.
+  bool adaptive_spinning = false;
 };
 /// \brief An interface used by the onnxruntime implementation to
 /// access operating system functionality like the filesystem etc.
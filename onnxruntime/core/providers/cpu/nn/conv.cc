@@ -151,18 +151,89 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+Status Conv<float>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                            /*out*/ bool& is_packed,
+                            /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // Only the filter of 3x3 convolutions with unit strides and dilations can use the Winograd algorithm.
+  const auto& shape = tensor.Shape();
+  if (input_idx != 1 || shape.NumDimensions() != 4 || shape[2] != 3 || shape[3] != 3) {
+    return Status::OK();
+  }
+
+  const auto is_one = [](int64_t value) { return value == 1; };
+  if (!std::all_of(conv_attrs_.strides.begin(), conv_attrs_.strides.end(), is_one) ||
+      !std::all_of(conv_attrs_.dilations.begin(), conv_attrs_.dilations.end(), is_one)) {
+    return Status::OK();
+  }
+
+  // MlasConvPrepare never selects the Winograd algorithm for filters with few channels.
+  const size_t group_count = static_cast<size_t>(conv_attrs_.group);
+  const size_t filter_count = static_cast<size_t>(shape[0]) / group_count;
+  const size_t input_channels = static_cast<size_t>(shape[1]);
+  if (!MlasConvWinogradIsFilterSupported(filter_count, input_channels)) {
+    return Status::OK();
+  }
+
+  const size_t packed_filter_size =
+      SafeInt<size_t>(sizeof(float)) *
+      MlasConvWinogradPackFilterSize(kWinogradOutputTileSize, group_count, filter_count, input_channels);
+  auto* packed_filter_data = alloc->Alloc(packed_filter_size);
+  packed_winograd_filter_ = BufferUniquePtr(packed_filter_data, BufferDeleter(alloc));
+
+  MlasConvWinogradPackFilter(kWinogradOutputTileSize, group_count, filter_count, input_channels,
+                             tensor.Data<float>(), static_cast<float*>(packed_filter_data));
+
+  // The original filter is still used for input shapes that do not suit the Winograd algorithm,
+  // so it is packed as is alongside the transformed filter.
+  const size_t filter_size = tensor.SizeInBytes();
+  auto* filter_data = alloc->Alloc(filter_size);
+  memcpy(filter_data, tensor.DataRaw(), filter_size);
+  packed_filter_ = BufferUniquePtr(filter_data, BufferDeleter(alloc));
+  filter_shape_ = shape;
+
+  is_packed = true;
+
+  bool share_prepacked_weights = (prepacked_weights != nullptr);
+  if (share_prepacked_weights) {
+    prepacked_weights->buffers_.push_back(std::move(packed_winograd_filter_));
+    prepacked_weights->buffer_sizes_.push_back(packed_filter_size);
+    prepacked_weights->buffers_.push_back(std::move(packed_filter_));
+    prepacked_weights->buffer_sizes_.push_back(filter_size);
+  }
+
+  return Status::OK();
+}
+
+Status Conv<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                              int input_idx,
+                                              /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_winograd_filter_ = std::move(prepacked_buffers[0]);
+    packed_filter_ = std::move(prepacked_buffers[1]);
+  }
+
+  return Status::OK();
+}
+
 Status Conv<float>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
   const auto* X = context->Input<Tensor>(0);
-  const auto* W = context->Input<Tensor>(1);
+  const auto* W = packed_filter_ ? nullptr : context->Input<Tensor>(1);
   const Tensor* B = num_inputs == 3 ? context->Input<Tensor>(2) : nullptr;
+  const TensorShape& W_shape = W ? W->Shape() : filter_shape_;
+  const float* Wdata = W ? W->template Data<float>() : static_cast<const float*>(packed_filter_.get());
   const int64_t N = X->Shape()[0];
   const int64_t C = X->Shape()[1];
-  const int64_t M = W->Shape()[0];
-  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X, W));
+  const int64_t M = W_shape[0];
+  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X->Shape(), W_shape));
 
   std::vector<int64_t> kernel_shape;
-  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W->Shape(), kernel_shape));
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W_shape, kernel_shape));
 
   std::vector<int64_t> pads(conv_attrs_.pads);
   if (pads.empty()) {
@@ -217,13 +288,21 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
                     &WorkingBufferSize,
                     thread_pool);
 
+    if (packed_winograd_filter_ != nullptr) {
+      MlasConvWinogradUsePackedFilter(&Parameters,
+                                      kWinogradOutputTileSize,
+                                      static_cast<const float*>(packed_winograd_filter_.get()),
+                                      &WorkingBufferSize,
+                                      thread_pool);
+    }
+
     auto* working_data = WorkingBufferSize > 0 ? alloc->Alloc(SafeInt<size_t>(sizeof(float)) * WorkingBufferSize)
                                                : nullptr;
     BufferUniquePtr working_buffer(working_data, BufferDeleter(alloc));
 
     MlasConv(&Parameters,
              Xdata,
-             W->template Data<float>(),
+             Wdata,
              Bdata,
              static_cast<float*>(working_buffer.get()),
              Ydata,
@@ -234,7 +313,7 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
     const int64_t kernel_size = TensorShape(kernel_shape).Size();
     const int64_t X_offset = C / conv_attrs_.group * input_image_size;
     const int64_t Y_offset = Y->Shape().Size() / Y->Shape()[0] / conv_attrs_.group;
-    const int64_t W_offset = W->Shape().Size() / conv_attrs_.group;
+    const int64_t W_offset = W_shape.Size() / conv_attrs_.group;
     const int64_t kernel_dim = C / conv_attrs_.group * kernel_size;
     const int64_t col_buffer_size = kernel_dim * output_image_size;
 
@@ -263,7 +342,7 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
             output_image_size,
             kernel_dim,
             1,
-            W->template Data<float>() + group_id * W_offset,
+            Wdata + group_id * W_offset,
             col_buffer_data,
             0,
             Ydata + group_id * Y_offset,
@@ -28,12 +28,30 @@ class Conv<float> : public OpKernel {
     activation_.ActivationKind = MlasIdentityActivation;
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
   Status Compute(OpKernelContext* context) const override;
 
  protected:
   MLAS_ACTIVATION activation_;
 
   ConvAttributes conv_attrs_;
+
+ private:
+  // Output tile size of the Winograd algorithm that 3x3 filters are transformed for. F(4x4,3x3) suits
+  // feature maps of at least 8x8, and smaller ones fall back to the algorithm chosen by MlasConvPrepare.
+  static constexpr size_t kWinogradOutputTileSize = 4;
+
+  BufferUniquePtr packed_winograd_filter_;
+  // Copy of the original filter, which is used for the input shapes that do not suit the Winograd algorithm.
+  BufferUniquePtr packed_filter_;
+  TensorShape filter_shape_;
 };
 
 }  // namespace onnxruntime
@@ -18,7 +18,8 @@ class QLinearConv : public OpKernel {
   explicit QLinearConv(const OpKernelInfo& info) : OpKernel(info),
                                                    conv_attrs_(info),
                                                    is_W_signed_(false),
-                                                   is_W_packed_(false) {
+                                                   is_W_packed_(false),
+                                                   use_direct_conv_(false) {
     channels_last_ = (info.GetAttrOrDefault<int64_t>("channels_last", static_cast<int64_t>(0)) != 0);
   }
 
@@ -55,6 +56,8 @@ class QLinearConv : public OpKernel {
   BufferUniquePtr reordered_W_buffer_;
   bool is_W_signed_;
   bool is_W_packed_;
+  // Set if the filter is packed for MlasConvDirectU8S8 in packed_W_buffer_.
+  bool use_direct_conv_;
   bool channels_last_;
 };
 
@@ -128,6 +131,33 @@ Status QLinearConv::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr al
 
   bool share_prepacked_weights = (prepacked_weights != nullptr);
 
+  // Use the direct convolution kernel for signed filters that would otherwise
+  // require the im2col transform. The kernel consumes four input channels at a
+  // time, so inputs with very few channels are faster with the GEMM path.
+  if (is_W_signed_ && group_count == 1 && group_input_channels >= 8 &&
+      (kernel_size != 1 || !conv_attrs_.HasStridesOneAndNoPadding())) {
+    packed_W_size_ = MlasConvDirectU8S8PackFilterSize(output_channels, group_input_channels, kernel_size);
+
+    if (packed_W_size_ != 0) {
+      auto* packed_W = static_cast<uint8_t*>(alloc->Alloc(packed_W_size_));
+      memset(packed_W, 0, packed_W_size_);
+      packed_W_buffer_ = BufferUniquePtr(packed_W, BufferDeleter(alloc));
+
+      MlasConvDirectU8S8PackFilter(output_channels, group_input_channels, kernel_size,
+                                   reinterpret_cast<const int8_t*>(Wdata), packed_W);
+
+      if (share_prepacked_weights) {
+        prepacked_weights->buffers_.push_back(std::move(packed_W_buffer_));
+        prepacked_weights->buffer_sizes_.push_back(packed_W_size_);
+      }
+
+      use_direct_conv_ = true;
+      is_W_packed_ = true;
+      is_packed = true;
+      return Status::OK();
+    }
+  }
+
   // Don't pack the filter buffer if the MlasConvDepthwise path is used.
   if (group_input_channels != 1 && group_output_channels != 1) {
     packed_W_size_ = MlasGemmPackBSize(group_output_channels, kernel_dim, is_W_signed_);
@@ -212,7 +242,7 @@ Status QLinearConv::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prep
 
   used_shared_buffers = true;
 
-  if (prepacked_buffers.size() == 1) {  // This means that only packed_W_ exists
+  if (prepacked_buffers.size() == 1) {  // This means that only packed_W_ exists (GEMM or direct convolution)
     packed_W_buffer_ = std::move(prepacked_buffers[0]);
   } else if (prepacked_buffers.size() == 2) {  // This means that only reordered_W_ exists
     // Enforce that the first "placeholder" buffer is nullptr
@@ -370,6 +400,10 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
     group_count = 1;
   }
 
+  // Test for the direct convolution path, which consumes the input through an
+  // indirection buffer in the same way as the depthwise path.
+  const bool is_direct_conv = use_direct_conv_;
+
   const int64_t X_offset = C * input_image_size;
   const int64_t Y_offset = M * output_image_size;
   const int64_t kernel_dim = group_input_channels * kernel_size;
@@ -399,7 +433,7 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
   BufferUniquePtr col_buffer;
   std::vector<uint8_t> padding_data;
 
-  if (is_depthwise_conv) {
+  if (is_depthwise_conv || is_direct_conv) {
     // Allocate indirection buffer pointers and prepare a padding vector for
     // the im2col transform.
     auto* col_data = alloc->Alloc(SafeInt<size_t>(sizeof(const uint8_t*)) * kernel_size * output_image_size);
@@ -456,7 +490,7 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
 
     // Threaded implementation of ND convolution is not yet supported, so
     // prepare all im2col transformations here.
-    if (!is_depthwise_conv && col_buffer && kernel_rank > 2) {
+    if (!is_depthwise_conv && !is_direct_conv && col_buffer && kernel_rank > 2) {
       for (int64_t group_id = 0; group_id < group_count; ++group_id) {
         math::Im2col<uint8_t, StorageOrder::NHWC>()(
             input_data + group_id * group_input_channels,
@@ -482,7 +516,7 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
       auto* worker_gemm_output = gemm_output + output_start * M;
       auto* worker_requantize_output = output_data + output_start * M;
 
-      if (is_depthwise_conv) {
+      if (is_depthwise_conv || is_direct_conv) {
         auto* worker_col_buffer = static_cast<uint8_t const**>(col_buffer.get()) + output_start * kernel_size;
         math::Im2col<uint8_t, StorageOrder::NHWC>()(
             input_data,
@@ -498,16 +532,29 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
             output_count,
             worker_col_buffer,
             padding_data.data());
-        MlasConvDepthwise(
-            worker_col_buffer,
-            X_zero_point_value,
-            reordered_W,
-            W_zero_point_value,
-            is_W_signed,
-            worker_gemm_output,
-            static_cast<size_t>(M),
-            static_cast<size_t>(output_count),
-            static_cast<size_t>(kernel_size));
+        if (is_direct_conv) {
+          MlasConvDirectU8S8(
+              worker_col_buffer,
+              X_zero_point_value,
+              packed_W_buffer_.get(),
+              static_cast<int8_t>(W_zero_point_value),
+              worker_gemm_output,
+              static_cast<size_t>(C),
+              static_cast<size_t>(M),
+              static_cast<size_t>(output_count),
+              static_cast<size_t>(kernel_size));
+        } else {
+          MlasConvDepthwise(
+              worker_col_buffer,
+              X_zero_point_value,
+              reordered_W,
+              W_zero_point_value,
+              is_W_signed,
+              worker_gemm_output,
+              static_cast<size_t>(M),
+              static_cast<size_t>(output_count),
+              static_cast<size_t>(kernel_size));
+        }
       } else {
         for (int64_t group_id = 0; group_id < group_count; ++group_id) {
           MLAS_GEMM_U8X8_DATA_PARAMS gemm_params;
@@ -175,6 +175,12 @@ ORT_API_STATUS_IMPL(OrtApis::AddFreeDimensionOverrideByName, _Inout_ OrtSessionO
   return nullptr;
 }
 
+ORT_API_STATUS_IMPL(OrtApis::AddStatefulInputOutput, _Inout_ OrtSessionOptions* options,
+                    _In_z_ const char* input_name, _In_z_ const char* output_name) {
+  options->value.stateful_inputs_outputs.push_back(onnxruntime::StatefulInputOutput{input_name, output_name});
+  return nullptr;
+}
+
 ORT_API_STATUS_IMPL(OrtApis::DisablePerSessionThreads, _In_ OrtSessionOptions* options) {
   options->value.use_per_session_threads = false;
   return nullptr;
@@ -2,6 +2,12 @@
 // Licensed under the MIT License.
 
 #include "core/session/environment.h"
+
+#include <mutex>
+#ifndef _WIN32
+#include <signal.h>
+#endif
+
 #include "core/framework/allocatormgr.h"
 #include "core/graph/constants.h"
 #include "core/graph/op.h"
@@ -23,7 +29,9 @@
 #include "core/graph/dml_ops/dml_defs.h"
 #endif
 
+#include "core/common/trace_recorder.h"
 #include "core/platform/env.h"
+#include "core/platform/env_var_utils.h"
 #include "core/util/thread_utils.h"
 #include "core/session/allocator_impl.h"
 
@@ -133,6 +141,35 @@ Status Environment::CreateAndRegisterAllocator(const OrtMemoryInfo& mem_info, co
   return RegisterAllocator(allocator_ptr);
 }
 
+namespace {
+// The trace recorder is configured with environment variables so that it can be enabled in a
+// deployment without changing the application.
+void ConfigureTraceRecorderFromEnvironment() {
+  static std::once_flag configured;
+  std::call_once(configured, []() {
+    const auto sampling_interval =
+        ParseEnvironmentVariable<uint32_t>(trace_recorder_env_vars::kSamplingInterval);
+    if (!sampling_interval.has_value()) {
+      return;
+    }
+
+    profiling::TraceRecorder::Options options{};
+    options.sampling_interval = *sampling_interval;
+    options.events_per_thread = ParseEnvironmentVariableWithDefault<size_t>(
+        trace_recorder_env_vars::kEventsPerThread, options.events_per_thread);
+    profiling::TraceRecorder::Enable(options);
+
+#ifndef _WIN32
+    const std::string output_path = Env::Default().GetEnvironmentVar(trace_recorder_env_vars::kSignalOutputPath);
+    if (!output_path.empty()) {
+      const auto status = profiling::TraceRecorder::WriteChromeTraceOnSignal(SIGUSR2, output_path);
+      LOGS_DEFAULT_IF(!status.IsOK(), WARNING) << "Failed to set up trace output: " << status.ErrorMessage();
+    }
+#endif
+  });
+}
+}  // namespace
+
 Status Environment::Initialize(std::unique_ptr<logging::LoggingManager> logging_manager,
                                const OrtThreadingOptions* tp_options,
                                bool create_global_thread_pools) {
@@ -242,6 +279,8 @@ Internal copy node
     // fire off startup telemetry (this call is idempotent)
     const Env& env = Env::Default();
     env.GetTelemetryProvider().LogProcessInfo();
+
+    ConfigureTraceRecorderFromEnvironment();
   }
   ORT_CATCH(const std::exception& ex) {
     ORT_HANDLE_EXCEPTION([&]() {
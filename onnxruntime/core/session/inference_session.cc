@@ -4,6 +4,7 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/inference_session.h"
 
+#include <algorithm>
 #include <memory>
 #include <sstream>
 #include <unordered_set>
@@ -12,8 +13,10 @@
 #include <thread>
 
 #include "core/common/denormal.h"
+#include "core/common/parallel_for_tuner.h"
 #include "core/common/logging/logging.h"
 #include "core/common/parse_string.h"
+#include "core/common/trace_recorder.h"
 #include "core/framework/arena.h"
 #include "core/framework/allocatormgr.h"
 #include "core/framework/error_code_helper.h"
@@ -50,6 +53,7 @@
 #include "core/session/inference_session_utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/onnxruntime_run_options_config_keys.h"
+#include "core/session/stateful_values.h"
 #include "core/util/protobuf_parsing_utils.h"
 #include "core/util/thread_utils.h"
 
@@ -253,6 +257,8 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
                              session_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL &&
                              to.affinity_vec_len == 0;
       to.allow_spinning = allow_intra_op_spinning;
+      to.adaptive_spinning =
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpAdaptiveSpinning, "0") == "1";
       thread_pool_ =
           concurrency::CreateThreadPool(&Env::Default(), to, concurrency::ThreadPoolType::INTRA_OP);
     }
@@ -273,6 +279,8 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
       to.name = inter_thread_pool_name_.c_str();
       to.set_denormal_as_zero = set_denormal_as_zero;
       to.allow_spinning = allow_inter_op_spinning;
+      to.adaptive_spinning =
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigInterOpAdaptiveSpinning, "0") == "1";
       inter_op_thread_pool_ =
           concurrency::CreateThreadPool(&Env::Default(), to, concurrency::ThreadPoolType::INTER_OP);
       if (inter_op_thread_pool_ == nullptr) {
@@ -280,6 +288,10 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
         session_options_.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
       }
     }
+  } else if (shape_specialization_parent_ != nullptr) {
+    LOGS(*session_logger_, INFO) << "Using the threadpools of the session this shape specialized session was created by";
+    intra_op_thread_pool_from_env_ = shape_specialization_parent_->GetIntraOpThreadPoolToUse();
+    inter_op_thread_pool_from_env_ = shape_specialization_parent_->GetInterOpThreadPoolToUse();
   } else {
     LOGS(*session_logger_, INFO) << "Using global/env threadpools since use_per_session_threads_ is false";
     intra_op_thread_pool_from_env_ = session_env.GetIntraOpThreadPool();
@@ -289,6 +301,25 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
                 " threadpools, the env must be created with the the CreateEnvWithGlobalThreadPools API.");
   }
 
+  {
+    const bool enable_tuning =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigEnableParallelForTuning, "0") == "1";
+    const std::string tuning_file =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigParallelForTuningFile, "");
+    if (enable_tuning || !tuning_file.empty()) {
+      parallel_for_tuner_ = std::make_unique<concurrency::ParallelForTuner>(enable_tuning);
+      if (!tuning_file.empty()) {
+        parallel_for_tuning_file_ = ToPathString(tuning_file);
+        auto status = parallel_for_tuner_->Load(parallel_for_tuning_file_);
+        if (!status.IsOK()) {
+          // a missing file is expected on the first tuning run
+          LOGS(*session_logger_, INFO) << "Parallel-for tuning results not loaded from " << tuning_file << ": "
+                                       << status.ErrorMessage();
+        }
+      }
+    }
+  }
+
   session_profiler_.Initialize(session_logger_);
   if (session_options_.enable_profiling) {
     StartProfiling(session_options_.profile_file_prefix);
@@ -311,6 +342,17 @@ InferenceSession::InferenceSession(const SessionOptions& session_options, const
 }
 
 #if !defined(ORT_MINIMAL_BUILD)
+InferenceSession::InferenceSession(const SessionOptions& session_options, const InferenceSession& parent)
+    : graph_transformation_mgr_(session_options.max_num_graph_transformation_steps),
+      insert_cast_transformer_("CastFloat16Transformer"),
+      logging_manager_(parent.logging_manager_),
+      environment_(parent.environment_),
+      shape_specialization_parent_(&parent) {
+  model_location_ = parent.model_location_;
+  prepacked_weights_container_ = parent.prepacked_weights_container_;
+  ConstructorCommon(session_options, parent.environment_);
+}
+
 InferenceSession::InferenceSession(const SessionOptions& session_options, const Environment& session_env,
                                    const std::string& model_uri)
     : model_location_(ToWideString(model_uri)),
@@ -392,6 +434,13 @@ InferenceSession::~InferenceSession() {
     }
   }
 
+  if (parallel_for_tuner_ && !parallel_for_tuning_file_.empty() && parallel_for_tuner_->HasNewResults()) {
+    auto status = parallel_for_tuner_->Save(parallel_for_tuning_file_);
+    if (!status.IsOK()) {
+      LOGS(*session_logger_, WARNING) << "Failed to save parallel-for tuning results: " << status.ErrorMessage();
+    }
+  }
+
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
   if (session_activity_started_)
     TraceLoggingWriteStop(session_activity, "OrtInferenceSessionActivity");
@@ -1221,6 +1270,7 @@ common::Status InferenceSession::Initialize() {
         session_options_.use_deterministic_compute,
         session_options_.enable_mem_reuse,
         prepacked_weights_container_);
+    session_state_->SetParallelForTuner(parallel_for_tuner_.get());
 
     // Collect the kernel registries from execution provider instances;
     // There are 2 kinds of kernel registries with priority from high to low as below,
@@ -1245,6 +1295,13 @@ common::Status InferenceSession::Initialize() {
 
 #if !defined(ORT_MINIMAL_BUILD)
     if (!loading_ort_format) {
+      ORT_RETURN_IF_ERROR_SESSIONID_(InitializeShapeSpecialization());
+
+      // subgraphs of control flow nodes are transformed in parallel on the intra-op thread pool, and the time taken
+      // by each transformer is recorded if profiling is enabled.
+      graph_transformation_mgr_.SetThreadPool(GetIntraOpThreadPoolToUse());
+      graph_transformation_mgr_.SetProfiler(&session_profiler_);
+
       // add predefined transformers
       AddPredefinedTransformers(graph_transformation_mgr_, session_options_.graph_optimization_level);
 
@@ -1314,6 +1371,8 @@ common::Status InferenceSession::Initialize() {
     }
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
+    ORT_RETURN_IF_ERROR_SESSIONID_(InitializeStatefulValues());
+
     session_state_->ResolveMemoryPatternFlag();
     is_inited_ = true;
 
@@ -1606,15 +1665,257 @@ Status InferenceSession::PartialRun(onnxruntime::RunOptions& run_options,
 }
 #endif
 
+#if !defined(ORT_MINIMAL_BUILD)
+common::Status InferenceSession::InitializeShapeSpecialization() {
+  const std::string cache_size_str =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigShapeSpecializationCacheSize, "0");
+  int cache_size = 0;
+  if (!TryParseStringWithClassicLocale<int>(cache_size_str, cache_size) || cache_size < 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ",
+                           kOrtSessionOptionsConfigShapeSpecializationCacheSize, ": ", cache_size_str);
+  }
+  if (cache_size == 0) {
+    return Status::OK();
+  }
+
+  // The specialized sessions only get the CPU execution provider, and can not register custom ops.
+  if (execution_providers_.NumProviders() != 1 || execution_providers_.Get(kCpuExecutionProvider) == nullptr ||
+      HasLocalSchema()) {
+    LOGS(*session_logger_, WARNING) << "Shape specialization is only supported for sessions that use the CPU "
+                                       "execution provider alone and have no custom ops. It is disabled.";
+    return Status::OK();
+  }
+
+  bool has_dynamic_inputs = false;
+  for (const auto* input : model_->MainGraph().GetInputs()) {
+    const auto* shape = input->Shape();
+    if (shape == nullptr) {
+      has_dynamic_inputs = true;
+      break;
+    }
+    for (const auto& dim : shape->dim()) {
+      if (!utils::HasDimValue(dim)) {
+        has_dynamic_inputs = true;
+        break;
+      }
+    }
+  }
+  if (!has_dynamic_inputs) {
+    return Status::OK();
+  }
+
+  shape_specialization_model_ = std::make_unique<ONNX_NAMESPACE::ModelProto>(model_->ToProto());
+
+  // Deserialize the initializers once into buffers owned by this session, and share them with the specialized
+  // sessions and this session itself, so that neither holds a copy of its own. The kept model only keeps the name,
+  // type and shape of each shared initializer. String tensors can not be created on a buffer owned by the session.
+  AllocatorPtr allocator = execution_providers_.Get(kCpuExecutionProvider)->GetAllocator(0, OrtMemTypeDefault);
+  for (auto& initializer : *shape_specialization_model_->mutable_graph()->mutable_initializer()) {
+    const std::string& name = initializer.name();
+    if (initializer.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING ||
+        session_options_.initializers_to_share_map.count(name) > 0) {
+      continue;
+    }
+
+    size_t size_in_bytes = 0;
+    ORT_RETURN_IF_ERROR(utils::GetSizeInBytesFromTensorProto<0>(initializer, &size_in_bytes));
+    BufferUniquePtr buffer(size_in_bytes > 0 ? allocator->Alloc(size_in_bytes) : nullptr, BufferDeleter(allocator));
+    const auto* type = DataTypeImpl::TensorTypeFromONNXEnum(initializer.data_type())->GetElementType();
+    auto tensor = std::make_unique<Tensor>(type, utils::GetTensorShapeFromTensorProto(initializer), buffer.get(),
+                                           allocator->Info());
+    ORT_RETURN_IF_ERROR(utils::TensorProtoToTensor(Env::Default(), model_location_.c_str(), initializer, *tensor));
+
+    OrtValue& value = shape_specialization_initializers_[name];
+    auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+    value.Init(tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+    shape_specialization_initializer_buffers_.push_back(std::move(buffer));
+    ORT_RETURN_IF_ERROR(session_options_.AddInitializer(name.c_str(), &value));
+
+    ONNX_NAMESPACE::TensorProto stub;
+    stub.set_name(name);
+    stub.set_data_type(initializer.data_type());
+    *stub.mutable_dims() = initializer.dims();
+    initializer = std::move(stub);
+  }
+
+  shape_specialization_cache_ = std::make_unique<ShapeSpecializationCache>(static_cast<size_t>(cache_size));
+  return Status::OK();
+}
+
+std::shared_ptr<InferenceSession> InferenceSession::GetShapeSpecializedSession(
+    const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds) {
+  std::string signature;
+  if (!ShapeSpecializationCache::GetSignature(feed_names, feeds, signature)) {
+    return nullptr;
+  }
+
+  return shape_specialization_cache_->GetOrCreate(
+      signature,
+      [this, &feed_names, &feeds](std::unique_ptr<InferenceSession>& session) {
+        return CreateShapeSpecializedSession(feed_names, feeds, session);
+      },
+      *session_logger_);
+}
+
+common::Status InferenceSession::CreateShapeSpecializedSession(const std::vector<std::string>& feed_names,
+                                                               const std::vector<OrtValue>& feeds,
+                                                               std::unique_ptr<InferenceSession>& session) const {
+  auto model_proto = std::make_unique<ONNX_NAMESPACE::ModelProto>(*shape_specialization_model_);
+
+  // The graph transformers read the data of the initializers, so the graph gets a temporary copy. The session state
+  // of the specialized session uses the shared values instead, and the copy is released when it is finalized.
+  for (auto& initializer : *model_proto->mutable_graph()->mutable_initializer()) {
+    auto it = shape_specialization_initializers_.find(initializer.name());
+    if (it != shape_specialization_initializers_.end()) {
+      initializer = utils::TensorToTensorProto(it->second.Get<Tensor>(), initializer.name());
+    }
+  }
+
+  // Replace the declared shapes of the fed graph inputs with the shapes of the feeds.
+  for (auto& input : *model_proto->mutable_graph()->mutable_input()) {
+    auto it = std::find(feed_names.begin(), feed_names.end(), input.name());
+    if (it == feed_names.end() || !input.type().has_tensor_type()) {
+      continue;
+    }
+    const auto& dims = feeds[it - feed_names.begin()].Get<Tensor>().Shape().GetDims();
+    auto* shape = input.mutable_type()->mutable_tensor_type()->mutable_shape();
+    shape->clear_dim();
+    for (auto dim : dims) {
+      shape->add_dim()->set_dim_value(dim);
+    }
+  }
+
+  // The specialized session must not write files or create threads of its own.
+  SessionOptions session_options = session_options_;
+  session_options.use_per_session_threads = false;
+  session_options.enable_profiling = false;
+  session_options.optimized_model_filepath.clear();
+  // the states are kept by this session and fed to the specialized session like the other inputs
+  session_options.stateful_inputs_outputs.clear();
+  auto& configurations = session_options.config_options.configurations;
+  configurations.erase(kOrtSessionOptionsConfigShapeSpecializationCacheSize);
+  configurations.erase(kOrtSessionOptionsConfigEnableParallelForTuning);
+  configurations.erase(kOrtSessionOptionsConfigParallelForTuningFile);
+
+  std::unique_ptr<InferenceSession> specialized_session(new InferenceSession(session_options, *this));
+  auto loader = [&specialized_session, &model_proto](std::shared_ptr<onnxruntime::Model>& model) {
+    return onnxruntime::Model::Load(std::move(*model_proto), specialized_session->model_location_, model, nullptr,
+                                    *specialized_session->session_logger_);
+  };
+  ORT_RETURN_IF_ERROR(specialized_session->Load(loader, "model_loading_shape_specialization"));
+  ORT_RETURN_IF_ERROR(specialized_session->Initialize());
+
+  session = std::move(specialized_session);
+  return Status::OK();
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+common::Status InferenceSession::InitializeStatefulValues() {
+  const auto& stateful_inputs_outputs = session_options_.stateful_inputs_outputs;
+  if (stateful_inputs_outputs.empty()) {
+    return Status::OK();
+  }
+
+  const Graph& graph = model_->MainGraph();
+  const auto& inputs = graph.GetInputs();
+  const auto& outputs = graph.GetOutputs();
+
+  std::vector<StatefulValues::State> states;
+  states.reserve(stateful_inputs_outputs.size());
+  for (const auto& input_output : stateful_inputs_outputs) {
+    const auto input = std::find_if(inputs.cbegin(), inputs.cend(), [&input_output](const NodeArg* arg) {
+      return arg->Name() == input_output.input_name;
+    });
+    ORT_RETURN_IF(input == inputs.cend(), "The state input ", input_output.input_name, " is not a graph input.");
+    const auto output = std::find_if(outputs.cbegin(), outputs.cend(), [&input_output](const NodeArg* arg) {
+      return arg->Name() == input_output.output_name;
+    });
+    ORT_RETURN_IF(output == outputs.cend(), "The state output ", input_output.output_name, " is not a graph output.");
+
+    const auto* input_type = (*input)->TypeAsProto();
+    const auto* output_type = (*output)->TypeAsProto();
+    ORT_RETURN_IF(input_type == nullptr || !utils::HasTensorType(*input_type) ||
+                      output_type == nullptr || !utils::HasTensorType(*output_type),
+                  "The state input ", input_output.input_name, " and output ", input_output.output_name,
+                  " must be tensors.");
+    ORT_RETURN_IF(input_type->tensor_type().elem_type() != output_type->tensor_type().elem_type(),
+                  "The state input ", input_output.input_name, " and output ", input_output.output_name,
+                  " have different element types.");
+
+    StatefulValues::State state;
+    state.input_name = input_output.input_name;
+    state.output_name = input_output.output_name;
+    state.element_type = DataTypeImpl::TensorTypeFromONNXEnum(input_type->tensor_type().elem_type())->GetElementType();
+    const auto* shape = (*input)->Shape();
+    if (shape != nullptr) {
+      state.has_initial_shape = std::all_of(shape->dim().cbegin(), shape->dim().cend(),
+                                            [](const ONNX_NAMESPACE::TensorShapeProto_Dimension& dim) {
+                                              return utils::HasDimValue(dim);
+                                            });
+      if (state.has_initial_shape) {
+        state.initial_shape = utils::GetTensorShapeFromTensorShapeProto(*shape).GetDims();
+      }
+    }
+    const auto* output_shape = (*output)->Shape();
+    if (shape != nullptr && output_shape != nullptr && shape->dim_size() == output_shape->dim_size()) {
+      state.output_shape_follows_input = true;
+      for (int i = 0; i < shape->dim_size() && state.output_shape_follows_input; ++i) {
+        const auto& dim = shape->dim(i);
+        const auto& output_dim = output_shape->dim(i);
+        state.output_shape_follows_input =
+            (utils::HasDimValue(dim) && utils::HasDimValue(output_dim) && dim.dim_value() == output_dim.dim_value()) ||
+            (utils::HasDimParam(dim) && utils::HasDimParam(output_dim) && dim.dim_param() == output_dim.dim_param());
+      }
+    }
+    states.push_back(std::move(state));
+  }
+
+  stateful_values_ = std::make_unique<StatefulValues>(std::move(states), session_state_->GetAllocator(OrtDevice()));
+  return Status::OK();
+}
+
+void InferenceSession::ResetStates() {
+  if (stateful_values_ != nullptr) {
+    stateful_values_->Reset();
+  }
+}
+
 Status InferenceSession::Run(const RunOptions& run_options,
                              const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
                              const std::vector<std::string>& output_names, std::vector<OrtValue>* p_fetches,
                              const std::vector<OrtDevice>* p_fetches_device_info) {
+  if (stateful_values_ == nullptr) {
+    return RunImpl(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info);
+  }
+
+  ORT_RETURN_IF(p_fetches == nullptr, "Output vector pointer is NULL");
+  return stateful_values_->Run(
+      feed_names, feeds, output_names, *p_fetches,
+      [&](const std::vector<std::string>& run_feed_names, const std::vector<OrtValue>& run_feeds,
+          const std::vector<std::string>& run_output_names, std::vector<OrtValue>& run_fetches) {
+        if (p_fetches_device_info == nullptr) {
+          return RunImpl(run_options, run_feed_names, run_feeds, run_output_names, &run_fetches, nullptr);
+        }
+        // the states are kept on CPU, which is the default device of the fetches
+        std::vector<OrtDevice> run_fetches_device_info(*p_fetches_device_info);
+        run_fetches_device_info.resize(run_output_names.size());
+        return RunImpl(run_options, run_feed_names, run_feeds, run_output_names, &run_fetches,
+                       &run_fetches_device_info);
+      });
+}
+
+Status InferenceSession::RunImpl(const RunOptions& run_options,
+                                 const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
+                                 const std::vector<std::string>& output_names, std::vector<OrtValue>* p_fetches,
+                                 const std::vector<OrtDevice>* p_fetches_device_info) {
   TimePoint tp;
   if (session_profiler_.IsEnabled()) {
     tp = session_profiler_.StartTime();
   }
 
+  static const uint32_t trace_run_name_id = profiling::TraceRecorder::InternName("model_run");
+  profiling::TraceRecorder::RunScope trace_run_scope{trace_run_name_id};
+
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
   TraceLoggingActivity<telemetry_provider_handle> ortrun_activity;
   ortrun_activity.SetRelatedActivity(session_activity);
@@ -1640,6 +1941,16 @@ Status InferenceSession::Run(const RunOptions& run_options,
     ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
     ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, p_fetches));
 
+#if !defined(ORT_MINIMAL_BUILD)
+    if (shape_specialization_cache_ != nullptr) {
+      auto specialized_session = GetShapeSpecializedSession(feed_names, feeds);
+      if (specialized_session != nullptr) {
+        return specialized_session->Run(run_options, feed_names, feeds, output_names, p_fetches,
+                                        p_fetches_device_info);
+      }
+    }
+#endif
+
     // shrink certain default memory arenas if the user has requested for it
     const std::string& shrink_memory_arenas =
         run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigEnableMemoryArenaShrinkage, "");
@@ -1648,6 +1959,10 @@ Status InferenceSession::Run(const RunOptions& run_options,
       ORT_RETURN_IF_ERROR_SESSIONID_(ValidateAndParseShrinkArenaString(shrink_memory_arenas, arenas_to_shrink));
     }
 
+    // budget the intra-op thread pool for this run if the user has requested it
+    std::unique_ptr<concurrency::ThreadPool::RunScope> intra_op_run_scope;
+    ORT_RETURN_IF_ERROR_SESSIONID_(CreateIntraOpRunScope(run_options, intra_op_run_scope));
+
     FeedsFetchesInfo info(feed_names, output_names, session_state_->GetOrtValueNameIdxMap());
     FeedsFetchesManager feeds_fetches_manager{std::move(info)};
 
@@ -1945,6 +2260,42 @@ common::Status InferenceSession::ValidateAndParseShrinkArenaString(const std::st
   return Status::OK();
 }
 
+common::Status InferenceSession::CreateIntraOpRunScope(const RunOptions& run_options,
+                                                       /*out*/ std::unique_ptr<concurrency::ThreadPool::RunScope>& run_scope) const {
+  const std::string max_dop_str =
+      run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigIntraOpMaxDegreeOfParallelism, "");
+  const std::string priority_str =
+      run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigIntraOpPriority, "");
+
+  if (max_dop_str.empty() && priority_str.empty()) {
+    return Status::OK();
+  }
+
+  int max_dop = 0;
+  if (!max_dop_str.empty() &&
+      (!TryParseStringWithClassicLocale<int>(max_dop_str, max_dop) || max_dop < 0)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ",
+                           kOrtRunOptionsConfigIntraOpMaxDegreeOfParallelism, ": ", max_dop_str);
+  }
+
+  auto priority = concurrency::ThreadPool::RunPriority::kNormal;
+  if (priority_str == "low") {
+    priority = concurrency::ThreadPool::RunPriority::kLow;
+  } else if (priority_str == "high") {
+    priority = concurrency::ThreadPool::RunPriority::kHigh;
+  } else if (!priority_str.empty() && priority_str != "normal") {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ",
+                           kOrtRunOptionsConfigIntraOpPriority, ": ", priority_str);
+  }
+
+  auto* tp = GetIntraOpThreadPoolToUse();
+  if (tp != nullptr) {
+    run_scope = std::make_unique<concurrency::ThreadPool::RunScope>(tp, max_dop, priority);
+  }
+
+  return Status::OK();
+}
+
 void InferenceSession::ShrinkMemoryArenas(const std::vector<AllocatorPtr>& arenas_to_shrink) {
   for (auto& alloc : arenas_to_shrink) {
     auto status = static_cast<IArenaAllocator*>(alloc.get())->Shrink();
@@ -22,6 +22,8 @@
 #include "core/optimizer/insert_cast_transformer.h"
 #include "core/framework/session_options.h"
 #include "core/framework/allocatormgr.h"
+#include "core/session/shape_specialization_cache.h"
+#include "core/session/stateful_values.h"
 #ifdef ENABLE_LANGUAGE_INTEROP_OPS
 #include "core/language_interop_ops/language_interop_ops.h"
 #endif
@@ -306,6 +308,13 @@ class InferenceSession {
   virtual common::Status Run(const RunOptions& run_options, IOBinding& io_binding) ORT_MUST_USE_RESULT;
   common::Status Run(IOBinding& io_binding) ORT_MUST_USE_RESULT;
 
+  /**
+    * Resets the states of the session, see SessionOptions::stateful_inputs_outputs. The next run starts from the
+    * initial values of the states, all zeros, unless the state inputs are fed.
+    * This API is thread-safe, it waits for the current run that uses the states.
+    */
+  void ResetStates();
+
 #ifdef ENABLE_TRAINING
   /**
   * Partially run a pre-loaded and pre-intialized model.
@@ -429,6 +438,14 @@ class InferenceSession {
     return *session_state_;
   }
 
+#if !defined(ORT_MINIMAL_BUILD)
+  /**
+    * Get the cache of shape specialized sessions.
+    * @return nullptr if kOrtSessionOptionsConfigShapeSpecializationCacheSize is not enabled for this session.
+    */
+  const ShapeSpecializationCache* GetShapeSpecializationCache() const { return shape_specialization_cache_.get(); }
+#endif
+
   /**
     * Add a PrepackedWeightsContainer instance to the session so as to store the pre-packed weights 
     *  of shared initializers to be shared across sessions.
@@ -497,6 +514,31 @@ class InferenceSession {
   void ConstructorCommon(const SessionOptions& session_options,
                          const Environment& session_env);
 
+  common::Status RunImpl(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                         const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
+                         std::vector<OrtValue>* p_fetches,
+                         const std::vector<OrtDevice>* p_fetches_device_info) ORT_MUST_USE_RESULT;
+
+  // Validates SessionOptions::stateful_inputs_outputs against the graph and creates the holder of the states.
+  common::Status InitializeStatefulValues() ORT_MUST_USE_RESULT;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // Creates a session for a shape specialized copy of the model of parent, which uses the thread pools of parent.
+  InferenceSession(const SessionOptions& session_options, const InferenceSession& parent);
+
+  // Keeps a copy of the unoptimized model if shape specialized sessions are enabled and supported for this session.
+  // The initializers are moved out of the copy into buffers that this session and the specialized sessions share.
+  common::Status InitializeShapeSpecialization() ORT_MUST_USE_RESULT;
+
+  // Returns the shape specialized session for the shapes of the feeds, or nullptr to run this session.
+  std::shared_ptr<InferenceSession> GetShapeSpecializedSession(const std::vector<std::string>& feed_names,
+                                                               const std::vector<OrtValue>& feeds);
+
+  common::Status CreateShapeSpecializedSession(const std::vector<std::string>& feed_names,
+                                               const std::vector<OrtValue>& feeds,
+                                               std::unique_ptr<InferenceSession>& session) const ORT_MUST_USE_RESULT;
+#endif
+
   common::Status SaveModelMetadata(const onnxruntime::Model& model) ORT_MUST_USE_RESULT;
 
 #if !defined(ORT_MINIMAL_BUILD)
@@ -579,6 +621,14 @@ class InferenceSession {
    */
   void ShrinkMemoryArenas(const std::vector<AllocatorPtr>& arenas_to_shrink);
 
+  /*
+   * Validates the intra-op budgeting entries in the run options (if any), and creates a
+   * RunScope on the intra-op thread pool for the duration of the run.
+   * `run_scope` is left empty if the user did not request budgeting for this run.
+   */
+  common::Status CreateIntraOpRunScope(const RunOptions& run_options,
+                                       /*out*/ std::unique_ptr<concurrency::ThreadPool::RunScope>& run_scope) const ORT_MUST_USE_RESULT;
+
 #if !defined(ORT_MINIMAL_BUILD)
   virtual void AddPredefinedTransformers(GraphTransformerManager& transformer_manager,
                                          TransformerLevel graph_optimization_level);
@@ -631,6 +681,11 @@ class InferenceSession {
   onnxruntime::concurrency::ThreadPool* intra_op_thread_pool_from_env_{};
   onnxruntime::concurrency::ThreadPool* inter_op_thread_pool_from_env_{};
 
+  // Tuner for the block sizes of parallel loops, and the file its results are loaded from/saved to.
+  // Initialized from the session options; nullptr if neither tuning nor a tuning file is configured.
+  std::unique_ptr<onnxruntime::concurrency::ParallelForTuner> parallel_for_tuner_;
+  std::basic_string<ORTCHAR_T> parallel_for_tuning_file_;
+
   // initialized from session options
   // Determines which threadpools will be intialized and used for the duration of this session.
   // If true, use the per session ones, or else the global threadpools.
@@ -704,6 +759,23 @@ class InferenceSession {
   bool is_model_proto_parsed_ = false;
   const Environment& environment_;
 
+  // The session whose thread pools are used by this session, if this is a shape specialized session.
+  const InferenceSession* shape_specialization_parent_ = nullptr;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // The unoptimized model and the sessions created from it for concrete input shapes.
+  // Set if kOrtSessionOptionsConfigShapeSpecializationCacheSize is enabled.
+  // The initializers of the model are only kept as values, which session_options_ shares with all these sessions.
+  // They are declared before the cache so that they outlive the specialized sessions.
+  std::unique_ptr<ONNX_NAMESPACE::ModelProto> shape_specialization_model_;
+  std::vector<BufferUniquePtr> shape_specialization_initializer_buffers_;
+  std::unordered_map<std::string, OrtValue> shape_specialization_initializers_;
+  std::unique_ptr<ShapeSpecializationCache> shape_specialization_cache_;
+#endif
+
+  // Values kept between runs for SessionOptions::stateful_inputs_outputs. nullptr if there are none.
+  std::unique_ptr<StatefulValues> stateful_values_;
+
   // Bytes from an ORT format model.
   // We store them currently to make the Load + Initialize behave the same way as for an ONNX model
   // as we need some of the bytes for the Load (create the Model) and some for the Initialize (create SessionState).
@@ -18,6 +18,7 @@
 #include "core/common/logging/logging.h"
 #include "core/common/status.h"
 #include "core/common/safeint.h"
+#include "core/dlpack/dlpack_converter.h"
 #include "core/graph/constants.h"
 #include "core/graph/graph.h"
 #include "core/framework/allocator.h"
@@ -799,6 +800,31 @@ ORT_API_STATUS_IMPL(OrtApis::IsTensor, _In_ const OrtValue* value, _Out_ int* ou
   return nullptr;
 }
 
+ORT_API_STATUS_IMPL(OrtApis::CreateTensorFromDLPack, _Inout_ void* dlpack_tensor, int is_bool_tensor,
+                    _Outptr_ OrtValue** out) {
+  API_IMPL_BEGIN
+  auto* dlmanaged_tensor = static_cast<DLManagedTensor*>(dlpack_tensor);
+  if (dlmanaged_tensor->dl_tensor.ctx.device_type != kDLCPU) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "Only DLPack tensors in CPU memory are supported");
+  }
+  *out = std::make_unique<OrtValue>(dlpack::DlpackToOrtValue(dlmanaged_tensor, is_bool_tensor != 0)).release();
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::CreateDLPackFromTensor, _In_ OrtValue* value, _Outptr_ void** out) {
+  API_IMPL_BEGIN
+  if (!value->IsTensor()) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "Only tensors can be converted to DLPack tensors");
+  }
+  if (value->Get<Tensor>().Location().device.Type() != OrtDevice::CPU) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "Only tensors in CPU memory are supported");
+  }
+  *out = dlpack::OrtValueToDlpack(*value);
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::GetTensorMutableData, _Inout_ OrtValue* value, _Outptr_ void** output) {
   TENSOR_READWRITE_API_BEGIN
   //TODO: test if it's a string tensor
@@ -1011,6 +1037,14 @@ ORT_API_STATUS_IMPL(OrtApis::SessionEndProfiling, _In_ OrtSession* sess, _Inout_
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SessionResetStates, _In_ OrtSession* sess) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  session->ResetStates();
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::SessionGetModelMetadata, _In_ const OrtSession* sess,
                     _Outptr_ OrtModelMetadata** out) {
   API_IMPL_BEGIN
@@ -2296,6 +2330,10 @@ static constexpr OrtApi ort_api_1_to_9 = {
     &OrtApis::GetTensorRTProviderOptionsAsString,
     &OrtApis::ReleaseTensorRTProviderOptions,
     &OrtApis::EnableOrtCustomOps,
+    &OrtApis::CreateTensorFromDLPack,
+    &OrtApis::CreateDLPackFromTensor,
+    &OrtApis::AddStatefulInputOutput,
+    &OrtApis::SessionResetStates,
 };
 
 // Assert to do a limited check to ensure Version 1 of OrtApi never changes (will detect an addition or deletion but not if they cancel out each other)
@@ -286,4 +286,9 @@ ORT_API_STATUS_IMPL(UpdateTensorRTProviderOptions, _Inout_ OrtTensorRTProviderOp
 ORT_API_STATUS_IMPL(GetTensorRTProviderOptionsAsString, _In_ const OrtTensorRTProviderOptionsV2* tensorrt_options, _Inout_ OrtAllocator* allocator, _Outptr_ char** ptr);
 ORT_API(void, ReleaseTensorRTProviderOptions, _Frees_ptr_opt_ OrtTensorRTProviderOptionsV2*);
 ORT_API_STATUS_IMPL(EnableOrtCustomOps, _Inout_ OrtSessionOptions* options);
+ORT_API_STATUS_IMPL(CreateTensorFromDLPack, _Inout_ void* dlpack_tensor, int is_bool_tensor, _Outptr_ OrtValue** out);
+ORT_API_STATUS_IMPL(CreateDLPackFromTensor, _In_ OrtValue* value, _Outptr_ void** out);
+ORT_API_STATUS_IMPL(AddStatefulInputOutput, _Inout_ OrtSessionOptions* options, _In_z_ const char* input_name,
+                    _In_z_ const char* output_name);
+ORT_API_STATUS_IMPL(SessionResetStates, _In_ OrtSession* sess);
 }  // namespace OrtApis
@@ -0,0 +1,91 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/shape_specialization_cache.h"
+
+#include <algorithm>
+#include <numeric>
+#include <sstream>
+
+#include "core/framework/tensor.h"
+#include "core/session/inference_session.h"
+
+namespace onnxruntime {
+
+bool ShapeSpecializationCache::GetSignature(const std::vector<std::string>& feed_names,
+                                            const std::vector<OrtValue>& feeds,
+                                            std::string& signature) {
+  // The feeds may be given in any order, so sort them by name.
+  std::vector<size_t> order(feed_names.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&feed_names](size_t a, size_t b) { return feed_names[a] < feed_names[b]; });
+
+  std::ostringstream out;
+  for (auto i : order) {
+    if (!feeds[i].IsTensor()) {
+      return false;
+    }
+    out << feed_names[i] << ':';
+    for (auto dim : feeds[i].Get<Tensor>().Shape().GetDims()) {
+      out << dim << ',';
+    }
+    out << ';';
+  }
+  signature = out.str();
+  return true;
+}
+
+std::shared_ptr<InferenceSession> ShapeSpecializationCache::GetOrCreate(const std::string& signature,
+                                                                        const CreateSessionFn& create_session,
+                                                                        const logging::Logger& logger) {
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto it = index_.find(signature);
+    if (it != index_.end()) {
+      ++stats_.hits;
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return it->second->second;
+    }
+  }
+
+  std::unique_ptr<InferenceSession> created_session;
+  auto status = create_session(created_session);
+  std::shared_ptr<InferenceSession> session;
+  if (status.IsOK()) {
+    session = std::move(created_session);
+    LOGS(logger, INFO) << "Created shape specialized session for inputs " << signature;
+  } else {
+    LOGS(logger, WARNING) << "Running without shape specialization for inputs " << signature
+                          << ". Creating the specialized session failed: " << status.ErrorMessage();
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  ++stats_.misses;
+  auto it = index_.find(signature);
+  if (it != index_.end()) {
+    // Another run created the session first.
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->second;
+  }
+
+  entries_.emplace_front(signature, session);
+  index_[signature] = entries_.begin();
+  while (entries_.size() > capacity_) {
+    index_.erase(entries_.back().first);
+    entries_.pop_back();
+    ++stats_.evictions;
+  }
+  return session;
+}
+
+ShapeSpecializationCache::Stats ShapeSpecializationCache::GetStats() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return stats_;
+}
+
+size_t ShapeSpecializationCache::Size() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return entries_.size();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,73 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/logging/logging.h"
+#include "core/framework/ml_value.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class InferenceSession;
+
+/**
+  * Least recently used cache of sessions created for concrete input shapes of a model with dynamic input shapes.
+  * The sessions are shared pointers so that a run can keep using a session that is evicted concurrently.
+  */
+class ShapeSpecializationCache {
+ public:
+  using CreateSessionFn = std::function<common::Status(std::unique_ptr<InferenceSession>&)>;
+
+  struct Stats {
+    // Lookups that found a cached session, including a cached failure to create one.
+    size_t hits = 0;
+    // Lookups that created a session.
+    size_t misses = 0;
+    // Sessions dropped because the cache was full.
+    size_t evictions = 0;
+  };
+
+  explicit ShapeSpecializationCache(size_t capacity) : capacity_(capacity) {}
+
+  /**
+    * Builds the key of the feeds from their names and shapes.
+    * @return false if a feed is not a tensor, in which case the feeds can not be specialized.
+    */
+  static bool GetSignature(const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
+                           std::string& signature);
+
+  /**
+    * Returns the session for the signature, calling create_session on a miss. The session is created without
+    * holding the cache lock, so runs with cached signatures are not blocked while a new session is initialized.
+    * @return nullptr if the session could not be created. The failure is cached so it is not retried.
+    */
+  std::shared_ptr<InferenceSession> GetOrCreate(const std::string& signature, const CreateSessionFn& create_session,
+                                                const logging::Logger& logger);
+
+  Stats GetStats() const;
+
+  size_t Size() const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ShapeSpecializationCache);
+
+  using Entry = std::pair<std::string, std::shared_ptr<InferenceSession>>;
+
+  const size_t capacity_;
+  mutable OrtMutex mutex_;
+  // Most recently used first.
+  std::list<Entry> entries_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+  Stats stats_;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,129 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/stateful_values.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+StatefulValues::StatefulValues(std::vector<State> states, AllocatorPtr allocator)
+    : states_(std::move(states)), allocator_(std::move(allocator)), buffers_(states_.size()) {
+}
+
+common::Status StatefulValues::CreateInitialValue(const State& state, OrtValue& value) const {
+  if (!state.has_initial_shape) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The shape of the state input ", state.input_name,
+                           " is not fully known, so it must be fed in the first run and after a reset.");
+  }
+
+  auto tensor = std::make_unique<Tensor>(state.element_type, TensorShape(state.initial_shape), allocator_);
+  if (!tensor->IsDataTypeString()) {
+    memset(tensor->MutableDataRaw(), 0, tensor->SizeInBytes());
+  }
+
+  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+  value.Init(tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+  return Status::OK();
+}
+
+common::Status StatefulValues::Run(const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
+                                   const std::vector<std::string>& output_names, std::vector<OrtValue>& fetches,
+                                   const RunFn& run) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+
+  struct RunState {
+    OrtValue fed_value;
+    bool fed_reusable = false;
+    size_t output_index = 0;
+    bool output_fetched = false;
+    bool output_is_spare = false;
+  };
+  std::vector<RunState> run_states(states_.size());
+
+  std::vector<std::string> run_feed_names(feed_names);
+  std::vector<OrtValue> run_feeds(feeds);
+  std::vector<std::string> run_output_names(output_names);
+  std::vector<OrtValue> run_fetches(fetches);
+  run_fetches.resize(output_names.size());
+
+  for (size_t i = 0, end = states_.size(); i < end; ++i) {
+    const State& state = states_[i];
+    Buffers& buffers = buffers_[i];
+    RunState& run_state = run_states[i];
+
+    auto fed = std::find(feed_names.cbegin(), feed_names.cend(), state.input_name);
+    if (fed != feed_names.cend()) {
+      run_state.fed_value = feeds[fed - feed_names.cbegin()];
+    } else {
+      if (!buffers.current.IsAllocated()) {
+        ORT_RETURN_IF_ERROR(CreateInitialValue(state, buffers.current));
+        buffers.current_reusable = true;
+      }
+      run_state.fed_value = buffers.current;
+      run_state.fed_reusable = buffers.current_reusable;
+      run_feed_names.push_back(state.input_name);
+      run_feeds.push_back(buffers.current);
+    }
+
+    auto fetched = std::find(output_names.cbegin(), output_names.cend(), state.output_name);
+    run_state.output_fetched = fetched != output_names.cend();
+    if (run_state.output_fetched) {
+      run_state.output_index = fetched - output_names.cbegin();
+    } else {
+      run_state.output_index = run_output_names.size();
+      run_output_names.push_back(state.output_name);
+      run_fetches.emplace_back();
+    }
+
+    // the output is written to the spare buffer if it is known to have the shape of the input, which is the case
+    // for the states of most models. The executor enforces the shape of a pre-allocated output, so the spare
+    // buffer is not used when the output shape is only known after the run.
+    OrtValue& output = run_fetches[run_state.output_index];
+    if (state.output_shape_follows_input &&
+        !output.IsAllocated() && buffers.spare_reusable && buffers.spare.IsTensor() &&
+        run_state.fed_value.IsTensor() &&
+        buffers.spare.Get<Tensor>().Shape() == run_state.fed_value.Get<Tensor>().Shape()) {
+      output = buffers.spare;
+      run_state.output_is_spare = true;
+    }
+  }
+
+  ORT_RETURN_IF_ERROR(run(run_feed_names, run_feeds, run_output_names, run_fetches));
+
+  for (size_t i = 0, end = states_.size(); i < end; ++i) {
+    Buffers& buffers = buffers_[i];
+    RunState& run_state = run_states[i];
+
+    buffers.current = run_fetches[run_state.output_index];
+
+    // an output that is an unchanged input shares the buffer of the input
+    const bool output_is_input = buffers.current.IsTensor() && run_state.fed_value.IsTensor() &&
+                                 buffers.current.Get<Tensor>().DataRaw() ==
+                                     run_state.fed_value.Get<Tensor>().DataRaw();
+    buffers.current_reusable = !run_state.output_fetched && (!output_is_input || run_state.fed_reusable);
+    if (run_state.fed_reusable && !output_is_input) {
+      buffers.spare = std::move(run_state.fed_value);
+      buffers.spare_reusable = true;
+    } else if (run_state.output_is_spare || output_is_input) {
+      buffers.spare = OrtValue();
+      buffers.spare_reusable = false;
+    }
+  }
+
+  run_fetches.resize(output_names.size());
+  fetches = std::move(run_fetches);
+  return Status::OK();
+}
+
+void StatefulValues::Reset() {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  for (auto& buffers : buffers_) {
+    buffers = Buffers();
+  }
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/allocator.h"
+#include "core/framework/data_types.h"
+#include "core/framework/ml_value.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+/**
+  * Values of the graph inputs that are fed with the graph outputs of the previous run, e.g. the hidden states of a
+  * recurrent model or the look-back buffer of a convolution that is run on a stream chunk by chunk.
+  *
+  * Each state has two buffers that swap roles after every run: the current value is fed as the input and the spare
+  * buffer is pre-allocated as the output. So for a state whose output is declared with the shape of its input, runs
+  * neither copy nor allocate it. Other states, e.g. a cache that grows, are allocated by the executor in every run.
+  * Runs that use the states are serialized.
+  */
+class StatefulValues {
+ public:
+  struct State {
+    std::string input_name;
+    std::string output_name;
+    // type of the input tensor
+    MLDataType element_type = nullptr;
+    // the value of the input before the first run is all zeros if its shape is fully known
+    bool has_initial_shape = false;
+    std::vector<int64_t> initial_shape;
+    // whether the graph declares the same shape for the output as for the input, so that the output of a run is
+    // known to have the shape of the fed value before the run
+    bool output_shape_follows_input = false;
+  };
+
+  using RunFn = std::function<common::Status(const std::vector<std::string>& feed_names,
+                                             const std::vector<OrtValue>& feeds,
+                                             const std::vector<std::string>& output_names,
+                                             std::vector<OrtValue>& fetches)>;
+
+  /**
+    * @param allocator Allocator of the initial values.
+    */
+  StatefulValues(std::vector<State> states, AllocatorPtr allocator);
+
+  /**
+    * Calls run with the state inputs that are not fed and the state outputs that are not fetched added, then keeps
+    * the state outputs for the next run. A state input that is fed overrides the kept value, and a state output that
+    * is fetched is also returned. The states are not changed if run fails.
+    */
+  common::Status Run(const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
+                     const std::vector<std::string>& output_names, std::vector<OrtValue>& fetches,
+                     const RunFn& run);
+
+  /**
+    * Drops the kept values, so the next run starts from the initial values again.
+    */
+  void Reset();
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(StatefulValues);
+
+  struct Buffers {
+    OrtValue current;
+    OrtValue spare;
+    // whether the buffer is only referenced here, i.e. it was neither fed nor returned to the user, so it can be
+    // overwritten by a later run
+    bool current_reusable = false;
+    bool spare_reusable = false;
+  };
+
+  common::Status CreateInitialValue(const State& state, OrtValue& value) const;
+
+  const std::vector<State> states_;
+  const AllocatorPtr allocator_;
+  OrtMutex mutex_;
+  std::vector<Buffers> buffers_;
+};
+
+}  // namespace onnxruntime
@@ -18,6 +18,9 @@ struct OrtThreadPoolParams {
   bool auto_set_affinity = false;
   //If it is true, the thread pool will spin a while after the queue became empty.
   bool allow_spinning = true;
+  //If it is true and allow_spinning is true, the duration of the spin is adapted to the recent
+  //arrival times of work instead of using a fixed spin count.
+  bool adaptive_spinning = false;
 
   unsigned int stack_size = 0;
   //Index is thread id, value is processor ID
@@ -5,6 +5,7 @@
 #include "core/framework/data_types.h"
 #include "core/framework/data_types_internal.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
 
 #include "Featurizers/ForecastingPivotFeaturizer.h"
 #include "Featurizers/../Archive.h"
@@ -16,15 +17,21 @@ namespace featurizers {
 template <typename T>
 struct CopyImputedColumnsImpl {
   void operator()(const Tensor* input_tensor, Tensor* output_tensor_imputed,
-                  const std::vector<int64_t>& row_idx_record, int64_t input_matrix_size, int num_output_rows) const {
+                  const std::vector<int64_t>& row_idx_record, int64_t input_matrix_size, int num_output_rows,
+                  concurrency::ThreadPool* tp) const {
       const T* input_data(input_tensor->template Data<T>());
       T* output_data_imputed = output_tensor_imputed->MutableData<T>();
 
-      for (int imputed_output_row_idx = 0; imputed_output_row_idx < num_output_rows; imputed_output_row_idx++) {
-        output_data_imputed = std::copy(input_data + row_idx_record[imputed_output_row_idx] * input_matrix_size,
-                                        input_data + (row_idx_record[imputed_output_row_idx] + 1) * input_matrix_size,
-                                        output_data_imputed);
-      }
+      const double bytes_per_row = static_cast<double>(input_matrix_size * sizeof(T));
+      concurrency::ThreadPool::TryParallelFor(
+          tp, num_output_rows, TensorOpCost{bytes_per_row, bytes_per_row, static_cast<double>(input_matrix_size)},
+          [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            for (std::ptrdiff_t imputed_output_row_idx = first; imputed_output_row_idx < last; imputed_output_row_idx++) {
+              std::copy(input_data + row_idx_record[imputed_output_row_idx] * input_matrix_size,
+                        input_data + (row_idx_record[imputed_output_row_idx] + 1) * input_matrix_size,
+                        output_data_imputed + imputed_output_row_idx * input_matrix_size);
+            }
+          });
   }
 };
 
@@ -118,6 +125,8 @@ struct ForecastingPivotTransformerImpl {
     }
     transformer.flush(callback_fn);
 
+    concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+
     // Prepare the number of output rows
     ORT_ENFORCE(!output.empty(), "All rows dropped is an exception");
     int num_output_rows = static_cast<int>(output.size());
@@ -128,15 +137,30 @@ struct ForecastingPivotTransformerImpl {
     if (!output.empty() && !output[0].empty()) {
       num_pivot_output_columns = static_cast<int>(output[0].size());
 
+      for (const auto& pivot_output_row : output) {
+        ORT_ENFORCE(static_cast<int>(pivot_output_row.size()) == num_pivot_output_columns,
+                    "All the pivoted rows must have the same number of columns");
+      }
+
+      std::vector<T*> pivot_output_data(num_pivot_output_columns);
       for (int pivot_output_tensor_idx = 0; pivot_output_tensor_idx < num_pivot_output_columns; pivot_output_tensor_idx++) {
         TensorShape output_shape({static_cast<int64_t>(num_output_rows), 1});
         Tensor* output_tensor(ctx->Output(pivot_output_tensor_idx, output_shape));
-        T* output_data = output_tensor->MutableData<T>();
-
-        for (int pivot_output_row_idx = 0; pivot_output_row_idx < num_output_rows; pivot_output_row_idx++){
-          *output_data++ = output[pivot_output_row_idx][pivot_output_tensor_idx];
-        }
+        pivot_output_data[pivot_output_tensor_idx] = output_tensor->MutableData<T>();
       }
+
+      // Each pivoted row is read once and scattered to the output columns, one block of rows per thread
+      const double bytes_per_row = static_cast<double>(num_pivot_output_columns * sizeof(T));
+      concurrency::ThreadPool::TryParallelFor(
+          tp, num_output_rows, TensorOpCost{bytes_per_row, bytes_per_row, static_cast<double>(num_pivot_output_columns)},
+          [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            for (std::ptrdiff_t pivot_output_row_idx = first; pivot_output_row_idx < last; pivot_output_row_idx++) {
+              const OutputType& pivot_output_row = output[pivot_output_row_idx];
+              for (int pivot_output_tensor_idx = 0; pivot_output_tensor_idx < num_pivot_output_columns; pivot_output_tensor_idx++) {
+                pivot_output_data[pivot_output_tensor_idx][pivot_output_row_idx] = pivot_output_row[pivot_output_tensor_idx];
+              }
+            }
+          });
     }
 
     // Prepare the non-pivot(imputed) Output
@@ -158,7 +182,7 @@ struct ForecastingPivotTransformerImpl {
       utils::MLTypeCallDispatcher<int8_t, uint8_t, int16_t, uint16_t, int32_t, uint32_t, int64_t, uint64_t,
                                   float, double, bool, std::string>
           t_disp(elem_type);
-      t_disp.Invoke<CopyImputedColumnsImpl>(input_tensor, output_tensor_imputed, row_idx_record, input_matrix_size, num_output_rows);
+      t_disp.Invoke<CopyImputedColumnsImpl>(input_tensor, output_tensor_imputed, row_idx_record, input_matrix_size, num_output_rows, tp);
     }
 
     // Prepare the horizon Output(uint32)
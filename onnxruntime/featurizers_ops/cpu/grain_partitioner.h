@@ -0,0 +1,94 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace featurizers {
+
+// Grained transformers keep a separate state for each grain, so the rows of different grains can be
+// transformed concurrently by separate transformer instances as long as the rows of each grain are
+// transformed in their original order. Every partition deserializes its own transformer, which is only
+// worth it for a large enough number of rows.
+constexpr int64_t kMinRowsPerGrainPartition = 1024;
+
+/*
+Splits the rows into partitions such that all the rows of a grain are in the same partition, in ascending
+order. Returns a single partition with all the rows when the rows are too few to be worth splitting or
+the thread pool has a single thread.
+*/
+inline std::vector<std::vector<int64_t>> PartitionRowsByGrain(concurrency::ThreadPool* tp,
+                                                              const std::string* grains_data,
+                                                              int64_t grains_num,
+                                                              int64_t num_rows) {
+  const int64_t num_partitions = std::min<int64_t>(concurrency::ThreadPool::DegreeOfParallelism(tp),
+                                                   num_rows / kMinRowsPerGrainPartition);
+  std::vector<std::vector<int64_t>> partitions;
+  if (num_partitions <= 1) {
+    partitions.emplace_back(static_cast<size_t>(num_rows));
+    std::iota(partitions[0].begin(), partitions[0].end(), int64_t{0});
+    return partitions;
+  }
+
+  partitions.resize(static_cast<size_t>(num_partitions));
+  for (auto& partition : partitions) {
+    partition.reserve(static_cast<size_t>(num_rows / num_partitions));
+  }
+
+  std::hash<std::string> hasher;
+  for (int64_t row = 0; row < num_rows; ++row) {
+    size_t hash = 0;
+    for (int64_t i = 0; i < grains_num; ++i) {
+      hash = hash * 31 + hasher(grains_data[row * grains_num + i]);
+    }
+    partitions[hash % static_cast<size_t>(num_partitions)].push_back(row);
+  }
+
+  partitions.erase(std::remove_if(partitions.begin(), partitions.end(),
+                                  [](const std::vector<int64_t>& partition) { return partition.empty(); }),
+                   partitions.end());
+  return partitions;
+}
+
+/*
+Calls fn(partition_index) for every partition, concurrently on the thread pool. The thread pool does not
+propagate exceptions, so an exception thrown for a partition is rethrown on the calling thread once all
+the partitions are done.
+*/
+template <typename Fn>
+void ForEachGrainPartition(concurrency::ThreadPool* tp, size_t num_partitions, const Fn& fn) {
+  if (num_partitions == 1) {
+    fn(0);
+    return;
+  }
+
+  std::vector<Status> statuses(num_partitions);
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_partitions),
+      [&fn, &statuses](std::ptrdiff_t partition_index) {
+        ORT_TRY {
+          fn(static_cast<size_t>(partition_index));
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            statuses[partition_index] = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+          });
+        }
+      });
+
+  for (const auto& status : statuses) {
+    ORT_THROW_IF_ERROR(status);
+  }
+}
+
+}  // namespace featurizers
+}  // namespace onnxruntime
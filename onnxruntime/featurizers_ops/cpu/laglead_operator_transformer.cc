@@ -5,6 +5,9 @@
 #include "core/framework/data_types.h"
 #include "core/framework/data_types_internal.h"
 #include "core/framework/op_kernel.h"
+#include "featurizers_ops/cpu/grain_partitioner.h"
+
+#include <numeric>
 
 #include "Featurizers/LagLeadOperatorFeaturizer.h"
 #include "Featurizers/../Archive.h"
@@ -16,15 +19,31 @@ namespace featurizers {
 
 template <typename T>
 struct LagLeadOperatorTransformerImpl {
+  using GrainT = std::vector<std::string>;
+  using EstimatorT = Microsoft::Featurizer::Featurizers::GrainedLagLeadOperatorEstimator<T>;
+  using GrainedInputType = typename EstimatorT::InputType;
+  using OutputMatrixDataType = typename NS::Traits<T>::nullable_type;
+  using OutputMatrixType = NS::RowMajMatrix<OutputMatrixDataType>;
+  using OutputType = std::tuple<GrainT, OutputMatrixType>;
+
   void operator()(OpKernelContext* ctx) const {
+    // Get the Grains
+    const auto* grains_tensor(ctx->Input<Tensor>(1));
+    const std::string* grains_data(grains_tensor->Data<std::string>());
+    const int64_t grains_num = grains_tensor->Shape()[1];
+    const int64_t output_dim_0 = grains_tensor->Shape()[0];
 
-    using GrainT = std::vector<std::string>;
-    using EstimatorT = Microsoft::Featurizer::Featurizers::GrainedLagLeadOperatorEstimator<T>;
-    using GrainedInputType = typename EstimatorT::InputType;
-    using OutputMatrixDataType = typename NS::Traits<T>::nullable_type;
-    using OutputMatrixType = NS::RowMajMatrix<OutputMatrixDataType>;
-    using OutputType = std::tuple<GrainT, OutputMatrixType>;
+    concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+    auto partitions = PartitionRowsByGrain(tp, grains_data, grains_num, output_dim_0);
+    if (partitions.size() == 1) {
+      TransformSequentially(ctx);
+    } else {
+      TransformPartitions(ctx, tp, partitions);
+    }
+  }
 
+ private:
+  static void TransformSequentially(OpKernelContext* ctx) {
     //Get the transformer
     const auto* state_tensor(ctx->Input<Tensor>(0));
     const uint8_t* const state_data(state_tensor->Data<uint8_t>());
@@ -85,6 +104,131 @@ struct LagLeadOperatorTransformerImpl {
     }
     transformer.flush(callback_fn);
   }
+
+  // Outputs of a partition, buffered until the outputs of all the partitions are known
+  struct PartitionOutputs {
+    // outputs produced while executing a row, with the row they were produced for
+    std::vector<std::pair<int64_t, OutputType>> executed;
+    // outputs produced by flush
+    std::vector<OutputType> flushed;
+  };
+
+  /*
+  Transforms the partitions concurrently and writes their outputs in the order the sequential transform
+  produces them. While executing, the outputs produced by a row only depend on the state of its grain, so
+  they go at the position of that row. On flush, the grained transformer flushes its grains in ascending
+  order, so the flushed outputs of all the partitions are ordered by grain.
+  */
+  static void TransformPartitions(OpKernelContext* ctx, concurrency::ThreadPool* tp,
+                                  const std::vector<std::vector<int64_t>>& partitions) {
+    const auto* state_tensor(ctx->Input<Tensor>(0));
+    const uint8_t* const state_data(state_tensor->Data<uint8_t>());
+    const auto state_size = state_tensor->Shape().Size();
+
+    const auto* grains_tensor(ctx->Input<Tensor>(1));
+    const std::string* const grains_data(grains_tensor->Data<std::string>());
+    const int64_t grains_num = grains_tensor->Shape()[1];
+    const int64_t output_dim_0 = grains_tensor->Shape()[0];
+
+    const auto* target_tensor(ctx->Input<Tensor>(2));
+    const T* const target_data(target_tensor->Data<T>());
+
+    // every row belongs to a single partition, so the counts of the rows are written without races
+    std::vector<int64_t> output_offsets(static_cast<size_t>(output_dim_0) + 1, 0);
+    std::vector<PartitionOutputs> partition_outputs(partitions.size());
+    ForEachGrainPartition(tp, partitions.size(), [&](size_t partition_index) {
+      Microsoft::Featurizer::Archive archive(state_data, state_size);
+      typename EstimatorT::TransformerType transformer(archive);
+
+      PartitionOutputs& outputs = partition_outputs[partition_index];
+      int64_t row = 0;
+      std::function<void(OutputType)> callback_fn;
+      callback_fn = [&outputs, &output_offsets, &row](OutputType value) -> void {
+        outputs.executed.emplace_back(row, std::move(value));
+        ++output_offsets[row + 1];
+      };
+
+      GrainT grains;
+      grains.reserve(grains_num);
+      for (const int64_t partition_row : partitions[partition_index]) {
+        row = partition_row;
+        const std::string* const row_grains_data = grains_data + row * grains_num;
+        grains.assign(row_grains_data, row_grains_data + grains_num);
+        const GrainedInputType input_tuple(grains, target_data[row]);
+        transformer.execute(input_tuple, callback_fn);
+      }
+
+      std::function<void(OutputType)> flush_callback_fn;
+      flush_callback_fn = [&outputs](OutputType value) -> void {
+        outputs.flushed.emplace_back(std::move(value));
+      };
+      transformer.flush(flush_callback_fn);
+    });
+
+    std::partial_sum(output_offsets.begin(), output_offsets.end(), output_offsets.begin());
+    const int64_t num_executed = output_offsets.back();
+
+    std::vector<OutputType*> flushed;
+    for (auto& outputs : partition_outputs) {
+      for (auto& value : outputs.flushed) {
+        flushed.push_back(&value);
+      }
+    }
+    std::stable_sort(flushed.begin(), flushed.end(), [](const OutputType* lhs, const OutputType* rhs) {
+      return std::get<0>(*lhs) < std::get<0>(*rhs);
+    });
+    ORT_ENFORCE(num_executed + static_cast<int64_t>(flushed.size()) == output_dim_0,
+                "Number of outputs: ", num_executed + flushed.size(), " expected: ", output_dim_0);
+
+    // Prepare the OutputGrains
+    Tensor* output_grains_tensor(ctx->Output(0, grains_tensor->Shape()));
+    std::string* const output_grains_data = output_grains_tensor->MutableData<std::string>();
+
+    // Prepare the Output
+    const OutputMatrixType* first_matrix = nullptr;
+    for (const auto& outputs : partition_outputs) {
+      if (!outputs.executed.empty()) {
+        first_matrix = &std::get<1>(outputs.executed.front().second);
+        break;
+      }
+    }
+    if (first_matrix == nullptr) {
+      first_matrix = &std::get<1>(*flushed.front());
+    }
+    const int64_t matrix_rows = first_matrix->rows();
+    const int64_t matrix_cols = first_matrix->cols();
+    TensorShape output_shape({output_dim_0, matrix_rows, matrix_cols});
+    T* const output_data = ctx->Output(1, output_shape)->template MutableData<T>();
+
+    auto write_output = [&](int64_t output_index, OutputType& value) {
+      GrainT& output_grains(std::get<0>(value));
+      const OutputMatrixType& output_matrix(std::get<1>(value));
+      ORT_ENFORCE(static_cast<int64_t>(output_grains.size()) == grains_num &&
+                      output_matrix.rows() == matrix_rows && output_matrix.cols() == matrix_cols,
+                  "All the outputs must have the same shape");
+      std::move(output_grains.begin(), output_grains.end(), output_grains_data + output_index * grains_num);
+      Eigen::Map<OutputMatrixType> output_matrix_mapping(output_data + output_index * matrix_rows * matrix_cols,
+                                                         matrix_rows, matrix_cols);
+      output_matrix_mapping = output_matrix;
+    };
+
+    ForEachGrainPartition(tp, partition_outputs.size(), [&](size_t partition_index) {
+      int64_t previous_row = -1;
+      int64_t output_index = 0;
+      for (auto& executed : partition_outputs[partition_index].executed) {
+        if (executed.first != previous_row) {
+          previous_row = executed.first;
+          output_index = output_offsets[previous_row];
+        }
+        write_output(output_index++, executed.second);
+      }
+    });
+
+    int64_t output_index = num_executed;
+    for (OutputType* value : flushed) {
+      write_output(output_index++, *value);
+    }
+  }
 };
 
 class LagLeadOperatorTransformer final : public OpKernel {
@@ -5,6 +5,9 @@
 #include "core/framework/data_types.h"
 #include "core/framework/data_types_internal.h"
 #include "core/framework/op_kernel.h"
+#include "featurizers_ops/cpu/grain_partitioner.h"
+
+#include <mutex>
 
 #include "Featurizers/AnalyticalRollingWindowFeaturizer.h"
 #include "Featurizers/SimpleRollingWindowFeaturizer.h"
@@ -20,55 +23,71 @@ void RollingWindowTransformerImpl(OpKernelContext* ctx) {
   using GrainedInputType = typename EstimatorT::InputType;
   using OutputType = typename EstimatorT::TransformedType;
 
-  //Get the transformer
+  //Get the transformer state
   const auto* state_tensor(ctx->Input<Tensor>(0));
   const uint8_t* const state_data(state_tensor->Data<uint8_t>());
-  Microsoft::Featurizer::Archive archive(state_data, state_tensor->Shape().Size());
-  typename EstimatorT::TransformerType transformer(archive);
+  const auto state_size = state_tensor->Shape().Size();
 
   // Get the Grains
   const auto* grains_tensor(ctx->Input<Tensor>(1));
-  const std::string* grains_data(grains_tensor->Data<std::string>());
+  const std::string* const grains_data(grains_tensor->Data<std::string>());
   const auto grains_num = grains_tensor->Shape()[1];
 
   // Get the Target
   const auto* target_tensor(ctx->Input<Tensor>(2));
-  const T* target_data(target_tensor->Data<T>());
+  const T* const target_data(target_tensor->Data<T>());
 
   // Prepare the output
   const auto output_dim_0 = grains_tensor->Shape()[0];
 
+  // Each row produces exactly one output, so the rows of different grains can be transformed concurrently
+  // and their outputs written at the position of the row
   MatrixElementType* output_data = nullptr;
-  bool has_allocate_output_data = false;
-  std::function<void(OutputType)> callback_fn;
-  callback_fn = [ctx, &output_data, &has_allocate_output_data, output_dim_0](OutputType value) -> void {
-    //Allocate tensor memory after first output is generated
-    if(!has_allocate_output_data) {
-      TensorShape output_shape({output_dim_0, 1, static_cast<int64_t>(value.size())});
-      Tensor* output_tensor(ctx->Output(0, output_shape));
-      output_data = output_tensor->MutableData<MatrixElementType>();
-      has_allocate_output_data = true;
-    }
-    Eigen::Map<OutputType> output_matrix_mapping(output_data, value.rows(), value.cols());
-    output_matrix_mapping = value;
-    output_data += value.size();
+  int64_t output_row_size = 0;
+  std::once_flag allocate_output_flag;
+  auto allocate_output = [ctx, &output_data, &output_row_size, output_dim_0](const OutputType& value) {
+    output_row_size = static_cast<int64_t>(value.size());
+    TensorShape output_shape({output_dim_0, 1, output_row_size});
+    Tensor* output_tensor(ctx->Output(0, output_shape));
+    output_data = output_tensor->MutableData<MatrixElementType>();
   };
 
-  // Transform
-  GrainT grains;
-  grains.reserve(grains_num);
-  for (int64_t i = 0; i < output_dim_0; ++i) {
-    //Prepare Input
-    grains.clear();
-    std::copy(grains_data, grains_data + grains_num, std::back_inserter(grains));
-    const GrainedInputType input_tuple(grains, *target_data);
-    //Execute
-    transformer.execute(input_tuple, callback_fn);
-    //Increment Pointer
-    target_data++;
-    grains_data += grains_num;
-  }
-  transformer.flush(callback_fn);
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  const auto partitions = PartitionRowsByGrain(tp, grains_data, grains_num, output_dim_0);
+  ForEachGrainPartition(tp, partitions.size(), [&](size_t partition_index) {
+    Microsoft::Featurizer::Archive archive(state_data, state_size);
+    typename EstimatorT::TransformerType transformer(archive);
+
+    int64_t row = 0;
+    std::function<void(OutputType)> callback_fn;
+    callback_fn = [&](OutputType value) -> void {
+      //Allocate tensor memory after first output is generated
+      std::call_once(allocate_output_flag, allocate_output, value);
+      ORT_ENFORCE(static_cast<int64_t>(value.size()) == output_row_size,
+                  "All the outputs must have the same size. Expected: ", output_row_size, " got: ", value.size());
+      Eigen::Map<OutputType> output_matrix_mapping(output_data + row * output_row_size, value.rows(), value.cols());
+      output_matrix_mapping = value;
+    };
+
+    // Transform
+    GrainT grains;
+    grains.reserve(grains_num);
+    for (const int64_t partition_row : partitions[partition_index]) {
+      //Prepare Input
+      row = partition_row;
+      const std::string* const row_grains_data = grains_data + row * grains_num;
+      grains.assign(row_grains_data, row_grains_data + grains_num);
+      const GrainedInputType input_tuple(grains, target_data[row]);
+      //Execute
+      transformer.execute(input_tuple, callback_fn);
+    }
+    // every output belongs to a row, so nothing is expected to be left at this point
+    std::function<void(OutputType)> flush_callback_fn;
+    flush_callback_fn = [](OutputType) -> void {
+      ORT_THROW("Rolling window transformer produced an output without an input row");
+    };
+    transformer.flush(flush_callback_fn);
+  });
 }
 
 template <typename T>
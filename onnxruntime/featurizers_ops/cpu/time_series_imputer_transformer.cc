@@ -4,6 +4,7 @@
 #include "core/common/common.h"
 #include "core/framework/data_types.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
 
 #include <cstdlib>
 #include <limits>
@@ -206,10 +207,12 @@ struct TimeSeriesImputerTransformerImpl {
       const T* const key_row_data = keys_data + (row * keys_per_row);
       const T* const keys_row_end = key_row_data + keys_per_row;
       std::vector<std::string> str_keys;
+      str_keys.reserve(keys_per_row);
       std::transform(key_row_data, keys_row_end, std::back_inserter(str_keys),
                      ToString<T>());
 
       std::vector<nonstd::optional<std::string>> str_data;
+      str_data.reserve(columns);
       const T* const data_row = data_data + (row * columns);
       const T* const data_row_end = data_row + columns;
       std::transform(data_row, data_row_end, std::back_inserter(str_data),
@@ -238,21 +241,32 @@ struct TimeSeriesImputerTransformerImpl {
     std::vector<bool> is_row_imputed;
     is_row_imputed.reserve(output_rows_num);
     for (const auto& out : output_rows) {
+      ORT_ENFORCE(static_cast<int64_t>(std::get<2>(out).size()) == keys_per_row,
+                  "resulting number of keys: ", std::get<2>(out).size(), " expected: ", keys_per_row);
+      ORT_ENFORCE(static_cast<int64_t>(std::get<3>(out).size()) == columns,
+                  "resulting number of columns: ", std::get<3>(out).size(), " expected: ", columns);
       is_row_imputed.push_back(std::get<0>(out));
-      *added_output++ = std::get<0>(out);
-      *time_output++ = ToSecs(std::get<1>(out));
-      const auto& imputed_keys = std::get<2>(out);
-      ORT_ENFORCE(static_cast<int64_t>(imputed_keys.size()) == keys_per_row,
-                  "resulting number of keys: ", imputed_keys.size(), " expected: ", keys_per_row);
-      const auto& imputed_data = std::get<3>(out);
-      ORT_ENFORCE(static_cast<int64_t>(imputed_data.size()) == columns,
-                  "resulting number of columns: ", imputed_data.size(), " expected: ", columns);
-      keys_output = std::transform(imputed_keys.cbegin(), imputed_keys.cend(), keys_output,
-                                   FromString<T>());
-      data_output = std::transform(imputed_data.cbegin(), imputed_data.cend(), data_output,
-                                   FromStringOptional<T>());
     }
 
+    // The transformer has to see the rows in order, but the output rows are converted independently
+    const double values_per_row = static_cast<double>(keys_per_row + columns);
+    concurrency::ThreadPool::TryParallelFor(
+        ctx->GetOperatorThreadPool(), output_rows_num,
+        TensorOpCost{values_per_row * sizeof(std::string), values_per_row * sizeof(T), values_per_row * 16},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t row = first; row < last; ++row) {
+            const auto& out = output_rows[row];
+            added_output[row] = std::get<0>(out);
+            time_output[row] = ToSecs(std::get<1>(out));
+            const auto& imputed_keys = std::get<2>(out);
+            std::transform(imputed_keys.cbegin(), imputed_keys.cend(), keys_output + row * keys_per_row,
+                           FromString<T>());
+            const auto& imputed_data = std::get<3>(out);
+            std::transform(imputed_data.cbegin(), imputed_data.cend(), data_output + row * columns,
+                           FromStringOptional<T>());
+          }
+        });
+
     const int variadic_input_start_id = ctx->NumVariadicInputs(0) + ctx->NumVariadicInputs(1) + ctx->NumVariadicInputs(2) + 1;
     const int variadic_input_end_id = variadic_input_start_id + ctx->NumVariadicInputs(3) - 1;
     for (int input_id = variadic_input_start_id; input_id < variadic_input_end_id; ++input_id) {
@@ -177,7 +177,8 @@ class Session:
 
             sess.run([output_name], {input_name: x})
         """
-        num_required_inputs = len(self._inputs_meta)
+        # the stateful inputs are fed by the session unless they are given
+        num_required_inputs = len(self._inputs_meta) - len(self._sess_options.stateful_input_names)
         num_inputs = len(input_feed)
         # the graph may have optional inputs used to override initializers. allow for that.
         if num_inputs < num_required_inputs:
@@ -197,6 +198,34 @@ class Session:
             else:
                 raise
 
+    def run_with_outputs(self, output_names, input_feed, outputs, run_options=None):
+        """
+        Compute the predictions and write them into preallocated numpy arrays.
+        The arrays can be reused across calls to avoid allocating the outputs for every run.
+
+        :param output_names: name of the outputs
+        :param input_feed: dictionary ``{ input_name: input_value }``
+        :param outputs: list of numpy arrays receiving the outputs, in the order of ``output_names``.
+            Each array must be contiguous, writeable and have the type and shape of the output.
+        :param run_options: See :class:`onnxruntime.RunOptions`.
+        :return: ``outputs``
+
+        ::
+
+            y = np.empty((3, 2), dtype=np.float32)
+            sess.run_with_outputs([output_name], {input_name: x}, [y])
+        """
+        # the stateful inputs are fed by the session unless they are given
+        num_required_inputs = len(self._inputs_meta) - len(self._sess_options.stateful_input_names)
+        num_inputs = len(input_feed)
+        # the graph may have optional inputs used to override initializers. allow for that.
+        if num_inputs < num_required_inputs:
+            raise ValueError("Model requires {} inputs. Input Feed contains {}".format(num_required_inputs, num_inputs))
+        if not output_names:
+            output_names = [output.name for output in self._outputs_meta]
+        self._sess.run_with_outputs(output_names, input_feed, outputs, run_options)
+        return outputs
+
     def end_profiling(self):
         """
         End profiling and return results in a file.
@@ -228,6 +257,14 @@ class Session:
         """
         self._sess.run_with_iobinding(iobinding._iobinding, run_options)
 
+    def reset_states(self):
+        """
+        Drop the values kept for the inputs added with
+        :meth:`onnxruntime.SessionOptions.add_stateful_input_output`, e.g. at the start of a new stream.
+        The next run starts from the initial values of the states again.
+        """
+        self._sess.reset_states()
+
 
 class InferenceSession(Session):
     """
@@ -495,6 +532,30 @@ class OrtValue:
         return OrtValue(C.OrtValue.ortvalue_from_shape_and_type(shape, element_type,
                         C.OrtDevice(get_ort_device_type(device_type), C.OrtDevice.default_memory(), device_id)))
 
+    @staticmethod
+    def from_dlpack(data, is_bool_tensor=False):
+        '''
+        Factory method to construct an OrtValue (which holds a Tensor) from a DLPack capsule or from an object
+        implementing the DLPack protocol, e.g. a Numpy array or a PyTorch tensor. The OrtValue shares the data
+        buffer of the given object instead of copying it.
+        :param data: DLPack capsule or object with a `__dlpack__` method
+        :param is_bool_tensor: DLPack represents bool tensors as uint8 tensors, set to True to create a bool tensor
+        '''
+        return OrtValue(C.OrtValue.from_dlpack(data, is_bool_tensor))
+
+    def to_dlpack(self):
+        '''
+        Returns a DLPack capsule sharing the data buffer of the OrtValue, e.g. for `torch.utils.dlpack.from_dlpack`.
+        Valid only for OrtValues holding Tensors.
+        '''
+        return self._ortvalue.to_dlpack()
+
+    def __dlpack__(self, stream=None):
+        return self._ortvalue.__dlpack__(stream)
+
+    def __dlpack_device__(self):
+        return self._ortvalue.__dlpack_device__()
+
     def data_ptr(self):
         '''
         Returns the address of the first element in the OrtValue's data buffer
@@ -481,6 +481,23 @@ static void CreateTensorMLValue(const AllocatorPtr& alloc, const std::string& na
                   ml_tensor->GetDeleteFunc());
 }
 
+void CreateNumpyOutputMLValue(const AllocatorPtr& alloc, const std::string& name_output, py::object& value,
+                              OrtValue* p_mlvalue) {
+  if (!PyObjectCheck_NumpyArray(value.ptr())) {
+    throw std::runtime_error("The value supplied for output '" + name_output + "' must be a numpy array.");
+  }
+
+  // The session writes into the array memory, so the array must be usable as is.
+  PyArrayObject* arr = reinterpret_cast<PyArrayObject*>(value.ptr());
+  if (!IsNumericNumpyType(PyArray_TYPE(arr)) || !PyArray_IS_C_CONTIGUOUS(arr) ||
+      !PyArray_ISALIGNED(arr) || !PyArray_ISWRITEABLE(arr)) {
+    throw std::runtime_error("The array supplied for output '" + name_output +
+                             "' must be a writeable, aligned and contiguous numeric array.");
+  }
+
+  CreateTensorMLValue(alloc, name_output, arr, p_mlvalue, true);
+}
+
 // This function will create a Tensor that owns the python array memory. This is done to properly
 // release python arrays allocated within the pybind code.
 static void CreateTensorMLValueOwned(const OrtPybindSingleUseAllocatorPtr& pybind_alloc, const AllocatorPtr& alloc, OrtValue* p_mlvalue) {
@@ -79,6 +79,11 @@ void CreateGenericMLValue(const onnxruntime::InputDefList* input_def_list, const
                           const std::string& name_input, py::object& value, OrtValue* p_mlvalue,
                           bool accept_only_numpy_array = false, bool use_numpy_data_memory = true, MemCpyFunc mem_cpy_to_device = CpuToCpuMemCpy);
 
+// Creates an OrtValue for a session output that uses the memory of the supplied
+// numpy array. The array must stay alive until the OrtValue is released.
+void CreateNumpyOutputMLValue(const AllocatorPtr& alloc, const std::string& name_output, py::object& value,
+                              OrtValue* p_mlvalue);
+
 void GetPyObjFromTensor(const Tensor& rtensor, py::object& obj,
                         const DataTransferManager* data_transfer_manager = nullptr,
                         const std::unordered_map<OrtDevice::DeviceType, MemCpyFunc>* mem_cpy_to_host_functions = nullptr);
@@ -201,14 +201,28 @@ void addOrtValueMethods(pybind11::module& m) {
 #endif
         return obj;
       })
-#ifdef ENABLE_TRAINING
+      // The DLPack functions share the tensor data with the other framework instead of copying it.
       .def("to_dlpack", [](OrtValue* ort_value) -> py::object {
         return py::reinterpret_steal<py::object>(ToDlpack(*ort_value));
       })
-      .def_static("from_dlpack", [](py::object data, bool is_bool_tensor = false) {
-        return FromDlpack(data.ptr(), is_bool_tensor);
+      .def_static(
+          "from_dlpack", [](py::object data, bool is_bool_tensor) {
+            // objects implementing the DLPack protocol, e.g. numpy arrays or torch tensors, export a capsule
+            if (py::hasattr(data, "__dlpack__")) {
+              data = data.attr("__dlpack__")();
+            }
+            return FromDlpack(data.ptr(), is_bool_tensor);
+          },
+          py::arg("data"), py::arg("is_bool_tensor") = false)
+      .def(
+          "__dlpack__", [](OrtValue* ort_value, py::object /*stream*/) -> py::object {
+            return py::reinterpret_steal<py::object>(ToDlpack(*ort_value));
+          },
+          py::arg("stream") = py::none())
+      .def("__dlpack_device__", [](const OrtValue* ort_value) -> py::tuple {
+        DLContext ctx = dlpack::GetDlpackContext(*ort_value);
+        return py::make_tuple(static_cast<int>(ctx.device_type), ctx.device_id);
       })
-#endif
       ;
 }
 
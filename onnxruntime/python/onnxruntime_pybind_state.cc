@@ -282,6 +282,81 @@ void AddTensorAsPyObj(const OrtValue& val, std::vector<py::object>& pyobjs,
   pyobjs.push_back(obj);
 }
 
+// Returns true if the tensor can be returned to python without copying the data,
+// which requires a CPU tensor with an element type that numpy stores inline.
+static bool CanShareTensorDataWithNumpy(const Tensor& rtensor) {
+  return rtensor.Location().device.Type() == OrtDevice::CPU &&
+         IsNumericNumpyType(OnnxRuntimeTensorToNumpyType(rtensor.DataType()));
+}
+
+// Wraps the buffer of a CPU tensor in a numpy array without copying the data.
+// The array holds a capsule that owns a reference to the OrtValue as its base
+// object, so the buffer stays alive as long as the array or any view of it.
+static py::object GetPyObjFromTensorNoCopy(const OrtValue& val) {
+  const Tensor& rtensor = val.Get<Tensor>();
+  const TensorShape& shape = rtensor.Shape();
+
+  std::vector<npy_intp> npy_dims;
+  for (size_t n = 0; n < shape.NumDimensions(); ++n) {
+    npy_dims.push_back(shape[n]);
+  }
+
+  const int numpy_type = OnnxRuntimeTensorToNumpyType(rtensor.DataType());
+  auto obj = py::reinterpret_steal<py::object>(PyArray_SimpleNewFromData(
+      shape.NumDimensions(), npy_dims.data(), numpy_type, const_cast<void*>(rtensor.DataRaw())));
+  if (!obj) {
+    throw py::error_already_set();
+  }
+
+  py::capsule owner(new OrtValue(val), [](void* p) { delete reinterpret_cast<OrtValue*>(p); });
+
+  // PyArray_SetBaseObject steals the reference to the capsule.
+  if (PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(obj.ptr()), owner.release().ptr()) != 0) {
+    throw py::error_already_set();
+  }
+
+  return obj;
+}
+
+// Returns true if the buffer of a fetched output belongs to the run that produced it. Kernels that
+// alias their input (e.g. Identity or Reshape) may return the buffer of a feed or of an initializer,
+// possibly under a different name, and handing that to numpy without a copy would let the caller
+// write into it, or leave the array dangling once the feed or the session is released.
+static bool IsOutputOwnedByRun(const InferenceSession& session, const Tensor& output, const NameMLValMap& feeds) {
+  if (!output.OwnsBuffer()) {
+    return false;
+  }
+
+  const void* data = output.DataRaw();
+  for (const auto& feed : feeds) {
+    if (feed.second.IsTensor() && feed.second.Get<Tensor>().DataRaw() == data) {
+      return false;
+    }
+  }
+
+  for (const auto& initializer : session.GetSessionState().GetInitializedTensors()) {
+    if (initializer.second.IsTensor() && initializer.second.Get<Tensor>().DataRaw() == data) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static void CreateFeedsFromPyObjects(PyInferenceSession* sess, std::map<std::string, py::object>& pyfeeds,
+                                     NameMLValMap& feeds) {
+  auto px = sess->GetSessionHandle()->GetModelInputs();
+  if (!px.first.IsOK() || !px.second) {
+    throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
+  }
+  for (auto& _ : pyfeeds) {
+    OrtValue ml_value;
+    CreateGenericMLValue(px.second, GetAllocator(), _.first, _.second, &ml_value);
+    ThrowIfPyErrOccured();
+    feeds.insert(std::make_pair(_.first, ml_value));
+  }
+}
+
 static inline void RegisterExecutionProvider(InferenceSession* sess, onnxruntime::IExecutionProviderFactory& f) {
   auto p = f.CreateProvider();
   OrtPybindThrowIfError(sess->RegisterExecutionProvider(std::move(p)));
@@ -1321,6 +1396,23 @@ Applies to session load, initialization, etc. Default is 0.)pbdoc")
                                 onnxruntime::FreeDimensionOverrideType::Name,
                                 dim_value}); },
           R"pbdoc(Specify values of named dimensions within model inputs.)pbdoc")
+      .def(
+          "add_stateful_input_output",
+          [](PySessionOptions* options, const char* input_name, const char* output_name) -> void {
+            options->stateful_inputs_outputs.push_back(onnxruntime::StatefulInputOutput{input_name, output_name});
+          },
+          R"pbdoc(Keep the value of a graph output between runs and feed it as the given graph input of the next run,
+e.g. the hidden state of a recurrent model that is run on a stream chunk by chunk.)pbdoc")
+      .def_property_readonly(
+          "stateful_input_names",
+          [](const PySessionOptions* options) -> std::vector<std::string> {
+            std::vector<std::string> names;
+            for (const auto& input_output : options->stateful_inputs_outputs) {
+              names.push_back(input_output.input_name);
+            }
+            return names;
+          },
+          R"pbdoc(Names of the graph inputs added with add_stateful_input_output, which don't need to be fed.)pbdoc")
       .def(
           "add_session_config_entry",
           [](PySessionOptions* options, const char* config_key, const char* config_value) -> void {
@@ -1513,16 +1605,7 @@ including arg name, arg type (contains both type and shape).)pbdoc")
               std::map<std::string, py::object> pyfeeds, RunOptions* run_options = nullptr)
                -> std::vector<py::object> {
              NameMLValMap feeds;
-             for (auto _ : pyfeeds) {
-               OrtValue ml_value;
-               auto px = sess->GetSessionHandle()->GetModelInputs();
-               if (!px.first.IsOK() || !px.second) {
-                 throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
-               }
-               CreateGenericMLValue(px.second, GetAllocator(), _.first, _.second, &ml_value);
-               ThrowIfPyErrOccured();
-               feeds.insert(std::make_pair(_.first, ml_value));
-             }
+             CreateFeedsFromPyObjects(sess, pyfeeds, feeds);
 
              std::vector<OrtValue> fetches;
              common::Status status;
@@ -1537,20 +1620,85 @@ including arg name, arg type (contains both type and shape).)pbdoc")
                }
              }
 
+             // The fetches are in the order of the model outputs when no names are given.
+             if (output_names.empty()) {
+               auto px = sess->GetSessionHandle()->GetModelOutputs();
+               OrtPybindThrowIfError(px.first);
+               for (const auto* output_def : *px.second) {
+                 output_names.push_back(output_def->Name());
+               }
+             }
+
              std::vector<py::object> rfetch;
              rfetch.reserve(fetches.size());
-             for (auto _ : fetches) {
+             for (size_t i = 0; i < fetches.size(); ++i) {
+               const OrtValue& _ = fetches[i];
                if (_.IsTensor()) {
-                 AddTensorAsPyObj(_, rfetch, nullptr, nullptr);
+                 // The fetches produced by this call are handed to numpy directly
+                 // instead of being copied.
+                 if (CanShareTensorDataWithNumpy(_.Get<Tensor>()) &&
+                     IsOutputOwnedByRun(*sess->GetSessionHandle(), _.Get<Tensor>(), feeds)) {
+                   rfetch.push_back(GetPyObjFromTensorNoCopy(_));
+                 } else {
+                   AddTensorAsPyObj(_, rfetch, nullptr, nullptr);
+                 }
                } else {
                  AddNonTensorAsPyObj(_, rfetch, nullptr, nullptr);
                }
              }
              return rfetch;
            })
+      .def("run_with_outputs",
+           [](PyInferenceSession* sess, std::vector<std::string> output_names,
+              std::map<std::string, py::object> pyfeeds, std::vector<py::object> pyoutputs,
+              RunOptions* run_options = nullptr) -> void {
+             if (output_names.size() != pyoutputs.size()) {
+               throw std::runtime_error("The number of output arrays must match the number of output names");
+             }
+
+             NameMLValMap feeds;
+             CreateFeedsFromPyObjects(sess, pyfeeds, feeds);
+
+             // The session writes the outputs directly into the buffers of the
+             // supplied arrays.
+             std::vector<OrtValue> fetches(pyoutputs.size());
+             std::vector<MLDataType> output_types(pyoutputs.size());
+             for (size_t i = 0; i < pyoutputs.size(); ++i) {
+               CreateNumpyOutputMLValue(GetAllocator(), output_names[i], pyoutputs[i], &fetches[i]);
+               output_types[i] = fetches[i].Get<Tensor>().DataType();
+             }
+
+             {
+               // release GIL to allow multiple python threads to invoke Run() in parallel.
+               py::gil_scoped_release release;
+               if (run_options != nullptr) {
+                 OrtPybindThrowIfError(sess->GetSessionHandle()->Run(*run_options, feeds, output_names, &fetches));
+               } else {
+                 OrtPybindThrowIfError(sess->GetSessionHandle()->Run(feeds, output_names, &fetches));
+               }
+             }
+
+             // An output may be produced in a different buffer, for example when
+             // it is also a graph input, so copy it into the supplied array.
+             for (size_t i = 0; i < fetches.size(); ++i) {
+               const Tensor& rtensor = fetches[i].Get<Tensor>();
+               auto* darray = reinterpret_cast<PyArrayObject*>(pyoutputs[i].ptr());
+               if (rtensor.DataRaw() != PyArray_DATA(darray)) {
+                 const size_t num_bytes = rtensor.SizeInBytes();
+                 ORT_ENFORCE(rtensor.DataType() == output_types[i] &&
+                                 num_bytes == static_cast<size_t>(PyArray_NBYTES(darray)),
+                             "The array supplied for output '", output_names[i], "' does not match the output ",
+                             rtensor.Shape());
+                 memcpy(PyArray_DATA(darray), rtensor.DataRaw(), num_bytes);
+               }
+             }
+           })
       .def("end_profiling", [](const PyInferenceSession* sess) -> std::string {
         return sess->GetSessionHandle()->EndProfiling();
       })
+      .def("reset_states", [](PyInferenceSession* sess) -> void {
+        sess->GetSessionHandle()->ResetStates();
+      })
       .def_property_readonly("get_profiling_start_time_ns", [](const PyInferenceSession* sess) -> uint64_t {
         return sess->GetSessionHandle()->GetProfiling().GetStartTimeNs();
       })
@@ -43,8 +43,6 @@ onnxruntime::ROCMExecutionProviderExternalAllocatorInfo external_allocator_info{
 onnxruntime::ArenaExtendStrategy arena_extend_strategy = onnxruntime::ArenaExtendStrategy::kNextPowerOfTwo;
 #endif
 
-#ifdef ENABLE_TRAINING
-
 static void DlpackCapsuleDestructor(PyObject* data) {
   DLManagedTensor* dlmanged_tensor = reinterpret_cast<DLManagedTensor*>(
       PyCapsule_GetPointer(data, "dltensor"));
@@ -71,13 +69,16 @@ PyObject* ToDlpack(OrtValue ort_value) {
 OrtValue FromDlpack(PyObject* dlpack_tensor, const bool is_bool_tensor) {
   // Extract DLPack tensor pointer from the capsule carrier.
   DLManagedTensor* dlmanaged_tensor = (DLManagedTensor*)PyCapsule_GetPointer(dlpack_tensor, "dltensor");
+  if (!dlmanaged_tensor) {
+    // PyCapsule_GetPointer has set an error indicator.
+    PyErr_Clear();
+    ORT_THROW("Expected a DLPack capsule that was not consumed yet.");
+  }
   OrtValue ort_value = dlpack::DlpackToOrtValue(dlmanaged_tensor, is_bool_tensor);
   // Make sure this capsule will never be used again.
   PyCapsule_SetName(dlpack_tensor, "used_dltensor");
   return ort_value;
 }
 
-#endif
-
 }  // namespace python
 }  // namespace onnxruntime
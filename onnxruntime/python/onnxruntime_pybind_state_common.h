@@ -10,9 +10,7 @@
 #include "core/session/environment.h"
 #include "core/session/inference_session.h"
 
-#ifdef ENABLE_TRAINING
 #include "core/dlpack/dlpack_converter.h"
-#endif
 
 // execution provider factory creator headers
 struct OrtStatus {
@@ -341,8 +339,6 @@ bool CheckIfTensor(const std::vector<const NodeArg*>& def_list,
                    const std::string& name,
                    /*out*/ ONNX_NAMESPACE::TypeProto& type_proto);
 
-#ifdef ENABLE_TRAINING
-
 // Allocate a new Capsule object, which takes the ownership of OrtValue.
 // Caller is responsible for releasing.
 // This function calls OrtValueToDlpack(...).
@@ -352,7 +348,5 @@ PyObject* ToDlpack(OrtValue ort_value);
 // create a OrtValue. This function calls DlpackToOrtValue(...) to do the conversion.
 OrtValue FromDlpack(PyObject* dlpack_tensor, const bool is_bool_tensor);
 
-#endif
-
 }  // namespace python
 }  // namespace onnxruntime
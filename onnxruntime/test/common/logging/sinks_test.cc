@@ -1,8 +1,16 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
+
 #include "core/common/logging/capture.h"
 #include "core/common/logging/logging.h"
+#include "core/common/logging/sinks/async_sink.h"
 #include "core/common/logging/sinks/cerr_sink.h"
 #include "core/common/logging/sinks/clog_sink.h"
 #include "core/common/logging/sinks/composite_sink.h"
@@ -26,6 +34,28 @@ void DeleteFile(const std::string& filename) {
   int result = std::remove(filename.c_str());
   EXPECT_EQ(result, 0);
 }
+
+// A string buffer that blocks writes until it is released.
+class BlockingStringBuf : public std::stringbuf {
+ public:
+  void Release() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    released_ = true;
+    released_cv_.notify_all();
+  }
+
+ protected:
+  std::streamsize xsputn(const char* s, std::streamsize count) override {
+    std::unique_lock<std::mutex> lock(mutex_);
+    released_cv_.wait(lock, [this]() { return released_; });
+    return std::stringbuf::xsputn(s, count);
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable released_cv_;
+  bool released_ = false;
+};
 }  // namespace
 
 /// <summary>
@@ -144,3 +174,125 @@ TEST(LoggingTests, TestCompositeSink) {
 
   LOGS_CATEGORY(*logger, WARNING, "ArbitraryCategory") << "Warning";
 }
+
+/// <summary>
+/// Tests that the async sink writes all the messages.
+/// </summary>
+TEST(LoggingTests, TestAsyncSink) {
+  const std::string logid{"AsyncSink"};
+  const Severity min_log_level = Severity::kWARNING;
+  const int num_messages = 100;
+
+  std::ostringstream stream;
+
+  // create scoped manager so sink gets destroyed once done
+  {
+    AsyncSink* sink = new AsyncSink{stream};
+    LoggingManager manager{std::unique_ptr<ISink>{sink}, min_log_level, false, InstanceType::Temporal};
+
+    auto logger = manager.CreateLogger(logid);
+
+    for (int i = 0; i < num_messages; ++i) {
+      LOGS(*logger, WARNING) << "Test async message " << i;
+    }
+
+    sink->Flush();
+    EXPECT_EQ(sink->WrittenMessageCount(), static_cast<uint64_t>(num_messages));
+    EXPECT_EQ(sink->DroppedMessageCount(), 0u);
+  }
+
+  const std::string output = stream.str();
+  EXPECT_NE(output.find("Test async message 0\n"), std::string::npos);
+  EXPECT_NE(output.find("Test async message 99\n"), std::string::npos);
+}
+
+/// <summary>
+/// Tests that the async sink drops and reports messages when its queue is full.
+/// </summary>
+TEST(LoggingTests, TestAsyncSinkDropsOnOverflow) {
+  const std::string logid{"AsyncSinkOverflow"};
+  const Severity min_log_level = Severity::kWARNING;
+  const int num_messages = 10;
+  const size_t capacity = 2;
+
+  BlockingStringBuf buffer;
+  std::ostream stream{&buffer};
+
+  {
+    AsyncSink* sink = new AsyncSink{stream, capacity};
+    LoggingManager manager{std::unique_ptr<ISink>{sink}, min_log_level, false, InstanceType::Temporal};
+
+    auto logger = manager.CreateLogger(logid);
+
+    // the writer is blocked on the first message it dequeues, so at most capacity + 1 messages are kept
+    for (int i = 0; i < num_messages; ++i) {
+      LOGS(*logger, WARNING) << "Test overflow message " << i;
+    }
+
+    EXPECT_GE(sink->DroppedMessageCount(), static_cast<uint64_t>(num_messages - capacity - 1));
+
+    buffer.Release();
+  }
+
+  EXPECT_NE(buffer.str().find("log messages because the queue was full"), std::string::npos);
+}
+
+/// <summary>
+/// Tests that the async sink neither loses nor duplicates messages sent concurrently by multiple threads.
+/// </summary>
+TEST(LoggingTests, TestAsyncSinkMultipleProducers) {
+  const std::string logid{"AsyncSinkProducers"};
+  const Severity min_log_level = Severity::kWARNING;
+  const int num_threads = 8;
+  const int num_messages_per_thread = 1000;
+  // small enough for the queue to overflow at times
+  const size_t capacity = 64;
+  const std::string tag{"Test producer message "};
+
+  std::ostringstream stream;
+  uint64_t written = 0;
+  uint64_t dropped = 0;
+
+  {
+    AsyncSink* sink = new AsyncSink{stream, capacity};
+    LoggingManager manager{std::unique_ptr<ISink>{sink}, min_log_level, false, InstanceType::Temporal};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&manager, &logid, &tag, t]() {
+        auto logger = manager.CreateLogger(logid);
+        for (int i = 0; i < num_messages_per_thread; ++i) {
+          LOGS(*logger, WARNING) << tag << t << ":" << i;
+        }
+      });
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    sink->Flush();
+    written = sink->WrittenMessageCount();
+    dropped = sink->DroppedMessageCount();
+  }
+
+  EXPECT_EQ(written + dropped, static_cast<uint64_t>(num_threads * num_messages_per_thread));
+
+  // every written message is in the output exactly once
+  std::istringstream output{stream.str()};
+  std::set<std::string> messages;
+  uint64_t num_lines = 0;
+  std::string line;
+  while (std::getline(output, line)) {
+    const auto pos = line.find(tag);
+    if (pos == std::string::npos) {
+      continue;
+    }
+
+    ++num_lines;
+    EXPECT_TRUE(messages.insert(line.substr(pos + tag.size())).second) << "Duplicated message: " << line;
+  }
+
+  EXPECT_EQ(num_lines, written);
+  EXPECT_EQ(messages.size(), written);
+}
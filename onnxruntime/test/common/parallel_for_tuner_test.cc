@@ -0,0 +1,101 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/parallel_for_tuner.h"
+
+#include <atomic>
+#include <set>
+
+#include "gtest/gtest.h"
+
+#include "core/platform/env.h"
+#include "core/platform/threadpool.h"
+#include "test/util/include/asserts.h"
+#include "test/util/include/temp_dir.h"
+
+namespace onnxruntime {
+namespace test {
+
+using concurrency::ParallelForTuner;
+
+namespace {
+// Run a loop until the tuner has settled on a choice, and return the block size used from then on.
+std::ptrdiff_t TuneLoop(ParallelForTuner& tuner, const std::string& op_type,
+                        std::ptrdiff_t total, std::ptrdiff_t default_block_size) {
+  std::set<std::ptrdiff_t> block_sizes_seen;
+  for (int i = 0; i < 100 && !tuner.HasNewResults(); i++) {
+    tuner.Run("", op_type, 0, 4, total, default_block_size, [&](std::ptrdiff_t block_size) {
+      block_sizes_seen.insert(block_size);
+    });
+  }
+  EXPECT_TRUE(tuner.HasNewResults());
+  // all candidates are measured during warm-up
+  EXPECT_GT(block_sizes_seen.size(), 1u);
+
+  std::ptrdiff_t chosen = -1;
+  tuner.Run("", op_type, 0, 4, total, default_block_size, [&](std::ptrdiff_t block_size) { chosen = block_size; });
+  EXPECT_EQ(block_sizes_seen.count(chosen), 1u);
+  return chosen;
+}
+}  // namespace
+
+TEST(ParallelForTunerTest, UntunedLoopUsesDefaultBlockSize) {
+  ParallelForTuner tuner(false);
+  std::ptrdiff_t used = -1;
+  tuner.Run("", "Op", 0, 4, 1024, 64, [&](std::ptrdiff_t block_size) { used = block_size; });
+  EXPECT_EQ(used, 64);
+  EXPECT_FALSE(tuner.HasNewResults());
+}
+
+TEST(ParallelForTunerTest, SaveAndLoad) {
+  TemporaryDirectory temp_dir{ORT_TSTR("parallel_for_tuner_test")};
+  const PathString file = temp_dir.Path() + ORT_TSTR("/tuning.txt");
+
+  ParallelForTuner tuner(true);
+  const std::ptrdiff_t chosen = TuneLoop(tuner, "Op", 1024, 64);
+  ASSERT_STATUS_OK(tuner.Save(file));
+
+  // the loaded choice is applied without tuning, for all loop sizes in the same bucket
+  ParallelForTuner loaded(false);
+  ASSERT_STATUS_OK(loaded.Load(file));
+  std::ptrdiff_t used = -1;
+  loaded.Run("", "Op", 0, 4, 1024 + 100, 64, [&](std::ptrdiff_t block_size) { used = block_size; });
+  EXPECT_EQ(used, chosen == 1024 ? 1024 + 100 : chosen);
+
+  // other loops are not affected
+  loaded.Run("", "Op", 1, 4, 1024, 64, [&](std::ptrdiff_t block_size) { used = block_size; });
+  EXPECT_EQ(used, 64);
+  loaded.Run("", "OtherOp", 0, 4, 1024, 64, [&](std::ptrdiff_t block_size) { used = block_size; });
+  EXPECT_EQ(used, 64);
+  // nor are ops of the same name in another domain, or pools with another degree of parallelism
+  loaded.Run("com.microsoft", "Op", 0, 4, 1024, 64, [&](std::ptrdiff_t block_size) { used = block_size; });
+  EXPECT_EQ(used, 64);
+  loaded.Run("", "Op", 0, 8, 1024, 64, [&](std::ptrdiff_t block_size) { used = block_size; });
+  EXPECT_EQ(used, 64);
+}
+
+TEST(ParallelForTunerTest, LoadMissingFile) {
+  ParallelForTuner tuner(true);
+  EXPECT_FALSE(tuner.Load(ORT_TSTR("parallel_for_tuner_test_missing_file.txt")).IsOK());
+}
+
+TEST(ParallelForTunerTest, ThreadPoolLoopsRunAllIterations) {
+  auto tp = std::make_unique<concurrency::ThreadPool>(&Env::Default(), ThreadOptions(), nullptr, 4, true);
+  ParallelForTuner tuner(true);
+  const std::string domain{};
+  const std::string op_type{"Op"};
+  constexpr std::ptrdiff_t total = 4096;
+  for (int i = 0; i < 4 * ParallelForTuner::kTrialsPerCandidate * 6; i++) {
+    std::atomic<std::ptrdiff_t> iterations{0};
+    {
+      concurrency::ThreadPool::TuningScope tuning_scope(&tuner, domain, op_type);
+      concurrency::ThreadPool::TryParallelFor(tp.get(), total, 1000.0, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        iterations += last - first;
+      });
+    }
+    ASSERT_EQ(iterations, total);
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,149 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/trace_recorder.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "core/common/logging/logging.h"
+#include "core/platform/env.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace profiling {
+namespace test {
+
+namespace {
+size_t CountOccurrences(const std::string& s, const std::string& pattern) {
+  size_t count = 0;
+  for (size_t pos = s.find(pattern); pos != std::string::npos; pos = s.find(pattern, pos + pattern.size())) {
+    ++count;
+  }
+  return count;
+}
+}  // namespace
+
+TEST(TraceRecorderTest, RecordsSampledRuns) {
+  TraceRecorder::Options options{};
+  options.sampling_interval = 2;
+  TraceRecorder::Enable(options);
+
+  const uint32_t run_name_id = TraceRecorder::InternName("TraceRecorderTest_run");
+  const uint32_t node_name_id = TraceRecorder::InternName("TraceRecorderTest_node");
+  const uint32_t op_name_id = TraceRecorder::InternName("TraceRecorderTest_op");
+
+  std::thread thread{[&]() {
+    for (int i = 0; i < 4; ++i) {
+      TraceRecorder::RunScope run_scope{run_name_id};
+      if (TraceRecorder::IsThreadTraced()) {
+        const uint64_t start_ns = TraceRecorder::NowNs();
+        TraceRecorder::RecordEvent(TraceRecorder::EventKind::kNode, node_name_id, op_name_id,
+                                   start_ns, TraceRecorder::NowNs());
+      }
+    }
+    EXPECT_FALSE(TraceRecorder::IsThreadTraced());
+  }};
+  thread.join();
+
+  TraceRecorder::Disable();
+
+  const std::string trace = TraceRecorder::ExportChromeTrace();
+  EXPECT_EQ(CountOccurrences(trace, R"("name" :"TraceRecorderTest_run")"), 2u);
+  EXPECT_EQ(CountOccurrences(trace, R"("name" :"TraceRecorderTest_node","args" : {"op_name" : "TraceRecorderTest_op"})"),
+            2u);
+}
+
+TEST(TraceRecorderTest, KeepsLatestEvents) {
+  TraceRecorder::Options options{};
+  options.events_per_thread = 4;
+  TraceRecorder::Enable(options);
+
+  // the buffer size applies to threads that did not record events yet
+  std::thread thread{[]() {
+    for (int i = 0; i < 10; ++i) {
+      const uint32_t name_id = TraceRecorder::InternName("TraceRecorderTest_event_" + std::to_string(i));
+      const uint64_t start_ns = TraceRecorder::NowNs();
+      TraceRecorder::RecordEvent(TraceRecorder::EventKind::kThreadPoolWork, name_id, name_id,
+                                 start_ns, TraceRecorder::NowNs());
+    }
+  }};
+  thread.join();
+
+  TraceRecorder::Disable();
+
+  // the oldest slot may be overwritten while it is read, so the export can skip it
+  const std::string trace = TraceRecorder::ExportChromeTrace();
+  for (int i = 0; i < 10; ++i) {
+    const std::string name = "\"TraceRecorderTest_event_" + std::to_string(i) + "\"";
+    if (i < 6) {
+      EXPECT_EQ(CountOccurrences(trace, name), 0u) << name;
+    } else if (i > 6) {
+      EXPECT_EQ(CountOccurrences(trace, name), 1u) << name;
+    }
+  }
+}
+
+TEST(TraceRecorderTest, ReusesBuffersOfExitedThreads) {
+  TraceRecorder::Enable(TraceRecorder::Options{});
+
+  const uint32_t name_id = TraceRecorder::InternName("TraceRecorderTest_reused");
+  unsigned int thread_ids[2] = {};
+  size_t num_buffers[2] = {};
+  for (int i = 0; i < 2; ++i) {
+    std::thread thread{[&]() {
+      thread_ids[i] = logging::GetThreadId();
+      const uint64_t start_ns = TraceRecorder::NowNs();
+      TraceRecorder::RecordEvent(TraceRecorder::EventKind::kThreadPoolWork, name_id, name_id,
+                                 start_ns, TraceRecorder::NowNs());
+    }};
+    thread.join();
+    num_buffers[i] = TraceRecorder::GetNumThreadBuffers();
+  }
+
+  TraceRecorder::Disable();
+
+  // the second thread records to the buffer of the first one, which keeps its events
+  EXPECT_EQ(num_buffers[1], num_buffers[0]);
+  const std::string trace = TraceRecorder::ExportChromeTrace();
+  EXPECT_EQ(CountOccurrences(trace, R"("name" :"TraceRecorderTest_reused")"), 2u);
+  for (const unsigned int thread_id : thread_ids) {
+    EXPECT_NE(trace.find("\"tid\" :" + std::to_string(thread_id) + ","), std::string::npos) << thread_id;
+  }
+}
+
+#ifndef _OPENMP
+TEST(TraceRecorderTest, RecordsThreadPoolWork) {
+  auto tp = std::make_unique<concurrency::ThreadPool>(&Env::Default(), ThreadOptions(), nullptr, 4, true);
+  TraceRecorder::Enable(TraceRecorder::Options{});
+
+  const uint32_t run_name_id = TraceRecorder::InternName("TraceRecorderTest_pool_run");
+  std::atomic<int> num_iterations{0};
+  {
+    TraceRecorder::RunScope run_scope{run_name_id};
+    ASSERT_TRUE(TraceRecorder::IsThreadTraced());
+    concurrency::ThreadPool::TrySimpleParallelFor(tp.get(), 64, [&](std::ptrdiff_t) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      ++num_iterations;
+    });
+  }
+
+  TraceRecorder::Disable();
+
+  EXPECT_EQ(num_iterations.load(), 64);
+  const std::string trace = TraceRecorder::ExportChromeTrace();
+  EXPECT_EQ(CountOccurrences(trace, R"("name" :"TraceRecorderTest_pool_run")"), 1u);
+  // the thread starting the loop works on it too, so there is at least one work event
+  EXPECT_GE(CountOccurrences(trace, R"("name" :"ParallelFor")"), 1u);
+  EXPECT_NE(trace.find("\"tid\" :" + std::to_string(logging::GetThreadId()) + ","), std::string::npos);
+}
+#endif
+
+}  // namespace test
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -1490,6 +1490,103 @@ TEST(AttentionTest, AttentionPastState_dynamic) {
   test.Run();
 }
 
+// Runs Attention with the given chunk_size on the CPU and returns its output.
+static std::vector<float> RunAttentionWithChunkSize(int chunk_size,
+                                                    const std::vector<float>& input_data,
+                                                    const std::vector<float>& weight_data,
+                                                    const std::vector<float>& bias_data,
+                                                    const std::vector<int32_t>& mask_index_data,
+                                                    const std::vector<int64_t>& mask_index_dims,
+                                                    const std::vector<float>& past_data,
+                                                    int batch_size,
+                                                    int sequence_length,
+                                                    int past_sequence_length,
+                                                    int hidden_size,
+                                                    int number_of_heads,
+                                                    bool is_unidirectional) {
+  const int head_size = hidden_size / number_of_heads;
+  const int all_sequence_length = past_sequence_length + sequence_length;
+
+  OpTester tester("Attention", 1, onnxruntime::kMSDomain, false /*verify_output*/);
+  tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(number_of_heads));
+  tester.AddAttribute<int64_t>("unidirectional", static_cast<int64_t>(is_unidirectional ? 1 : 0));
+  tester.AddAttribute<int64_t>("chunk_size", static_cast<int64_t>(chunk_size));
+
+  tester.AddInput<float>("input", {batch_size, sequence_length, hidden_size}, input_data);
+  tester.AddInput<float>("weight", {hidden_size, 3 * hidden_size}, weight_data);
+  tester.AddInput<float>("bias", {3 * hidden_size}, bias_data);
+  if (mask_index_data.size() > 0) {
+    tester.AddInput<int32_t>("mask_index", mask_index_dims, mask_index_data);
+  } else {
+    tester.AddOptionalInputEdge<int32_t>();
+  }
+  tester.AddInput<float>("past", {2, batch_size, number_of_heads, past_sequence_length, head_size}, past_data);
+
+  tester.AddOutput<float>("output", {batch_size, sequence_length, hidden_size},
+                          std::vector<float>(static_cast<size_t>(batch_size) * sequence_length * hidden_size));
+  tester.AddOutput<float>("present", {2, batch_size, number_of_heads, all_sequence_length, head_size},
+                          std::vector<float>(static_cast<size_t>(2) * batch_size * number_of_heads * all_sequence_length * head_size));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+
+  const Tensor& output = tester.GetFetches()[0].Get<Tensor>();
+  return std::vector<float>(output.Data<float>(), output.Data<float>() + output.Shape().Size());
+}
+
+// The chunked attention only changes the order of the operations, so it is compared with the attention that
+// materializes the attention probs. The sequence spans two blocks of queries and the keys several blocks.
+TEST(AttentionTest, AttentionChunked) {
+  constexpr int batch_size = 2;
+  constexpr int sequence_length = 70;
+  constexpr int past_sequence_length = 11;
+  constexpr int all_sequence_length = past_sequence_length + sequence_length;
+  constexpr int hidden_size = 32;
+  constexpr int number_of_heads = 4;
+  constexpr int head_size = hidden_size / number_of_heads;
+
+  RandomValueGenerator random{};
+  std::vector<float> input_data = random.Gaussian<float>({batch_size, sequence_length, hidden_size}, 0.0f, 0.3f);
+  std::vector<float> weight_data = random.Gaussian<float>({hidden_size, 3 * hidden_size}, 0.0f, 0.3f);
+  std::vector<float> bias_data = random.Gaussian<float>({3 * hidden_size}, 0.0f, 0.3f);
+  std::vector<float> past_data =
+      random.Gaussian<float>({2, batch_size, number_of_heads, past_sequence_length, head_size}, 0.0f, 0.3f);
+
+  std::vector<int32_t> raw_mask(batch_size * all_sequence_length, 1);
+  std::fill(raw_mask.begin() + all_sequence_length - 7, raw_mask.begin() + all_sequence_length, 0);
+
+  struct MaskCase {
+    std::vector<int32_t> data;
+    std::vector<int64_t> dims;
+  };
+  const std::vector<MaskCase> mask_cases = {
+      {{}, {}},
+      {{all_sequence_length - 5, all_sequence_length}, {batch_size}},
+      {{all_sequence_length, all_sequence_length - 9, 3, 0}, {2 * batch_size}},
+      {raw_mask, {batch_size, all_sequence_length}},
+  };
+
+  for (bool is_unidirectional : {false, true}) {
+    for (const auto& mask_case : mask_cases) {
+      std::vector<float> expected = RunAttentionWithChunkSize(0, input_data, weight_data, bias_data,
+                                                              mask_case.data, mask_case.dims, past_data,
+                                                              batch_size, sequence_length, past_sequence_length,
+                                                              hidden_size, number_of_heads, is_unidirectional);
+      for (int chunk_size : {16, 1000}) {
+        std::vector<float> actual = RunAttentionWithChunkSize(chunk_size, input_data, weight_data, bias_data,
+                                                              mask_case.data, mask_case.dims, past_data,
+                                                              batch_size, sequence_length, past_sequence_length,
+                                                              hidden_size, number_of_heads, is_unidirectional);
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); i++) {
+          EXPECT_NEAR(actual[i], expected[i], 1e-4f) << "chunk_size " << chunk_size << ", index " << i;
+        }
+      }
+    }
+  }
+}
+
 TEST(AttentionTest, AttentionPrunedModel) {
   int batch_size = 2;
   int sequence_length = 2;
@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(FusedElementwiseTest, SwishWithBias) {
+  // Y = Sigmoid(X + B) * X, where the last step uses the input X as its operand.
+  const std::vector<int64_t> dims{2, 3};
+  const std::vector<float> X{-2.f, -1.f, 0.f, 1.f, 2.f, 3.f};
+  const std::vector<float> B{0.5f, -0.5f, 1.f};
+
+  std::vector<float> Y;
+  for (size_t i = 0; i < X.size(); ++i) {
+    float value = X[i] + B[i % B.size()];
+    Y.push_back(X[i] / (1.f + std::exp(-value)));
+  }
+
+  OpTester tester("FusedElementwise", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute("operators", std::vector<std::string>{"Add", "Sigmoid", "Mul"});
+  tester.AddAttribute("operands", std::vector<int64_t>{1, -1, 0});
+  tester.AddInput<float>("X", dims, X);
+  tester.AddInput<float>("B", {3}, B);
+  tester.AddOutput<float>("Y", dims, Y);
+  tester.Run();
+}
+
+TEST(FusedElementwiseTest, SwappedScalarOperands) {
+  // Y = Pow(2 / (1 - X), 2)
+  const std::vector<int64_t> dims{4};
+  const std::vector<float> X{-1.f, 0.f, 0.5f, 3.f};
+
+  std::vector<float> Y;
+  for (auto x : X) {
+    float value = 2.f / (1.f - x);
+    Y.push_back(value * value);
+  }
+
+  OpTester tester("FusedElementwise", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute("operators", std::vector<std::string>{"Sub", "Div", "Pow"});
+  tester.AddAttribute("operands", std::vector<int64_t>{1, 2, 2});
+  tester.AddAttribute("swap_operands", std::vector<int64_t>{1, 1, 0});
+  tester.AddInput<float>("X", dims, X);
+  tester.AddInput<float>("one", {}, {1.f});
+  tester.AddInput<float>("two", {1}, {2.f});
+  tester.AddOutput<float>("Y", dims, Y);
+  tester.Run();
+}
+
+TEST(FusedElementwiseTest, LargeInputWithRowOperand) {
+  // Spans several blocks with a row operand whose length does not divide the block size.
+  const int64_t rows = 97;
+  const int64_t cols = 131;
+  std::vector<float> X(static_cast<size_t>(rows * cols));
+  std::vector<float> B(static_cast<size_t>(cols));
+  for (size_t i = 0; i < X.size(); ++i) {
+    X[i] = static_cast<float>(i % 17) * 0.25f - 2.f;
+  }
+  for (size_t i = 0; i < B.size(); ++i) {
+    B[i] = static_cast<float>(i % 5) - 2.f;
+  }
+
+  std::vector<float> Y;
+  for (size_t i = 0; i < X.size(); ++i) {
+    Y.push_back(std::tanh(std::max(X[i] * B[i % B.size()], 0.f)));
+  }
+
+  OpTester tester("FusedElementwise", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute("operators", std::vector<std::string>{"Mul", "Relu", "Tanh"});
+  tester.AddAttribute("operands", std::vector<int64_t>{1, -1, -1});
+  tester.AddInput<float>("X", {rows, cols}, X);
+  tester.AddInput<float>("B", {1, cols}, B);
+  tester.AddOutput<float>("Y", {rows, cols}, Y);
+  tester.Run();
+}
+
+TEST(FusedElementwiseTest, InvalidOperandShape) {
+  OpTester tester("FusedElementwise", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute("operators", std::vector<std::string>{"Add", "Relu"});
+  tester.AddAttribute("operands", std::vector<int64_t>{1, -1});
+  tester.AddInput<float>("X", {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  tester.AddInput<float>("B", {2, 1}, {1.f, 2.f});
+  tester.AddOutput<float>("Y", {2, 3}, {0.f, 0.f, 0.f, 0.f, 0.f, 0.f});
+  tester.Run(OpTester::ExpectResult::kExpectFailure, "does not broadcast to the input shape");
+}
+
+TEST(FusedElementwiseTest, OperandOfHigherRank) {
+  OpTester tester("FusedElementwise", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute("operators", std::vector<std::string>{"Add", "Relu"});
+  tester.AddAttribute("operands", std::vector<int64_t>{1, -1});
+  tester.AddInput<float>("X", {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  tester.AddInput<float>("B", {1, 1, 3}, {1.f, 2.f, 3.f});
+  tester.AddOutput<float>("Y", {2, 3}, {0.f, 0.f, 0.f, 0.f, 0.f, 0.f});
+  tester.Run(OpTester::ExpectResult::kExpectFailure, "has a higher rank than the input shape");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
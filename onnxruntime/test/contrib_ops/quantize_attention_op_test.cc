@@ -3,6 +3,8 @@
 
 #include <algorithm>
 #include <cfenv>
+#include <cmath>
+#include <limits>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -825,6 +827,139 @@ TEST(QAttentionTest, QAttentionPrunedModel) {
                    input_hidden_size);
 }
 
+// Computes the attention of the dequantized input and weights in float. It is the reference for the
+// integer attention path, which also quantizes Q, K, V and the attention probabilities.
+static std::vector<float> ComputeAttentionReference(const std::vector<float>& input,
+                                                    const std::vector<float>& weights,
+                                                    const std::vector<float>& bias,
+                                                    const std::vector<int32_t>& mask_index,
+                                                    int batch_size, int sequence_length, int hidden_size,
+                                                    int number_of_heads, bool is_unidirectional) {
+  const int head_size = hidden_size / number_of_heads;
+  const float alpha = 1.0f / std::sqrt(static_cast<float>(head_size));
+
+  std::vector<float> qkv(static_cast<size_t>(batch_size) * sequence_length * 3 * hidden_size);
+  for (int row = 0; row < batch_size * sequence_length; row++) {
+    for (int col = 0; col < 3 * hidden_size; col++) {
+      float sum = bias[col];
+      for (int k = 0; k < hidden_size; k++) {
+        sum += input[row * hidden_size + k] * weights[k * 3 * hidden_size + col];
+      }
+      qkv[row * 3 * hidden_size + col] = sum;
+    }
+  }
+
+  std::vector<float> output(static_cast<size_t>(batch_size) * sequence_length * hidden_size);
+  std::vector<float> probs(sequence_length);
+  for (int b = 0; b < batch_size; b++) {
+    for (int n = 0; n < number_of_heads; n++) {
+      for (int s = 0; s < sequence_length; s++) {
+        const float* q = &qkv[(b * sequence_length + s) * 3 * hidden_size + n * head_size];
+        float max_logit = std::numeric_limits<float>::lowest();
+        for (int t = 0; t < sequence_length; t++) {
+          const float* k = &qkv[(b * sequence_length + t) * 3 * hidden_size + hidden_size + n * head_size];
+          float logit = 0.0f;
+          for (int h = 0; h < head_size; h++) {
+            logit += q[h] * k[h];
+          }
+          logit *= alpha;
+          if (!mask_index.empty() && t >= mask_index[b]) {
+            logit += -10000.0f;
+          }
+          if (is_unidirectional && t > s) {
+            logit += -10000.0f;
+          }
+          probs[t] = logit;
+          max_logit = std::max(max_logit, logit);
+        }
+
+        float sum = 0.0f;
+        for (int t = 0; t < sequence_length; t++) {
+          probs[t] = std::exp(probs[t] - max_logit);
+          sum += probs[t];
+        }
+
+        float* out = &output[(b * sequence_length + s) * hidden_size + n * head_size];
+        for (int h = 0; h < head_size; h++) {
+          float value = 0.0f;
+          for (int t = 0; t < sequence_length; t++) {
+            value += probs[t] / sum * qkv[(b * sequence_length + t) * 3 * hidden_size + 2 * hidden_size + n * head_size + h];
+          }
+          out[h] = value;
+        }
+      }
+    }
+  }
+  return output;
+}
+
+static void RunQAttentionIntegerAttention(bool use_mask, bool is_unidirectional) {
+  constexpr int batch_size = 2;
+  constexpr int sequence_length = 16;
+  constexpr int hidden_size = 32;
+  constexpr int number_of_heads = 4;
+  constexpr float input_scale = 0.01f;
+  constexpr uint8_t input_zero_point = 128;
+  constexpr float weight_scale = 0.003f;
+
+  RandomValueGenerator random{};
+  std::vector<uint8_t> input_quant = random.Uniform<uint8_t>({batch_size, sequence_length, hidden_size}, 0, 255);
+  std::vector<int8_t> weight_quant = random.Uniform<int8_t>({hidden_size, 3 * hidden_size}, -127, 127);
+  std::vector<float> bias_data = random.Uniform<float>({3 * hidden_size}, -0.3f, 0.3f);
+  std::vector<int32_t> mask_index_data;
+  if (use_mask) {
+    mask_index_data = {12, sequence_length};
+  }
+
+  std::vector<float> input_data(input_quant.size());
+  for (size_t i = 0; i < input_quant.size(); i++) {
+    input_data[i] = (static_cast<int32_t>(input_quant[i]) - input_zero_point) * input_scale;
+  }
+  std::vector<float> weight_data(weight_quant.size());
+  for (size_t i = 0; i < weight_quant.size(); i++) {
+    weight_data[i] = weight_quant[i] * weight_scale;
+  }
+
+  std::vector<float> output_data = ComputeAttentionReference(input_data, weight_data, bias_data, mask_index_data,
+                                                             batch_size, sequence_length, hidden_size,
+                                                             number_of_heads, is_unidirectional);
+
+  // The float path only differs from the reference in the order of the operations, while the integer path
+  // adds the quantization error of Q, K, V and the attention probabilities. With these ranges that error stays
+  // below about 0.035, while int16 saturation in the GEMMs typically shows up as errors of 0.1 or more.
+  for (int64_t integer_attention : {0, 1}) {
+    OpTester tester("QAttention", 1, onnxruntime::kMSDomain);
+    tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(number_of_heads));
+    tester.AddAttribute<int64_t>("unidirectional", static_cast<int64_t>(is_unidirectional ? 1 : 0));
+    tester.AddAttribute<int64_t>("integer_attention", integer_attention);
+
+    tester.AddInput<uint8_t>("input", {batch_size, sequence_length, hidden_size}, input_quant);
+    tester.AddInput<int8_t>("weight", {hidden_size, 3 * hidden_size}, weight_quant);
+    tester.AddInput<float>("bias", {3 * hidden_size}, bias_data);
+    tester.AddInput<float>("input_scale", {1}, {input_scale});
+    tester.AddInput<float>("weight_scale", {1}, {weight_scale});
+    if (use_mask) {
+      tester.AddInput<int32_t>("mask_index", {batch_size}, mask_index_data);
+    } else {
+      tester.AddOptionalInputEdge<int32_t>();
+    }
+    tester.AddInput<uint8_t>("input_zero_point", {1}, {input_zero_point});
+    tester.AddInput<int8_t>("weight_zero_point", {1}, {0});
+    tester.AddOutput<float>("output", {batch_size, sequence_length, hidden_size}, output_data);
+    tester.SetOutputAbsErr("output", integer_attention ? 0.05f : 0.001f);
+
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  }
+}
+
+TEST(QAttentionTest, QAttentionIntegerAttention) {
+  RunQAttentionIntegerAttention(/*use_mask=*/false, /*is_unidirectional=*/false);
+  RunQAttentionIntegerAttention(/*use_mask=*/true, /*is_unidirectional=*/false);
+  RunQAttentionIntegerAttention(/*use_mask=*/false, /*is_unidirectional=*/true);
+}
+
 #ifndef ENABLE_TRAINING  // Prepacking is enabled only on non-training builds
 TEST(QAttentionTest, SharedPrepackedWeights) {
   int batch_size = 1;
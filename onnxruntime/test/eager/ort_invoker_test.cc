@@ -79,6 +79,104 @@ TEST(InvokerTest, Inplace) {
   }
 }
 
+TEST(InvokerTest, CachedKernel) {
+  std::unique_ptr<IExecutionProvider> cpu_execution_provider = std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo(false));
+  const std::string logger_id{"InvokerTest"};
+  auto logging_manager = std::make_unique<logging::LoggingManager>(
+      std::unique_ptr<logging::ISink>{new logging::CLogSink{}},
+      logging::Severity::kVERBOSE, false,
+      logging::LoggingManager::InstanceType::Default,
+      &logger_id);
+  std::unique_ptr<Environment> env;
+  Environment::Create(std::move(logging_manager), env);
+  IOnnxRuntimeOpSchemaRegistryList tmp_op_registry = {};
+  ORTInvoker kernel_invoker(std::move(cpu_execution_provider), env->GetLoggingManager()->DefaultLogger(), tmp_op_registry);
+  auto allocator = kernel_invoker.GetCurrentExecutionProvider().GetAllocator(0, OrtMemTypeDefault);
+
+  // The second invocation reuses the kernel of the first one, and must not see its inputs.
+  std::vector<int64_t> dims = {3, 2};
+  OrtValue A, B, C;
+  CreateMLValue<float>(allocator, dims, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, &A);
+  CreateMLValue<float>(allocator, dims, {1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f}, &B);
+  CreateMLValue<float>(allocator, dims, {-1.0f, -2.0f, -3.0f, -4.0f, -5.0f, -6.0f}, &C);
+  for (const auto& rhs : {B, C}) {
+    std::vector<OrtValue> result(1);
+    ASSERT_TRUE(kernel_invoker.Invoke("Add", {A, rhs}, result, nullptr).IsOK());
+    const auto* a_data = A.Get<Tensor>().Data<float>();
+    const auto* rhs_data = rhs.Get<Tensor>().Data<float>();
+    const auto* result_data = result.back().Get<Tensor>().Data<float>();
+    for (size_t i = 0; i < 6; ++i) {
+      EXPECT_EQ(result_data[i], a_data[i] + rhs_data[i]);
+    }
+  }
+
+  // Other input types use another kernel.
+  OrtValue D;
+  CreateMLValue<int32_t>(allocator, dims, {1, 2, 3, 4, 5, 6}, &D);
+  std::vector<OrtValue> int_result(1);
+  ASSERT_TRUE(kernel_invoker.Invoke("Add", {D, D}, int_result, nullptr).IsOK());
+  const auto* int_data = int_result.back().Get<Tensor>().Data<int32_t>();
+  for (int32_t i = 0; i < 6; ++i) {
+    EXPECT_EQ(int_data[i], 2 * (i + 1));
+  }
+
+  // Other attribute values use another kernel.
+  for (int64_t axis : {0, 1}) {
+    ONNX_NAMESPACE::AttributeProto axis_attribute;
+    axis_attribute.set_name("axis");
+    axis_attribute.set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_INT);
+    axis_attribute.set_i(axis);
+    NodeAttributes attributes{{"axis", axis_attribute}};
+
+    std::vector<OrtValue> result(1);
+    ASSERT_TRUE(kernel_invoker.Invoke("Concat", {A, B}, result, &attributes).IsOK());
+    const std::vector<int64_t> expected_dims = axis == 0 ? std::vector<int64_t>{6, 2} : std::vector<int64_t>{3, 4};
+    EXPECT_EQ(result.back().Get<Tensor>().Shape().GetDims(), expected_dims);
+  }
+}
+
+TEST(InvokerTest, KernelCacheIsBounded) {
+  std::unique_ptr<IExecutionProvider> cpu_execution_provider = std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo(false));
+  const std::string logger_id{"InvokerTest"};
+  auto logging_manager = std::make_unique<logging::LoggingManager>(
+      std::unique_ptr<logging::ISink>{new logging::CLogSink{}},
+      logging::Severity::kVERBOSE, false,
+      logging::LoggingManager::InstanceType::Default,
+      &logger_id);
+  std::unique_ptr<Environment> env;
+  Environment::Create(std::move(logging_manager), env);
+  IOnnxRuntimeOpSchemaRegistryList tmp_op_registry = {};
+  ORTInvoker kernel_invoker(std::move(cpu_execution_provider), env->GetLoggingManager()->DefaultLogger(), tmp_op_registry,
+                            2);
+  auto allocator = kernel_invoker.GetCurrentExecutionProvider().GetAllocator(0, OrtMemTypeDefault);
+
+  std::vector<int64_t> dims = {3, 2};
+  OrtValue float_a, int_a, long_a;
+  CreateMLValue<float>(allocator, dims, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, &float_a);
+  CreateMLValue<int32_t>(allocator, dims, {1, 2, 3, 4, 5, 6}, &int_a);
+  CreateMLValue<int64_t>(allocator, dims, {1, 2, 3, 4, 5, 6}, &long_a);
+
+  // Each input type uses another kernel, the least recently used one is evicted.
+  for (const OrtValue* a : {&float_a, &int_a, &long_a, &float_a}) {
+    std::vector<OrtValue> result(1);
+    ASSERT_TRUE(kernel_invoker.Invoke("Add", {*a, *a}, result, nullptr).IsOK());
+    EXPECT_EQ(result.back().Get<Tensor>().Shape().GetDims(), dims);
+    EXPECT_LE(kernel_invoker.KernelCacheSize(), 2u);
+  }
+  EXPECT_EQ(kernel_invoker.KernelCacheSize(), 2u);
+
+  kernel_invoker.ClearKernelCache();
+  EXPECT_EQ(kernel_invoker.KernelCacheSize(), 0u);
+
+  std::vector<OrtValue> result(1);
+  ASSERT_TRUE(kernel_invoker.Invoke("Add", {long_a, long_a}, result, nullptr).IsOK());
+  const auto* long_data = result.back().Get<Tensor>().Data<int64_t>();
+  for (int64_t i = 0; i < 6; ++i) {
+    EXPECT_EQ(long_data[i], 2 * (i + 1));
+  }
+  EXPECT_EQ(kernel_invoker.KernelCacheSize(), 1u);
+}
+
 class TestKernel final : public OpKernel {
  public:
   TestKernel(const OpKernelInfo& info) : OpKernel(info) {}
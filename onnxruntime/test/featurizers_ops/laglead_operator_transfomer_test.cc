@@ -113,5 +113,76 @@ TEST(FeaturizersTests, Grained_LagLead_2_grain_horizon_2_lead_1_lead_2_double) {
   test.Run();
 }
 
+TEST(FeaturizersTests, Grained_LagLead_many_grains_horizon_2_lead_1_lead_2) {
+  using InputType = float;
+  using GrainType = std::vector<std::string>;
+  NS::AnnotationMapsPtr                                            pAllColumnAnnotations(NS::CreateTestAnnotationMapsPtr(1));
+  NS::Featurizers::GrainedLagLeadOperatorEstimator<InputType>      estimator(pAllColumnAnnotations, 2, {1, 2});
+
+  using GrainedInputType = typename NS::Featurizers::GrainedLagLeadOperatorEstimator<InputType>::InputType;
+
+  // enough rows for the grains to be transformed in several partitions
+  const int num_grains = 8;
+  const int rows_per_grain = 512;
+
+  std::vector<GrainType> grains;
+  grains.reserve(num_grains);
+  for (int grain_idx = 0; grain_idx < num_grains; ++grain_idx) {
+    grains.push_back(GrainType({"grain_" + std::to_string(grain_idx)}));
+  }
+  const InputType training_value(static_cast<InputType>(0));
+  std::vector<std::tuple<GrainType const &, InputType const &>> training_batch;
+  for (int grain_idx = 0; grain_idx < num_grains; ++grain_idx) {
+    training_batch.emplace_back(grains[grain_idx], training_value);
+  }
+
+  auto stream = GetStream(estimator, training_batch);
+  auto dim = static_cast<int64_t>(stream.size());
+
+  auto value = [rows_per_grain](int grain_idx, int row_idx) {
+    return row_idx < rows_per_grain ? static_cast<InputType>(grain_idx * rows_per_grain + row_idx)
+                                    : NS::Traits<InputType>::CreateNullValue();
+  };
+  auto add_output = [&](std::vector<std::string>& output_grains, std::vector<InputType>& output_values,
+                        int grain_idx, int row_idx) {
+    output_grains.push_back(grains[grain_idx][0]);
+    for (int lead = 1; lead <= 2; ++lead) {
+      for (int horizon_idx = 0; horizon_idx < 2; ++horizon_idx) {
+        output_values.push_back(value(grain_idx, row_idx + lead - 1 + horizon_idx));
+      }
+    }
+  };
+
+  // the rows of the grains are interleaved. The output of a row is produced once its leads are known,
+  // and the outputs of the last rows of the grains are produced on flush, grain after grain.
+  std::vector<std::string> input_grains;
+  std::vector<InputType> input_values;
+  std::vector<std::string> output_grains;
+  std::vector<InputType> output_values;
+  for (int row_idx = 0; row_idx < rows_per_grain; ++row_idx) {
+    for (int grain_idx = 0; grain_idx < num_grains; ++grain_idx) {
+      input_grains.push_back(grains[grain_idx][0]);
+      input_values.push_back(value(grain_idx, row_idx));
+      if (row_idx >= 2) {
+        add_output(output_grains, output_values, grain_idx, row_idx - 2);
+      }
+    }
+  }
+  for (int grain_idx = 0; grain_idx < num_grains; ++grain_idx) {
+    add_output(output_grains, output_values, grain_idx, rows_per_grain - 2);
+    add_output(output_grains, output_values, grain_idx, rows_per_grain - 1);
+  }
+  const int64_t num_rows = static_cast<int64_t>(input_values.size());
+
+  OpTester test("LagLeadOperatorTransformer", 1, onnxruntime::kMSFeaturizersDomain);
+  test.AddInput<uint8_t>("State", {dim}, stream);
+  test.AddInput<std::string>("Grains", {num_rows, 1}, input_grains);
+  test.AddInput<float>("Target", {num_rows}, input_values);
+  test.AddOutput<std::string>("OutputGrains", {num_rows, 1}, output_grains);
+  test.AddOutput<float>("Output", {num_rows, 2, 2}, output_values);
+
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
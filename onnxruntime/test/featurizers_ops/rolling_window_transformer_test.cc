@@ -147,5 +147,56 @@ TEST(FeaturizersTests, SimpleRollingWindow_Transformer_Grained_Min_1_grain_windo
   test.Run();
 }
 
+TEST(FeaturizersTests, AnalyticalRollingWindow_Transformer_Grained_Mean_many_grains_window_size_1_horizon_1) {
+  using EstimatorT = NS::Featurizers::GrainedAnalyticalRollingWindowEstimator<double>;
+  using GrainType = std::vector<std::string>;
+  using GrainedInputType = EstimatorT::InputType;
+
+  EstimatorT      estimator(NS::CreateTestAnnotationMapsPtr(1), NS::Featurizers::AnalyticalRollingWindowCalculation::Mean, 1, 1);
+
+  // enough rows for the grains to be transformed in several partitions
+  const int num_grains = 8;
+  const int rows_per_grain = 512;
+
+  std::vector<GrainType> grains;
+  std::vector<double> training_values(num_grains, 0.0);
+  std::vector<GrainedInputType> training_batch;
+  grains.reserve(num_grains);
+  training_batch.reserve(num_grains);
+  for (int grain_idx = 0; grain_idx < num_grains; ++grain_idx) {
+    grains.push_back(GrainType({"grain_" + std::to_string(grain_idx)}));
+  }
+  for (int grain_idx = 0; grain_idx < num_grains; ++grain_idx) {
+    training_batch.emplace_back(grains[grain_idx], training_values[grain_idx]);
+  }
+
+  auto stream = GetStream(estimator, training_batch);
+  auto dim = static_cast<int64_t>(stream.size());
+
+  // the rows of the grains are interleaved, and every output is the previous value of the grain
+  std::vector<std::string> input_grains;
+  std::vector<double> input_values;
+  std::vector<double> output_values;
+  for (int row_idx = 0; row_idx < rows_per_grain; ++row_idx) {
+    for (int grain_idx = 0; grain_idx < num_grains; ++grain_idx) {
+      input_grains.push_back(grains[grain_idx][0]);
+      input_values.push_back(static_cast<double>(grain_idx * rows_per_grain + row_idx));
+      output_values.push_back(row_idx == 0 ? NS::Traits<double>::CreateNullValue()
+                                           : static_cast<double>(grain_idx * rows_per_grain + row_idx - 1));
+    }
+  }
+  const int64_t num_rows = static_cast<int64_t>(input_values.size());
+
+  OpTester test("AnalyticalRollingWindowTransformer", 1, onnxruntime::kMSFeaturizersDomain);
+
+  test.AddInput<uint8_t>("State", {dim}, stream);
+  test.AddInput<std::string>("Grains", {num_rows, 1}, input_grains);
+  test.AddInput<double>("Target", {num_rows}, input_values);
+
+  test.AddOutput<double>("Output", {num_rows, 1, 1}, output_values);
+
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
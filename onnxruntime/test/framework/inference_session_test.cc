@@ -43,6 +43,7 @@
 #include "core/session/allocator_impl.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/onnxruntime_run_options_config_keys.h"
+#include "core/session/stateful_values.h"
 #include "dummy_provider.h"
 #include "test_utils.h"
 #include "test/capturing_sink.h"
@@ -2874,5 +2875,433 @@ TEST(InferenceSessionTests, InterThreadPoolWithDenormalAsZero) {
   VerifyThreadPoolWithDenormalAsZero(session2.GetInterOpThreadPoolToUse(), false);
 }
 
+TEST(InferenceSessionTests, ShapeSpecializationCache) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.ShapeSpecializationCache";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigShapeSpecializationCacheSize, "1"));
+
+  // The model has the input shape {Dim1, Dim2, 5}.
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(ORT_TSTR("testdata/abs_free_dimensions.onnx")));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+
+  auto run_with_shape = [&](const std::vector<int64_t>& dims) {
+    std::vector<float> values(static_cast<size_t>(TensorShape(dims).Size()));
+    std::vector<float> expected_values(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+      values[i] = i % 2 == 0 ? -static_cast<float>(i) : static_cast<float>(i);
+      expected_values[i] = static_cast<float>(i);
+    }
+
+    OrtValue ml_value_x;
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), dims, values, &ml_value_x);
+    NameMLValMap feeds;
+    feeds.insert(std::make_pair("x", ml_value_x));
+
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(run_options, feeds, {"y"}, &fetches));
+    VerifyOutputs(fetches, dims, expected_values);
+  };
+
+  const ShapeSpecializationCache* cache = session_object.GetShapeSpecializationCache();
+  ASSERT_NE(cache, nullptr);
+  auto expect_stats = [cache](size_t hits, size_t misses, size_t evictions) {
+    auto stats = cache->GetStats();
+    EXPECT_EQ(stats.hits, hits);
+    EXPECT_EQ(stats.misses, misses);
+    EXPECT_EQ(stats.evictions, evictions);
+    EXPECT_EQ(cache->Size(), 1u);
+  };
+
+  // The capacity of one forces the first specialized session to be evicted and then created again.
+  run_with_shape({1, 2, 5});
+  expect_stats(0, 1, 0);
+  run_with_shape({1, 2, 5});
+  expect_stats(1, 1, 0);
+  run_with_shape({3, 4, 5});
+  expect_stats(1, 2, 1);
+  run_with_shape({1, 2, 5});
+  expect_stats(1, 3, 2);
+}
+
+TEST(InferenceSessionTests, ShapeSpecializationCacheDisabled) {
+  SessionOptions so;
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(ORT_TSTR("testdata/abs_free_dimensions.onnx")));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  ASSERT_EQ(session_object.GetShapeSpecializationCache(), nullptr);
+}
+
+// y = x + w, where x has the shape {n, 2} and w is an initializer
+static void CreateDynamicAddInitializerModel(const std::string& model_file_name) {
+  onnxruntime::Model model("dynamic_add_initializer", false, ModelMetaData(), PathString(),
+                           IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {},
+                           DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto x_type;
+  x_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  x_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("n");
+  x_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  ONNX_NAMESPACE::TensorProto w_tensor;
+  w_tensor.set_name("w");
+  w_tensor.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  w_tensor.add_dims(2);
+  w_tensor.add_float_data(1.0f);
+  w_tensor.add_float_data(2.0f);
+  graph.AddInitializedTensor(w_tensor);
+
+  auto& x = graph.GetOrCreateNodeArg("x", &x_type);
+  auto& w = graph.GetOrCreateNodeArg("w", nullptr);
+  auto& y = graph.GetOrCreateNodeArg("y", nullptr);
+  graph.AddNode("node_1", "Add", "node 1.", {&x, &w}, {&y});
+  graph.SetInputs({&x});
+  graph.SetOutputs({&y});
+
+  ASSERT_STATUS_OK(graph.Resolve());
+  ASSERT_STATUS_OK(onnxruntime::Model::Save(model, model_file_name));
+}
+
+// The specialized sessions use the initializers of the session that created them instead of copies of their own.
+TEST(InferenceSessionTests, ShapeSpecializationSharesInitializers) {
+  std::string model_file_name = "dynamic_add_initializer_model.onnx";
+  CreateDynamicAddInitializerModel(model_file_name);
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.ShapeSpecializationSharesInitializers";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigShapeSpecializationCacheSize, "2"));
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(model_file_name));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // The session itself uses the shared value, which the specialized sessions inherit with the session options.
+  const auto& shared_initializers = session_object.GetSessionOptions().initializers_to_share_map;
+  ASSERT_EQ(shared_initializers.count("w"), 1u);
+  const SessionState& session_state = session_object.GetSessionState();
+  int w_idx = -1;
+  ASSERT_STATUS_OK(session_state.GetOrtValueNameIdxMap().GetIdx("w", w_idx));
+  ASSERT_EQ(session_state.GetInitializedTensors().at(w_idx).Get<Tensor>().DataRaw(),
+            shared_initializers.at("w")->Get<Tensor>().DataRaw());
+
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+  for (int64_t rows : {1, 3, 1}) {
+    std::vector<int64_t> dims = {rows, 2};
+    std::vector<float> values(static_cast<size_t>(rows * 2), 1.0f);
+    std::vector<float> expected_values;
+    for (int64_t i = 0; i < rows; ++i) {
+      expected_values.push_back(2.0f);
+      expected_values.push_back(3.0f);
+    }
+
+    OrtValue ml_value_x;
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), dims, values, &ml_value_x);
+    NameMLValMap feeds;
+    feeds.insert(std::make_pair("x", ml_value_x));
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(run_options, feeds, {"y"}, &fetches));
+    VerifyOutputs(fetches, dims, expected_values);
+  }
+
+  auto stats = session_object.GetShapeSpecializationCache()->GetStats();
+  EXPECT_EQ(stats.hits, 1u);
+  EXPECT_EQ(stats.misses, 2u);
+  EXPECT_EQ(stats.evictions, 0u);
+}
+
+TEST(InferenceSessionTests, ShapeSpecializationCacheInvalidSize) {
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigShapeSpecializationCacheSize, "abc"));
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(ORT_TSTR("testdata/abs_free_dimensions.onnx")));
+  auto status = session_object.Initialize();
+  ASSERT_FALSE(status.IsOK());
+  ASSERT_TRUE(status.ErrorMessage().find(kOrtSessionOptionsConfigShapeSpecializationCacheSize) != std::string::npos);
+}
+
+// state_out = state_in + x, y = state_out + x
+static void CreateStatefulAddModel(const std::string& model_file_name) {
+  onnxruntime::Model model("stateful_add", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  auto& state_in = graph.GetOrCreateNodeArg("state_in", &float_tensor);
+  auto& x = graph.GetOrCreateNodeArg("x", &float_tensor);
+  auto& state_out = graph.GetOrCreateNodeArg("state_out", &float_tensor);
+  auto& y = graph.GetOrCreateNodeArg("y", &float_tensor);
+  graph.AddNode("node_1", "Add", "node 1.", {&state_in, &x}, {&state_out});
+  graph.AddNode("node_2", "Add", "node 2.", {&state_out, &x}, {&y});
+  // state_out is consumed by node_2, so it is only a graph output if it is listed explicitly
+  graph.SetOutputs({&state_out, &y});
+
+  ASSERT_STATUS_OK(graph.Resolve());
+  ASSERT_STATUS_OK(onnxruntime::Model::Save(model, model_file_name));
+}
+
+TEST(InferenceSessionTests, StatefulInputsOutputs) {
+  std::string model_file_name = "stateful_add_model.onnx";
+  CreateStatefulAddModel(model_file_name);
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.StatefulInputsOutputs";
+  so.stateful_inputs_outputs.push_back({"state_in", "state_out"});
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(model_file_name));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+
+  std::vector<int64_t> dims = {3, 2};
+  std::vector<float> values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  auto times = [&values](float factor) {
+    std::vector<float> result(values);
+    for (auto& value : result) {
+      value *= factor;
+    }
+    return result;
+  };
+
+  OrtValue ml_value_x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), dims, values, &ml_value_x);
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("x", ml_value_x));
+
+  // the state starts at zero and accumulates x on every run
+  std::vector<OrtValue> fetches;
+  for (int i = 1; i <= 3; ++i) {
+    fetches.clear();
+    ASSERT_STATUS_OK(session_object.Run(run_options, feeds, {"y"}, &fetches));
+    VerifyOutputs(fetches, dims, times(static_cast<float>(i + 1)));
+  }
+
+  // fetching the state output returns it without affecting the next run
+  fetches.clear();
+  ASSERT_STATUS_OK(session_object.Run(run_options, feeds, {"state_out", "y"}, &fetches));
+  ASSERT_EQ(fetches.size(), 2u);
+  OrtValue fetched_state = fetches[0];
+  VerifyOutputs(fetched_state.Get<Tensor>(), dims, times(4.0f));
+  for (int i = 6; i <= 8; ++i) {
+    fetches.clear();
+    ASSERT_STATUS_OK(session_object.Run(run_options, feeds, {"y"}, &fetches));
+    VerifyOutputs(fetches, dims, times(static_cast<float>(i)));
+  }
+
+  // the later runs don't write to the fetched state
+  VerifyOutputs(fetched_state.Get<Tensor>(), dims, times(4.0f));
+
+  session_object.ResetStates();
+  fetches.clear();
+  ASSERT_STATUS_OK(session_object.Run(run_options, feeds, {"y"}, &fetches));
+  VerifyOutputs(fetches, dims, times(2.0f));
+
+  // a fed state input overrides the kept value
+  feeds.insert(std::make_pair("state_in", ml_value_x));
+  fetches.clear();
+  ASSERT_STATUS_OK(session_object.Run(run_options, feeds, {"y"}, &fetches));
+  VerifyOutputs(fetches, dims, times(3.0f));
+}
+
+// state_out = state_in[:rows(x)] + x and y = state_out + x, so the state shrinks when a chunk is short
+static void CreateStatefulShortChunkModel(const std::string& model_file_name) {
+  onnxruntime::Model model("stateful_short_chunk", false, ModelMetaData(), PathString(),
+                           IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {},
+                           DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  auto make_type = [](const std::string& rows) {
+    ONNX_NAMESPACE::TypeProto type;
+    type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param(rows);
+    type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+    return type;
+  };
+  ONNX_NAMESPACE::TypeProto state_type = make_type("n");
+  ONNX_NAMESPACE::TypeProto x_type = make_type("m");
+
+  for (int64_t value : {0, 1}) {
+    ONNX_NAMESPACE::TensorProto tensor;
+    tensor.set_name(value == 0 ? "zero" : "one");
+    tensor.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_INT64);
+    tensor.add_dims(1);
+    tensor.add_int64_data(value);
+    graph.AddInitializedTensor(tensor);
+  }
+
+  auto& state_in = graph.GetOrCreateNodeArg("state_in", &state_type);
+  auto& x = graph.GetOrCreateNodeArg("x", &x_type);
+  auto& zero = graph.GetOrCreateNodeArg("zero", nullptr);
+  auto& one = graph.GetOrCreateNodeArg("one", nullptr);
+  auto& x_shape = graph.GetOrCreateNodeArg("x_shape", nullptr);
+  auto& x_rows = graph.GetOrCreateNodeArg("x_rows", nullptr);
+  auto& state_head = graph.GetOrCreateNodeArg("state_head", nullptr);
+  auto& state_out = graph.GetOrCreateNodeArg("state_out", nullptr);
+  auto& y = graph.GetOrCreateNodeArg("y", nullptr);
+  graph.AddNode("node_1", "Shape", "node 1.", {&x}, {&x_shape});
+  graph.AddNode("node_2", "Slice", "node 2.", {&x_shape, &zero, &one, &zero}, {&x_rows});
+  graph.AddNode("node_3", "Slice", "node 3.", {&state_in, &zero, &x_rows, &zero}, {&state_head});
+  graph.AddNode("node_4", "Add", "node 4.", {&state_head, &x}, {&state_out});
+  graph.AddNode("node_5", "Add", "node 5.", {&state_out, &x}, {&y});
+  graph.SetInputs({&state_in, &x});
+  graph.SetOutputs({&state_out, &y});
+
+  ASSERT_STATUS_OK(graph.Resolve());
+  ASSERT_STATUS_OK(onnxruntime::Model::Save(model, model_file_name));
+}
+
+// The state output is only known to have the shape of the state input after the run, so it must not be written to
+// the spare buffer even when that buffer has the shape of the input.
+TEST(InferenceSessionTests, StatefulInputsOutputsShortChunk) {
+  std::string model_file_name = "stateful_short_chunk_model.onnx";
+  CreateStatefulShortChunkModel(model_file_name);
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.StatefulInputsOutputsShortChunk";
+  so.stateful_inputs_outputs.push_back({"state_in", "state_out"});
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(model_file_name));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+
+  auto allocator = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  std::vector<float> values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  auto one_plus = [&values](float factor, size_t count) {
+    std::vector<float> result(values.begin(), values.begin() + count);
+    for (auto& value : result) {
+      value = 1.0f + value * factor;
+    }
+    return result;
+  };
+
+  OrtValue ml_value_x;
+  OrtValue ml_value_short_x;
+  OrtValue ml_value_state;
+  CreateMLValue<float>(allocator, {3, 2}, values, &ml_value_x);
+  CreateMLValue<float>(allocator, {2, 2}, std::vector<float>(values.begin(), values.begin() + 4), &ml_value_short_x);
+  CreateMLValue<float>(allocator, {3, 2}, std::vector<float>(6, 1.0f), &ml_value_state);
+
+  // the shape of the state input is not fully known, so it is fed in the first run
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("x", ml_value_x));
+  feeds.insert(std::make_pair("state_in", ml_value_state));
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session_object.Run(run_options, feeds, {"y"}, &fetches));
+  VerifyOutputs(fetches, {3, 2}, one_plus(2.0f, 6));
+
+  feeds.erase("state_in");
+  fetches.clear();
+  ASSERT_STATUS_OK(session_object.Run(run_options, feeds, {"y"}, &fetches));
+  VerifyOutputs(fetches, {3, 2}, one_plus(3.0f, 6));
+
+  // the spare buffer and the kept state both have 3 rows, while the new state has 2
+  feeds["x"] = ml_value_short_x;
+  fetches.clear();
+  ASSERT_STATUS_OK(session_object.Run(run_options, feeds, {"y"}, &fetches));
+  VerifyOutputs(fetches, {2, 2}, one_plus(4.0f, 4));
+
+  fetches.clear();
+  ASSERT_STATUS_OK(session_object.Run(run_options, feeds, {"y"}, &fetches));
+  VerifyOutputs(fetches, {2, 2}, one_plus(5.0f, 4));
+}
+
+// The state is written to the buffer that was fed in the previous run, so the two buffers alternate.
+TEST(InferenceSessionTests, StatefulValuesAlternateBuffers) {
+  auto allocator = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+
+  for (bool output_shape_follows_input : {true, false}) {
+    StatefulValues::State state;
+    state.input_name = "state_in";
+    state.output_name = "state_out";
+    state.element_type = DataTypeImpl::GetType<float>();
+    state.has_initial_shape = true;
+    state.initial_shape = {2};
+    state.output_shape_follows_input = output_shape_follows_input;
+    StatefulValues stateful_values({state}, allocator);
+
+    // adds one to the state, which is the last feed and the last fetch
+    std::vector<const void*> input_buffers;
+    std::vector<const void*> output_buffers;
+    int preallocated_outputs = 0;
+    auto run = [&](const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
+                   const std::vector<std::string>& output_names, std::vector<OrtValue>& fetches) {
+      EXPECT_EQ(feed_names.back(), "state_in");
+      EXPECT_EQ(output_names.back(), "state_out");
+      if (fetches.back().IsAllocated()) {
+        preallocated_outputs++;
+      } else {
+        CreateMLValue<float>(allocator, {2}, {0.0f, 0.0f}, &fetches.back());
+      }
+
+      const Tensor& input = feeds.back().Get<Tensor>();
+      Tensor& output = *fetches.back().GetMutable<Tensor>();
+      for (int64_t i = 0; i < 2; ++i) {
+        output.MutableData<float>()[i] = input.Data<float>()[i] + 1.0f;
+      }
+      input_buffers.push_back(input.DataRaw());
+      output_buffers.push_back(output.DataRaw());
+      return Status::OK();
+    };
+
+    std::vector<OrtValue> fetches;
+    for (int i = 0; i < 4; ++i) {
+      fetches.clear();
+      ASSERT_STATUS_OK(stateful_values.Run({}, {}, {}, fetches, run));
+      EXPECT_TRUE(fetches.empty());
+    }
+
+    for (size_t i = 1; i < input_buffers.size(); ++i) {
+      EXPECT_EQ(input_buffers[i], output_buffers[i - 1]);
+    }
+    if (output_shape_follows_input) {
+      EXPECT_EQ(preallocated_outputs, 3);
+      for (size_t i = 1; i < output_buffers.size(); ++i) {
+        EXPECT_EQ(output_buffers[i], input_buffers[i - 1]);
+      }
+    } else {
+      EXPECT_EQ(preallocated_outputs, 0);
+    }
+
+    // a fetched state is not written to by later runs
+    fetches.clear();
+    ASSERT_STATUS_OK(stateful_values.Run({}, {}, {"state_out"}, fetches, run));
+    ASSERT_EQ(fetches.size(), 1u);
+    OrtValue fetched_state = fetches[0];
+    for (int i = 0; i < 3; ++i) {
+      fetches.clear();
+      ASSERT_STATUS_OK(stateful_values.Run({}, {}, {}, fetches, run));
+    }
+    VerifyOutputs(fetched_state.Get<Tensor>(), {2}, std::vector<float>{5.0f, 5.0f});
+
+    fetches.clear();
+    ASSERT_STATUS_OK(stateful_values.Run({}, {}, {"state_out"}, fetches, run));
+    VerifyOutputs(fetches, {2}, {9.0f, 9.0f});
+  }
+}
+
+TEST(InferenceSessionTests, StatefulInputsOutputsInvalidName) {
+  std::string model_file_name = "stateful_add_model_invalid.onnx";
+  CreateStatefulAddModel(model_file_name);
+
+  SessionOptions so;
+  so.stateful_inputs_outputs.push_back({"state_in", "not_an_output"});
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(model_file_name));
+  auto status = session_object.Initialize();
+  ASSERT_FALSE(status.IsOK());
+  ASSERT_TRUE(status.ErrorMessage().find("not_an_output") != std::string::npos);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
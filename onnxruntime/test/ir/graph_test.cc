@@ -1924,5 +1924,68 @@ TEST_F(GraphTest, DontRemoveUnusedInitializerWithGraphInput) {
 
   ASSERT_NE(j, inputs_including_initializers.cend()) << "Unused initializer was incorrectly removed.";
 }
+
+// Resolve only infers nodes again if their inputs, input types or attributes changed. A change of the graph input
+// shape must still reach all the downstream nodes, while the nodes it does not reach are skipped.
+TEST_F(GraphTest, IncrementalResolvePropagatesShapeChanges) {
+  Model m{"test_model", false, *logger_};
+  Graph& graph = m.MainGraph();
+
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto* input_shape = float_tensor.mutable_tensor_type()->mutable_shape();
+  input_shape->add_dim()->set_dim_value(2);
+  input_shape->add_dim();
+
+  TypeProto other_float_tensor;
+  other_float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  other_float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+
+  auto& input_arg = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& transpose_out = graph.GetOrCreateNodeArg("transpose_out", nullptr);
+  auto& relu_out = graph.GetOrCreateNodeArg("relu_out", nullptr);
+  auto& output_arg = graph.GetOrCreateNodeArg("Y", nullptr);
+  graph.AddNode("transpose", "Transpose", "", {&input_arg}, {&transpose_out})
+      .AddAttribute("perm", std::vector<int64_t>{1, 0});
+  graph.AddNode("relu", "Relu", "", {&transpose_out}, {&relu_out});
+  graph.AddNode("neg", "Neg", "", {&relu_out}, {&output_arg});
+
+  // a node the shape change of X does not reach
+  auto& other_input_arg = graph.GetOrCreateNodeArg("X2", &other_float_tensor);
+  auto& other_output_arg = graph.GetOrCreateNodeArg("Y2", nullptr);
+  graph.AddNode("abs", "Abs", "", {&other_input_arg}, {&other_output_arg});
+
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(graph.NumberOfNodesInferredByLastResolve(), 4u);
+
+  ASSERT_NE(output_arg.Shape(), nullptr);
+  ASSERT_EQ(output_arg.Shape()->dim_size(), 2);
+  EXPECT_FALSE(output_arg.Shape()->dim(0).has_dim_value());
+  EXPECT_EQ(output_arg.Shape()->dim(1).dim_value(), 2);
+
+  // nothing changed, so no node is inferred again
+  graph.SetGraphResolveNeeded();
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(graph.NumberOfNodesInferredByLastResolve(), 0u);
+
+  // the shape change is propagated through the unchanged Transpose and Relu nodes, and Abs is skipped.
+  input_shape->mutable_dim(1)->set_dim_value(3);
+  input_arg.SetShape(*input_shape);
+  graph.SetGraphResolveNeeded();
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(graph.NumberOfNodesInferredByLastResolve(), 3u);
+
+  for (const auto* arg : {&transpose_out, &relu_out, &output_arg}) {
+    ASSERT_NE(arg->Shape(), nullptr);
+    ASSERT_EQ(arg->Shape()->dim_size(), 2);
+    EXPECT_EQ(arg->Shape()->dim(0).dim_value(), 3) << arg->Name();
+    EXPECT_EQ(arg->Shape()->dim(1).dim_value(), 2) << arg->Name();
+  }
+
+  ASSERT_NE(other_output_arg.Shape(), nullptr);
+  ASSERT_EQ(other_output_arg.Shape()->dim_size(), 1);
+  EXPECT_EQ(other_output_arg.Shape()->dim(0).dim_value(), 4);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -66,6 +66,35 @@ class MlasConv2DTest : public MlasTestBase {
              BufferWorking.GetBuffer(WorkingBufferSize),
              Output,
              threadpool_);
+
+    OutputIsApproximate = (Parameters.Algorithm == MlasConvAlgorithmWinograd);
+
+    //
+    // Also run the convolution with a Winograd filter transformed ahead of
+    // time, as the Conv kernel does.
+    //
+
+    if (KernelHeight == 3 && KernelWidth == 3) {
+      for (size_t OutputTileSize : {4, 2}) {
+        size_t PackedFilterSize = MlasConvWinogradPackFilterSize(OutputTileSize, GroupCount, FilterCount, InputChannels);
+        float* PackedFilter = BufferPackedFilter.GetBuffer(PackedFilterSize);
+
+        MlasConvWinogradPackFilter(OutputTileSize, GroupCount, FilterCount, InputChannels, Filter, PackedFilter);
+
+        if (MlasConvWinogradUsePackedFilter(&Parameters, OutputTileSize, PackedFilter, &WorkingBufferSize, threadpool_)) {
+          OutputWinogradPacked = BufferOutputWinogradPacked.GetBuffer(BatchCount * GroupCount * FilterCount * OutputHeight * OutputWidth);
+
+          MlasConv(&Parameters,
+                   Input,
+                   nullptr,
+                   Bias,
+                   BufferWorking.GetBuffer(WorkingBufferSize),
+                   OutputWinogradPacked,
+                   threadpool_);
+          break;
+        }
+      }
+    }
   }
 
   void ReferenceConv2D(
@@ -153,6 +182,13 @@ class MlasConv2DTest : public MlasTestBase {
   MatrixGuardBuffer<float> BufferOutputReference;
   MatrixGuardBuffer<float> BufferWorking;
   MatrixGuardBuffer<float> BufferIm2Col;
+  MatrixGuardBuffer<float> BufferPackedFilter;
+  MatrixGuardBuffer<float> BufferOutputWinogradPacked;
+
+  // Set by MlasConv2D if the Winograd algorithm was used, which does not
+  // produce results identical to the reference.
+  bool OutputIsApproximate;
+  float* OutputWinogradPacked;
 
   MLAS_THREADPOOL* threadpool_;
 
@@ -214,6 +250,9 @@ class MlasConv2DTest : public MlasTestBase {
     float* Output = BufferOutput.GetBuffer(OutputElements);
     float* OutputReference = BufferOutputReference.GetBuffer(OutputElements);
 
+    OutputIsApproximate = false;
+    OutputWinogradPacked = nullptr;
+
     MlasConv2D(BatchCount,
                GroupCount,
                InputChannels,
@@ -245,6 +284,15 @@ class MlasConv2DTest : public MlasTestBase {
                     Bias,
                     OutputReference);
 
+    if (OutputWinogradPacked != nullptr) {
+      CheckApproximateOutput(OutputWinogradPacked, OutputReference, OutputElements);
+    }
+
+    if (OutputIsApproximate) {
+      CheckApproximateOutput(Output, OutputReference, OutputElements);
+      return;
+    }
+
     ASSERT_EQ(memcmp(Output, OutputReference, OutputElements * sizeof(float)), 0)
         << "B" << BatchCount << "/"
         << "G" << GroupCount << "/"
@@ -259,6 +307,25 @@ class MlasConv2DTest : public MlasTestBase {
         << "Stride" << StrideHeight << "," << StrideWidth;
   }
 
+  void CheckApproximateOutput(const float* Output, const float* OutputReference, size_t OutputElements) {
+    //
+    // The transforms introduce rounding errors relative to the magnitude of
+    // the intermediate sums.
+    //
+
+    float MaximumValue = 1.0f;
+
+    for (size_t i = 0; i < OutputElements; i++) {
+      MaximumValue = std::max(MaximumValue, std::abs(OutputReference[i]));
+    }
+
+    const float Tolerance = MaximumValue * 1e-4f;
+
+    for (size_t i = 0; i < OutputElements; i++) {
+      ASSERT_NEAR(Output[i], OutputReference[i], Tolerance) << "@" << i;
+    }
+  }
+
   void ExecuteLong(void) override {
     static const unsigned cs[] = {32, 14, 1};
     static const unsigned is[] = {53, 11, 5, 1};
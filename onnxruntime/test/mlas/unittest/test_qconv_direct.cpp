@@ -0,0 +1,128 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasConvDirectU8S8Test : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<uint8_t> BufferInput;
+  MatrixGuardBuffer<int8_t> BufferFilter;
+  MatrixGuardBuffer<uint8_t> BufferPackedFilter;
+  MatrixGuardBuffer<int32_t> BufferOutput;
+  MatrixGuardBuffer<int32_t> BufferOutputReference;
+
+  void Test(size_t InputChannels,
+            size_t OutputChannels,
+            size_t InputHeight,
+            size_t InputWidth,
+            size_t KernelHeight,
+            size_t KernelWidth,
+            size_t Padding,
+            size_t Stride,
+            uint8_t InputZeroPoint,
+            int8_t FilterZeroPoint) {
+    const size_t OutputHeight = (InputHeight + 2 * Padding - KernelHeight) / Stride + 1;
+    const size_t OutputWidth = (InputWidth + 2 * Padding - KernelWidth) / Stride + 1;
+    const size_t OutputCount = OutputHeight * OutputWidth;
+    const size_t KernelSize = KernelHeight * KernelWidth;
+
+    uint8_t* Input = BufferInput.GetBuffer(InputHeight * InputWidth * InputChannels);
+    int8_t* Filter = BufferFilter.GetBuffer(OutputChannels * InputChannels * KernelSize);
+    int32_t* Output = BufferOutput.GetBuffer(OutputCount * OutputChannels);
+    int32_t* OutputReference = BufferOutputReference.GetBuffer(OutputCount * OutputChannels);
+
+    std::default_random_engine generator(static_cast<unsigned>(InputChannels * OutputChannels + KernelSize));
+    std::uniform_int_distribution<int> input_distribution(0, 255);
+    // N.B. Limit the filter range to avoid saturating the intermediate 16-bit
+    // sums of the AVX2 kernel.
+    std::uniform_int_distribution<int> filter_distribution(-63, 63);
+
+    for (size_t i = 0; i < InputHeight * InputWidth * InputChannels; i++) {
+      Input[i] = static_cast<uint8_t>(input_distribution(generator));
+    }
+    for (size_t i = 0; i < OutputChannels * InputChannels * KernelSize; i++) {
+      Filter[i] = static_cast<int8_t>(filter_distribution(generator));
+    }
+
+    //
+    // Build the indirection buffer over the channels last input.
+    //
+
+    std::vector<uint8_t> PaddingVector(InputChannels, InputZeroPoint);
+    std::vector<const uint8_t*> Indirection(OutputCount * KernelSize);
+
+    for (size_t oh = 0; oh < OutputHeight; oh++) {
+      for (size_t ow = 0; ow < OutputWidth; ow++) {
+        for (size_t kh = 0; kh < KernelHeight; kh++) {
+          for (size_t kw = 0; kw < KernelWidth; kw++) {
+            const size_t ih = oh * Stride + kh - Padding;
+            const size_t iw = ow * Stride + kw - Padding;
+            const uint8_t* row = PaddingVector.data();
+            if (ih < InputHeight && iw < InputWidth) {
+              row = Input + (ih * InputWidth + iw) * InputChannels;
+            }
+            Indirection[((oh * OutputWidth + ow) * KernelHeight + kh) * KernelWidth + kw] = row;
+          }
+        }
+      }
+    }
+
+    for (size_t i = 0; i < OutputCount; i++) {
+      for (size_t oc = 0; oc < OutputChannels; oc++) {
+        int32_t Accumulator = 0;
+        for (size_t k = 0; k < KernelSize; k++) {
+          for (size_t ic = 0; ic < InputChannels; ic++) {
+            const int32_t InputValue = int32_t(Indirection[i * KernelSize + k][ic]) - InputZeroPoint;
+            const int32_t FilterValue = int32_t(Filter[(oc * InputChannels + ic) * KernelSize + k]) - FilterZeroPoint;
+            Accumulator += InputValue * FilterValue;
+          }
+        }
+        OutputReference[i * OutputChannels + oc] = Accumulator;
+      }
+    }
+
+    const size_t PackedFilterSize = MlasConvDirectU8S8PackFilterSize(OutputChannels, InputChannels, KernelSize);
+    uint8_t* PackedFilter = BufferPackedFilter.GetBuffer(PackedFilterSize);
+
+    MlasConvDirectU8S8PackFilter(OutputChannels, InputChannels, KernelSize, Filter, PackedFilter);
+    MlasConvDirectU8S8(Indirection.data(), InputZeroPoint, PackedFilter, FilterZeroPoint, Output,
+                       InputChannels, OutputChannels, OutputCount, KernelSize);
+
+    for (size_t i = 0; i < OutputCount * OutputChannels; i++) {
+      ASSERT_EQ(Output[i], OutputReference[i])
+          << " @" << i << ", C=" << InputChannels << " M=" << OutputChannels
+          << " H=" << InputHeight << " W=" << InputWidth << " K=" << KernelHeight << "x" << KernelWidth
+          << " P=" << Padding << " S=" << Stride
+          << " xzp=" << int(InputZeroPoint) << " wzp=" << int(FilterZeroPoint);
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("ConvDirectU8S8");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    static const size_t InputChannels[] = {1, 3, 4, 7, 16, 33, 64};
+    static const size_t OutputChannels[] = {1, 8, 15, 16, 17, 40};
+
+    for (size_t ic = 0; ic < _countof(InputChannels); ic++) {
+      for (size_t oc = 0; oc < _countof(OutputChannels); oc++) {
+        Test(InputChannels[ic], OutputChannels[oc], 7, 9, 3, 3, 1, 1, 128, 0);
+        Test(InputChannels[ic], OutputChannels[oc], 8, 8, 3, 3, 0, 2, 0, 0);
+        Test(InputChannels[ic], OutputChannels[oc], 6, 5, 1, 1, 0, 1, 7, 3);
+        Test(InputChannels[ic], OutputChannels[oc], 11, 10, 5, 3, 2, 1, 255, -5);
+      }
+    }
+  }
+};
+
+template <> MlasConvDirectU8S8Test* MlasTestFixture<MlasConvDirectU8S8Test>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  if (!is_short_execute || MlasConvDirectU8S8PackFilterSize(16, 16, 9) == 0) {
+    return size_t(0);
+  }
+  return MlasDirectShortExecuteTests<MlasConvDirectU8S8Test>::RegisterShortExecute();
+});
@@ -0,0 +1,74 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <memory>
+
+#include <benchmark/benchmark.h>
+#include <core/eager/ort_kernel_invoker.h>
+#include <core/framework/tensor.h>
+#include <core/providers/cpu/cpu_execution_provider.h>
+#include <core/session/ort_env.h>
+
+using namespace onnxruntime;
+
+extern OrtEnv* env;
+
+static OrtValue CreateEagerInput(const AllocatorPtr& allocator, int64_t size) {
+  auto tensor = std::make_unique<Tensor>(DataTypeImpl::GetType<float>(), TensorShape({size}), allocator);
+  std::fill_n(tensor->MutableData<float>(), size, 1.0f);
+  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+  return OrtValue{tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc()};
+}
+
+// Per call overhead of an eager Add on small tensors. The first invocation of an invoker builds and resolves a
+// graph and creates the kernel, and the following ones reuse the cached kernel.
+static void BM_EagerAddFirstCall(benchmark::State& state) {
+  const int64_t size = state.range(0);
+  IOnnxRuntimeOpSchemaRegistryList registries;
+  for (auto _ : state) {
+    state.PauseTiming();
+    ORTInvoker invoker(std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo(false)),
+                       env->GetLoggingManager()->DefaultLogger(), registries);
+    auto allocator = invoker.GetCurrentExecutionProvider().GetAllocator(0, OrtMemTypeDefault);
+    OrtValue a = CreateEagerInput(allocator, size);
+    OrtValue b = CreateEagerInput(allocator, size);
+    std::vector<OrtValue> outputs(1);
+    state.ResumeTiming();
+    auto status = invoker.Invoke("Add", {a, b}, outputs, nullptr);
+    if (!status.IsOK()) {
+      state.SkipWithError(status.ErrorMessage().c_str());
+      break;
+    }
+  }
+}
+
+BENCHMARK(BM_EagerAddFirstCall)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->Arg(16)
+    ->Arg(4096);
+
+static void BM_EagerAddCachedKernel(benchmark::State& state) {
+  const int64_t size = state.range(0);
+  IOnnxRuntimeOpSchemaRegistryList registries;
+  ORTInvoker invoker(std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo(false)),
+                     env->GetLoggingManager()->DefaultLogger(), registries);
+  auto allocator = invoker.GetCurrentExecutionProvider().GetAllocator(0, OrtMemTypeDefault);
+  OrtValue a = CreateEagerInput(allocator, size);
+  OrtValue b = CreateEagerInput(allocator, size);
+  for (auto _ : state) {
+    std::vector<OrtValue> outputs(1);
+    auto status = invoker.Invoke("Add", {a, b}, outputs, nullptr);
+    if (!status.IsOK()) {
+      state.SkipWithError(status.ErrorMessage().c_str());
+      break;
+    }
+  }
+}
+
+BENCHMARK(BM_EagerAddCachedKernel)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->Arg(16)
+    ->Arg(4096);
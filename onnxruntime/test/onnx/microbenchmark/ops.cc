@@ -0,0 +1,454 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Benchmarks of CPU kernels. Each benchmark runs a model with a single node whose input shapes are taken from
+// common models, with several intra-op thread counts.
+// To catch regressions, save the results with --benchmark_out=<file> --benchmark_out_format=json and compare
+// them with the results of a baseline build using tools/python/compare_benchmark_results.py.
+
+#include <benchmark/benchmark.h>
+#include <core/graph/constants.h>
+#include <core/graph/onnx_protobuf.h>
+#include <core/session/onnxruntime_c_api.h>
+#include <core/session/onnxruntime_cxx_api.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+extern OrtEnv* env;
+extern const OrtApi* g_ort;
+
+using namespace onnxruntime;
+
+namespace {
+
+size_t ShapeSize(const std::vector<int64_t>& shape) {
+  size_t size = 1;
+  for (int64_t dim : shape) {
+    size *= static_cast<size_t>(dim);
+  }
+  return size;
+}
+
+// fixed seeds keep the inputs, and so the work done by data dependent kernels, the same between runs
+std::vector<float> RandomFloats(const std::vector<int64_t>& shape) {
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  std::vector<float> data(ShapeSize(shape));
+  for (float& value : data) {
+    value = dist(gen);
+  }
+  return data;
+}
+
+std::vector<int64_t> RandomIndices(const std::vector<int64_t>& shape, int64_t upper) {
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<int64_t> dist(0, upper - 1);
+  std::vector<int64_t> data(ShapeSize(shape));
+  for (int64_t& value : data) {
+    value = dist(gen);
+  }
+  return data;
+}
+
+bool SkipOnError(benchmark::State& state, OrtStatus* status) {
+  if (status == nullptr) {
+    return false;
+  }
+  state.SkipWithError(g_ort->GetErrorMessage(status));
+  g_ort->ReleaseStatus(status);
+  return true;
+}
+
+class SingleNodeModel {
+ public:
+  explicit SingleNodeModel(const std::string& op_type, const std::string& domain = kOnnxDomain) {
+    model_.set_ir_version(ONNX_NAMESPACE::IR_VERSION);
+    for (const auto& domain_and_version : {std::make_pair(kOnnxDomain, 13),
+                                           std::make_pair(kMSDomain, 1),
+                                           std::make_pair(kMLDomain, 2)}) {
+      auto* opset = model_.add_opset_import();
+      opset->set_domain(domain_and_version.first);
+      opset->set_version(domain_and_version.second);
+    }
+
+    node_ = model_.mutable_graph()->add_node();
+    node_->set_op_type(op_type);
+    node_->set_domain(domain);
+  }
+
+  // Adds a graph input that is fed with data at every run.
+  void AddInput(const std::string& name, const std::vector<int64_t>& shape, std::vector<float> data) {
+    AddGraphInput(name, shape, ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    inputs_.push_back({name, shape, std::move(data), {}});
+  }
+
+  void AddInput(const std::string& name, const std::vector<int64_t>& shape, std::vector<int64_t> data) {
+    AddGraphInput(name, shape, ONNX_NAMESPACE::TensorProto_DataType_INT64);
+    inputs_.push_back({name, shape, {}, std::move(data)});
+  }
+
+  // Adds a constant input, e.g. weights or axes.
+  void AddInitializer(const std::string& name, const std::vector<int64_t>& shape, const std::vector<float>& data) {
+    auto* initializer = AddInitializerProto(name, shape, ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    for (float value : data) {
+      initializer->add_float_data(value);
+    }
+  }
+
+  void AddInitializer(const std::string& name, const std::vector<int64_t>& shape, const std::vector<int64_t>& data) {
+    auto* initializer = AddInitializerProto(name, shape, ONNX_NAMESPACE::TensorProto_DataType_INT64);
+    for (int64_t value : data) {
+      initializer->add_int64_data(value);
+    }
+  }
+
+  // Skips an optional input of the node.
+  void AddMissingInput() {
+    node_->add_input("");
+  }
+
+  void AddOutput(const std::string& name, ONNX_NAMESPACE::TensorProto_DataType elem_type) {
+    node_->add_output(name);
+    auto* output = model_.mutable_graph()->add_output();
+    output->set_name(name);
+    output->mutable_type()->mutable_tensor_type()->set_elem_type(elem_type);
+    output_names_.push_back(name);
+  }
+
+  void AddAttribute(const std::string& name, int64_t value) {
+    auto* attribute = AddAttributeProto(name, ONNX_NAMESPACE::AttributeProto_AttributeType_INT);
+    attribute->set_i(value);
+  }
+
+  void AddAttribute(const std::string& name, float value) {
+    auto* attribute = AddAttributeProto(name, ONNX_NAMESPACE::AttributeProto_AttributeType_FLOAT);
+    attribute->set_f(value);
+  }
+
+  void AddAttribute(const std::string& name, const std::string& value) {
+    auto* attribute = AddAttributeProto(name, ONNX_NAMESPACE::AttributeProto_AttributeType_STRING);
+    attribute->set_s(value);
+  }
+
+  void AddAttribute(const std::string& name, const std::vector<int64_t>& values) {
+    auto* attribute = AddAttributeProto(name, ONNX_NAMESPACE::AttributeProto_AttributeType_INTS);
+    for (int64_t value : values) {
+      attribute->add_ints(value);
+    }
+  }
+
+  void AddAttribute(const std::string& name, const std::vector<float>& values) {
+    auto* attribute = AddAttributeProto(name, ONNX_NAMESPACE::AttributeProto_AttributeType_FLOATS);
+    for (float value : values) {
+      attribute->add_floats(value);
+    }
+  }
+
+  void AddAttribute(const std::string& name, const std::vector<std::string>& values) {
+    auto* attribute = AddAttributeProto(name, ONNX_NAMESPACE::AttributeProto_AttributeType_STRINGS);
+    for (const auto& value : values) {
+      attribute->add_strings(value);
+    }
+  }
+
+  // Runs the model with the number of intra-op threads given by the first argument of the benchmark.
+  void Run(benchmark::State& state) {
+    const std::string model_data = model_.SerializeAsString();
+    Ort::SessionOptions session_options;
+    session_options.SetIntraOpNumThreads(static_cast<int>(state.range(0)));
+    session_options.SetGraphOptimizationLevel(ORT_DISABLE_ALL);
+    OrtSession* session = nullptr;
+    if (SkipOnError(state, g_ort->CreateSessionFromArray(env, model_data.data(), model_data.size(),
+                                                         session_options, &session))) {
+      return;
+    }
+
+    Ort::MemoryInfo memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+    std::vector<Ort::Value> input_values;
+    std::vector<const OrtValue*> raw_input_values;
+    std::vector<const char*> input_names;
+    for (auto& input : inputs_) {
+      if (!input.float_data.empty()) {
+        input_values.push_back(Ort::Value::CreateTensor<float>(memory_info, input.float_data.data(),
+                                                               input.float_data.size(),
+                                                               input.shape.data(), input.shape.size()));
+      } else {
+        input_values.push_back(Ort::Value::CreateTensor<int64_t>(memory_info, input.int64_data.data(),
+                                                                 input.int64_data.size(),
+                                                                 input.shape.data(), input.shape.size()));
+      }
+      raw_input_values.push_back(input_values.back());
+      input_names.push_back(input.name.c_str());
+    }
+
+    std::vector<const char*> output_names;
+    for (const auto& name : output_names_) {
+      output_names.push_back(name.c_str());
+    }
+    std::vector<OrtValue*> output_values(output_names.size(), nullptr);
+
+    for (auto _ : state) {
+      if (SkipOnError(state, g_ort->Run(session, nullptr, input_names.data(), raw_input_values.data(),
+                                        input_names.size(), output_names.data(), output_names.size(),
+                                        output_values.data()))) {
+        break;
+      }
+
+      for (OrtValue*& value : output_values) {
+        g_ort->ReleaseValue(value);
+        value = nullptr;
+      }
+    }
+
+    g_ort->ReleaseSession(session);
+  }
+
+ private:
+  struct Input {
+    std::string name;
+    std::vector<int64_t> shape;
+    std::vector<float> float_data;
+    std::vector<int64_t> int64_data;
+  };
+
+  void AddGraphInput(const std::string& name, const std::vector<int64_t>& shape,
+                     ONNX_NAMESPACE::TensorProto_DataType elem_type) {
+    node_->add_input(name);
+    auto* input = model_.mutable_graph()->add_input();
+    input->set_name(name);
+    auto* tensor_type = input->mutable_type()->mutable_tensor_type();
+    tensor_type->set_elem_type(elem_type);
+    for (int64_t dim : shape) {
+      tensor_type->mutable_shape()->add_dim()->set_dim_value(dim);
+    }
+  }
+
+  ONNX_NAMESPACE::TensorProto* AddInitializerProto(const std::string& name, const std::vector<int64_t>& shape,
+                                                   ONNX_NAMESPACE::TensorProto_DataType elem_type) {
+    node_->add_input(name);
+    auto* initializer = model_.mutable_graph()->add_initializer();
+    initializer->set_name(name);
+    initializer->set_data_type(elem_type);
+    for (int64_t dim : shape) {
+      initializer->add_dims(dim);
+    }
+    return initializer;
+  }
+
+  ONNX_NAMESPACE::AttributeProto* AddAttributeProto(const std::string& name,
+                                                    ONNX_NAMESPACE::AttributeProto_AttributeType type) {
+    auto* attribute = node_->add_attribute();
+    attribute->set_name(name);
+    attribute->set_type(type);
+    return attribute;
+  }
+
+  ONNX_NAMESPACE::ModelProto model_;
+  ONNX_NAMESPACE::NodeProto* node_;
+  std::vector<Input> inputs_;
+  std::vector<std::string> output_names_;
+};
+
+void ThreadCounts(benchmark::internal::Benchmark* b) {
+  b->ArgName("threads");
+  for (int threads : {1, 2, 4, 8}) {
+    b->Arg(threads);
+  }
+  b->UseRealTime();
+  b->Unit(benchmark::TimeUnit::kMicrosecond);
+}
+
+}  // namespace
+
+static void BM_Attention(benchmark::State& state, int64_t batch_size, int64_t sequence_length,
+                         int64_t hidden_size, int64_t num_heads) {
+  const std::vector<int64_t> input_shape{batch_size, sequence_length, hidden_size};
+  const std::vector<int64_t> weight_shape{hidden_size, 3 * hidden_size};
+  const std::vector<int64_t> bias_shape{3 * hidden_size};
+
+  SingleNodeModel model("Attention", kMSDomain);
+  model.AddInput("input", input_shape, RandomFloats(input_shape));
+  model.AddInitializer("weight", weight_shape, RandomFloats(weight_shape));
+  model.AddInitializer("bias", bias_shape, RandomFloats(bias_shape));
+  model.AddOutput("output", ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  model.AddAttribute("num_heads", num_heads);
+  model.Run(state);
+}
+
+BENCHMARK_CAPTURE(BM_Attention, bert_base_seq128, 1, 128, 768, 12)->Apply(ThreadCounts);
+BENCHMARK_CAPTURE(BM_Attention, bert_base_seq384, 1, 384, 768, 12)->Apply(ThreadCounts);
+
+static void BM_LayerNormalization(benchmark::State& state, std::vector<int64_t> input_shape) {
+  const std::vector<int64_t> scale_shape{input_shape.back()};
+
+  SingleNodeModel model("LayerNormalization");
+  model.AddInput("X", input_shape, RandomFloats(input_shape));
+  model.AddInitializer("scale", scale_shape, RandomFloats(scale_shape));
+  model.AddInitializer("B", scale_shape, RandomFloats(scale_shape));
+  model.AddOutput("Y", ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  model.AddAttribute("axis", int64_t{-1});
+  model.AddAttribute("epsilon", 1e-12f);
+  model.Run(state);
+}
+
+BENCHMARK_CAPTURE(BM_LayerNormalization, bert_base, std::vector<int64_t>{8, 128, 768})->Apply(ThreadCounts);
+BENCHMARK_CAPTURE(BM_LayerNormalization, bert_large, std::vector<int64_t>{8, 384, 1024})->Apply(ThreadCounts);
+
+static void BM_Gather(benchmark::State& state, std::vector<int64_t> data_shape, std::vector<int64_t> indices_shape) {
+  SingleNodeModel model("Gather");
+  model.AddInitializer("data", data_shape, RandomFloats(data_shape));
+  model.AddInput("indices", indices_shape, RandomIndices(indices_shape, data_shape[0]));
+  model.AddOutput("output", ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  model.AddAttribute("axis", int64_t{0});
+  model.Run(state);
+}
+
+BENCHMARK_CAPTURE(BM_Gather, bert_word_embedding, std::vector<int64_t>{30522, 768}, std::vector<int64_t>{8, 128})
+    ->Apply(ThreadCounts);
+
+static void BM_Resize(benchmark::State& state, std::vector<int64_t> input_shape, std::vector<float> scales,
+                      std::string mode) {
+  SingleNodeModel model("Resize");
+  model.AddInput("X", input_shape, RandomFloats(input_shape));
+  model.AddMissingInput();
+  model.AddInitializer("scales", {static_cast<int64_t>(scales.size())}, scales);
+  model.AddOutput("Y", ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  model.AddAttribute("mode", mode);
+  model.Run(state);
+}
+
+BENCHMARK_CAPTURE(BM_Resize, linear_upsample_2x, std::vector<int64_t>{1, 3, 224, 224},
+                  std::vector<float>{1.f, 1.f, 2.f, 2.f}, std::string("linear"))
+    ->Apply(ThreadCounts);
+BENCHMARK_CAPTURE(BM_Resize, nearest_upsample_2x, std::vector<int64_t>{1, 256, 40, 40},
+                  std::vector<float>{1.f, 1.f, 2.f, 2.f}, std::string("nearest"))
+    ->Apply(ThreadCounts);
+
+static void BM_TopK(benchmark::State& state, std::vector<int64_t> input_shape, int64_t k) {
+  SingleNodeModel model("TopK");
+  model.AddInput("X", input_shape, RandomFloats(input_shape));
+  model.AddInitializer("K", {1}, std::vector<int64_t>{k});
+  model.AddOutput("values", ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  model.AddOutput("indices", ONNX_NAMESPACE::TensorProto_DataType_INT64);
+  model.AddAttribute("axis", int64_t{-1});
+  model.Run(state);
+}
+
+BENCHMARK_CAPTURE(BM_TopK, classification_top5, std::vector<int64_t>{64, 1000}, 5)->Apply(ThreadCounts);
+BENCHMARK_CAPTURE(BM_TopK, vocabulary_top50, std::vector<int64_t>{8, 32000}, 50)->Apply(ThreadCounts);
+
+static void BM_Reduce(benchmark::State& state, std::string op_type, std::vector<int64_t> input_shape,
+                      std::vector<int64_t> axes) {
+  SingleNodeModel model(op_type);
+  model.AddInput("data", input_shape, RandomFloats(input_shape));
+  model.AddOutput("reduced", ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  model.AddAttribute("axes", axes);
+  model.Run(state);
+}
+
+BENCHMARK_CAPTURE(BM_Reduce, mean_last_axis, std::string("ReduceMean"), std::vector<int64_t>{8, 128, 768},
+                  std::vector<int64_t>{-1})
+    ->Apply(ThreadCounts);
+BENCHMARK_CAPTURE(BM_Reduce, mean_spatial, std::string("ReduceMean"), std::vector<int64_t>{8, 512, 14, 14},
+                  std::vector<int64_t>{2, 3})
+    ->Apply(ThreadCounts);
+BENCHMARK_CAPTURE(BM_Reduce, max_middle_axis, std::string("ReduceMax"), std::vector<int64_t>{8, 128, 768},
+                  std::vector<int64_t>{1})
+    ->Apply(ThreadCounts);
+
+static void BM_Concat(benchmark::State& state, std::vector<int64_t> input_shape, int64_t num_inputs) {
+  SingleNodeModel model("Concat");
+  for (int64_t i = 0; i < num_inputs; ++i) {
+    model.AddInput("input" + std::to_string(i), input_shape, RandomFloats(input_shape));
+  }
+  model.AddOutput("concat_result", ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  model.AddAttribute("axis", int64_t{-1});
+  model.Run(state);
+}
+
+BENCHMARK_CAPTURE(BM_Concat, attention_heads, std::vector<int64_t>{8, 128, 64}, 12)->Apply(ThreadCounts);
+
+static void BM_Cast(benchmark::State& state, std::vector<int64_t> input_shape,
+                    ONNX_NAMESPACE::TensorProto_DataType to) {
+  SingleNodeModel model("Cast");
+  model.AddInput("input", input_shape, RandomFloats(input_shape));
+  model.AddOutput("output", to);
+  model.AddAttribute("to", static_cast<int64_t>(to));
+  model.Run(state);
+}
+
+BENCHMARK_CAPTURE(BM_Cast, float_to_float16, std::vector<int64_t>{8, 128, 768},
+                  ONNX_NAMESPACE::TensorProto_DataType_FLOAT16)
+    ->Apply(ThreadCounts);
+BENCHMARK_CAPTURE(BM_Cast, float_to_double, std::vector<int64_t>{8, 128, 768},
+                  ONNX_NAMESPACE::TensorProto_DataType_DOUBLE)
+    ->Apply(ThreadCounts);
+
+static void BM_Softmax(benchmark::State& state, std::vector<int64_t> input_shape) {
+  SingleNodeModel model("Softmax");
+  model.AddInput("input", input_shape, RandomFloats(input_shape));
+  model.AddOutput("output", ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  model.AddAttribute("axis", int64_t{-1});
+  model.Run(state);
+}
+
+BENCHMARK_CAPTURE(BM_Softmax, attention_scores, std::vector<int64_t>{8, 12, 128, 128})->Apply(ThreadCounts);
+
+// complete binary trees with random splits, the way a gradient boosting model with a fixed depth looks like
+static void BM_TreeEnsembleRegressor(benchmark::State& state, int64_t num_trees, int64_t depth,
+                                     int64_t batch_size, int64_t num_features) {
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<int64_t> feature_dist(0, num_features - 1);
+  std::uniform_real_distribution<float> value_dist(-1.f, 1.f);
+
+  std::vector<int64_t> nodes_treeids, nodes_nodeids, nodes_featureids, nodes_truenodeids, nodes_falsenodeids;
+  std::vector<float> nodes_values;
+  std::vector<std::string> nodes_modes;
+  std::vector<int64_t> target_treeids, target_nodeids, target_ids;
+  std::vector<float> target_weights;
+
+  const int64_t num_internal_nodes = (int64_t{1} << depth) - 1;
+  const int64_t num_nodes = (int64_t{1} << (depth + 1)) - 1;
+  for (int64_t tree = 0; tree < num_trees; ++tree) {
+    for (int64_t node = 0; node < num_nodes; ++node) {
+      const bool is_leaf = node >= num_internal_nodes;
+      nodes_treeids.push_back(tree);
+      nodes_nodeids.push_back(node);
+      nodes_featureids.push_back(is_leaf ? 0 : feature_dist(gen));
+      nodes_values.push_back(is_leaf ? 0.f : value_dist(gen));
+      nodes_modes.push_back(is_leaf ? "LEAF" : "BRANCH_LEQ");
+      nodes_truenodeids.push_back(is_leaf ? 0 : 2 * node + 1);
+      nodes_falsenodeids.push_back(is_leaf ? 0 : 2 * node + 2);
+      if (is_leaf) {
+        target_treeids.push_back(tree);
+        target_nodeids.push_back(node);
+        target_ids.push_back(0);
+        target_weights.push_back(value_dist(gen));
+      }
+    }
+  }
+
+  const std::vector<int64_t> input_shape{batch_size, num_features};
+  SingleNodeModel model("TreeEnsembleRegressor", kMLDomain);
+  model.AddInput("X", input_shape, RandomFloats(input_shape));
+  model.AddOutput("Y", ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  model.AddAttribute("n_targets", int64_t{1});
+  model.AddAttribute("aggregate_function", std::string("SUM"));
+  model.AddAttribute("nodes_treeids", nodes_treeids);
+  model.AddAttribute("nodes_nodeids", nodes_nodeids);
+  model.AddAttribute("nodes_featureids", nodes_featureids);
+  model.AddAttribute("nodes_values", nodes_values);
+  model.AddAttribute("nodes_modes", nodes_modes);
+  model.AddAttribute("nodes_truenodeids", nodes_truenodeids);
+  model.AddAttribute("nodes_falsenodeids", nodes_falsenodeids);
+  model.AddAttribute("target_treeids", target_treeids);
+  model.AddAttribute("target_nodeids", target_nodeids);
+  model.AddAttribute("target_ids", target_ids);
+  model.AddAttribute("target_weights", target_weights);
+  model.Run(state);
+}
+
+BENCHMARK_CAPTURE(BM_TreeEnsembleRegressor, trees100_depth6_batch1, 100, 6, 1, 100)->Apply(ThreadCounts);
+BENCHMARK_CAPTURE(BM_TreeEnsembleRegressor, trees100_depth6_batch1000, 100, 6, 1000, 100)->Apply(ThreadCounts);
@@ -0,0 +1,149 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+TEST(ElementwiseFusionTests, FuseChain) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 8, 16}, -1.f, 1.f);
+    auto* add_out = builder.MakeIntermediate();
+    auto* mul_out = builder.MakeIntermediate();
+    auto* sigmoid_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    auto* bias_arg = builder.MakeInitializer<float>({16}, -1.f, 1.f);
+    auto* scale_arg = builder.MakeScalarInitializer<float>(0.5f);
+
+    builder.AddNode("Add", {bias_arg, input_arg}, {add_out});
+    builder.AddNode("Mul", {add_out, scale_arg}, {mul_out});
+    builder.AddNode("Sigmoid", {mul_out}, {sigmoid_out});
+    builder.AddNode("Mul", {input_arg, sigmoid_out}, {output_arg});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Add"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+    EXPECT_EQ(op_to_count["Sigmoid"], 0);
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level2,
+                    12,
+                    1e-5);
+}
+
+TEST(ElementwiseFusionTests, StopAtSharedOutput) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({4, 16}, -1.f, 1.f);
+    auto* sub_out = builder.MakeIntermediate();
+    auto* div_out = builder.MakeIntermediate();
+    auto* output1_arg = builder.MakeOutput();
+    auto* output2_arg = builder.MakeOutput();
+    auto* offset_arg = builder.MakeScalarInitializer<float>(2.f);
+    auto* scale_arg = builder.MakeInitializer<float>({1, 16}, 1.f, 2.f);
+    auto* exponent_arg = builder.MakeScalarInitializer<float>(2.f);
+
+    builder.AddNode("Sub", {input_arg, offset_arg}, {sub_out});
+    builder.AddNode("Div", {sub_out, scale_arg}, {div_out});
+    builder.AddNode("Pow", {div_out, exponent_arg}, {output1_arg});
+    // The output of Div has two consumers, so the chain ends at Div.
+    builder.AddNode("Relu", {div_out}, {output2_arg});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Pow"], 1);
+    EXPECT_EQ(op_to_count["Relu"], 1);
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level2);
+}
+
+TEST(ElementwiseFusionTests, SkipConvAddRelu) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({1, 8, 12, 12}, -1.f, 1.f);
+    auto* conv_out = builder.MakeIntermediate();
+    auto* add_out = builder.MakeIntermediate();
+    auto* relu_out = builder.MakeIntermediate();
+    auto* mul_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    auto* weight_arg = builder.MakeInitializer<float>({8, 8, 3, 3}, -1.f, 1.f);
+    auto* scale_arg = builder.MakeScalarInitializer<float>(0.5f);
+    auto* offset_arg = builder.MakeScalarInitializer<float>(0.25f);
+
+    builder.AddNode("Conv", {input_arg, weight_arg}, {conv_out}).AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+    builder.AddNode("Add", {conv_out, input_arg}, {add_out});
+    builder.AddNode("Relu", {add_out}, {relu_out});
+    builder.AddNode("Mul", {relu_out, scale_arg}, {mul_out});
+    builder.AddNode("Add", {mul_out, offset_arg}, {output_arg});
+  };
+
+  // The residual Add and the Relu are left for the NCHWc Conv fusion, so only the tail is fused.
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Add"], 1);
+    EXPECT_EQ(op_to_count["Relu"], 1);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level2,
+                    12,
+                    1e-5);
+}
+
+TEST(ElementwiseFusionTests, SkipOperandOfHigherRank) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 4}, -1.f, 1.f);
+    auto* relu_out = builder.MakeIntermediate();
+    auto* mul_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    auto* scale_arg = builder.MakeScalarInitializer<float>(0.5f);
+    auto* bias_arg = builder.MakeInitializer<float>({1, 1, 4}, -1.f, 1.f);
+
+    builder.AddNode("Relu", {input_arg}, {relu_out});
+    builder.AddNode("Mul", {relu_out, scale_arg}, {mul_out});
+    // The output of Add has the shape {1, 2, 4}, a higher rank than the chain.
+    builder.AddNode("Add", {mul_out, bias_arg}, {output_arg});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Add"], 1);
+    EXPECT_EQ(op_to_count["Relu"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level2,
+                    12,
+                    1e-5);
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -61,6 +61,8 @@
 #include "core/optimizer/propagate_cast_ops.h"
 #include "core/optimizer/utils.h"
 #include "core/platform/env.h"
+#include "core/platform/ort_mutex.h"
+#include "core/platform/threadpool.h"
 #include "core/session/inference_session.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/util/math.h"
@@ -349,6 +351,87 @@ TEST_F(GraphTransformationTests, ConstantFoldingSubgraph) {
       << "Constant folding should have been able to remove the Add node in both subgraphs";
 }
 
+// Transformer that records the subgraphs it is applied to, and reports each of them as modified.
+class SubgraphRecordingTransformer : public GraphTransformer {
+ public:
+  SubgraphRecordingTransformer() noexcept : GraphTransformer("SubgraphRecordingTransformer") {}
+
+  std::vector<const Graph*> GetTransformedSubgraphs() const {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    return transformed_subgraphs_;
+  }
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override {
+    GraphViewer graph_viewer(graph);
+    for (auto node_index : graph_viewer.GetNodesInTopologicalOrder()) {
+      ORT_RETURN_IF_ERROR(Recurse(*graph.GetNode(node_index), modified, graph_level, logger));
+    }
+
+    if (graph_level > 0) {
+      std::lock_guard<OrtMutex> lock(mutex_);
+      transformed_subgraphs_.push_back(&graph);
+      modified = true;
+    }
+
+    return Status::OK();
+  }
+
+  mutable OrtMutex mutex_;
+  mutable std::vector<const Graph*> transformed_subgraphs_;
+};
+
+// The branches of an If node are transformed in parallel when the transformer has a thread pool.
+TEST_F(GraphTransformationTests, TransformSubgraphsInParallel) {
+  TypeProto float_tensor_type;
+  float_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  // create a subgraph that returns a value of the parent graph
+  GraphProto subgraph;
+  {
+    Model model("TransformSubgraphsInParallel_subgraph", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, *logger_);
+    auto& graph = model.MainGraph();
+    auto& parent_value_arg = graph.GetOrCreateNodeArg("parent_value", &float_tensor_type);
+    graph.AddOuterScopeNodeArg("parent_value");
+    auto& subgraph_out = graph.GetOrCreateNodeArg("subgraph_out", &float_tensor_type);
+    graph.AddNode("identity", "Identity", "", {&parent_value_arg}, {&subgraph_out});
+    ASSERT_STATUS_OK(graph.Resolve());
+    subgraph = graph.ToGraphProto();
+  }
+
+  Model model("TransformSubgraphsInParallel_main_graph", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto if_cond_type;
+  if_cond_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+  if_cond_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  auto& if_cond_input = graph.GetOrCreateNodeArg("if_in", &if_cond_type);
+  auto& parent_value_input = graph.GetOrCreateNodeArg("parent_value_in", &float_tensor_type);
+  auto& parent_value = graph.GetOrCreateNodeArg("parent_value", &float_tensor_type);
+  auto& if_output = graph.GetOrCreateNodeArg("if_out", &float_tensor_type);
+  graph.AddNode("identity", "Identity", "", {&parent_value_input}, {&parent_value});
+  auto& if_node = graph.AddNode("if", "If", "If node", {&if_cond_input}, {&if_output});
+  if_node.AddAttribute("then_branch", subgraph);
+  if_node.AddAttribute("else_branch", subgraph);
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  auto thread_pool = std::make_unique<concurrency::ThreadPool>(&Env::Default(), ThreadOptions(), nullptr, 2, true);
+  SubgraphRecordingTransformer transformer;
+  transformer.SetThreadPool(thread_pool.get());
+
+  bool modified = false;
+  ASSERT_STATUS_OK(transformer.Apply(graph, modified, *logger_));
+  EXPECT_TRUE(modified) << "The modification of a subgraph should be reported for the main graph";
+
+  auto transformed_subgraphs = transformer.GetTransformedSubgraphs();
+  std::sort(transformed_subgraphs.begin(), transformed_subgraphs.end());
+  std::vector<const Graph*> expected_subgraphs{if_node.GetGraphAttribute("then_branch"),
+                                               if_node.GetGraphAttribute("else_branch")};
+  std::sort(expected_subgraphs.begin(), expected_subgraphs.end());
+  EXPECT_EQ(transformed_subgraphs, expected_subgraphs);
+}
+
 TEST_F(GraphTransformationTests, ConstantFoldingWithShapeToInitializer) {
   auto model_uri = MODEL_FOLDER "fusion/constant_folding_with_shape_to_initializer.onnx";
   std::shared_ptr<Model> model;
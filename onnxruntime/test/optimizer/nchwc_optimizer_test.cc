@@ -564,6 +564,39 @@ TEST(NchwcOptimizerTests, ConvAddFusion) {
   }
 }
 
+TEST(NchwcOptimizerTests, ConvAddReluFusionWithElementwiseTail) {
+  auto build_test_case = [&](NchwcTestHelper& helper) {
+    auto* input_arg = helper.MakeInput<float>({1, 32, 28, 28});
+    auto* conv1_output_arg = helper.MakeIntermediate();
+    auto* conv2_output_arg = helper.MakeIntermediate();
+    auto* add_output_arg = helper.MakeIntermediate();
+    auto* relu_output_arg = helper.MakeIntermediate();
+    auto* mul_output_arg = helper.MakeIntermediate();
+    auto* output_arg = helper.MakeOutput();
+
+    helper.AddConvNode(input_arg, conv1_output_arg, {32, 32, 3, 3});
+    helper.AddConvNode(input_arg, conv2_output_arg, {32, 32, 3, 3});
+    helper.AddNode("Add", {conv1_output_arg, conv2_output_arg}, {add_output_arg});
+    helper.AddNode("Relu", {add_output_arg}, {relu_output_arg});
+    helper.AddNode("Mul", {relu_output_arg, helper.Make1DInitializer<float>({0.5f})}, {mul_output_arg});
+    helper.AddNode("Sigmoid", {mul_output_arg}, {output_arg});
+  };
+
+  auto check_nchwc_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.nchwc.Conv"], 2);
+    EXPECT_EQ(op_to_count["com.microsoft.nchwc.ReorderInput"], 1);
+    EXPECT_EQ(op_to_count["com.microsoft.nchwc.ReorderOutput"], 1);
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Add"], 0);
+    EXPECT_EQ(op_to_count["Relu"], 0);
+  };
+
+  // Verify that the elementwise fusion at Level2 leaves the Add and Relu nodes
+  // for the NCHWc Conv fusion and only merges the operators that follow them.
+  NchwcOptimizerTester(build_test_case, check_nchwc_graph);
+}
+
 TEST(NchwcOptimizerTests, ConvNoBiasAddFusion) {
   auto build_test_case = [&](NchwcTestHelper& helper) {
     auto* input_arg = helper.MakeInput<float>({1, 32, 28, 28});
@@ -140,6 +140,43 @@ TEST(NhwcTransformerTests, ConvBlockBinary) {
   }
 }
 
+TEST(NhwcTransformerTests, ConvBinaryConstantConv) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<uint8_t>({1, 23, 13, 13}, 0, 31);
+    auto* conv1_output_arg = builder.MakeIntermediate();
+    auto* add_output_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    auto* conv1_weight_arg = NhwcMakeInitializer<int8_t>(builder, {30, 23, 3, 3});
+    auto* conv2_weight_arg = NhwcMakeInitializer<int8_t>(builder, {16, 30, 3, 3});
+    auto* channel_arg = builder.MakeInitializer<uint8_t>({1, 30, 1, 1}, 0, 255);
+
+    builder.AddQLinearConvNode<int8_t>(input_arg, .01f, 135,
+                                       conv1_weight_arg, .02f, 0,
+                                       conv1_output_arg, .37f, 131);
+    builder.AddQLinearBinaryNode("QLinearAdd",
+                                 conv1_output_arg, .37f, 131,
+                                 channel_arg, .05f, 128,
+                                 add_output_arg, .43f, 126);
+    builder.AddQLinearConvNode<int8_t>(add_output_arg, .43f, 126,
+                                       conv2_weight_arg, .02f, 0,
+                                       output_arg, .37f, 131);
+  };
+
+  auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.QLinearConv"], 2);
+    // The per-channel constant is reordered instead of the convolution
+    // outputs: one Transpose each for the graph input, the constant, and the
+    // graph output.
+    EXPECT_EQ(op_to_count["Transpose"], 3);
+  };
+
+  TransformerTester(build_test_case,
+                    check_nhwc_graph,
+                    TransformerLevel::Level2,
+                    TransformerLevel::Level3);
+}
+
 TEST(NhwcTransformerTests, ConvMaxPool) {
   auto test_case = [&](const std::vector<int64_t>& input_shape, const std::vector<int64_t>& weights_shape) {
     auto build_test_case = [&](ModelTestBuilder& builder) {
@@ -0,0 +1,317 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+#include "core/optimizer/initializer.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(TransposeOptimizerTests, CancelThroughElementwise) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 4, 5}, -1.f, 1.f);
+    auto* transpose_1_out = builder.MakeIntermediate();
+    auto* add_out = builder.MakeIntermediate();
+    auto* relu_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    auto* bias_arg = builder.MakeInitializer<float>({3}, -1.f, 1.f);
+
+    builder.AddNode("Transpose", {input_arg}, {transpose_1_out}).AddAttribute("perm", std::vector<int64_t>{0, 2, 3, 1});
+    builder.AddNode("Add", {transpose_1_out, bias_arg}, {add_out});
+    builder.AddNode("Relu", {add_out}, {relu_out});
+    builder.AddNode("Transpose", {relu_out}, {output_arg}).AddAttribute("perm", std::vector<int64_t>{0, 3, 1, 2});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 0);
+    EXPECT_EQ(op_to_count["Add"], 1);
+    EXPECT_EQ(op_to_count["Relu"], 1);
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level1);
+}
+
+TEST(TransposeOptimizerTests, MergeThroughConcatAndReduce) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input1_arg = builder.MakeInput<float>({2, 3, 4}, -1.f, 1.f);
+    auto* input2_arg = builder.MakeInput<float>({2, 3, 4}, -1.f, 1.f);
+    auto* transpose_1_out = builder.MakeIntermediate();
+    auto* transpose_2_out = builder.MakeIntermediate();
+    auto* concat_out = builder.MakeIntermediate();
+    auto* reduce_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Transpose", {input1_arg}, {transpose_1_out}).AddAttribute("perm", std::vector<int64_t>{2, 0, 1});
+    builder.AddNode("Transpose", {input2_arg}, {transpose_2_out}).AddAttribute("perm", std::vector<int64_t>{2, 0, 1});
+    builder.AddNode("Concat", {transpose_1_out, transpose_2_out}, {concat_out}).AddAttribute("axis", int64_t{-1});
+    auto& reduce_node = builder.AddNode("ReduceMean", {concat_out}, {reduce_out});
+    reduce_node.AddAttribute("axes", std::vector<int64_t>{1});
+    reduce_node.AddAttribute("keepdims", int64_t{0});
+    builder.AddNode("Transpose", {reduce_out}, {output_arg}).AddAttribute("perm", std::vector<int64_t>{1, 0});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 0);
+    EXPECT_EQ(op_to_count["Concat"], 1);
+    EXPECT_EQ(op_to_count["ReduceMean"], 1);
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level1);
+}
+
+TEST(TransposeOptimizerTests, PushThroughReduceWithEmptyAxes) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 4}, -1.f, 1.f);
+    auto* transpose_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    auto* axes_arg = builder.MakeInitializer<int64_t>({0}, std::vector<int64_t>{});
+
+    builder.AddNode("Transpose", {input_arg}, {transpose_out}).AddAttribute("perm", std::vector<int64_t>{2, 0, 1});
+    // empty axes reduce all the axes, so the output is a scalar
+    builder.AddNode("ReduceSum", {transpose_out, axes_arg}, {output_arg}).AddAttribute("keepdims", int64_t{0});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 0);
+    EXPECT_EQ(op_to_count["ReduceSum"], 1);
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level1,
+                    13);
+}
+
+TEST(TransposeOptimizerTests, KeepUnpairedTranspose) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 4}, -1.f, 1.f);
+    auto* transpose_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Transpose", {input_arg}, {transpose_out}).AddAttribute("perm", std::vector<int64_t>{0, 2, 1});
+    builder.AddNode("Relu", {transpose_out}, {output_arg});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    const auto& graph = session.GetGraph();
+    auto op_to_count = CountOpsInGraph(graph);
+    EXPECT_EQ(op_to_count["Transpose"], 1);
+    EXPECT_EQ(op_to_count["Relu"], 1);
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "Relu") {
+        EXPECT_EQ(node.InputNodesBegin()->OpType(), "Transpose");
+      }
+    }
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level1);
+}
+
+TEST(TransposeOptimizerTests, PushThroughSplit) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 4}, -1.f, 1.f);
+    auto* transpose_out = builder.MakeIntermediate();
+    auto* split_out_1 = builder.MakeIntermediate();
+    auto* split_out_2 = builder.MakeIntermediate();
+    auto* output_arg_1 = builder.MakeOutput();
+    auto* output_arg_2 = builder.MakeOutput();
+
+    builder.AddNode("Transpose", {input_arg}, {transpose_out}).AddAttribute("perm", std::vector<int64_t>{0, 2, 1});
+    auto& split_node = builder.AddNode("Split", {transpose_out}, {split_out_1, split_out_2});
+    split_node.AddAttribute("axis", int64_t{1});
+    split_node.AddAttribute("split", std::vector<int64_t>{1, 3});
+    builder.AddNode("Transpose", {split_out_1}, {output_arg_1}).AddAttribute("perm", std::vector<int64_t>{0, 2, 1});
+    builder.AddNode("Transpose", {split_out_2}, {output_arg_2}).AddAttribute("perm", std::vector<int64_t>{0, 2, 1});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    const auto& graph = session.GetGraph();
+    auto op_to_count = CountOpsInGraph(graph);
+    EXPECT_EQ(op_to_count["Transpose"], 0);
+    EXPECT_EQ(op_to_count["Split"], 1);
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "Split") {
+        EXPECT_EQ(node.GetAttributes().at("axis").i(), 2);
+      }
+    }
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level1);
+}
+
+TEST(TransposeOptimizerTests, PushThroughUnsqueezeAndSqueeze) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 4}, -1.f, 1.f);
+    auto* transpose_out = builder.MakeIntermediate();
+    auto* unsqueeze_out = builder.MakeIntermediate();
+    auto* relu_out = builder.MakeIntermediate();
+    auto* squeeze_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    // {2, 3, 4} -> {3, 2, 4} -> {3, 1, 2, 4} -> {3, 2, 4} -> {2, 3, 4}
+    builder.AddNode("Transpose", {input_arg}, {transpose_out}).AddAttribute("perm", std::vector<int64_t>{1, 0, 2});
+    builder.AddNode("Unsqueeze", {transpose_out}, {unsqueeze_out}).AddAttribute("axes", std::vector<int64_t>{1});
+    builder.AddNode("Relu", {unsqueeze_out}, {relu_out});
+    builder.AddNode("Squeeze", {relu_out}, {squeeze_out}).AddAttribute("axes", std::vector<int64_t>{-3});
+    builder.AddNode("Transpose", {squeeze_out}, {output_arg}).AddAttribute("perm", std::vector<int64_t>{1, 0, 2});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    const auto& graph = session.GetGraph();
+    auto op_to_count = CountOpsInGraph(graph);
+    EXPECT_EQ(op_to_count["Transpose"], 0);
+    EXPECT_EQ(op_to_count["Unsqueeze"], 1);
+    EXPECT_EQ(op_to_count["Squeeze"], 1);
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "Unsqueeze" || node.OpType() == "Squeeze") {
+        const auto& axes = node.GetAttributes().at("axes").ints();
+        EXPECT_EQ(std::vector<int64_t>(axes.begin(), axes.end()), std::vector<int64_t>{1});
+      }
+    }
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level1);
+}
+
+TEST(TransposeOptimizerTests, PushThroughPad) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({1, 2, 3, 4}, -1.f, 1.f);
+    auto* pads_arg = builder.Make1DInitializer<int64_t>({0, 1, 2, 0, 0, 3, 0, 0});
+    auto* transpose_out = builder.MakeIntermediate();
+    auto* pad_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Transpose", {input_arg}, {transpose_out}).AddAttribute("perm", std::vector<int64_t>{0, 2, 3, 1});
+    builder.AddNode("Pad", {transpose_out, pads_arg}, {pad_out});
+    builder.AddNode("Transpose", {pad_out}, {output_arg}).AddAttribute("perm", std::vector<int64_t>{0, 3, 1, 2});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    const auto& graph = session.GetGraph();
+    auto op_to_count = CountOpsInGraph(graph);
+    EXPECT_EQ(op_to_count["Transpose"], 0);
+    EXPECT_EQ(op_to_count["Pad"], 1);
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "Pad") {
+        const auto* pads_tensor = graph.GetConstantInitializer(node.InputDefs()[1]->Name(), true);
+        ASSERT_NE(pads_tensor, nullptr);
+        Initializer pads{*pads_tensor, graph.ModelPath()};
+        EXPECT_EQ(std::vector<int64_t>(pads.data<int64_t>(), pads.data<int64_t>() + pads.size()),
+                  (std::vector<int64_t>{0, 0, 1, 2, 0, 0, 3, 0}));
+      }
+    }
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level1);
+}
+
+TEST(TransposeOptimizerTests, PushThroughSoftmax) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 4}, -1.f, 1.f);
+    auto* transpose_out = builder.MakeIntermediate();
+    auto* softmax_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Transpose", {input_arg}, {transpose_out}).AddAttribute("perm", std::vector<int64_t>{0, 2, 1});
+    builder.AddNode("Softmax", {transpose_out}, {softmax_out}).AddAttribute("axis", int64_t{1});
+    builder.AddNode("Transpose", {softmax_out}, {output_arg}).AddAttribute("perm", std::vector<int64_t>{0, 2, 1});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    const auto& graph = session.GetGraph();
+    auto op_to_count = CountOpsInGraph(graph);
+    EXPECT_EQ(op_to_count["Transpose"], 0);
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "Softmax") {
+        EXPECT_EQ(node.GetAttributes().at("axis").i(), 2);
+      }
+    }
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level1,
+                    13);
+
+  // Before opset 13 Softmax flattens the input at the axis, so the Transpose nodes stay.
+  auto check_graph_opset12 = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 2);
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph_opset12,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level1,
+                    12);
+}
+
+TEST(TransposeOptimizerTests, PushThroughPerAxisQDQ) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 4}, -1.f, 1.f);
+    auto* scale_arg = builder.Make1DInitializer<float>({0.01f, 0.02f, 0.03f});
+    auto* zero_point_arg = builder.Make1DInitializer<uint8_t>({128, 100, 150});
+    auto* transpose_out = builder.MakeIntermediate();
+    auto* quantize_out = builder.MakeIntermediate();
+    auto* dequantize_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    // The scales apply to the axis of size 3, which is axis 2 after the Transpose and axis 1 before it.
+    builder.AddNode("Transpose", {input_arg}, {transpose_out}).AddAttribute("perm", std::vector<int64_t>{0, 2, 1});
+    builder.AddNode("QuantizeLinear", {transpose_out, scale_arg, zero_point_arg}, {quantize_out})
+        .AddAttribute("axis", int64_t{2});
+    builder.AddNode("DequantizeLinear", {quantize_out, scale_arg, zero_point_arg}, {dequantize_out})
+        .AddAttribute("axis", int64_t{-1});
+    builder.AddNode("Transpose", {dequantize_out}, {output_arg}).AddAttribute("perm", std::vector<int64_t>{0, 2, 1});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    const auto& graph = session.GetGraph();
+    auto op_to_count = CountOpsInGraph(graph);
+    EXPECT_EQ(op_to_count["Transpose"], 0);
+    EXPECT_EQ(op_to_count["QuantizeLinear"], 1);
+    EXPECT_EQ(op_to_count["DequantizeLinear"], 1);
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "QuantizeLinear" || node.OpType() == "DequantizeLinear") {
+        EXPECT_EQ(node.GetAttributes().at("axis").i(), 1);
+      }
+    }
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level1,
+                    13);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
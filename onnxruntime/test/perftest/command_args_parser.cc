@@ -5,6 +5,8 @@
 
 #include <string.h>
 #include <iostream>
+#include <string>
+#include <vector>
 
 // Windows Specific
 #ifdef _WIN32
@@ -33,6 +35,11 @@ namespace perftest {
       "\t-A: Disable memory arena\n"
       "\t-I: Generate tensor input binding (Free dimensions are treated as 1.)\n"
       "\t-c [parallel runs]: Specifies the (max) number of runs to invoke simultaneously. Default:1.\n"
+      "\t-Q [qps_list]: Runs in open-loop mode: requests are sent at the given rate regardless of when the previous ones\n"
+      "\t\tcomplete, and are served by the number of threads given by -c. A comma separated list of rates, e.g. 10,20,50,\n"
+      "\t\truns each rate for the given duration or repeated times and reports the latency and throughput curve.\n"
+      "\t\tThe results are written to result_file as JSON if it has a .json extension, and as CSV otherwise.\n"
+      "\t-a [poisson|constant]: Specifies the arrival distribution of the requests in open-loop mode. Default:'poisson'.\n"
       "\t-e [cpu|cuda|dnnl|tensorrt|openvino|nuphar|dml|acl]: Specifies the provider 'cpu','cuda','dnnl','tensorrt', "
       "'openvino', 'nuphar', 'dml', 'acl', 'nnapi' or 'coreml'. "
       "Default:'cpu'.\n"
@@ -105,9 +112,32 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
   return true;
 }
 
+static bool ParseQpsList(std::vector<double>& qps_list) {
+  std::basic_string<ORTCHAR_T> qps_list_str(optarg);
+  size_t begin = 0;
+  while (begin <= qps_list_str.size()) {
+    size_t end = qps_list_str.find(ORT_TSTR(','), begin);
+    if (end == std::basic_string<ORTCHAR_T>::npos) {
+      end = qps_list_str.size();
+    }
+    ORT_TRY {
+      double qps = std::stod(qps_list_str.substr(begin, end - begin));
+      if (!(qps > 0)) {
+        return false;
+      }
+      qps_list.push_back(qps);
+    }
+    ORT_CATCH(...) {
+      return false;
+    }
+    begin = end + 1;
+  }
+  return !qps_list.empty();
+}
+
 /*static*/ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int argc, ORTCHAR_T* argv[]) {
   int ch;
-  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:d:o:u:i:f:F:AMPIvhsqz"))) != -1) {
+  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:d:o:u:i:f:F:Q:a:AMPIvhsqz"))) != -1) {
     switch (ch) {
       case 'f': {
         std::basic_string<ORTCHAR_T> dim_name;
@@ -218,6 +248,21 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
           return false;
         }
         break;
+      case 'Q':
+        test_config.run_config.open_loop_qps.clear();
+        if (!ParseQpsList(test_config.run_config.open_loop_qps)) {
+          return false;
+        }
+        break;
+      case 'a':
+        if (!CompareCString(optarg, ORT_TSTR("poisson"))) {
+          test_config.run_config.arrival_distribution = ArrivalDistribution::kPoisson;
+        } else if (!CompareCString(optarg, ORT_TSTR("constant"))) {
+          test_config.run_config.arrival_distribution = ArrivalDistribution::kConstant;
+        } else {
+          return false;
+        }
+        break;
       case 'o': {
         int tmp = static_cast<int>(OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr));
         switch (tmp) {
@@ -3,6 +3,7 @@
 
 #pragma once
 #include <core/session/onnxruntime_cxx_api.h>
+#include <core/platform/ort_mutex.h>
 #include <random>
 #include "test_configuration.h"
 #include "test_session.h"
@@ -38,6 +39,8 @@ class OnnxRuntimeTestSession : public TestSession {
 
  private:
   Ort::Session session_{nullptr};
+  // guards rand_engine_ and dist_ against concurrent calls of Run
+  OrtMutex rand_engine_mutex_;
   std::mt19937 rand_engine_;
   std::uniform_int_distribution<int> dist_;
   std::vector<std::vector<Ort::Value>> test_inputs_;
@@ -7,7 +7,9 @@
 #endif
 
 #include "performance_runner.h"
+#include <cstdio>
 #include <iostream>
+#include <thread>
 
 #include "TestCase.h"
 #include "TFModelInfo.h"
@@ -99,6 +101,78 @@ void PerformanceResult::DumpToFile(const std::basic_string<ORTCHAR_T>& path, boo
   }
 }
 
+// Escapes the characters of a string that can't appear in a JSON string literal as is.
+static std::string EscapeJsonString(const std::string& value) {
+  std::string escaped;
+  escaped.reserve(value.size());
+  for (char c : value) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+      escaped += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char code[7];
+      snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned int>(static_cast<unsigned char>(c)));
+      escaped += code;
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+static std::vector<std::pair<const char*, double>> GetOpenLoopResultFields(const OpenLoopResult& result) {
+  return {{"target_qps", result.target_qps},
+          {"achieved_qps", result.achieved_qps},
+          {"requests", static_cast<double>(result.requests)},
+          {"failed_requests", static_cast<double>(result.failed_requests)},
+          {"average_service_time", result.average_service_time},
+          {"p50_latency", result.p50_latency},
+          {"p90_latency", result.p90_latency},
+          {"p99_latency", result.p99_latency},
+          {"max_latency", result.max_latency},
+          {"average_CPU_usage", result.average_CPU_usage},
+          {"peak_CPU_usage", result.peak_CPU_usage}};
+}
+
+void PerformanceResult::DumpOpenLoopResultsToFile(const std::basic_string<ORTCHAR_T>& path) const {
+  // without a result file the results were only written to the output by PerformanceRunner::Run
+  if (path.empty()) {
+    return;
+  }
+
+  std::ofstream outfile(path, std::ofstream::out | std::ofstream::trunc);
+  if (!outfile.good()) {
+    std::cerr << "failed to open result file '" << ToMBString(path.c_str()) << "'.\n";
+    return;
+  }
+
+  if (HasExtensionOf(path, ORT_TSTR("json"))) {
+    outfile << "[\n";
+    for (size_t i = 0; i < open_loop_results.size(); ++i) {
+      outfile << "  {\"model_name\": \"" << EscapeJsonString(model_name) << "\"";
+      for (const auto& field : GetOpenLoopResultFields(open_loop_results[i])) {
+        outfile << ", \"" << field.first << "\": " << field.second;
+      }
+      outfile << (i + 1 < open_loop_results.size() ? "},\n" : "}\n");
+    }
+    outfile << "]" << std::endl;
+  } else {
+    outfile << "model_name";
+    for (const auto& field : GetOpenLoopResultFields(OpenLoopResult{})) {
+      outfile << "," << field.first;
+    }
+    outfile << "\n";
+    for (const auto& result : open_loop_results) {
+      outfile << model_name;
+      for (const auto& field : GetOpenLoopResultFields(result)) {
+        outfile << "," << field.second;
+      }
+      outfile << "\n";
+    }
+    outfile.flush();
+  }
+}
+
 Status PerformanceRunner::Run() {
   if (!Initialize()) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "failed to initialize.");
@@ -107,6 +181,13 @@ Status PerformanceRunner::Run() {
   // warm up
   RunOneIteration<true>();
 
+  if (!performance_test_config_.run_config.open_loop_qps.empty()) {
+    ORT_RETURN_IF_ERROR(OpenLoopTest());
+    performance_result_.peak_workingset_size = utils::GetPeakWorkingSetSize();
+    std::cout << "Peak working set size: " << performance_result_.peak_workingset_size << " bytes" << std::endl;
+    return Status::OK();
+  }
+
   // TODO: start profiling
   // if (!performance_test_config_.run_config.profile_file.empty())
   performance_result_.start = std::chrono::high_resolution_clock::now();
@@ -230,6 +311,146 @@ Status PerformanceRunner::ForkJoinRepeat() {
   return Status::OK();
 }
 
+Status PerformanceRunner::OpenLoopTest() {
+  for (double target_qps : performance_test_config_.run_config.open_loop_qps) {
+    OpenLoopResult result;
+    ORT_RETURN_IF_ERROR(RunOpenLoop(target_qps, result));
+
+    std::cout << "Target QPS: " << result.target_qps
+              << ", achieved QPS: " << result.achieved_qps
+              << ", requests: " << result.requests
+              << ", failed: " << result.failed_requests << "\n"
+              << "  Average service time: " << result.average_service_time << " s"
+              << ", P50 latency: " << result.p50_latency << " s"
+              << ", P90 latency: " << result.p90_latency << " s"
+              << ", P99 latency: " << result.p99_latency << " s"
+              << ", Max latency: " << result.max_latency << " s\n"
+              << "  Avg CPU usage: " << result.average_CPU_usage << " %"
+              << ", Peak CPU usage: " << result.peak_CPU_usage << " %" << std::endl;
+
+    performance_result_.open_loop_results.push_back(result);
+  }
+
+  return Status::OK();
+}
+
+// Sends requests at target_qps without waiting for the previous ones to complete, so unlike the closed-loop modes
+// the measured latency includes the time the requests are queued when the session can't keep up.
+Status PerformanceRunner::RunOpenLoop(double target_qps, OpenLoopResult& result) {
+  using Clock = std::chrono::steady_clock;
+  constexpr std::chrono::milliseconds kCPUSamplingInterval{500};
+  const auto& run_config = performance_test_config_.run_config;
+
+  // the threads serving the requests. requests sent while all of them are busy wait in the queue of the pool
+  auto tpool = std::make_unique<DefaultThreadPoolType>(static_cast<int>(run_config.concurrent_session_runs));
+  OrtMutex m;
+  OrtCondVar requests_completed;
+  OrtCondVar stop_sampling_requested;
+  size_t pending_requests = 0;
+  size_t failed_requests = 0;
+  double total_service_time = 0;
+  std::vector<double> latencies;
+
+  std::unique_ptr<utils::ICPUUsage> average_CPU_usage = utils::CreateICPUUsage();
+  std::vector<short> CPU_usage_samples;
+  bool stop_sampling = false;
+  std::thread CPU_sampler([&]() {
+    std::unique_ptr<utils::ICPUUsage> CPU_usage = utils::CreateICPUUsage();
+    auto next_sample = Clock::now() + kCPUSamplingInterval;
+    std::unique_lock<OrtMutex> lock(m);
+    while (!stop_sampling) {
+      if (Clock::now() >= next_sample) {
+        CPU_usage_samples.push_back(CPU_usage->GetUsage());
+        CPU_usage->Reset();
+        next_sample = Clock::now() + kCPUSamplingInterval;
+      }
+      stop_sampling_requested.wait_for(lock, next_sample - Clock::now());
+    }
+  });
+
+  std::exponential_distribution<double> poisson_interval(target_qps);
+  const auto start = Clock::now();
+  const auto end_of_requests =
+      start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(run_config.duration_in_seconds));
+  auto send_time = start;
+  for (size_t num_sent = 0;; ++num_sent) {
+    if (run_config.test_mode == TestMode::KFixRepeatedTimesMode ? num_sent == run_config.repeated_times
+                                                                : send_time >= end_of_requests) {
+      break;
+    }
+
+    std::this_thread::sleep_until(send_time);
+    {
+      std::lock_guard<OrtMutex> lg(m);
+      ++pending_requests;
+    }
+    tpool->Schedule([this, send_time, &m, &requests_completed, &pending_requests, &failed_requests,
+                     &total_service_time, &latencies]() {
+      std::chrono::duration<double> service_time(0);
+      bool failed = false;
+      ORT_TRY {
+        service_time = session_->Run();
+      }
+      ORT_CATCH(const std::exception& ex) {
+        ORT_HANDLE_EXCEPTION([&]() {
+          std::cerr << "PerformanceRunner::RunOpenLoop caught exception: " << ex.what() << std::endl;
+          failed = true;
+        });
+      }
+      std::chrono::duration<double> latency = Clock::now() - send_time;
+
+      std::lock_guard<OrtMutex> lg(m);
+      if (failed) {
+        ++failed_requests;
+      } else {
+        latencies.push_back(latency.count());
+        total_service_time += service_time.count();
+      }
+      --pending_requests;
+      requests_completed.notify_all();
+    });
+
+    // the send time of a request doesn't depend on when the previous request was actually sent, so a late
+    // wake up of this thread shows up in the latency
+    const double interval = run_config.arrival_distribution == ArrivalDistribution::kConstant
+                                ? 1.0 / target_qps
+                                : poisson_interval(arrival_engine_);
+    send_time += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(interval));
+  }
+
+  {
+    std::unique_lock<OrtMutex> lock(m);
+    requests_completed.wait(lock, [&pending_requests]() { return pending_requests == 0; });
+  }
+  const std::chrono::duration<double> elapsed = Clock::now() - start;
+  result.average_CPU_usage = average_CPU_usage->GetUsage();
+  {
+    std::lock_guard<OrtMutex> lg(m);
+    stop_sampling = true;
+    stop_sampling_requested.notify_all();
+  }
+  CPU_sampler.join();
+
+  result.target_qps = target_qps;
+  result.requests = latencies.size() + failed_requests;
+  result.failed_requests = failed_requests;
+  result.achieved_qps = latencies.size() / elapsed.count();
+  result.peak_CPU_usage = CPU_usage_samples.empty()
+                              ? result.average_CPU_usage
+                              : *std::max_element(CPU_usage_samples.begin(), CPU_usage_samples.end());
+  if (!latencies.empty()) {
+    std::sort(latencies.begin(), latencies.end());
+    const size_t total = latencies.size();
+    result.average_service_time = total_service_time / total;
+    result.p50_latency = latencies[static_cast<size_t>(total * 0.5)];
+    result.p90_latency = latencies[static_cast<size_t>(total * 0.9)];
+    result.p99_latency = latencies[static_cast<size_t>(total * 0.99)];
+    result.max_latency = latencies.back();
+  }
+
+  return Status::OK();
+}
+
 static std::unique_ptr<TestModelInfo> CreateModelInfo(const PerformanceTestConfig& performance_test_config_) {
   if (CompareCString(performance_test_config_.backend.c_str(), ORT_TSTR("ort")) == 0) {
     const auto& file_path = performance_test_config_.model_info.model_file_path;
@@ -272,7 +493,8 @@ static std::unique_ptr<TestSession> CreateSession(Ort::Env& env, std::random_dev
 
 PerformanceRunner::PerformanceRunner(Ort::Env& env, const PerformanceTestConfig& test_config, std::random_device& rd)
     : performance_test_config_(test_config),
-      test_model_info_(CreateModelInfo(test_config)) {
+      test_model_info_(CreateModelInfo(test_config)),
+      arrival_engine_(rd()) {
   session_create_start_ = std::chrono::high_resolution_clock::now();
   session_ = CreateSession(env, rd, test_config, *test_model_info_);
   session_create_end_ = std::chrono::high_resolution_clock::now();
@@ -27,6 +27,22 @@ class TestModelInfo;
 namespace onnxruntime {
 namespace perftest {
 
+// Result of running at one request rate in open-loop mode. The latency of a request is measured from the time
+// it was scheduled to be sent, so it includes the time the request waited for a free thread.
+struct OpenLoopResult {
+  double target_qps{0};
+  double achieved_qps{0};
+  size_t requests{0};
+  size_t failed_requests{0};
+  double average_service_time{0};
+  double p50_latency{0};
+  double p90_latency{0};
+  double p99_latency{0};
+  double max_latency{0};
+  short average_CPU_usage{0};
+  short peak_CPU_usage{0};
+};
+
 struct PerformanceResult {
   std::chrono::time_point<std::chrono::high_resolution_clock> start;
   std::chrono::time_point<std::chrono::high_resolution_clock> end;
@@ -35,8 +51,11 @@ struct PerformanceResult {
   double total_time_cost{0};
   std::vector<double> time_costs;
   std::string model_name;
+  std::vector<OpenLoopResult> open_loop_results;
 
   void DumpToFile(const std::basic_string<ORTCHAR_T>& path, bool f_include_statistics = false) const;
+  // writes JSON if path has a .json extension, and CSV otherwise
+  void DumpOpenLoopResultsToFile(const std::basic_string<ORTCHAR_T>& path) const;
 };
 
 class PerformanceRunner {
@@ -49,6 +68,10 @@ class PerformanceRunner {
   inline const PerformanceResult& GetResult() const { return performance_result_; }
 
   inline void SerializeResult() const {
+    if (!performance_result_.open_loop_results.empty()) {
+      performance_result_.DumpOpenLoopResultsToFile(performance_test_config_.model_info.result_file_path);
+      return;
+    }
     performance_result_.DumpToFile(performance_test_config_.model_info.result_file_path,
                                    performance_test_config_.run_config.f_dump_statistics);
   }
@@ -88,6 +111,8 @@ class PerformanceRunner {
   Status RepeatedTimesTest();
   Status ForkJoinRepeat();
   Status RunParallelDuration();
+  Status OpenLoopTest();
+  Status RunOpenLoop(double target_qps, OpenLoopResult& result);
 
   inline Status RunFixDuration() {
     while (performance_result_.total_time_cost < performance_test_config_.run_config.duration_in_seconds) {
@@ -112,6 +137,7 @@ class PerformanceRunner {
   std::unique_ptr<TestSession> session_;
   onnxruntime::test::HeapBuffer b_;
   std::unique_ptr<ITestCase> test_case_;
+  std::mt19937 arrival_engine_;
 
   OrtMutex results_mutex_;
 };
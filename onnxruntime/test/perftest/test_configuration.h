@@ -6,6 +6,7 @@
 #include <map>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "core/graph/constants.h"
 #include "core/framework/session_options.h"
@@ -18,6 +19,12 @@ enum class TestMode : std::uint8_t {
   KFixRepeatedTimesMode
 };
 
+// how the requests of the open-loop mode are spaced
+enum class ArrivalDistribution : std::uint8_t {
+  kPoisson = 0,
+  kConstant
+};
+
 enum class Platform : std::uint8_t {
   kWindows = 0,
   kLinux
@@ -57,6 +64,10 @@ struct RunConfig {
   std::basic_string<ORTCHAR_T> ep_runtime_config_string;
   std::map<std::basic_string<ORTCHAR_T>, int64_t> free_dim_name_overrides;
   std::map<std::basic_string<ORTCHAR_T>, int64_t> free_dim_denotation_overrides;
+  // if not empty, requests are sent at these rates (requests per second) regardless of when the previous
+  // requests complete, one rate after the other
+  std::vector<double> open_loop_qps;
+  ArrivalDistribution arrival_distribution{ArrivalDistribution::kPoisson};
 };
 
 struct PerformanceTestConfig {
@@ -4,6 +4,7 @@
 #pragma once
 #include <core/session/onnxruntime_cxx_api.h>
 #include <core/platform/env.h>
+#include <core/platform/ort_mutex.h>
 #include "test_configuration.h"
 #include "tensorflow/c/c_api.h"
 #include "test_session.h"
@@ -13,6 +14,8 @@ namespace onnxruntime {
 namespace perftest {
 class TensorflowTestSession : public TestSession {
  private:
+  // guards rand_engine_ and dist_ against concurrent calls of Run
+  OrtMutex rand_engine_mutex_;
   std::mt19937 rand_engine_;
   std::uniform_int_distribution<int> dist_;
   std::vector<char> model_data_;
@@ -206,9 +209,13 @@ class TensorflowTestSession : public TestSession {
     feed_tensors_[test_data_id][input_id] = t;
   }
   std::chrono::duration<double> Run() override {
-    //Randomly pick one OrtValueArray from feed_tensors_. (NOT ThreadSafe)
-    const std::uniform_int_distribution<int>::param_type p(0, static_cast<int>(feed_tensors_.size() - 1));
-    const size_t id = static_cast<size_t>(dist_(rand_engine_, p));
+    //Randomly pick one OrtValueArray from feed_tensors_. Run may be called by several threads at once (-c).
+    size_t id;
+    {
+      std::lock_guard<OrtMutex> lock(rand_engine_mutex_);
+      const std::uniform_int_distribution<int>::param_type p(0, static_cast<int>(feed_tensors_.size() - 1));
+      id = static_cast<size_t>(dist_(rand_engine_, p));
+    }
     std::vector<TF_Tensor*>& feed_tensors = feed_tensors_.at(id);
 
     TF_Status* s = TF_NewStatus();
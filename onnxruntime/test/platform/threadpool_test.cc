@@ -7,8 +7,10 @@
 
 #include "gtest/gtest.h"
 #include <algorithm>
+#include <chrono>
 #include <memory>
 #include <functional>
+#include <thread>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -424,6 +426,99 @@ TEST(ThreadPoolTest, TestStagedMultiLoopSections_4Thread_10Loop) {
 TEST(ThreadPoolTest, TestStagedMultiLoopSections_4Thread_100Loop) {
   TestStagedMultiLoopSections("TestStagedMultiLoopSections_4Thread_100Loop", 4, 100);
 }
+#ifndef ORT_MINIMAL_BUILD
+// Returns the sum of a counter over the sub threads in the output of ThreadPool::StopProfiling.
+static uint64_t SumChildThreadCounter(const std::string& stats, const std::string& counter) {
+  const std::string key = "\"" + counter + "\": ";
+  uint64_t sum = 0;
+  for (auto pos = stats.find(key); pos != std::string::npos; pos = stats.find(key, pos + key.size())) {
+    sum += std::stoull(stats.substr(pos + key.size()));
+  }
+  return sum;
+}
+
+// Runs body on a new 4-thread pool with adaptive spinning and returns the profiling output.
+static std::string ProfileAdaptiveSpinning(const std::function<void(ThreadPool*)>& body) {
+  onnxruntime::ThreadOptions to;
+  to.adaptive_spinning = true;
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), to, nullptr, 4, true);
+  ThreadPool::StartProfiling(tp.get());
+  body(tp.get());
+  return ThreadPool::StopProfiling(tp.get());
+}
+
+TEST(ThreadPoolTest, TestAdaptiveSpinning) {
+  const int num_loops = 10;
+  auto test_data = CreateTestData(1024);
+
+  // Alternate loops with pauses longer than the maximum adaptive spin, so
+  // that workers park between loops
+  std::string stats = ProfileAdaptiveSpinning([&](ThreadPool* tp) {
+    for (int l = 0; l < num_loops; l++) {
+      ThreadPool::TrySimpleParallelFor(tp, 1024, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+  });
+  ValidateTestData(*test_data, num_loops);
+  for (const char* counter : {"\"num_spin\"", "\"num_park\"", "\"num_wakeup\"", "\"num_steal\""}) {
+    ASSERT_NE(stats.find(counter), std::string::npos) << stats;
+  }
+  EXPECT_GT(SumChildThreadCounter(stats, "num_park"), 0u) << stats;
+
+  // Back-to-back loops give work to the workers while they are still
+  // spinning after the previous loop
+  const int num_back_to_back_loops = 1000;
+  auto back_to_back_data = CreateTestData(1024);
+  stats = ProfileAdaptiveSpinning([&](ThreadPool* tp) {
+    for (int l = 0; l < num_back_to_back_loops; l++) {
+      ThreadPool::TrySimpleParallelFor(tp, 1024, [&](std::ptrdiff_t i) { IncrementElement(*back_to_back_data, i); });
+    }
+  });
+  ValidateTestData(*back_to_back_data, num_back_to_back_loops);
+  EXPECT_GT(SumChildThreadCounter(stats, "num_spin"), 0u) << stats;
+}
+#endif
+
+#ifndef _OPENMP
+TEST(ThreadPoolTest, TestRunScopeDegreeOfParallelism) {
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions(), nullptr, 4, true);
+  {
+    // Explicit cap on a single run
+    ThreadPool::RunScope rs(tp.get(), 2, ThreadPool::RunPriority::kNormal);
+    ASSERT_EQ(ThreadPool::DegreeOfParallelism(tp.get()), 2);
+  }
+  {
+    // Two normal-priority runs share the pool
+    ThreadPool::RunScope rs1(tp.get(), 0, ThreadPool::RunPriority::kNormal);
+    ASSERT_EQ(ThreadPool::DegreeOfParallelism(tp.get()), 4);
+    ThreadPool::RunScope rs2(tp.get(), 0, ThreadPool::RunPriority::kNormal);
+    ASSERT_EQ(ThreadPool::DegreeOfParallelism(tp.get()), 2);
+  }
+  {
+    // A high-priority run is not limited by lower-priority runs, whereas a
+    // low-priority run yields to all of the others
+    ThreadPool::RunScope rs1(tp.get(), 0, ThreadPool::RunPriority::kLow);
+    ThreadPool::RunScope rs2(tp.get(), 0, ThreadPool::RunPriority::kNormal);
+    {
+      ThreadPool::RunScope rs3(tp.get(), 0, ThreadPool::RunPriority::kHigh);
+      ASSERT_EQ(ThreadPool::DegreeOfParallelism(tp.get()), 4);
+    }
+    {
+      ThreadPool::RunScope rs3(tp.get(), 0, ThreadPool::RunPriority::kLow);
+      ASSERT_EQ(ThreadPool::DegreeOfParallelism(tp.get()), 1);
+    }
+  }
+
+  // Loops still run all iterations when budgeted
+  auto test_data = CreateTestData(1024);
+  {
+    ThreadPool::RunScope rs(tp.get(), 2, ThreadPool::RunPriority::kLow);
+    ThreadPool::TrySimpleParallelFor(tp.get(), 1024, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+  }
+  ValidateTestData(*test_data);
+}
+#endif
+
 #ifdef _WIN32
 #pragma warning(push)
 #pragma warning(disable : 6387)
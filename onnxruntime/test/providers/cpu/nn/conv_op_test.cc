@@ -3,6 +3,7 @@
 
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include "default_providers.h"
 using namespace std;
 namespace onnxruntime {
 namespace test {
@@ -713,5 +714,110 @@ TEST(ConvTest, Conv_AutoPad_with_non_default_strides) {
   TestConvOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape, true);
 }
 
+#ifndef ENABLE_TRAINING  // Prepacking is enabled only on non-training builds
+TEST(ConvTest, SharedPrepackedWeights) {
+  // The filter has enough channels to be packed for the Winograd algorithm, while the output is too small
+  // for it, so the copy of the original filter that is packed with it is used.
+  OpTester test("Conv", 11);
+  test.AddAttribute("kernel_shape", vector<int64_t>{3, 3});
+  test.AddAttribute("pads", vector<int64_t>{1, 1, 1, 1});
+
+  constexpr int64_t channels = 8;
+  std::vector<float> X(channels * 4 * 4, 1.0f);
+  test.AddInput<float>("X", {1, channels, 4, 4}, X);
+
+  std::vector<float> W(channels * channels * 3 * 3, 1.0f);
+  test.AddInput<float>("W", {channels, channels, 3, 3}, W, true);  // Trigger pre-packing
+
+  // Each output sums the input channels over the kernel positions that are not in the padding.
+  const std::vector<float> output_image = {32.0f, 48.0f, 48.0f, 32.0f,
+                                           48.0f, 72.0f, 72.0f, 48.0f,
+                                           48.0f, 72.0f, 72.0f, 48.0f,
+                                           32.0f, 48.0f, 48.0f, 32.0f};
+  std::vector<float> expected_vals;
+  for (int64_t i = 0; i < channels; i++) {
+    expected_vals.insert(expected_vals.end(), output_image.begin(), output_image.end());
+  }
+  test.AddOutput<float>("Y", {1, channels, 4, 4}, expected_vals);
+
+  auto p_tensor = std::make_unique<Tensor>(DataTypeImpl::GetType<float>(), TensorShape({channels, channels, 3, 3}),
+                                           W.data(), OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator));
+  OrtValue w;
+
+  w.Init(p_tensor.release(), DataTypeImpl::GetType<Tensor>(),
+         DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+
+  SessionOptions so;
+  // Set up W as a shared initializer to be shared between sessions
+  ASSERT_EQ(so.AddInitializer("W", &w), Status::OK());
+
+  // We want all sessions running using this OpTester to be able to share pre-packed weights if applicable
+  test.EnableSharingOfPrePackedWeightsAcrossSessions();
+
+  // Pre-packing is limited just to the CPU EP for now and we will only test the CPU EP
+  // and we want to ensure that it is available in this build
+  auto cpu_ep = []() -> std::vector<std::unique_ptr<IExecutionProvider>> {
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    return execution_providers;
+  };
+
+  size_t number_of_pre_packed_weights_counter_session_1 = 0;
+  size_t number_of_shared_pre_packed_weights_counter = 0;
+
+  // Session 1
+  {
+    auto ep_vec = cpu_ep();
+    test.Run(so, OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr,
+             &ep_vec, {}, &number_of_pre_packed_weights_counter_session_1, &number_of_shared_pre_packed_weights_counter);
+    // Assert that no pre-packed weights have been shared thus far
+    ASSERT_EQ(number_of_shared_pre_packed_weights_counter, static_cast<size_t>(0));
+  }
+
+  // The filter is packed for the Winograd algorithm on every platform
+  ASSERT_EQ(number_of_pre_packed_weights_counter_session_1, static_cast<size_t>(1));
+  ASSERT_EQ(test.GetNumPrePackedWeightsShared(), static_cast<size_t>(1));
+
+  // Session 2
+  {
+    size_t number_of_pre_packed_weights_counter_session_2 = 0;
+    auto ep_vec = cpu_ep();
+    test.Run(so, OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr,
+             &ep_vec, {}, &number_of_pre_packed_weights_counter_session_2, &number_of_shared_pre_packed_weights_counter);
+
+    // Assert that the same number of weights were pre-packed in both sessions
+    ASSERT_EQ(number_of_pre_packed_weights_counter_session_1, number_of_pre_packed_weights_counter_session_2);
+
+    // Assert that the number of pre-packed weights that were shared equals
+    // the number of pre-packed weights in the second session
+    ASSERT_EQ(number_of_pre_packed_weights_counter_session_2,
+              static_cast<size_t>(number_of_shared_pre_packed_weights_counter));
+  }
+}
+
+TEST(ConvTest, Conv2D_FewChannels_NotPrepacked) {
+  // Filters with fewer channels than the Winograd algorithm needs are not packed.
+  OpTester test("Conv", 11);
+  test.AddAttribute("kernel_shape", vector<int64_t>{3, 3});
+  test.AddAttribute("pads", vector<int64_t>{1, 1, 1, 1});
+
+  std::vector<float> X(2 * 4 * 4, 1.0f);
+  test.AddInput<float>("X", {1, 2, 4, 4}, X);
+  test.AddInput<float>("W", {1, 2, 3, 3}, std::vector<float>(2 * 3 * 3, 1.0f), true);
+  test.AddOutput<float>("Y", {1, 1, 4, 4}, {8.0f, 12.0f, 12.0f, 8.0f,
+                                            12.0f, 18.0f, 18.0f, 12.0f,
+                                            12.0f, 18.0f, 18.0f, 12.0f,
+                                            8.0f, 12.0f, 12.0f, 8.0f});
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+
+  size_t number_of_pre_packed_weights_counter = 0;
+  test.Run(SessionOptions{}, OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr,
+           &execution_providers, {}, &number_of_pre_packed_weights_counter);
+  ASSERT_EQ(number_of_pre_packed_weights_counter, static_cast<size_t>(0));
+}
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
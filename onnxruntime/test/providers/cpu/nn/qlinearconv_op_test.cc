@@ -591,6 +591,16 @@ TEST(QLinearConvTest, Conv2D_U8S8) {
   test.Run();
 }
 
+TEST(QLinearConvTest, Conv2D_U8S8_FilterZeroPoint) {
+  QLinearConvOpTester<uint8_t, int8_t> test;
+  test.GenerateRandomInput({2, 13, 9, 10}, .05f, 4);
+  test.GenerateRandomWeights({20, 13, 3, 3}, .125f, -3);
+  test.GenerateRandomBias();
+  test.SetPads({1, 1, 1, 1});
+  test.SetOutputScaleAndZeroPoint(.55f, 54);
+  test.Run();
+}
+
 TEST(QLinearConvTest, Conv3D_U8S8) {
   QLinearConvOpTester<uint8_t, int8_t> test;
   test.GenerateRandomInput({2, 2, 15, 11, 6}, .05f, 4);
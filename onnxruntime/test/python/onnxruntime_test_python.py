@@ -313,6 +313,74 @@ class TestInferenceSession(unittest.TestCase):
         output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
         np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
 
+    def testRunModelOutputSharesMemory(self):
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"))
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        res = sess.run(["Y"], {"X": x})
+        # The output wraps the buffer of the OrtValue, which is kept alive by the array.
+        self.assertFalse(res[0].flags.owndata)
+        self.assertIsNotNone(res[0].base)
+        view = res[0][1:]
+        del res
+        output_expected = np.array([[9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        np.testing.assert_allclose(output_expected, view, rtol=1e-05, atol=1e-08)
+
+    def testRunModelConstantOutputIsCopied(self):
+        sess = onnxrt.InferenceSession(get_name("initializer_as_output.onnx"))
+        res = sess.run(["values"], {})
+        expected = res[0].copy()
+        # The output is backed by the session initializer, so writing to it must not change the model.
+        res[0][:] = 0.0
+        res = sess.run(["values"], {})
+        np.testing.assert_array_equal(expected, res[0])
+
+    def testRunModelAliasedInitializerOutputIsCopied(self):
+        from onnx import helper, numpy_helper, TensorProto
+        w = np.array([[1.0, 2.0, 3.0], [4.0, 5.0, 6.0]], dtype=np.float32)
+        graph = helper.make_graph(
+            [helper.make_node("Reshape", ["W", "shape"], ["Y"])], "reshape_initializer", [],
+            [helper.make_tensor_value_info("Y", TensorProto.FLOAT, [3, 2])],
+            [numpy_helper.from_array(w, "W"), numpy_helper.from_array(np.array([3, 2], dtype=np.int64), "shape")])
+        model = helper.make_model(graph, opset_imports=[helper.make_opsetid("", 13)])
+        so = onnxrt.SessionOptions()
+        # keep constant folding from turning Y into an initializer
+        so.graph_optimization_level = onnxrt.GraphOptimizationLevel.ORT_DISABLE_ALL
+        sess = onnxrt.InferenceSession(model.SerializeToString(), sess_options=so)
+        # Reshape returns the buffer of W under the name Y, so writing to it must not change the model.
+        res = sess.run(["Y"], {})
+        res[0][:] = 0.0
+        res = sess.run(["Y"], {})
+        np.testing.assert_array_equal(w.reshape(3, 2), res[0])
+
+    def testRunModelAliasedInputOutputIsCopied(self):
+        from onnx import helper, TensorProto
+        graph = helper.make_graph(
+            [helper.make_node("Identity", ["X"], ["Y"])], "identity_input",
+            [helper.make_tensor_value_info("X", TensorProto.FLOAT, [3, 2])],
+            [helper.make_tensor_value_info("Y", TensorProto.FLOAT, [3, 2])])
+        model = helper.make_model(graph, opset_imports=[helper.make_opsetid("", 13)])
+        so = onnxrt.SessionOptions()
+        so.graph_optimization_level = onnxrt.GraphOptimizationLevel.ORT_DISABLE_ALL
+        sess = onnxrt.InferenceSession(model.SerializeToString(), sess_options=so)
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        # Identity returns the buffer of the feed, which belongs to x.
+        res = sess.run(["Y"], {"X": x})
+        self.assertFalse(np.shares_memory(res[0], x))
+        res[0][:] = 0.0
+        np.testing.assert_array_equal(np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32), x)
+
+    def testRunModelWithOutputs(self):
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"))
+        y = np.zeros((3, 2), dtype=np.float32)
+        for scale in [1.0, 2.0]:
+            x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32) * scale
+            res = sess.run_with_outputs(["Y"], {"X": x}, [y])
+            self.assertIs(res[0], y)
+            np.testing.assert_allclose(x * x, y, rtol=1e-05, atol=1e-08)
+
+        with self.assertRaises(RuntimeError):
+            sess.run_with_outputs(["Y"], {"X": x}, [np.zeros((2, 3), dtype=np.float32).T])
+
     def testRunModelFromBytes(self):
         with open(get_name("mul_1.onnx"), "rb") as f:
             content = f.read()
@@ -785,6 +853,33 @@ class TestInferenceSession(unittest.TestCase):
         res = sess.run(["Y"], {"X": np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)})
         self.assertTrue(np.array_equal(res[0], np.array([[2.0, 2.0], [12.0, 12.0], [30.0, 30.0]], dtype=np.float32)))
 
+    def testSessionOptionsAddStatefulInputOutput(self):
+        # mul_1 computes Y = X * W, so feeding Y back as X multiplies the state by W in every run
+        so = onnxrt.SessionOptions()
+        so.add_stateful_input_output("X", "Y")
+        self.assertEqual(so.stateful_input_names, ["X"])
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"), so, ['CPUExecutionProvider'])
+        w = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+
+        res = sess.run(["Y"], {"X": np.ones((3, 2), dtype=np.float32)})
+        np.testing.assert_allclose(res[0], w)
+        fetched_state = res[0].copy()
+
+        # the input is fed by the session
+        res = sess.run(["Y"], {})
+        np.testing.assert_allclose(res[0], w * w)
+        res = sess.run(["Y"], {})
+        np.testing.assert_allclose(res[0], w * w * w)
+
+        # the initial state is all zeros since the shape of X is fully known
+        sess.reset_states()
+        res = sess.run(["Y"], {})
+        np.testing.assert_allclose(res[0], np.zeros((3, 2), dtype=np.float32))
+
+        # a fed input overrides the kept state
+        res = sess.run(["Y"], {"X": fetched_state})
+        np.testing.assert_allclose(res[0], w * w)
+
     def testRegisterCustomOpsLibrary(self):
         if sys.platform.startswith("win"):
             shared_library = 'custom_op_library.dll'
@@ -870,6 +965,33 @@ class TestInferenceSession(unittest.TestCase):
             # The constructed OrtValue should still be valid after being used in a session
             self.assertTrue(np.array_equal(ortvalue2.numpy(), numpy_arr_input))
 
+    def testOrtValueDlpack(self):
+        numpy_arr_input = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        numpy_arr_output = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+
+        ortvalue1 = onnxrt.OrtValue.ortvalue_from_numpy(numpy_arr_input)
+        self.assertEqual(ortvalue1.__dlpack_device__(), (1, 0))  # kDLCPU
+
+        # The OrtValue created from the DLPack capsule shares the data of the original one
+        ortvalue2 = onnxrt.OrtValue.from_dlpack(ortvalue1.to_dlpack())
+        self.assertEqual(ortvalue2.data_ptr(), ortvalue1.data_ptr())
+        self.assertEqual(ortvalue2.shape(), [3, 2])
+        self.assertEqual(ortvalue2.data_type(), "tensor(float)")
+
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"))
+        res = sess.run(["Y"], {"X": ortvalue2})
+        self.assertTrue(np.array_equal(res[0], numpy_arr_output))
+
+        ortvalue_bool = onnxrt.OrtValue.ortvalue_from_numpy(np.array([True, False]))
+        ortvalue_bool2 = onnxrt.OrtValue.from_dlpack(ortvalue_bool.to_dlpack(), is_bool_tensor=True)
+        self.assertEqual(ortvalue_bool2.data_type(), "tensor(bool)")
+
+        # Numpy implements the DLPack protocol since version 1.22
+        if hasattr(np, 'from_dlpack'):
+            ortvalue3 = onnxrt.OrtValue.from_dlpack(numpy_arr_input)
+            self.assertEqual(ortvalue3.data_ptr(), numpy_arr_input.ctypes.data)
+            self.assertTrue(np.array_equal(np.from_dlpack(ortvalue1), numpy_arr_input))
+
     def testRunModelWithCudaCopyStream(self):
         available_providers = onnxrt.get_available_providers()
 
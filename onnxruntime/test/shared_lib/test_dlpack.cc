@@ -0,0 +1,141 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <functional>
+#include <vector>
+
+#include <dlpack/dlpack.h>
+
+#include "core/common/common.h"
+#include "core/session/onnxruntime_cxx_api.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+
+// A DLPack tensor in CPU memory owned by the test, which counts the calls of its deleter.
+struct TestDLPackTensor {
+  TestDLPackTensor(std::vector<float> values, std::vector<int64_t> shape)
+      : values_(std::move(values)), shape_(std::move(shape)) {
+    managed_tensor.dl_tensor.data = values_.data();
+    managed_tensor.dl_tensor.ctx.device_type = kDLCPU;
+    managed_tensor.dl_tensor.ctx.device_id = 0;
+    managed_tensor.dl_tensor.ndim = static_cast<int>(shape_.size());
+    managed_tensor.dl_tensor.dtype.code = kDLFloat;
+    managed_tensor.dl_tensor.dtype.bits = 32;
+    managed_tensor.dl_tensor.dtype.lanes = 1;
+    managed_tensor.dl_tensor.shape = shape_.data();
+    managed_tensor.dl_tensor.strides = nullptr;
+    managed_tensor.dl_tensor.byte_offset = 0;
+    managed_tensor.manager_ctx = this;
+    managed_tensor.deleter = [](DLManagedTensor* self) {
+      ++static_cast<TestDLPackTensor*>(self->manager_ctx)->deleter_calls;
+    };
+  }
+
+  std::vector<float> values_;
+  std::vector<int64_t> shape_;
+  DLManagedTensor managed_tensor{};
+  int deleter_calls = 0;
+};
+
+// Returns the error code of the exception thrown by fn, or ORT_OK if it does not throw.
+OrtErrorCode GetErrorCode(const std::function<void()>& fn) {
+  OrtErrorCode code = ORT_OK;
+  ORT_TRY {
+    fn();
+  }
+  ORT_CATCH(const Ort::Exception& e) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      code = e.GetOrtErrorCode();
+    });
+  }
+  return code;
+}
+
+}  // namespace
+
+TEST(CApiTest, DLPackRoundTrip) {
+  Ort::MemoryInfo info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
+  std::vector<float> values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  std::vector<int64_t> shape = {2, 3};
+  Ort::Value tensor = Ort::Value::CreateTensor<float>(info, values.data(), values.size(), shape.data(), shape.size());
+
+  auto* exported = static_cast<DLManagedTensor*>(tensor.ToDLPack());
+  ASSERT_NE(exported, nullptr);
+  EXPECT_EQ(exported->dl_tensor.data, values.data());
+  EXPECT_EQ(exported->dl_tensor.ctx.device_type, kDLCPU);
+  EXPECT_EQ(exported->dl_tensor.dtype.code, kDLFloat);
+  EXPECT_EQ(exported->dl_tensor.dtype.bits, 32);
+  ASSERT_EQ(exported->dl_tensor.ndim, 2);
+  EXPECT_EQ(exported->dl_tensor.shape[0], 2);
+  EXPECT_EQ(exported->dl_tensor.shape[1], 3);
+
+  // the DLPack tensor keeps the data alive after the value it was created from is released
+  tensor = Ort::Value{nullptr};
+
+  Ort::Value imported = Ort::Value::CreateTensorFromDLPack(exported);
+  ASSERT_TRUE(imported.IsTensor());
+  EXPECT_EQ(imported.GetTensorData<float>(), values.data());
+  auto type_and_shape = imported.GetTensorTypeAndShapeInfo();
+  EXPECT_EQ(type_and_shape.GetElementType(), ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT);
+  EXPECT_EQ(type_and_shape.GetShape(), shape);
+}
+
+TEST(CApiTest, DLPackDeleterCalledOnRelease) {
+  TestDLPackTensor dlpack_tensor({1.0f, 2.0f, 3.0f, 4.0f}, {3});
+  // the tensor starts at the second element
+  dlpack_tensor.managed_tensor.dl_tensor.byte_offset = sizeof(float);
+
+  {
+    Ort::Value value = Ort::Value::CreateTensorFromDLPack(&dlpack_tensor.managed_tensor);
+    EXPECT_EQ(dlpack_tensor.deleter_calls, 0);
+    const float* data = value.GetTensorData<float>();
+    EXPECT_EQ(data, dlpack_tensor.values_.data() + 1);
+    EXPECT_EQ(data[2], 4.0f);
+  }
+
+  EXPECT_EQ(dlpack_tensor.deleter_calls, 1);
+}
+
+TEST(CApiTest, DLPackBoolTensor) {
+  TestDLPackTensor dlpack_tensor({}, {2});
+  uint8_t bool_values[] = {0, 1};
+  dlpack_tensor.managed_tensor.dl_tensor.data = bool_values;
+  dlpack_tensor.managed_tensor.dl_tensor.dtype.code = kDLUInt;
+  dlpack_tensor.managed_tensor.dl_tensor.dtype.bits = 8;
+
+  Ort::Value value = Ort::Value::CreateTensorFromDLPack(&dlpack_tensor.managed_tensor, true);
+  EXPECT_EQ(value.GetTensorTypeAndShapeInfo().GetElementType(), ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL);
+  EXPECT_TRUE(value.GetTensorData<bool>()[1]);
+}
+
+TEST(CApiTest, DLPackRejectsNonCpuTensor) {
+  TestDLPackTensor dlpack_tensor({1.0f, 2.0f}, {2});
+  dlpack_tensor.managed_tensor.dl_tensor.ctx.device_type = kDLGPU;
+
+  EXPECT_EQ(GetErrorCode([&]() { Ort::Value::CreateTensorFromDLPack(&dlpack_tensor.managed_tensor); }),
+            ORT_INVALID_ARGUMENT);
+  // the caller keeps the ownership on failure
+  EXPECT_EQ(dlpack_tensor.deleter_calls, 0);
+}
+
+TEST(CApiTest, DLPackRejectsUnsupportedDataType) {
+  TestDLPackTensor dlpack_tensor({1.0f, 2.0f}, {2});
+  dlpack_tensor.managed_tensor.dl_tensor.dtype.lanes = 2;
+  EXPECT_NE(GetErrorCode([&]() { Ort::Value::CreateTensorFromDLPack(&dlpack_tensor.managed_tensor); }), ORT_OK);
+
+  dlpack_tensor.managed_tensor.dl_tensor.dtype.lanes = 1;
+  dlpack_tensor.managed_tensor.dl_tensor.dtype.bits = 8;
+  EXPECT_NE(GetErrorCode([&]() { Ort::Value::CreateTensorFromDLPack(&dlpack_tensor.managed_tensor); }), ORT_OK);
+  EXPECT_EQ(dlpack_tensor.deleter_calls, 0);
+
+  // DLPack has no string type
+  Ort::AllocatorWithDefaultOptions allocator;
+  std::vector<int64_t> shape = {1};
+  Ort::Value string_tensor = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(),
+                                                      ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING);
+  const char* strings[] = {"a"};
+  string_tensor.FillStringTensor(strings, 1);
+  EXPECT_NE(GetErrorCode([&]() { string_tensor.ToDLPack(); }), ORT_OK);
+}
@@ -1205,6 +1205,54 @@ TEST(CApiTest, override_initializer) {
   ASSERT_EQ(*output_data, f11_input_data[0]);
 }
 
+TEST(CApiTest, stateful_input_output) {
+  // mul_1 computes Y = X * W, so feeding Y back as X multiplies the state by W in every run
+  Ort::SessionOptions session_options;
+  session_options.AddStatefulInputOutput("X", "Y");
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  const std::vector<float> w = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  auto power_of_w = [&w](int exponent) {
+    std::vector<float> result(w.size(), 1.0f);
+    for (size_t i = 0; i < w.size(); ++i) {
+      for (int e = 0; e < exponent; ++e) {
+        result[i] *= w[i];
+      }
+    }
+    return result;
+  };
+  auto get_data = [](Ort::Value& value) {
+    const float* data = value.GetTensorMutableData<float>();
+    return std::vector<float>(data, data + value.GetTensorTypeAndShapeInfo().GetElementCount());
+  };
+
+  Ort::MemoryInfo info("Cpu", OrtDeviceAllocator, 0, OrtMemTypeDefault);
+  std::vector<int64_t> dims = {3, 2};
+  std::vector<float> ones(6, 1.0f);
+  Ort::Value x = Ort::Value::CreateTensor<float>(info, ones.data(), ones.size(), dims.data(), dims.size());
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+
+  auto outputs = session.Run(Ort::RunOptions{nullptr}, input_names, &x, 1, output_names, 1);
+  ASSERT_EQ(outputs.size(), 1u);
+  ASSERT_EQ(get_data(outputs[0]), power_of_w(1));
+  Ort::Value fetched_state = std::move(outputs[0]);
+
+  // X is fed by the session
+  for (int i = 2; i <= 3; ++i) {
+    outputs = session.Run(Ort::RunOptions{nullptr}, nullptr, nullptr, 0, output_names, 1);
+    ASSERT_EQ(outputs.size(), 1u);
+    ASSERT_EQ(get_data(outputs[0]), power_of_w(i));
+  }
+  // the later runs don't write to a fetched state
+  ASSERT_EQ(get_data(fetched_state), power_of_w(1));
+
+  // the initial state is all zeros since the shape of X is fully known
+  session.ResetStates();
+  outputs = session.Run(Ort::RunOptions{nullptr}, nullptr, nullptr, 0, output_names, 1);
+  ASSERT_EQ(get_data(outputs[0]), std::vector<float>(6, 0.0f));
+}
+
 TEST(CApiTest, end_profiling) {
   Ort::MemoryInfo info("Cpu", OrtDeviceAllocator, 0, OrtMemTypeDefault);
   auto allocator = std::make_unique<MockedOrtAllocator>();
@@ -4,16 +4,21 @@
 #include "orttraining/core/framework/checkpointing.h"
 
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <fstream>
+#include <functional>
 #include <utility>
 #include <vector>
 
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
 #include "core/common/path.h"
+#include "core/framework/allocator.h"
 #include "core/framework/data_transfer_utils.h"
 #include "core/framework/endian_utils.h"
 #include "core/framework/ml_value.h"
+#include "core/framework/murmurhash3.h"
 #include "core/framework/tensor_external_data_info.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/platform/env.h"
@@ -42,26 +47,52 @@ PathString GetCheckpointPropertiesFilePath(const PathString& checkpoint_director
   return ConcatPathComponent<PathChar>(checkpoint_directory, k_properties_file_name);
 }
 
-Status SaveRuntimeTensor(
-    const std::string& tensor_name,
-    const Tensor& tensor,
-    gsl::span<const char> tensor_data,
-    const PathString& relative_data_path,
-    std::ofstream& data_file,
-    ONNX_NAMESPACE::TensorProto& tensor_proto) {
-  ORT_RETURN_IF(tensor.DataType() == DataTypeImpl::GetType<std::string>(), "tensor.DataType() is std::string");
+// the alignment of the tensor data offsets in the data file
+constexpr int64_t k_tensor_data_alignment = 64;
+
+// A host copy of a runtime tensor.
+struct TensorSnapshot {
+  std::string name;
+  std::vector<int64_t> dims;
+  int32_t element_type;
+  std::vector<char> data;
+};
+
+// Returns a 128-bit MurmurHash3 of the tensor data. An incremental checkpoint refers to the data saved
+// earlier if the hash is unchanged, without comparing the data, so every bit of it must affect the hash.
+std::array<uint64_t, 2> HashTensorData(gsl::span<const char> data) {
+  // MurmurHash3 takes an int length, so larger data is hashed in chunks, and then the chunk hashes
+  constexpr size_t k_max_chunk_size = size_t{1} << 30;
+  std::array<uint64_t, 2> hash{};
+  if (data.size() <= k_max_chunk_size) {
+    MurmurHash3::x86_128(data.data(), static_cast<int>(data.size()), 0, hash.data());
+    return hash;
+  }
 
-  VLOGS_DEFAULT(1) << "Saving tensor " << tensor_name;
+  std::vector<std::array<uint64_t, 2>> chunk_hashes((data.size() + k_max_chunk_size - 1) / k_max_chunk_size);
+  for (size_t i = 0; i < chunk_hashes.size(); ++i) {
+    const size_t offset = i * k_max_chunk_size;
+    const size_t length = std::min(k_max_chunk_size, data.size() - offset);
+    MurmurHash3::x86_128(data.data() + offset, static_cast<int>(length), 0, chunk_hashes[i].data());
+  }
+  MurmurHash3::x86_128(chunk_hashes.data(), static_cast<int>(chunk_hashes.size() * sizeof(chunk_hashes[0])), 0,
+                       hash.data());
+  return hash;
+}
 
+ONNX_NAMESPACE::TensorProto MakeExternalTensorProto(
+    const TensorSnapshot& snapshot,
+    const PathString& relative_data_path,
+    int64_t offset) {
   ONNX_NAMESPACE::TensorProto saved_tensor_proto{};
 
-  for (const auto dim : tensor.Shape().GetDims()) {
+  for (const auto dim : snapshot.dims) {
     saved_tensor_proto.add_dims(dim);
   }
 
-  saved_tensor_proto.set_data_type(tensor.GetElementType());
+  saved_tensor_proto.set_data_type(snapshot.element_type);
 
-  saved_tensor_proto.set_name(tensor_name);
+  saved_tensor_proto.set_name(snapshot.name);
 
   auto add_external_data = [&saved_tensor_proto](const std::string& key, const std::string& value) {
     auto* kvp = saved_tensor_proto.add_external_data();
@@ -71,26 +102,19 @@ Status SaveRuntimeTensor(
 
   // TODO is the encoding correct? https://github.com/onnx/onnx/issues/2392
   add_external_data("location", ToMBString(relative_data_path));
-  const std::streamoff offset = data_file.tellp();
   add_external_data("offset", std::to_string(offset));
-  const auto length = tensor_data.size_bytes();
-  add_external_data("length", std::to_string(length));
+  add_external_data("length", std::to_string(snapshot.data.size()));
 
   saved_tensor_proto.set_data_location(ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL);
 
-  // TODO need to ensure the data is written in little-endian format...
-  // e.g., with endian_utils.h:WriteLittleEndian()
-  // https://github.com/microsoft/onnxruntime/blob/master/onnxruntime/core/framework/endian_utils.h
-  if constexpr (endian::native != endian::little) {
-    ORT_NOT_IMPLEMENTED("checkpointing currently requires little-endian host byte order");
-  }
-
-  ORT_RETURN_IF_NOT(
-      data_file.write(tensor_data.data(), length),
-      "Failed to write to data file: ", ToMBString(relative_data_path));
+  return saved_tensor_proto;
+}
 
-  tensor_proto = std::move(saved_tensor_proto);
-  return Status::OK();
+// returns whether the data of a tensor saved earlier is still available
+bool IsTensorDataAvailable(const CheckpointTensorData& tensor_data) {
+  size_t file_length;
+  return Env::Default().GetFileLength(tensor_data.data_path.c_str(), file_length).IsOK() &&
+         static_cast<int64_t>(file_length) >= tensor_data.offset + static_cast<int64_t>(tensor_data.length);
 }
 
 // opens file descriptor and calls use_fn
@@ -125,45 +149,135 @@ std::vector<std::string> GetOrderedOrtValueNames(const NameMLValMap& name_to_val
   return ordered_names;
 }
 
-Status SaveRuntimeTensors(
-    const PathString& tensors_path,
-    const PathString& tensors_data_path,
+// Copies a runtime tensor to host memory, reusing the memory of the snapshot.
+Status SnapshotRuntimeTensor(
     const DataTransferManager& data_transfer_manager,
-    const NameMLValMap& ort_values) {
-  // just write data file basename to TensorProto - this will get overwritten
-  //   with the actual path when loading the checkpoint
-  const PathString tensors_data_relative_path = GetLastComponent(tensors_data_path);
+    const std::string& tensor_name,
+    const OrtValue& ort_value,
+    TensorSnapshot& snapshot) {
+  static const OrtMemoryInfo cpu_alloc_info{onnxruntime::CPU, OrtDeviceAllocator};
+  ORT_RETURN_IF_NOT(ort_value.IsTensor(), "ort_value.IsTensor() was false");
+  const Tensor& tensor = ort_value.Get<Tensor>();
+  ORT_RETURN_IF(tensor.DataType() == DataTypeImpl::GetType<std::string>(), "tensor.DataType() is std::string");
+
+  snapshot.name = tensor_name;
+  snapshot.dims = tensor.Shape().GetDims();
+  snapshot.element_type = tensor.GetElementType();
+  snapshot.data.resize(tensor.SizeInBytes());
+  ORT_RETURN_IF_ERROR(CopyTensorDataToByteSpan(
+      data_transfer_manager, tensor, cpu_alloc_info, gsl::make_span(snapshot.data)));
+
+  return Status::OK();
+}
 
+Status SnapshotRuntimeTensors(
+    const DataTransferManager& data_transfer_manager,
+    const NameMLValMap& ort_values,
+    std::vector<TensorSnapshot>& snapshots) {
   const std::vector<std::string> ordered_tensor_names = GetOrderedOrtValueNames(ort_values);
-  std::vector<char> tensor_data_buffer{};
-  static const OrtMemoryInfo cpu_alloc_info{onnxruntime::CPU, OrtDeviceAllocator};
+  std::vector<TensorSnapshot> tensor_snapshots(ordered_tensor_names.size());
+
+  for (size_t i = 0; i < ordered_tensor_names.size(); ++i) {
+    ORT_RETURN_IF_ERROR(SnapshotRuntimeTensor(
+        data_transfer_manager, ordered_tensor_names[i], ort_values.at(ordered_tensor_names[i]),
+        tensor_snapshots[i]));
+  }
+
+  snapshots = std::move(tensor_snapshots);
+  return Status::OK();
+}
+
+// Provides the snapshot of the tensor at the given index, which stays valid until the next call.
+using GetTensorSnapshotFn = std::function<Status(size_t index, const TensorSnapshot*& snapshot)>;
+
+// Writes the tensors files of a checkpoint.
+// If previous_tensors is given, the data of the tensors which did not change since it was saved
+// is not written again. The data of all the tensors of the checkpoint is returned in saved_tensors.
+Status SaveTensorSnapshots(
+    const PathString& checkpoint_path,
+    size_t num_tensors,
+    const GetTensorSnapshotFn& get_snapshot,
+    const std::unordered_map<std::string, CheckpointTensorData>* previous_tensors,
+    std::unordered_map<std::string, CheckpointTensorData>& saved_tensors) {
+  // TODO need to ensure the data is written in little-endian format...
+  // e.g., with endian_utils.h:WriteLittleEndian()
+  // https://github.com/microsoft/onnxruntime/blob/master/onnxruntime/core/framework/endian_utils.h
+  if constexpr (endian::native != endian::little) {
+    ORT_NOT_IMPLEMENTED("checkpointing currently requires little-endian host byte order");
+  }
+
+  PathString checkpoint_canonical_path{};
+  ORT_RETURN_IF_ERROR(Env::Default().GetCanonicalPath(checkpoint_path, checkpoint_canonical_path));
+  const Path checkpoint_canonical_path_obj = Path::Parse(checkpoint_canonical_path);
+  const PathString tensors_data_path = GetCheckpointTensorsDataFilePath(checkpoint_path);
+  const PathString tensors_data_canonical_path = GetCheckpointTensorsDataFilePath(checkpoint_canonical_path);
+  const PathString tensors_data_relative_path = GetLastComponent(tensors_data_path);
+
   std::vector<ONNX_NAMESPACE::TensorProto> saved_tensor_protos{};
-  saved_tensor_protos.reserve(ordered_tensor_names.size());
-  std::ofstream tensors_data_file{tensors_data_path};
-
-  for (const auto& tensor_name : ordered_tensor_names) {
-    const OrtValue& ort_value = ort_values.at(tensor_name);
-    ORT_RETURN_IF_NOT(ort_value.IsTensor(), "ort_value.IsTensor() was false");
-    const Tensor& tensor = ort_value.Get<Tensor>();
-
-    tensor_data_buffer.resize(tensor.SizeInBytes());
-    ORT_RETURN_IF_ERROR(CopyTensorDataToByteSpan(
-        data_transfer_manager, tensor, cpu_alloc_info, gsl::make_span(tensor_data_buffer)));
-
-    saved_tensor_protos.emplace_back();
-    ORT_RETURN_IF_ERROR(SaveRuntimeTensor(
-        tensor_name, tensor, tensor_data_buffer, tensors_data_relative_path,
-        tensors_data_file, saved_tensor_protos.back()));
+  saved_tensor_protos.reserve(num_tensors);
+  std::unordered_map<std::string, CheckpointTensorData> saved_tensor_data{};
+  std::ofstream tensors_data_file{tensors_data_path, std::ios::binary};
+  ORT_RETURN_IF_NOT(tensors_data_file, "Failed to open data file: ", ToMBString(tensors_data_path));
+  int64_t tensors_data_file_length = 0;
+  const std::vector<char> padding(k_tensor_data_alignment);
+
+  for (size_t i = 0; i < num_tensors; ++i) {
+    const TensorSnapshot* snapshot_ptr = nullptr;
+    ORT_RETURN_IF_ERROR(get_snapshot(i, snapshot_ptr));
+    const TensorSnapshot& snapshot = *snapshot_ptr;
+    const auto hash = HashTensorData(snapshot.data);
+
+    if (previous_tensors != nullptr) {
+      // the data file of this checkpoint was truncated when it was opened, so data saved to it
+      // earlier cannot be referred to
+      const auto previous_it = previous_tensors->find(snapshot.name);
+      if (previous_it != previous_tensors->end() &&
+          previous_it->second.data_path != tensors_data_canonical_path &&
+          previous_it->second.hash == hash &&
+          previous_it->second.length == snapshot.data.size() &&
+          IsTensorDataAvailable(previous_it->second)) {
+        VLOGS_DEFAULT(1) << "Referring to saved data of unchanged tensor " << snapshot.name;
+
+        Path relative_data_path_obj{};
+        ORT_RETURN_IF_ERROR(RelativePath(
+            checkpoint_canonical_path_obj, Path::Parse(previous_it->second.data_path),
+            relative_data_path_obj));
+        saved_tensor_protos.emplace_back(MakeExternalTensorProto(
+            snapshot, relative_data_path_obj.ToPathString(), previous_it->second.offset));
+        saved_tensor_data.emplace(snapshot.name, previous_it->second);
+        continue;
+      }
+    }
+
+    VLOGS_DEFAULT(1) << "Saving tensor " << snapshot.name;
+
+    const int64_t padding_length =
+        (k_tensor_data_alignment - tensors_data_file_length % k_tensor_data_alignment) % k_tensor_data_alignment;
+    const int64_t offset = tensors_data_file_length + padding_length;
+    ORT_RETURN_IF_NOT(
+        tensors_data_file.write(padding.data(), padding_length) &&
+            tensors_data_file.write(snapshot.data.data(), snapshot.data.size()),
+        "Failed to write to data file: ", ToMBString(tensors_data_path));
+    tensors_data_file_length = offset + static_cast<int64_t>(snapshot.data.size());
+
+    saved_tensor_protos.emplace_back(MakeExternalTensorProto(snapshot, tensors_data_relative_path, offset));
+    saved_tensor_data.emplace(
+        snapshot.name,
+        CheckpointTensorData{tensors_data_canonical_path, offset, snapshot.data.size(), hash});
   }
 
+  tensors_data_file.close();
+  ORT_RETURN_IF_NOT(tensors_data_file, "Failed to write to data file: ", ToMBString(tensors_data_path));
+
   ORT_RETURN_IF_ERROR(WithOpenFile(
-      tensors_path, false,
+      GetCheckpointTensorsFilePath(checkpoint_path), false,
       [&saved_tensor_protos](int fd) {
         google::protobuf::io::FileOutputStream output{fd};
         ORT_RETURN_IF_ERROR(WriteProtoMessageSequence(saved_tensor_protos, output));
         return Status::OK();
       }));
 
+  saved_tensors = std::move(saved_tensor_data);
   return Status::OK();
 }
 
@@ -200,13 +314,13 @@ Status SaveProperties(
   return Status::OK();
 }
 
-}  // namespace
-
-Status SaveModelCheckpoint(
+Status SaveCheckpointFiles(
     const PathString& checkpoint_path,
-    const DataTransferManager& data_transfer_manager,
-    const NameMLValMap& runtime_tensors,
-    const std::unordered_map<std::string, std::string>& properties) {
+    size_t num_tensors,
+    const GetTensorSnapshotFn& get_tensor_snapshot,
+    const std::unordered_map<std::string, std::string>& properties,
+    const std::unordered_map<std::string, CheckpointTensorData>* previous_tensors,
+    std::unordered_map<std::string, CheckpointTensorData>& saved_tensors) {
   LOGS_DEFAULT(INFO) << "Saving model checkpoint files to " << ToMBString(checkpoint_path);
 
   LOGS_DEFAULT_IF(Env::Default().FolderExists(checkpoint_path), WARNING)
@@ -215,10 +329,8 @@ Status SaveModelCheckpoint(
   ORT_RETURN_IF_ERROR(Env::Default().CreateFolder(checkpoint_path));
 
   // write tensors files
-  ORT_RETURN_IF_ERROR(SaveRuntimeTensors(
-      GetCheckpointTensorsFilePath(checkpoint_path),
-      GetCheckpointTensorsDataFilePath(checkpoint_path),
-      data_transfer_manager, runtime_tensors));
+  ORT_RETURN_IF_ERROR(SaveTensorSnapshots(
+      checkpoint_path, num_tensors, get_tensor_snapshot, previous_tensors, saved_tensors));
 
   // write properties file
   ORT_RETURN_IF_ERROR(SaveProperties(
@@ -229,10 +341,164 @@ Status SaveModelCheckpoint(
   return Status::OK();
 }
 
+}  // namespace
+
+Status SaveModelCheckpoint(
+    const PathString& checkpoint_path,
+    const DataTransferManager& data_transfer_manager,
+    const NameMLValMap& runtime_tensors,
+    const std::unordered_map<std::string, std::string>& properties) {
+  // the tensors are copied to host memory one at a time, as they are written
+  const std::vector<std::string> ordered_tensor_names = GetOrderedOrtValueNames(runtime_tensors);
+  TensorSnapshot tensor_snapshot{};
+  const auto get_tensor_snapshot = [&](size_t index, const TensorSnapshot*& snapshot) {
+    const std::string& tensor_name = ordered_tensor_names[index];
+    ORT_RETURN_IF_ERROR(SnapshotRuntimeTensor(
+        data_transfer_manager, tensor_name, runtime_tensors.at(tensor_name), tensor_snapshot));
+    snapshot = &tensor_snapshot;
+    return Status::OK();
+  };
+
+  std::unordered_map<std::string, CheckpointTensorData> saved_tensors{};
+  ORT_RETURN_IF_ERROR(SaveCheckpointFiles(
+      checkpoint_path, ordered_tensor_names.size(), get_tensor_snapshot, properties, nullptr, saved_tensors));
+
+  return Status::OK();
+}
+
+CheckpointWriter::CheckpointWriter(const DataTransferManager& data_transfer_manager)
+    : data_transfer_manager_{data_transfer_manager} {
+}
+
+CheckpointWriter::~CheckpointWriter() {
+  const Status status = Wait();
+  LOGS_DEFAULT_IF(!status.IsOK(), ERROR) << "Failed to save model checkpoint: " << status.ErrorMessage();
+}
+
+Status CheckpointWriter::SaveAsync(
+    const PathString& checkpoint_path,
+    const NameMLValMap& runtime_tensors,
+    const std::unordered_map<std::string, std::string>& properties,
+    bool incremental) {
+  ORT_RETURN_IF_ERROR(Wait());
+
+  if (Env::Default().FolderExists(checkpoint_path)) {
+    PathString checkpoint_canonical_path{};
+    ORT_RETURN_IF_ERROR(Env::Default().GetCanonicalPath(checkpoint_path, checkpoint_canonical_path));
+    ORT_RETURN_IF(IsCheckpointReferenced(checkpoint_canonical_path),
+                  "Checkpoint ", ToMBString(checkpoint_path),
+                  " holds data that other checkpoints refer to and cannot be overwritten.");
+  }
+
+  std::vector<TensorSnapshot> tensor_snapshots{};
+  ORT_RETURN_IF_ERROR(SnapshotRuntimeTensors(data_transfer_manager_, runtime_tensors, tensor_snapshots));
+
+  writer_thread_ = std::thread(
+      [this, checkpoint_path, tensor_snapshots = std::move(tensor_snapshots), properties, incremental]() {
+        try {
+          const auto get_tensor_snapshot = [&tensor_snapshots](size_t index, const TensorSnapshot*& snapshot) {
+            snapshot = &tensor_snapshots[index];
+            return Status::OK();
+          };
+
+          std::unordered_map<std::string, CheckpointTensorData> saved_tensors{};
+          writer_status_ = SaveCheckpointFiles(
+              checkpoint_path, tensor_snapshots.size(), get_tensor_snapshot, properties,
+              incremental ? &saved_tensors_ : nullptr, saved_tensors);
+          if (writer_status_.IsOK()) {
+            writer_status_ = AddCheckpointReferences(checkpoint_path, saved_tensors);
+          }
+          if (writer_status_.IsOK()) {
+            saved_tensors_ = std::move(saved_tensors);
+          }
+        } catch (const std::exception& e) {
+          writer_status_ = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, e.what());
+        }
+      });
+
+  return Status::OK();
+}
+
+Status CheckpointWriter::AddCheckpointReferences(
+    const PathString& checkpoint_path,
+    const std::unordered_map<std::string, CheckpointTensorData>& saved_tensors) {
+  PathString checkpoint_canonical_path{};
+  ORT_RETURN_IF_ERROR(Env::Default().GetCanonicalPath(checkpoint_path, checkpoint_canonical_path));
+
+  std::unordered_set<PathString> referenced_checkpoints{};
+  for (const auto& name_and_tensor_data : saved_tensors) {
+    PathString data_directory_path{};
+    ORT_RETURN_IF_ERROR(GetDirNameFromFilePath(name_and_tensor_data.second.data_path, data_directory_path));
+    if (data_directory_path != checkpoint_canonical_path) {
+      referenced_checkpoints.insert(data_directory_path);
+    }
+  }
+
+  // a checkpoint saved again to the same location no longer refers to what it referred to before
+  removed_checkpoints_.erase(checkpoint_canonical_path);
+  checkpoint_references_[checkpoint_canonical_path] = std::move(referenced_checkpoints);
+  return Status::OK();
+}
+
+bool CheckpointWriter::IsCheckpointReferenced(const PathString& checkpoint_canonical_path) const {
+  // Only the checkpoints which are kept pin the data of other checkpoints, so a removed checkpoint
+  // that is still referenced does not pin the checkpoints it refers to itself.
+  return std::any_of(
+      checkpoint_references_.begin(), checkpoint_references_.end(),
+      [this, &checkpoint_canonical_path](
+          const std::pair<const PathString, std::unordered_set<PathString>>& references) {
+        return removed_checkpoints_.count(references.first) == 0 &&
+               references.second.count(checkpoint_canonical_path) > 0;
+      });
+}
+
+Status CheckpointWriter::RemoveCheckpoint(const PathString& checkpoint_path) {
+  ORT_RETURN_IF_ERROR(Wait());
+
+  if (!Env::Default().FolderExists(checkpoint_path)) {
+    return Status::OK();
+  }
+
+  PathString checkpoint_canonical_path{};
+  ORT_RETURN_IF_ERROR(Env::Default().GetCanonicalPath(checkpoint_path, checkpoint_canonical_path));
+  removed_checkpoints_.insert(checkpoint_canonical_path);
+
+  for (auto removed_it = removed_checkpoints_.begin(); removed_it != removed_checkpoints_.end();) {
+    if (IsCheckpointReferenced(*removed_it)) {
+      VLOGS_DEFAULT(1) << "Keeping removed checkpoint " << ToMBString(*removed_it)
+                       << " as a kept checkpoint refers to its data";
+      ++removed_it;
+      continue;
+    }
+
+    ORT_RETURN_IF_ERROR(Env::Default().DeleteFolder(*removed_it));
+    checkpoint_references_.erase(*removed_it);
+    removed_it = removed_checkpoints_.erase(removed_it);
+  }
+
+  return Status::OK();
+}
+
+Status CheckpointWriter::Wait() {
+  if (writer_thread_.joinable()) {
+    writer_thread_.join();
+  }
+
+  Status status = writer_status_;
+  writer_status_ = Status::OK();
+  return status;
+}
+
 namespace {
+// Updates the external data locations, which are relative to the checkpoint directory, to be
+// relative to the model directory instead.
 Status UpdateTensorsExternalDataLocations(
-    const PathString& external_data_path,
+    const PathString& checkpoint_canonical_path,
+    const PathString& model_directory_canonical_path,
     std::vector<ONNX_NAMESPACE::TensorProto>& tensor_protos) {
+  const Path checkpoint_path_obj = Path::Parse(checkpoint_canonical_path);
+  const Path model_directory_path_obj = Path::Parse(model_directory_canonical_path);
+
   for (auto& tensor_proto : tensor_protos) {
     if (tensor_proto.data_location() != ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL) {
       continue;
@@ -245,9 +511,77 @@ Status UpdateTensorsExternalDataLocations(
     ORT_RETURN_IF_NOT(location_it != external_data.end(), "location_it == external_data.end()");
 
     // TODO is the encoding correct? https://github.com/onnx/onnx/issues/2392
-    location_it->set_value(ToMBString(external_data_path));
+    const Path data_path_obj = checkpoint_path_obj / Path::Parse(ToPathString(location_it->value()));
+    Path relative_data_path_obj{};
+    ORT_RETURN_IF_ERROR(RelativePath(model_directory_path_obj, data_path_obj, relative_data_path_obj));
+    location_it->set_value(ToMBString(relative_data_path_obj.ToPathString()));
+  }
+
+  return Status::OK();
+}
+
+Status LoadTensorProtos(
+    const PathString& checkpoint_path,
+    std::vector<ONNX_NAMESPACE::TensorProto>& tensor_protos) {
+  std::vector<ONNX_NAMESPACE::TensorProto> loaded_tensor_protos{};
+  ORT_RETURN_IF_ERROR(WithOpenFile(
+      GetCheckpointTensorsFilePath(checkpoint_path), true,
+      [&loaded_tensor_protos](int fd) {
+        google::protobuf::io::FileInputStream input{fd};
+        ORT_RETURN_IF_ERROR(ReadProtoMessageSequence(loaded_tensor_protos, input));
+        return Status::OK();
+      }));
+
+  tensor_protos = std::move(loaded_tensor_protos);
+  return Status::OK();
+}
+
+Status LoadProperties(
+    const PathString& checkpoint_path,
+    std::unordered_map<std::string, std::string>& properties) {
+  std::vector<ONNX_NAMESPACE::StringStringEntryProto> loaded_property_protos{};
+  ORT_RETURN_IF_ERROR(WithOpenFile(
+      GetCheckpointPropertiesFilePath(checkpoint_path), true,
+      [&loaded_property_protos](int fd) {
+        google::protobuf::io::FileInputStream input{fd};
+        ORT_RETURN_IF_ERROR(ReadProtoMessageSequence(loaded_property_protos, input));
+        return Status::OK();
+      }));
+
+  std::unordered_map<std::string, std::string> loaded_properties{};
+  std::transform(
+      loaded_property_protos.begin(), loaded_property_protos.end(),
+      std::inserter(loaded_properties, loaded_properties.end()),
+      [](const ONNX_NAMESPACE::StringStringEntryProto& property_proto) {
+        return std::make_pair(property_proto.key(), property_proto.value());
+      });
+
+  properties = std::move(loaded_properties);
+  return Status::OK();
+}
+
+// A memory-mapped tensor data file.
+struct MappedDataFile {
+  char* data;
+  size_t length;
+};
+
+Status MapTensorData(
+    const PathString& data_path,
+    std::unordered_map<PathString, MappedDataFile>& mapped_data_files,
+    std::vector<Env::MappedMemoryPtr>& mapped_files,
+    MappedDataFile& mapped_data_file) {
+  auto mapped_it = mapped_data_files.find(data_path);
+  if (mapped_it == mapped_data_files.end()) {
+    size_t file_length;
+    ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(data_path.c_str(), file_length));
+    Env::MappedMemoryPtr mapped_memory{};
+    ORT_RETURN_IF_ERROR(Env::Default().MapFileIntoMemory(data_path.c_str(), 0, file_length, mapped_memory));
+    mapped_it = mapped_data_files.emplace(data_path, MappedDataFile{mapped_memory.get(), file_length}).first;
+    mapped_files.emplace_back(std::move(mapped_memory));
   }
 
+  mapped_data_file = mapped_it->second;
   return Status::OK();
 }
 }  // namespace
@@ -261,13 +595,7 @@ Status LoadModelCheckpoint(
 
   // read tensors file
   std::vector<ONNX_NAMESPACE::TensorProto> loaded_tensor_protos{};
-  ORT_RETURN_IF_ERROR(WithOpenFile(
-      GetCheckpointTensorsFilePath(checkpoint_path), true,
-      [&loaded_tensor_protos](int fd) {
-        google::protobuf::io::FileInputStream input{fd};
-        ORT_RETURN_IF_ERROR(ReadProtoMessageSequence(loaded_tensor_protos, input));
-        return Status::OK();
-      }));
+  ORT_RETURN_IF_ERROR(LoadTensorProtos(checkpoint_path, loaded_tensor_protos));
 
   // set external data locations
   {
@@ -281,32 +609,13 @@ Status LoadModelCheckpoint(
     ORT_RETURN_IF_ERROR(Env::Default().GetCanonicalPath(
         checkpoint_path, checkpoint_canonical_path));
 
-    Path relative_tensors_data_path_obj{};
-    ORT_RETURN_IF_ERROR(RelativePath(
-        Path::Parse(model_directory_canonical_path),
-        Path::Parse(GetCheckpointTensorsDataFilePath(checkpoint_canonical_path)),
-        relative_tensors_data_path_obj));
     ORT_RETURN_IF_ERROR(UpdateTensorsExternalDataLocations(
-        relative_tensors_data_path_obj.ToPathString(), loaded_tensor_protos));
+        checkpoint_canonical_path, model_directory_canonical_path, loaded_tensor_protos));
   }
 
   // read properties file
-  std::vector<ONNX_NAMESPACE::StringStringEntryProto> loaded_property_protos{};
-  ORT_RETURN_IF_ERROR(WithOpenFile(
-      GetCheckpointPropertiesFilePath(checkpoint_path), true,
-      [&loaded_property_protos](int fd) {
-        google::protobuf::io::FileInputStream input{fd};
-        ORT_RETURN_IF_ERROR(ReadProtoMessageSequence(loaded_property_protos, input));
-        return Status::OK();
-      }));
-
   std::unordered_map<std::string, std::string> loaded_properties{};
-  std::transform(
-      loaded_property_protos.begin(), loaded_property_protos.end(),
-      std::inserter(loaded_properties, loaded_properties.end()),
-      [](const ONNX_NAMESPACE::StringStringEntryProto& property_proto) {
-        return std::make_pair(property_proto.key(), property_proto.value());
-      });
+  ORT_RETURN_IF_ERROR(LoadProperties(checkpoint_path, loaded_properties));
 
   tensor_protos = std::move(loaded_tensor_protos);
   properties = std::move(loaded_properties);
@@ -316,5 +625,89 @@ Status LoadModelCheckpoint(
   return Status::OK();
 }
 
+Status LoadModelCheckpoint(
+    const PathString& checkpoint_path,
+    NameMLValMap& runtime_tensors,
+    std::unordered_map<std::string, std::string>& properties,
+    std::vector<Env::MappedMemoryPtr>& mapped_files) {
+  LOGS_DEFAULT(INFO) << "Loading model checkpoint files from " << ToMBString(checkpoint_path);
+
+  if constexpr (endian::native != endian::little) {
+    ORT_NOT_IMPLEMENTED("checkpointing currently requires little-endian host byte order");
+  }
+
+  // read tensors file
+  std::vector<ONNX_NAMESPACE::TensorProto> loaded_tensor_protos{};
+  ORT_RETURN_IF_ERROR(LoadTensorProtos(checkpoint_path, loaded_tensor_protos));
+
+  PathString checkpoint_canonical_path{};
+  ORT_RETURN_IF_ERROR(Env::Default().GetCanonicalPath(checkpoint_path, checkpoint_canonical_path));
+  const Path checkpoint_path_obj = Path::Parse(checkpoint_canonical_path);
+
+  static const OrtMemoryInfo cpu_alloc_info{onnxruntime::CPU, OrtDeviceAllocator};
+  auto cpu_allocator = std::make_shared<CPUAllocator>();
+  std::unordered_map<PathString, MappedDataFile> mapped_data_files{};
+  std::vector<Env::MappedMemoryPtr> loaded_mapped_files{};
+  NameMLValMap loaded_tensors{};
+
+  for (const auto& tensor_proto : loaded_tensor_protos) {
+    ORT_RETURN_IF_NOT(
+        tensor_proto.data_location() == ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL,
+        "Checkpoint tensor: ", tensor_proto.name(), " does not have external data.");
+    ORT_RETURN_IF(
+        tensor_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING,
+        "Checkpoint tensor: ", tensor_proto.name(), " is a string tensor.");
+
+    std::unique_ptr<ExternalDataInfo> external_data_info{};
+    ORT_RETURN_IF_ERROR(ExternalDataInfo::Create(tensor_proto.external_data(), external_data_info));
+
+    const auto element_type =
+        DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
+    const TensorShape shape{tensor_proto.dims().data(), static_cast<size_t>(tensor_proto.dims().size())};
+    const size_t length = element_type->Size() * static_cast<size_t>(shape.Size());
+    ORT_RETURN_IF_NOT(
+        external_data_info->GetLength() == length,
+        "Checkpoint tensor: ", tensor_proto.name(), " has data length ", external_data_info->GetLength(),
+        ", expected ", length);
+
+    const PathString data_path =
+        (checkpoint_path_obj / Path::Parse(external_data_info->GetRelPath())).Normalize().ToPathString();
+    MappedDataFile mapped_data_file{};
+    ORT_RETURN_IF_ERROR(MapTensorData(data_path, mapped_data_files, loaded_mapped_files, mapped_data_file));
+
+    const auto offset = static_cast<size_t>(external_data_info->GetOffset());
+    ORT_RETURN_IF_NOT(
+        offset + length <= mapped_data_file.length,
+        "Checkpoint tensor: ", tensor_proto.name(), " data is out of the bounds of ", ToMBString(data_path));
+
+    std::unique_ptr<Tensor> tensor{};
+    if (offset % element_type->Size() == 0) {
+      tensor = std::make_unique<Tensor>(
+          element_type, shape, mapped_data_file.data + offset, cpu_alloc_info);
+    } else {
+      // checkpoints saved before the data offsets were aligned
+      tensor = std::make_unique<Tensor>(element_type, shape, cpu_allocator);
+      memcpy(tensor->MutableDataRaw(), mapped_data_file.data + offset, length);
+    }
+
+    OrtValue ort_value{};
+    ort_value.Init(
+        tensor.release(), DataTypeImpl::GetType<Tensor>(), DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+    loaded_tensors.emplace(tensor_proto.name(), std::move(ort_value));
+  }
+
+  // read properties file
+  std::unordered_map<std::string, std::string> loaded_properties{};
+  ORT_RETURN_IF_ERROR(LoadProperties(checkpoint_path, loaded_properties));
+
+  runtime_tensors = std::move(loaded_tensors);
+  properties = std::move(loaded_properties);
+  mapped_files = std::move(loaded_mapped_files);
+
+  LOGS_DEFAULT(INFO) << "Model checkpoint loaded successfully.";
+
+  return Status::OK();
+}
+
 }  // namespace training
 }  // namespace onnxruntime
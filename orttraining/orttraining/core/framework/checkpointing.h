@@ -3,8 +3,12 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "core/common/path_string.h"
@@ -12,6 +16,7 @@
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/data_types.h"
 #include "core/framework/framework_common.h"
+#include "core/platform/env.h"
 
 namespace onnxruntime {
 namespace training {
@@ -22,6 +27,11 @@ namespace training {
  *   tensors.pbseq - tensor protobuf messages
  *   tensors.bin - tensor binary data
  *   properties.pbseq - property protobuf messages
+ *
+ * The tensor data is stored raw in tensors.bin, each tensor at an offset aligned to 64 bytes.
+ * The external data location of a tensor protobuf message is relative to the checkpoint
+ * directory. The data of the tensors of an incremental checkpoint which did not change since an
+ * earlier checkpoint is not written again, their messages refer to the data file of that checkpoint.
  */
 
 /**
@@ -54,5 +64,119 @@ common::Status LoadModelCheckpoint(
     std::vector<ONNX_NAMESPACE::TensorProto>& tensor_protos,
     std::unordered_map<std::string, std::string>& properties);
 
+/**
+ * Loads a model checkpoint from the specified location into CPU tensors.
+ * The tensor data files are memory-mapped and the loaded tensors refer to the mapped memory,
+ * so they must not be used after mapped_files is destroyed. The mappings are private and
+ * copy-on-write, so updating the loaded tensors does not change the checkpoint files.
+ *
+ * @param checkpoint_path The checkpoint location.
+ * @param runtime_tensors The loaded tensors.
+ * @param properties The loaded properties.
+ * @param mapped_files The mapped tensor data files.
+ * @return The status of the operation.
+ */
+common::Status LoadModelCheckpoint(
+    const PathString& checkpoint_path,
+    NameMLValMap& runtime_tensors,
+    std::unordered_map<std::string, std::string>& properties,
+    std::vector<Env::MappedMemoryPtr>& mapped_files);
+
+/**
+ * The data of a tensor saved in a checkpoint.
+ */
+struct CheckpointTensorData {
+  // canonical path of the data file
+  PathString data_path;
+  int64_t offset;
+  size_t length;
+  // 128-bit MurmurHash3 of the data
+  std::array<uint64_t, 2> hash;
+};
+
+/**
+ * Saves model checkpoints in the background.
+ *
+ * Saving a checkpoint first copies the tensors to host memory, after which the training may
+ * update them again, and then writes the checkpoint files from a background thread.
+ * At most one checkpoint is written at a time.
+ *
+ * The checkpoints saved by a writer should be removed with RemoveCheckpoint(), which keeps the
+ * checkpoints holding data that the incremental checkpoints still kept refer to.
+ */
+class CheckpointWriter {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param data_transfer_manager The DataTransferManager instance used to copy the tensors.
+   */
+  explicit CheckpointWriter(const DataTransferManager& data_transfer_manager);
+
+  /**
+   * Destructor. Waits for the checkpoint being written, if any.
+   */
+  ~CheckpointWriter();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CheckpointWriter);
+
+  /**
+   * Starts saving a model checkpoint in the specified location.
+   * Waits for the previous checkpoint to be written first.
+   *
+   * An incremental checkpoint does not contain the data of the tensors which are unchanged since
+   * the last checkpoint saved by this writer, so it can only be loaded while the checkpoints
+   * holding that data are kept. A checkpoint holding data that another checkpoint refers to
+   * cannot be overwritten.
+   *
+   * @param checkpoint_path The checkpoint location.
+   * @param runtime_tensors The tensors to persist.
+   * @param properties The properties to persist.
+   * @param incremental Whether to save an incremental checkpoint.
+   * @return The status of the operation. Errors writing the checkpoint files are returned by Wait().
+   */
+  common::Status SaveAsync(
+      const PathString& checkpoint_path,
+      const NameMLValMap& runtime_tensors,
+      const std::unordered_map<std::string, std::string>& properties,
+      bool incremental = false);
+
+  /**
+   * Waits for the checkpoint being written, if any.
+   *
+   * @return The status of writing the checkpoint.
+   */
+  common::Status Wait();
+
+  /**
+   * Removes a checkpoint, e.g. one that is no longer retained.
+   * Waits for the checkpoint being written first. The checkpoint is deleted once none of the
+   * checkpoints saved by this writer and not removed refers to its data.
+   *
+   * @param checkpoint_path The checkpoint location.
+   * @return The status of the operation.
+   */
+  common::Status RemoveCheckpoint(const PathString& checkpoint_path);
+
+ private:
+  // records the checkpoints whose data a saved checkpoint refers to
+  common::Status AddCheckpointReferences(
+      const PathString& checkpoint_path,
+      const std::unordered_map<std::string, CheckpointTensorData>& saved_tensors);
+
+  // whether a checkpoint which is kept refers to the data of the given checkpoint
+  bool IsCheckpointReferenced(const PathString& checkpoint_canonical_path) const;
+
+  const DataTransferManager& data_transfer_manager_;
+  std::thread writer_thread_;
+  common::Status writer_status_;
+  // the data of the tensors saved by the last checkpoint, accessed only by the writer thread
+  std::unordered_map<std::string, CheckpointTensorData> saved_tensors_;
+  // the canonical paths of the checkpoints that each saved checkpoint refers to
+  std::unordered_map<PathString, std::unordered_set<PathString>> checkpoint_references_;
+  // the canonical paths of the removed checkpoints which are kept as other checkpoints refer to them
+  std::unordered_set<PathString> removed_checkpoints_;
+};
+
 }  // namespace training
 }  // namespace onnxruntime
@@ -901,7 +901,15 @@ Status TrainingRunner::TrainingLoop(IDataLoader& training_data_loader, IDataLoad
           }
 
           if (should_remove_old_checkpoint) {
-            const auto status = Env::Default().DeleteFolder(old_checkpoint_path);
+            // the old checkpoint may still be being written, and the writer keeps the checkpoints
+            // that the checkpoints it saved refer to
+            Status status{};
+            if (checkpoint_writer_) {
+              ORT_RETURN_IF_ERROR(checkpoint_writer_->Wait());
+              status = checkpoint_writer_->RemoveCheckpoint(old_checkpoint_path);
+            } else {
+              status = Env::Default().DeleteFolder(old_checkpoint_path);
+            }
             LOGS_DEFAULT_IF(!status.IsOK(), WARNING)
                 << "Failed to delete old checkpoint. "
                 << "Path: " << ToMBString(old_checkpoint_path)
@@ -922,6 +930,10 @@ Status TrainingRunner::TrainingLoop(IDataLoader& training_data_loader, IDataLoad
 
     ++epoch;
   }
+  if (checkpoint_writer_) {
+    ORT_RETURN_IF_ERROR(checkpoint_writer_->Wait());
+  }
+
   auto all_steps_time_end = std::chrono::high_resolution_clock::now();
   std::chrono::duration<double> all_steps_duration_seconds = all_steps_time_end - all_steps_time_start;
 
@@ -1212,63 +1224,29 @@ Status TrainingRunner::SaveCheckpoint(const PathString& checkpoint_path) {
   std::unordered_map<std::string, std::string> checkpointed_properties{};
   ORT_RETURN_IF_ERROR(SaveCheckpointProperties(checkpointed_properties));
 
-  ORT_RETURN_IF_ERROR(SaveModelCheckpoint(
-      checkpoint_path, session_.GetDataTransferManager(),
-      checkpointed_tensors, checkpointed_properties));
-
-  return Status::OK();
-}
-
-namespace {
-Status WithOrtValuesFromTensorProtos(
-    const PathString& model_location,
-    const std::vector<ONNX_NAMESPACE::TensorProto>& tensor_protos,
-    std::function<Status(const NameMLValMap&)> use_name_to_ort_value_fn) {
-  static const OrtMemoryInfo cpu_alloc_info{onnxruntime::CPU, OrtDeviceAllocator};
-
-  NameMLValMap name_to_ort_value{};
-  std::vector<std::vector<char>> tensor_buffers{};
-
-  for (const auto& tensor_proto : tensor_protos) {
-    const auto* tensor_type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type());
-    const size_t element_size = tensor_type->GetElementType()->Size();
-    const TensorShape shape{
-        tensor_proto.dims().data(), static_cast<size_t>(tensor_proto.dims().size())};
-
-    std::vector<char> tensor_buffer{};
-    tensor_buffer.resize(element_size * shape.Size());
-
-    const MemBuffer mem_buffer{tensor_buffer.data(), tensor_buffer.size(), cpu_alloc_info};
-
-    OrtValue ort_value;
-
-    ORT_RETURN_IF_ERROR(utils::TensorProtoToMLValue(
-        Env::Default(), model_location.c_str(), tensor_proto, mem_buffer,
-        ort_value));
-
-    name_to_ort_value.emplace(tensor_proto.name(), ort_value);
-    tensor_buffers.emplace_back(std::move(tensor_buffer));
+  if (params_.save_checkpoints_async) {
+    if (!checkpoint_writer_) {
+      checkpoint_writer_ = std::make_unique<CheckpointWriter>(session_.GetDataTransferManager());
+    }
+    ORT_RETURN_IF_ERROR(checkpoint_writer_->SaveAsync(
+        checkpoint_path, checkpointed_tensors, checkpointed_properties));
+  } else {
+    ORT_RETURN_IF_ERROR(SaveModelCheckpoint(
+        checkpoint_path, session_.GetDataTransferManager(),
+        checkpointed_tensors, checkpointed_properties));
   }
 
-  ORT_RETURN_IF_ERROR(use_name_to_ort_value_fn(name_to_ort_value));
-
   return Status::OK();
 }
-}  // namespace
 
 Status TrainingRunner::LoadCheckpoint(const PathString& checkpoint_path) {
-  std::vector<ONNX_NAMESPACE::TensorProto> checkpointed_tensors{};
+  NameMLValMap checkpointed_tensors{};
   std::unordered_map<std::string, std::string> checkpointed_properties{};
+  std::vector<Env::MappedMemoryPtr> mapped_files{};
   ORT_RETURN_IF_ERROR(LoadModelCheckpoint(
-      checkpoint_path, session_.GetModelLocation(),
-      checkpointed_tensors, checkpointed_properties));
-
-  ORT_RETURN_IF_ERROR(WithOrtValuesFromTensorProtos(
-      session_.GetModelLocation(), checkpointed_tensors,
-      [this](const NameMLValMap& name_to_ort_value) -> Status {
-        ORT_RETURN_IF_ERROR(session_.SetStateTensors(name_to_ort_value, true));
-        return Status::OK();
-      }));
+      checkpoint_path, checkpointed_tensors, checkpointed_properties, mapped_files));
+
+  ORT_RETURN_IF_ERROR(session_.SetStateTensors(checkpointed_tensors, true));
 
   ORT_RETURN_IF_ERROR(LoadCheckpointProperties(checkpointed_properties));
 
@@ -10,6 +10,7 @@
 #include "core/framework/ml_value.h"
 #include "core/providers/providers.h"
 #include "orttraining/core/framework/checkpoint_registry.h"
+#include "orttraining/core/framework/checkpointing.h"
 #include "orttraining/core/framework/communication/mpi/mpi_context.h"
 #include "orttraining/core/framework/pipeline.h"
 #include "orttraining/core/graph/optimizer_config.h"
@@ -167,6 +168,8 @@ class TrainingRunner {
     size_t checkpoint_period = 0;
     // upper limit on number of checkpoint files to keep
     size_t max_num_checkpoints = 1;
+    // whether checkpoints are written in the background while training continues
+    bool save_checkpoints_async = false;
 
     int data_parallel_size = 1;
     int horizontal_parallel_size = 1;
@@ -275,6 +278,7 @@ class TrainingRunner {
   AllocatorPtr input_allocator_;
 
   std::unique_ptr<CheckpointRegistry> checkpoint_registry_;
+  std::unique_ptr<CheckpointWriter> checkpoint_writer_;
 
   // Pipeline fields are valid only if params_.pipeline_parallel_size > 1.
   // Information for running pipeline.
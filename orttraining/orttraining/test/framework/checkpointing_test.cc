@@ -3,6 +3,7 @@
 
 #include "orttraining/core/framework/checkpointing.h"
 
+#include <cstring>
 #include <unordered_map>
 #include <vector>
 
@@ -13,6 +14,7 @@
 #include "core/framework/ml_value.h"
 #include "core/framework/tensor.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/platform/env.h"
 #include "core/platform/path_lib.h"
 #include "test/util/include/asserts.h"
 #include "test/util/include/temp_dir.h"
@@ -83,6 +85,23 @@ void CompareOrtValuesToTensorProtoValues(
         std::memcmp(a.DataRaw(), b.DataRaw(), a.SizeInBytes()) == 0);
   }
 }
+
+void CompareOrtValues(const NameMLValMap& expected, const NameMLValMap& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+
+  for (const auto& name_and_ort_value : expected) {
+    const auto actual_it = actual.find(name_and_ort_value.first);
+    ASSERT_NE(actual_it, actual.end());
+
+    ASSERT_TRUE(name_and_ort_value.second.IsTensor() && actual_it->second.IsTensor());
+    const Tensor& a = name_and_ort_value.second.Get<Tensor>();
+    const Tensor& b = actual_it->second.Get<Tensor>();
+    ASSERT_TRUE(
+        a.DataType() == b.DataType() &&
+        a.Shape() == b.Shape() &&
+        std::memcmp(a.DataRaw(), b.DataRaw(), a.SizeInBytes()) == 0);
+  }
+}
 }  // namespace
 
 TEST(CheckpointingTest, SaveAndLoad) {
@@ -137,6 +156,242 @@ TEST(CheckpointingTest, SaveAndLoad) {
       model_path, name_to_ort_value, name_to_loaded_tensor_proto);
 }
 
+TEST(CheckpointingTest, SaveAsyncAndLoadMapped) {
+  OrtValueTensorData first{{3}, {1.0f, 2.0f, 3.0f}};
+  OrtValueTensorData second{{2, 2}, {1.0f, 2.0f, 3.0f, 4.0f}};
+  NameMLValMap name_to_ort_value{
+      {"first", first.GetOrtValue()},
+      {"second", second.GetOrtValue()},
+  };
+
+  std::unordered_map<std::string, std::string> properties{
+      {"one", "1"},
+  };
+
+  TemporaryDirectory tmp_dir{ORT_TSTR("checkpointing_test_dir")};
+
+  PathString checkpoint_path{
+      ConcatPathComponent<PathChar>(tmp_dir.Path(), ORT_TSTR("test_checkpoint"))};
+
+  DataTransferManager data_transfer{};
+  data_transfer.RegisterDataTransfer(std::make_unique<CPUDataTransfer>());
+
+  CheckpointWriter writer{data_transfer};
+  ASSERT_STATUS_OK(writer.SaveAsync(checkpoint_path, name_to_ort_value, properties));
+  ASSERT_STATUS_OK(writer.Wait());
+
+  NameMLValMap loaded_ort_values{};
+  std::unordered_map<std::string, std::string> loaded_properties{};
+  std::vector<Env::MappedMemoryPtr> mapped_files{};
+
+  ASSERT_STATUS_OK(LoadModelCheckpoint(
+      checkpoint_path, loaded_ort_values, loaded_properties, mapped_files));
+
+  ASSERT_EQ(loaded_properties, properties);
+  CompareOrtValues(name_to_ort_value, loaded_ort_values);
+}
+
+TEST(CheckpointingTest, SaveIncremental) {
+  OrtValueTensorData first{{3}, {1.0f, 2.0f, 3.0f}};
+  OrtValueTensorData second{{2, 2}, {1.0f, 2.0f, 3.0f, 4.0f}};
+  NameMLValMap name_to_ort_value{
+      {"first", first.GetOrtValue()},
+      {"second", second.GetOrtValue()},
+  };
+
+  TemporaryDirectory tmp_dir{ORT_TSTR("checkpointing_test_dir")};
+
+  PathString base_checkpoint_path{
+      ConcatPathComponent<PathChar>(tmp_dir.Path(), ORT_TSTR("base_checkpoint"))};
+  PathString delta_checkpoint_path{
+      ConcatPathComponent<PathChar>(tmp_dir.Path(), ORT_TSTR("delta_checkpoint"))};
+  // this path doesn't need to exist, we just consider its parent directory
+  PathString model_path{
+      ConcatPathComponent<PathChar>(tmp_dir.Path(), ORT_TSTR("test_model.onnx"))};
+
+  DataTransferManager data_transfer{};
+  data_transfer.RegisterDataTransfer(std::make_unique<CPUDataTransfer>());
+
+  CheckpointWriter writer{data_transfer};
+  ASSERT_STATUS_OK(writer.SaveAsync(base_checkpoint_path, name_to_ort_value, {}, true));
+
+  // only "second" changes
+  OrtValueTensorData updated_second{{2, 2}, {5.0f, 6.0f, 7.0f, 8.0f}};
+  name_to_ort_value["second"] = updated_second.GetOrtValue();
+  ASSERT_STATUS_OK(writer.SaveAsync(delta_checkpoint_path, name_to_ort_value, {}, true));
+  ASSERT_STATUS_OK(writer.Wait());
+
+  size_t delta_data_length;
+  ASSERT_STATUS_OK(Env::Default().GetFileLength(
+      ConcatPathComponent<PathChar>(delta_checkpoint_path, ORT_TSTR("tensors.bin")).c_str(),
+      delta_data_length));
+  ASSERT_EQ(delta_data_length, 4 * sizeof(float));
+
+  NameMLValMap loaded_ort_values{};
+  std::unordered_map<std::string, std::string> loaded_properties{};
+  std::vector<Env::MappedMemoryPtr> mapped_files{};
+  ASSERT_STATUS_OK(LoadModelCheckpoint(
+      delta_checkpoint_path, loaded_ort_values, loaded_properties, mapped_files));
+  CompareOrtValues(name_to_ort_value, loaded_ort_values);
+
+  std::vector<ONNX_NAMESPACE::TensorProto> loaded_tensor_protos{};
+  ASSERT_STATUS_OK(LoadModelCheckpoint(
+      delta_checkpoint_path, model_path, loaded_tensor_protos, loaded_properties));
+
+  std::unordered_map<std::string, ONNX_NAMESPACE::TensorProto> name_to_loaded_tensor_proto{};
+  for (const auto& tensor_proto : loaded_tensor_protos) {
+    name_to_loaded_tensor_proto.emplace(tensor_proto.name(), tensor_proto);
+  }
+
+  CompareOrtValuesToTensorProtoValues(
+      model_path, name_to_ort_value, name_to_loaded_tensor_proto);
+}
+
+TEST(CheckpointingTest, SaveIncrementalDetectsSignChanges) {
+  OrtValueTensorData first{{4}, {1.0f, 2.0f, 3.0f, 4.0f}};
+  NameMLValMap name_to_ort_value{
+      {"first", first.GetOrtValue()},
+  };
+
+  TemporaryDirectory tmp_dir{ORT_TSTR("checkpointing_test_dir")};
+
+  PathString base_checkpoint_path{
+      ConcatPathComponent<PathChar>(tmp_dir.Path(), ORT_TSTR("base_checkpoint"))};
+  PathString delta_checkpoint_path{
+      ConcatPathComponent<PathChar>(tmp_dir.Path(), ORT_TSTR("delta_checkpoint"))};
+
+  DataTransferManager data_transfer{};
+  data_transfer.RegisterDataTransfer(std::make_unique<CPUDataTransfer>());
+
+  CheckpointWriter writer{data_transfer};
+  ASSERT_STATUS_OK(writer.SaveAsync(base_checkpoint_path, name_to_ort_value, {}, true));
+
+  // negating two odd-indexed elements flips the top bit of two 8 byte words
+  OrtValueTensorData updated_first{{4}, {1.0f, -2.0f, 3.0f, -4.0f}};
+  name_to_ort_value["first"] = updated_first.GetOrtValue();
+  ASSERT_STATUS_OK(writer.SaveAsync(delta_checkpoint_path, name_to_ort_value, {}, true));
+  ASSERT_STATUS_OK(writer.Wait());
+
+  size_t delta_data_length;
+  ASSERT_STATUS_OK(Env::Default().GetFileLength(
+      ConcatPathComponent<PathChar>(delta_checkpoint_path, ORT_TSTR("tensors.bin")).c_str(),
+      delta_data_length));
+  ASSERT_EQ(delta_data_length, 4 * sizeof(float));
+
+  NameMLValMap loaded_ort_values{};
+  std::unordered_map<std::string, std::string> loaded_properties{};
+  std::vector<Env::MappedMemoryPtr> mapped_files{};
+  ASSERT_STATUS_OK(LoadModelCheckpoint(
+      delta_checkpoint_path, loaded_ort_values, loaded_properties, mapped_files));
+  CompareOrtValues(name_to_ort_value, loaded_ort_values);
+}
+
+TEST(CheckpointingTest, SaveIncrementalToSameLocation) {
+  OrtValueTensorData first{{3}, {1.0f, 2.0f, 3.0f}};
+  OrtValueTensorData second{{2, 2}, {1.0f, 2.0f, 3.0f, 4.0f}};
+  NameMLValMap name_to_ort_value{
+      {"first", first.GetOrtValue()},
+      {"second", second.GetOrtValue()},
+  };
+
+  TemporaryDirectory tmp_dir{ORT_TSTR("checkpointing_test_dir")};
+
+  PathString checkpoint_path{
+      ConcatPathComponent<PathChar>(tmp_dir.Path(), ORT_TSTR("test_checkpoint"))};
+
+  DataTransferManager data_transfer{};
+  data_transfer.RegisterDataTransfer(std::make_unique<CPUDataTransfer>());
+
+  // the data of the unchanged tensors is written again, as the data file is replaced
+  CheckpointWriter writer{data_transfer};
+  ASSERT_STATUS_OK(writer.SaveAsync(checkpoint_path, name_to_ort_value, {}, true));
+  OrtValueTensorData updated_first{{3}, {4.0f, 5.0f, 6.0f}};
+  name_to_ort_value["first"] = updated_first.GetOrtValue();
+  ASSERT_STATUS_OK(writer.SaveAsync(checkpoint_path, name_to_ort_value, {}, true));
+  ASSERT_STATUS_OK(writer.Wait());
+
+  NameMLValMap loaded_ort_values{};
+  std::unordered_map<std::string, std::string> loaded_properties{};
+  std::vector<Env::MappedMemoryPtr> mapped_files{};
+  ASSERT_STATUS_OK(LoadModelCheckpoint(
+      checkpoint_path, loaded_ort_values, loaded_properties, mapped_files));
+  CompareOrtValues(name_to_ort_value, loaded_ort_values);
+}
+
+TEST(CheckpointingTest, RemoveKeepsReferencedCheckpoints) {
+  OrtValueTensorData first{{3}, {1.0f, 2.0f, 3.0f}};
+  OrtValueTensorData second{{2, 2}, {1.0f, 2.0f, 3.0f, 4.0f}};
+  NameMLValMap name_to_ort_value{
+      {"first", first.GetOrtValue()},
+      {"second", second.GetOrtValue()},
+  };
+
+  TemporaryDirectory tmp_dir{ORT_TSTR("checkpointing_test_dir")};
+
+  PathString base_checkpoint_path{
+      ConcatPathComponent<PathChar>(tmp_dir.Path(), ORT_TSTR("base_checkpoint"))};
+  PathString delta_checkpoint_path{
+      ConcatPathComponent<PathChar>(tmp_dir.Path(), ORT_TSTR("delta_checkpoint"))};
+
+  DataTransferManager data_transfer{};
+  data_transfer.RegisterDataTransfer(std::make_unique<CPUDataTransfer>());
+
+  CheckpointWriter writer{data_transfer};
+  ASSERT_STATUS_OK(writer.SaveAsync(base_checkpoint_path, name_to_ort_value, {}, true));
+  OrtValueTensorData updated_second{{2, 2}, {5.0f, 6.0f, 7.0f, 8.0f}};
+  name_to_ort_value["second"] = updated_second.GetOrtValue();
+  ASSERT_STATUS_OK(writer.SaveAsync(delta_checkpoint_path, name_to_ort_value, {}, true));
+
+  // the delta checkpoint refers to the data of "first" in the base checkpoint
+  ASSERT_STATUS_OK(writer.RemoveCheckpoint(base_checkpoint_path));
+  ASSERT_TRUE(Env::Default().FolderExists(base_checkpoint_path));
+  ASSERT_FALSE(writer.SaveAsync(base_checkpoint_path, name_to_ort_value, {}, true).IsOK());
+
+  NameMLValMap loaded_ort_values{};
+  std::unordered_map<std::string, std::string> loaded_properties{};
+  std::vector<Env::MappedMemoryPtr> mapped_files{};
+  ASSERT_STATUS_OK(LoadModelCheckpoint(
+      delta_checkpoint_path, loaded_ort_values, loaded_properties, mapped_files));
+  CompareOrtValues(name_to_ort_value, loaded_ort_values);
+  mapped_files.clear();
+
+  ASSERT_STATUS_OK(writer.RemoveCheckpoint(delta_checkpoint_path));
+  ASSERT_FALSE(Env::Default().FolderExists(delta_checkpoint_path));
+  ASSERT_FALSE(Env::Default().FolderExists(base_checkpoint_path));
+}
+
+TEST(CheckpointingTest, LoadMappedIsCopyOnWrite) {
+  OrtValueTensorData first{{3}, {1.0f, 2.0f, 3.0f}};
+  NameMLValMap name_to_ort_value{
+      {"first", first.GetOrtValue()},
+  };
+
+  TemporaryDirectory tmp_dir{ORT_TSTR("checkpointing_test_dir")};
+
+  PathString checkpoint_path{
+      ConcatPathComponent<PathChar>(tmp_dir.Path(), ORT_TSTR("test_checkpoint"))};
+
+  DataTransferManager data_transfer{};
+  data_transfer.RegisterDataTransfer(std::make_unique<CPUDataTransfer>());
+
+  ASSERT_STATUS_OK(SaveModelCheckpoint(checkpoint_path, data_transfer, name_to_ort_value, {}));
+
+  std::unordered_map<std::string, std::string> loaded_properties{};
+  {
+    NameMLValMap loaded_ort_values{};
+    std::vector<Env::MappedMemoryPtr> mapped_files{};
+    ASSERT_STATUS_OK(LoadModelCheckpoint(
+        checkpoint_path, loaded_ort_values, loaded_properties, mapped_files));
+    loaded_ort_values.at("first").GetMutable<Tensor>()->MutableData<float>()[0] = 10.0f;
+  }
+
+  NameMLValMap loaded_ort_values{};
+  std::vector<Env::MappedMemoryPtr> mapped_files{};
+  ASSERT_STATUS_OK(LoadModelCheckpoint(
+      checkpoint_path, loaded_ort_values, loaded_properties, mapped_files));
+  CompareOrtValues(name_to_ort_value, loaded_ort_values);
+}
+
 }  // namespace test
 }  // namespace training
 }  // namespace onnxruntime
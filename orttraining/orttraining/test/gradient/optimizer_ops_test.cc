@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <functional>
+#include <numeric>
 #include <random>
 
 #include "gtest/gtest.h"
@@ -243,6 +245,69 @@ TEST(OptimizerTest, AdamWeightDecayMode1WithBiasCorrection) {
   test.Run();
 }
 
+TEST(OptimizerTest, AdamOptimizerFP16GradientTest) {
+  OpTester test("AdamOptimizer", 1, onnxruntime::kMSDomain);
+  AdamOptimizerInputOutput data;
+
+  // The gradients are scaled by the loss scale, which the optimizer divides out.
+  const std::vector<float> scaled_g = {8.0f, 10.0f, 12.0f};
+  std::vector<MLFloat16> scaled_g_half(scaled_g.size());
+  ConvertFloatToMLFloat16(scaled_g.data(), scaled_g_half.data(), int(scaled_g.size()));
+
+  test.AddInput<float>("ETA", {}, data.eta);
+  test.AddInput<int64_t>("Update_Count", {}, {3});
+  test.AddInput<float>("W", {3}, data.w);
+  test.AddInput<MLFloat16>("G", {3}, scaled_g_half);
+  test.AddInput<float>("Moment_1", {3}, data.m1);
+  test.AddInput<float>("Moment_2", {3}, data.m2);
+  test.AddInput<MLFloat16>("FP16_W", {3}, data.w_half);
+  test.AddInput<float>("loss_scale", {1}, {2.0f});
+  // grad clipping should not take effect because default max_norm is 1.0f
+  test.AddInput<float>("grad_norm", {1}, {0.01f});
+
+  // Verify AdamOptimizer outputs
+  test.AddOutput<int64_t>("Update_Count_Out", {}, {4});
+  test.AddOutput<float>("Moment_1_Out", {3}, data.m1_new);
+  test.AddOutput<float>("Moment_2_Out", {3}, data.m2_new);
+  test.AddOutput<float>("W_Out", {3}, data.w_new);
+  test.AddOptionalOutputEdge<MLFloat16>();
+  test.AddOutput<MLFloat16>("FP16_W_Out", {3}, data.w_new_half);
+
+  test.AddAttribute("do_bias_correction", static_cast<int64_t>(0));
+  test.AddAttribute("weight_decay_mode", static_cast<int64_t>(0));
+
+  test.Run();
+}
+
+TEST(OptimizerTest, AdamOptimizerFP16Gradient_SkipUpdate_Test) {
+  OpTester test("AdamOptimizer", 1, onnxruntime::kMSDomain);
+  AdamOptimizerInputOutput data;
+
+  test.AddInput<float>("ETA", {}, data.eta);
+  test.AddInput<int64_t>("Update_Count", {}, {3});
+  test.AddInput<float>("W", {3}, data.w);
+  test.AddInput<MLFloat16>("G", {3}, data.g_half);
+  test.AddInput<float>("Moment_1", {3}, data.m1);
+  test.AddInput<float>("Moment_2", {3}, data.m2);
+  test.AddInput<MLFloat16>("FP16_W", {3}, data.w_half);
+  test.AddInput<float>("loss_scale", {1}, {1.0f});
+  test.AddInput<float>("grad_norm", {1}, {0.01f});
+  test.AddInput<bool>("DoUpdate", {1}, {false});
+
+  // Verify AdamOptimizer outputs
+  test.AddOutput<int64_t>("Update_Count_Out", {}, {3});
+  test.AddOutput<float>("Moment_1_Out", {3}, data.m1);
+  test.AddOutput<float>("Moment_2_Out", {3}, data.m2);
+  test.AddOutput<float>("W_Out", {3}, data.w);
+  test.AddOptionalOutputEdge<MLFloat16>();
+  test.AddOutput<MLFloat16>("FP16_W_Out", {3}, data.w_half);
+
+  test.AddAttribute("do_bias_correction", static_cast<int64_t>(0));
+  test.AddAttribute("weight_decay_mode", static_cast<int64_t>(0));
+
+  test.Run();
+}
+
 #if defined(USE_CUDA) || defined(USE_ROCM)
 
 float GetGradientL2Norm(const std::vector<float>& gradient_vector) {
@@ -449,6 +514,8 @@ TEST(OptimizerTest, AdamOptimizerMixPrecisionTest_Gradient) {
   test.Run();
 }
 
+#endif
+
 // This helper function is a CPU-based LAMB optimizer
 // implementation. It mainly focuses on readability.
 void compute_lamb(
@@ -811,108 +878,6 @@ void run_multi_tensor_lamb_test(
       ratio_min, ratio_max);
 }
 
-void run_lamb_mix_precision_test(
-    const std::vector<int64_t>& shape,
-    const std::vector<float>& eta,
-    const std::vector<float>& w,
-    const std::vector<float>& g,
-    const std::vector<float>& m,
-    const std::vector<float>& v,
-    const float lambda,
-    const float alpha,
-    const float beta,
-    const float epsilon,
-    const float max_norm,
-    const int64_t step = 0,
-    const float loss_scale = 1.0f,
-    const float* p_g_norm = nullptr) {
-  std::vector<float> w_new(w.size(), 0);
-  std::vector<float> g_new(g.size(), 0);
-  std::vector<float> m_new(m.size(), 0);
-  std::vector<float> v_new(v.size(), 0);
-
-  // Invoke LAMB's reference implementation to compute output.
-  compute_lamb(
-      shape, w, g, m, v,
-      eta[0], lambda, alpha, beta, epsilon, max_norm,
-      w_new, g_new, m_new, v_new, step, loss_scale, p_g_norm);
-
-  std::vector<MLFloat16> eta_half(eta.size());
-  std::vector<MLFloat16> g_half(w.size());
-  std::vector<MLFloat16> m_half(w.size());
-  std::vector<MLFloat16> v_half(w.size());
-  std::vector<MLFloat16> w_half(w.size());
-  ConvertFloatToMLFloat16(eta.data(), eta_half.data(), int(eta.size()));
-  ConvertFloatToMLFloat16(g.data(), g_half.data(), int(g.size()));
-  ConvertFloatToMLFloat16(m.data(), m_half.data(), int(m.size()));
-  ConvertFloatToMLFloat16(v.data(), v_half.data(), int(v.size()));
-  ConvertFloatToMLFloat16(w.data(), w_half.data(), int(w.size()));
-
-  std::vector<MLFloat16> m_new_half(m_new.size());
-  std::vector<MLFloat16> v_new_half(v_new.size());
-  std::vector<MLFloat16> w_new_half(w_new.size());
-  std::vector<MLFloat16> g_new_half(g_new.size());
-  ConvertFloatToMLFloat16(m_new.data(), m_new_half.data(), int(m_new.size()));
-  ConvertFloatToMLFloat16(v_new.data(), v_new_half.data(), int(v_new.size()));
-  ConvertFloatToMLFloat16(w_new.data(), w_new_half.data(), int(w_new.size()));
-  ConvertFloatToMLFloat16(g_new.data(), g_new_half.data(), int(g_new.size()));
-
-  // Half momentums, without fp16 weight
-  run_lamb_test_with_baseline(
-      shape, eta_half, w, g_half, m_half, v_half, alpha, beta, lambda, epsilon, max_norm,
-      w_new, {}, m_new_half, v_new_half, {}, {}, true, step, loss_scale, p_g_norm);
-
-  // Float momentums, without fp16 weight
-  run_lamb_test_with_baseline(
-      shape, eta_half, w, g_half, m, v, alpha, beta, lambda, epsilon, max_norm,
-      w_new, {}, m_new, v_new, {}, {}, true, step, loss_scale, p_g_norm);
-
-  // Half momentums, with fp16 weight
-  run_lamb_test_with_baseline(
-      shape, eta_half, w, g_half, m_half, v_half, alpha, beta, lambda, epsilon, max_norm,
-      w_new, {}, m_new_half, v_new_half, {}, {}, true, step, loss_scale, p_g_norm);
-
-  // Float momentums, with fp16 weight
-  run_lamb_test_with_baseline(
-      shape, eta_half, w, g_half, m, v, alpha, beta, lambda, epsilon, max_norm,
-      w_new, {}, m_new, v_new, w_half, w_new_half, true, step, loss_scale, p_g_norm);
-
-  // Half momentums, with fp16 weight, skip weight update
-  run_lamb_test_with_baseline(
-      shape, eta_half, w, g_half, m_half, v_half, alpha, beta, lambda, epsilon, max_norm,
-      w, {}, m_half, v_half, w_half, w_half, false, step, loss_scale, p_g_norm);
-
-  // Float momentums, with fp16 weight, skip weight update
-  run_lamb_test_with_baseline(
-      shape, eta_half, w, g_half, m, v, alpha, beta, lambda, epsilon, max_norm,
-      w, {}, m, v, w_half, w_half, false, step, loss_scale, p_g_norm);
-
-  // Float eta, float momentums, with fp16 weight
-  run_lamb_test_with_baseline(
-      shape, eta, w, g_half, m, v, alpha, beta, lambda, epsilon, max_norm,
-      w_new, {}, m_new, v_new, w_half, w_new_half, true, step, loss_scale, p_g_norm);
-
-  // Float eta, float momentums, with fp16 weight, skip weight update
-  run_lamb_test_with_baseline(
-      shape, eta, w, g_half, m, v, alpha, beta, lambda, epsilon, max_norm,
-      w, {}, m, v, w_half, w_half, false, step, loss_scale, p_g_norm);
-
-  // Float momentums, without fp16 weight, output gradients only
-  run_lamb_test_with_baseline(
-      shape, eta_half, w, g_half, m, v, alpha, beta, lambda, epsilon, max_norm,
-      {}, g_new_half, m_new, v_new, {}, {}, true, step, loss_scale, p_g_norm);
-
-  // Float momentums, with fp16 weight, output gradients only
-  run_lamb_test_with_baseline(
-      shape, eta_half, w, g_half, m, v, alpha, beta, lambda, epsilon, max_norm,
-      {}, g_new_half, m_new, v_new, w_half, {}, true, step, loss_scale, p_g_norm);
-
-  // Float momentums, with fp16 weight, output gradients only, skip weight update
-  run_lamb_test_with_baseline(
-      shape, eta_half, w, g_half, m, v, alpha, beta, lambda, epsilon, max_norm,
-      {}, g_half, m, v, w_half, {}, false, step, loss_scale, p_g_norm);
-}
-
 // A optimizer test with an 2-element vector.
 TEST(OptimizerTest, LambOptimizerTestVector) {
   // Input tensors and attributes.
@@ -1359,65 +1324,350 @@ TEST(OptimizerTest, LambOptimizerTestExternalBaseline) {
       shape, eta, w, g, m, v, alpha, beta, lambda, epsilon, max_norm, {}, g_new, m_new, v_new);
 }
 
-TEST(OptimizerTest, LambOptimizerTestExternalBaselineDouble) {
+TEST(OptimizerTest, LambOptimizerTestLarge) {
   // Input tensors and attributes.
-  const std::vector<int64_t> shape = {2, 5};
-  const std::vector<double> eta = {0.1f};
-  const std::vector<double> w = {
-      0.01379026, 0.15308191, -0.24356517, -0.21798165, -0.13770047, 0.09694599,
-      -0.02223516, 0.2664228, -0.01177993, 0.06832688};
-  const std::vector<double> g = {
-      -6.048543, 10.569487, -9.207029, -0.57407373,
-      5.884985, -0.21047728, 3.539946, -5.957566, -9.343748, 1.1502024};
-  const std::vector<double> m = {
-      -5.9078765, 9.673933, -8.731428, -0.6227454, 5.284312, -0.27138948,
-      3.443532, -5.681713, -8.72421, 1.1441823};
-  const std::vector<double> v = {
-      4.2659229e+01, 1.1438165e+02, 9.3179581e+01, 4.7399229e-01, 3.4129276e+01,
-      9.0019435e-02, 1.4493006e+01, 3.9455612e+01, 9.3025581e+01, 1.6000764e+0};
-
-  const float lambda = 0.1f;
-  const float alpha = 0.1f;
-  const float beta = 0.01f;
-  const float epsilon = 0.1f;
-  const float max_norm = 1.0f;
+  for (const auto& size : {55667, 1944006, 3907584}) {
+    const std::vector<int64_t> shape = {static_cast<int64_t>(size)};
+    const float eta = 0.5f;
+    std::vector<float> w(size);
+    std::vector<float> g(size);
+    std::vector<float> m(size);
+    std::vector<float> v(size);
 
-  std::vector<double> w_new = {
-      0.02979828, 0.13677707, -0.22708717, -0.20361158, -0.15338624, 0.1081504,
-      -0.03804127, 0.28198114, 0.00430069, 0.05319814};
-  std::vector<double> g_new = {
-      0.01600802, -0.01630484, 0.016478, 0.01437007, -0.01568577, 0.01120441,
-      -0.01580611, 0.01555834, 0.01608062, -0.01512874};
-  std::vector<double> m_new = {
-      -6.0344763, 10.479931, -9.15947, -0.57894087, 5.824918, -0.2165685,
-      3.5303047, -5.9299808, -9.281795, 1.1496004};
-  std::vector<double> v_new = {
-      3.6645618e+01, 1.1174072e+02, 8.4853485e+01, 3.3100498e-01, 3.4628010e+01,
-      4.4757873e-02, 1.2550836e+01, 3.5532223e+01, 8.7362823e+01, 1.3257366e+00};
+    std::random_device random_device;
+    std::mt19937 random_engine(0);
+    std::uniform_real_distribution<float> dist(0.1f, 1.0f);
+    for (int i = 0; i < size; ++i) {
+      w[i] = dist(random_engine);
+      g[i] = dist(random_engine);
+      m[i] = dist(random_engine);
+      v[i] = dist(random_engine);
+    }
 
-  // Output new weights
-  run_lamb_test_with_baseline(
-      shape, eta, w, g, m, v, alpha, beta, lambda, epsilon, max_norm, w_new, {}, m_new, v_new);
+    const float lambda = 0.5f;
+    const float alpha = 0.2f;
+    const float beta = 0.8f;
+    const float epsilon = 1e-6f;
+    const float max_norm = 1.0f;
+    const int64_t step = 0;
+    const float loss_scale = 1.f;
+    const float scaled_g_norm = 1.f;
 
-  // Output new gradients
-  run_lamb_test_with_baseline(
-      shape, eta, w, g, m, v, alpha, beta, lambda, epsilon, max_norm, {}, g_new, m_new, v_new);
+    run_multi_tensor_lamb_test(
+        {shape},
+        eta,
+        {w},
+        {g},
+        {m},
+        {v},
+        {lambda},
+        {alpha},
+        {beta},
+        {epsilon},
+        {max_norm},
+        step,
+        loss_scale,
+        &scaled_g_norm);
+  }
 }
 
-TEST(OptimizerTest, LambOptimizerTest5DTensorMixPrecision32_16) {
-  const std::vector<int64_t> shape = {2, 2, 2, 1, 1};
-  const std::vector<float> eta = {0.5f};
-  const std::vector<float> w = {1.0f, 2.0f, 2.5f, 1.5f, 1.0f, 2.0f, 2.0f, 1.5f};
-  const std::vector<float> g = {-1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 0.8f};
-  const std::vector<float> m = {1.0f, 2.0f, -0.25f, 1.1f, 1.0f, 2.0f, -0.21f, 1.1f};
-  const std::vector<float> v = {1.5f, 1.0f, 1.1f, 0.76f, 1.5f, 1.0f, 1.5f, 0.76f};
+TEST(OptimizerTest, LambOptimizerMultiTensorRatio) {
+  const int group_count = 127;
+  std::random_device random_device;
+  std::mt19937 random_engine(0);
+  std::uniform_real_distribution<float> dist(0.1f, 1.0f);
+  std::uniform_int_distribution<int64_t> dist_int(1, 1228);
 
-  const float lambda = 1.5f;
-  const float alpha = 1.5f;
-  const float beta = 1.5f;
-  const float epsilon = 1.0f;
-  const float max_norm = 1.0f;
-  const float loss_scale = 1.0f;
+  std::vector<int64_t> sizes(group_count);
+  std::vector<std::vector<int64_t>> shapes(group_count);
+
+  std::vector<std::vector<float>> ws(group_count);
+  std::vector<std::vector<float>> gs(group_count);
+  std::vector<std::vector<float>> ms(group_count);
+  std::vector<std::vector<float>> vs(group_count);
+  std::vector<float> alphas(group_count);
+  std::vector<float> betas(group_count);
+  std::vector<float> lambdas(group_count);
+  std::vector<float> epsilons(group_count);
+  std::vector<float> max_norms(group_count);
+
+  const float eta = dist(random_engine);
+
+  for (int64_t i = 0; i < group_count; ++i) {
+    const auto size = dist_int(random_engine);
+    sizes[i] = size;
+    shapes[i] = std::vector<int64_t>(1, size);
+
+    ws[i] = std::vector<float>(sizes[i]);
+    gs[i] = std::vector<float>(sizes[i]);
+    ms[i] = std::vector<float>(sizes[i]);
+    vs[i] = std::vector<float>(sizes[i]);
+
+    for (int64_t j = 0; j < sizes[i]; ++j) {
+      ws[i][j] = dist(random_engine);
+      gs[i][j] = dist(random_engine);
+      ms[i][j] = dist(random_engine);
+      vs[i][j] = dist(random_engine);
+    }
+
+    alphas[i] = dist(random_engine);
+    betas[i] = dist(random_engine);
+    lambdas[i] = dist(random_engine);
+    epsilons[i] = dist(random_engine);
+    max_norms[i] = dist(random_engine);
+  }
+
+  const int64_t step = 0;
+  float loss_scale = 1.f;
+  const float scaled_g_norm = 1.f;
+
+  run_multi_tensor_lamb_test(
+      shapes, eta,
+      ws, gs, ms, vs,
+      lambdas, alphas, betas, epsilons, max_norms,
+      step, loss_scale, &scaled_g_norm, 0.3f, 0.7f);
+
+  run_multi_tensor_lamb_test(
+      shapes, eta,
+      ws, gs, ms, vs,
+      lambdas, alphas, betas, epsilons, max_norms,
+      step, loss_scale, &scaled_g_norm);
+}
+
+// fp32 weights and momentums with fp16 gradients, the mixed precision setup supported on CPU.
+TEST(OptimizerTest, LambOptimizerMultiTensorFP16Gradient) {
+  const std::vector<std::vector<int64_t>> shapes = {{5}, {3, 4}, {2, 3, 5}};
+  const int group_count = static_cast<int>(shapes.size());
+  std::mt19937 random_engine(0);
+  std::uniform_real_distribution<float> dist(0.1f, 1.0f);
+
+  const float eta = 0.5f;
+  const int64_t step = 3;
+  const float loss_scale = 4.f;
+  // Larger than loss_scale * max_norm, so the gradients are clipped.
+  const float scaled_g_norm = 8.f;
+  const std::vector<float> alphas(group_count, 0.9f);
+  const std::vector<float> betas(group_count, 0.999f);
+  const std::vector<float> lambdas(group_count, 0.01f);
+  const std::vector<float> epsilons(group_count, 1e-6f);
+  const std::vector<float> max_norms(group_count, 1.f);
+
+  std::vector<std::vector<float>> ws(group_count);
+  std::vector<std::vector<float>> gs(group_count);
+  std::vector<std::vector<float>> ms(group_count);
+  std::vector<std::vector<float>> vs(group_count);
+  std::vector<std::vector<float>> w_news(group_count);
+  std::vector<std::vector<float>> g_news(group_count);
+  std::vector<std::vector<float>> m_news(group_count);
+  std::vector<std::vector<float>> v_news(group_count);
+  std::vector<std::vector<MLFloat16>> g_halfs(group_count);
+  std::vector<std::vector<MLFloat16>> w_halfs(group_count);
+  std::vector<std::vector<MLFloat16>> w_new_halfs(group_count);
+
+  for (int i = 0; i < group_count; ++i) {
+    const size_t size = static_cast<size_t>(
+        std::accumulate(shapes[i].begin(), shapes[i].end(), (int64_t)1, std::multiplies<int64_t>()));
+    ws[i].resize(size);
+    gs[i].resize(size);
+    ms[i].resize(size);
+    vs[i].resize(size);
+    for (size_t j = 0; j < size; ++j) {
+      ws[i][j] = dist(random_engine);
+      gs[i][j] = loss_scale * dist(random_engine);
+      ms[i][j] = dist(random_engine);
+      vs[i][j] = dist(random_engine);
+    }
+
+    // Round the gradients to fp16 so that the baseline sees the values the kernel gets.
+    g_halfs[i].resize(size);
+    ConvertFloatToMLFloat16(gs[i].data(), g_halfs[i].data(), int(size));
+    ConvertMLFloat16ToFloat(g_halfs[i].data(), gs[i].data(), int(size));
+
+    w_news[i].resize(size);
+    g_news[i].resize(size);
+    m_news[i].resize(size);
+    v_news[i].resize(size);
+    compute_lamb(
+        shapes[i], ws[i], gs[i], ms[i], vs[i],
+        eta, lambdas[i], alphas[i], betas[i], epsilons[i], max_norms[i],
+        w_news[i], g_news[i], m_news[i], v_news[i], step, loss_scale, &scaled_g_norm);
+
+    w_halfs[i].resize(size);
+    w_new_halfs[i].resize(size);
+    ConvertFloatToMLFloat16(ws[i].data(), w_halfs[i].data(), int(size));
+    ConvertFloatToMLFloat16(w_news[i].data(), w_new_halfs[i].data(), int(size));
+  }
+
+  run_multi_tensor_lamb_test_with_baseline(
+      shapes, eta,
+      ws, g_halfs, ms, vs,
+      alphas, betas, lambdas, epsilons, max_norms,
+      w_news, {}, m_news, v_news, w_halfs, w_new_halfs, true, step, loss_scale, &scaled_g_norm);
+}
+
+#if defined(USE_CUDA) || defined(USE_ROCM)
+
+void run_lamb_mix_precision_test(
+    const std::vector<int64_t>& shape,
+    const std::vector<float>& eta,
+    const std::vector<float>& w,
+    const std::vector<float>& g,
+    const std::vector<float>& m,
+    const std::vector<float>& v,
+    const float lambda,
+    const float alpha,
+    const float beta,
+    const float epsilon,
+    const float max_norm,
+    const int64_t step = 0,
+    const float loss_scale = 1.0f,
+    const float* p_g_norm = nullptr) {
+  std::vector<float> w_new(w.size(), 0);
+  std::vector<float> g_new(g.size(), 0);
+  std::vector<float> m_new(m.size(), 0);
+  std::vector<float> v_new(v.size(), 0);
+
+  // Invoke LAMB's reference implementation to compute output.
+  compute_lamb(
+      shape, w, g, m, v,
+      eta[0], lambda, alpha, beta, epsilon, max_norm,
+      w_new, g_new, m_new, v_new, step, loss_scale, p_g_norm);
+
+  std::vector<MLFloat16> eta_half(eta.size());
+  std::vector<MLFloat16> g_half(w.size());
+  std::vector<MLFloat16> m_half(w.size());
+  std::vector<MLFloat16> v_half(w.size());
+  std::vector<MLFloat16> w_half(w.size());
+  ConvertFloatToMLFloat16(eta.data(), eta_half.data(), int(eta.size()));
+  ConvertFloatToMLFloat16(g.data(), g_half.data(), int(g.size()));
+  ConvertFloatToMLFloat16(m.data(), m_half.data(), int(m.size()));
+  ConvertFloatToMLFloat16(v.data(), v_half.data(), int(v.size()));
+  ConvertFloatToMLFloat16(w.data(), w_half.data(), int(w.size()));
+
+  std::vector<MLFloat16> m_new_half(m_new.size());
+  std::vector<MLFloat16> v_new_half(v_new.size());
+  std::vector<MLFloat16> w_new_half(w_new.size());
+  std::vector<MLFloat16> g_new_half(g_new.size());
+  ConvertFloatToMLFloat16(m_new.data(), m_new_half.data(), int(m_new.size()));
+  ConvertFloatToMLFloat16(v_new.data(), v_new_half.data(), int(v_new.size()));
+  ConvertFloatToMLFloat16(w_new.data(), w_new_half.data(), int(w_new.size()));
+  ConvertFloatToMLFloat16(g_new.data(), g_new_half.data(), int(g_new.size()));
+
+  // Half momentums, without fp16 weight
+  run_lamb_test_with_baseline(
+      shape, eta_half, w, g_half, m_half, v_half, alpha, beta, lambda, epsilon, max_norm,
+      w_new, {}, m_new_half, v_new_half, {}, {}, true, step, loss_scale, p_g_norm);
+
+  // Float momentums, without fp16 weight
+  run_lamb_test_with_baseline(
+      shape, eta_half, w, g_half, m, v, alpha, beta, lambda, epsilon, max_norm,
+      w_new, {}, m_new, v_new, {}, {}, true, step, loss_scale, p_g_norm);
+
+  // Half momentums, with fp16 weight
+  run_lamb_test_with_baseline(
+      shape, eta_half, w, g_half, m_half, v_half, alpha, beta, lambda, epsilon, max_norm,
+      w_new, {}, m_new_half, v_new_half, {}, {}, true, step, loss_scale, p_g_norm);
+
+  // Float momentums, with fp16 weight
+  run_lamb_test_with_baseline(
+      shape, eta_half, w, g_half, m, v, alpha, beta, lambda, epsilon, max_norm,
+      w_new, {}, m_new, v_new, w_half, w_new_half, true, step, loss_scale, p_g_norm);
+
+  // Half momentums, with fp16 weight, skip weight update
+  run_lamb_test_with_baseline(
+      shape, eta_half, w, g_half, m_half, v_half, alpha, beta, lambda, epsilon, max_norm,
+      w, {}, m_half, v_half, w_half, w_half, false, step, loss_scale, p_g_norm);
+
+  // Float momentums, with fp16 weight, skip weight update
+  run_lamb_test_with_baseline(
+      shape, eta_half, w, g_half, m, v, alpha, beta, lambda, epsilon, max_norm,
+      w, {}, m, v, w_half, w_half, false, step, loss_scale, p_g_norm);
+
+  // Float eta, float momentums, with fp16 weight
+  run_lamb_test_with_baseline(
+      shape, eta, w, g_half, m, v, alpha, beta, lambda, epsilon, max_norm,
+      w_new, {}, m_new, v_new, w_half, w_new_half, true, step, loss_scale, p_g_norm);
+
+  // Float eta, float momentums, with fp16 weight, skip weight update
+  run_lamb_test_with_baseline(
+      shape, eta, w, g_half, m, v, alpha, beta, lambda, epsilon, max_norm,
+      w, {}, m, v, w_half, w_half, false, step, loss_scale, p_g_norm);
+
+  // Float momentums, without fp16 weight, output gradients only
+  run_lamb_test_with_baseline(
+      shape, eta_half, w, g_half, m, v, alpha, beta, lambda, epsilon, max_norm,
+      {}, g_new_half, m_new, v_new, {}, {}, true, step, loss_scale, p_g_norm);
+
+  // Float momentums, with fp16 weight, output gradients only
+  run_lamb_test_with_baseline(
+      shape, eta_half, w, g_half, m, v, alpha, beta, lambda, epsilon, max_norm,
+      {}, g_new_half, m_new, v_new, w_half, {}, true, step, loss_scale, p_g_norm);
+
+  // Float momentums, with fp16 weight, output gradients only, skip weight update
+  run_lamb_test_with_baseline(
+      shape, eta_half, w, g_half, m, v, alpha, beta, lambda, epsilon, max_norm,
+      {}, g_half, m, v, w_half, {}, false, step, loss_scale, p_g_norm);
+}
+
+TEST(OptimizerTest, LambOptimizerTestExternalBaselineDouble) {
+  // Input tensors and attributes.
+  const std::vector<int64_t> shape = {2, 5};
+  const std::vector<double> eta = {0.1f};
+  const std::vector<double> w = {
+      0.01379026, 0.15308191, -0.24356517, -0.21798165, -0.13770047, 0.09694599,
+      -0.02223516, 0.2664228, -0.01177993, 0.06832688};
+  const std::vector<double> g = {
+      -6.048543, 10.569487, -9.207029, -0.57407373,
+      5.884985, -0.21047728, 3.539946, -5.957566, -9.343748, 1.1502024};
+  const std::vector<double> m = {
+      -5.9078765, 9.673933, -8.731428, -0.6227454, 5.284312, -0.27138948,
+      3.443532, -5.681713, -8.72421, 1.1441823};
+  const std::vector<double> v = {
+      4.2659229e+01, 1.1438165e+02, 9.3179581e+01, 4.7399229e-01, 3.4129276e+01,
+      9.0019435e-02, 1.4493006e+01, 3.9455612e+01, 9.3025581e+01, 1.6000764e+0};
+
+  const float lambda = 0.1f;
+  const float alpha = 0.1f;
+  const float beta = 0.01f;
+  const float epsilon = 0.1f;
+  const float max_norm = 1.0f;
+
+  std::vector<double> w_new = {
+      0.02979828, 0.13677707, -0.22708717, -0.20361158, -0.15338624, 0.1081504,
+      -0.03804127, 0.28198114, 0.00430069, 0.05319814};
+  std::vector<double> g_new = {
+      0.01600802, -0.01630484, 0.016478, 0.01437007, -0.01568577, 0.01120441,
+      -0.01580611, 0.01555834, 0.01608062, -0.01512874};
+  std::vector<double> m_new = {
+      -6.0344763, 10.479931, -9.15947, -0.57894087, 5.824918, -0.2165685,
+      3.5303047, -5.9299808, -9.281795, 1.1496004};
+  std::vector<double> v_new = {
+      3.6645618e+01, 1.1174072e+02, 8.4853485e+01, 3.3100498e-01, 3.4628010e+01,
+      4.4757873e-02, 1.2550836e+01, 3.5532223e+01, 8.7362823e+01, 1.3257366e+00};
+
+  // Output new weights
+  run_lamb_test_with_baseline(
+      shape, eta, w, g, m, v, alpha, beta, lambda, epsilon, max_norm, w_new, {}, m_new, v_new);
+
+  // Output new gradients
+  run_lamb_test_with_baseline(
+      shape, eta, w, g, m, v, alpha, beta, lambda, epsilon, max_norm, {}, g_new, m_new, v_new);
+}
+
+TEST(OptimizerTest, LambOptimizerTest5DTensorMixPrecision32_16) {
+  const std::vector<int64_t> shape = {2, 2, 2, 1, 1};
+  const std::vector<float> eta = {0.5f};
+  const std::vector<float> w = {1.0f, 2.0f, 2.5f, 1.5f, 1.0f, 2.0f, 2.0f, 1.5f};
+  const std::vector<float> g = {-1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 0.8f};
+  const std::vector<float> m = {1.0f, 2.0f, -0.25f, 1.1f, 1.0f, 2.0f, -0.21f, 1.1f};
+  const std::vector<float> v = {1.5f, 1.0f, 1.1f, 0.76f, 1.5f, 1.0f, 1.5f, 0.76f};
+
+  const float lambda = 1.5f;
+  const float alpha = 1.5f;
+  const float beta = 1.5f;
+  const float epsilon = 1.0f;
+  const float max_norm = 1.0f;
+  const float loss_scale = 1.0f;
   run_lamb_mix_precision_test(
       shape, eta, w, g, m, v, lambda, alpha, beta, epsilon, max_norm);
 
@@ -1530,116 +1780,6 @@ TEST(OptimizerTest, LambOptimizerTestScalarMixPrecision32_16_NoDefaultMaxNormCli
       shape, eta, w, g, m, v,
       lambda, alpha, beta, epsilon, max_norm, 2, loss_scale, &gradient_norm);
 }
-
-TEST(OptimizerTest, LambOptimizerTestLarge) {
-  // Input tensors and attributes.
-  for (const auto& size : {55667, 1944006, 3907584}) {
-    const std::vector<int64_t> shape = {static_cast<int64_t>(size)};
-    const float eta = 0.5f;
-    std::vector<float> w(size);
-    std::vector<float> g(size);
-    std::vector<float> m(size);
-    std::vector<float> v(size);
-
-    std::random_device random_device;
-    std::mt19937 random_engine(0);
-    std::uniform_real_distribution<float> dist(0.1f, 1.0f);
-    for (int i = 0; i < size; ++i) {
-      w[i] = dist(random_engine);
-      g[i] = dist(random_engine);
-      m[i] = dist(random_engine);
-      v[i] = dist(random_engine);
-    }
-
-    const float lambda = 0.5f;
-    const float alpha = 0.2f;
-    const float beta = 0.8f;
-    const float epsilon = 1e-6f;
-    const float max_norm = 1.0f;
-    const int64_t step = 0;
-    const float loss_scale = 1.f;
-    const float scaled_g_norm = 1.f;
-
-    run_multi_tensor_lamb_test(
-        {shape},
-        eta,
-        {w},
-        {g},
-        {m},
-        {v},
-        {lambda},
-        {alpha},
-        {beta},
-        {epsilon},
-        {max_norm},
-        step,
-        loss_scale,
-        &scaled_g_norm);
-  }
-}
-
-TEST(OptimizerTest, LambOptimizerMultiTensorRatio) {
-  const int group_count = 127;
-  std::random_device random_device;
-  std::mt19937 random_engine(0);
-  std::uniform_real_distribution<float> dist(0.1f, 1.0f);
-  std::uniform_int_distribution<int64_t> dist_int(1, 1228);
-
-  std::vector<int64_t> sizes(group_count);
-  std::vector<std::vector<int64_t>> shapes(group_count);
-
-  std::vector<std::vector<float>> ws(group_count);
-  std::vector<std::vector<float>> gs(group_count);
-  std::vector<std::vector<float>> ms(group_count);
-  std::vector<std::vector<float>> vs(group_count);
-  std::vector<float> alphas(group_count);
-  std::vector<float> betas(group_count);
-  std::vector<float> lambdas(group_count);
-  std::vector<float> epsilons(group_count);
-  std::vector<float> max_norms(group_count);
-
-  const float eta = dist(random_engine);
-
-  for (int64_t i = 0; i < group_count; ++i) {
-    const auto size = dist_int(random_engine);
-    sizes[i] = size;
-    shapes[i] = std::vector<int64_t>(1, size);
-
-    ws[i] = std::vector<float>(sizes[i]);
-    gs[i] = std::vector<float>(sizes[i]);
-    ms[i] = std::vector<float>(sizes[i]);
-    vs[i] = std::vector<float>(sizes[i]);
-
-    for (int64_t j = 0; j < sizes[i]; ++j) {
-      ws[i][j] = dist(random_engine);
-      gs[i][j] = dist(random_engine);
-      ms[i][j] = dist(random_engine);
-      vs[i][j] = dist(random_engine);
-    }
-
-    alphas[i] = dist(random_engine);
-    betas[i] = dist(random_engine);
-    lambdas[i] = dist(random_engine);
-    epsilons[i] = dist(random_engine);
-    max_norms[i] = dist(random_engine);
-  }
-
-  const int64_t step = 0;
-  float loss_scale = 1.f;
-  const float scaled_g_norm = 1.f;
-
-  run_multi_tensor_lamb_test(
-      shapes, eta,
-      ws, gs, ms, vs,
-      lambdas, alphas, betas, epsilons, max_norms,
-      step, loss_scale, &scaled_g_norm, 0.3f, 0.7f);
-
-  run_multi_tensor_lamb_test(
-      shapes, eta,
-      ws, gs, ms, vs,
-      lambdas, alphas, betas, epsilons, max_norms,
-      step, loss_scale, &scaled_g_norm);
-}
 #endif
 }  // namespace
 }  // namespace test
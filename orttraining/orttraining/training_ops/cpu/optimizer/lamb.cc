@@ -0,0 +1,315 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "orttraining/training_ops/cpu/optimizer/lamb.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/platform/threadpool.h"
+#include "core/util/math_cpuonly.h"
+#include "orttraining/training_ops/cpu/optimizer/common.h"
+#include "orttraining/training_ops/cpu/optimizer/optimizer_utils.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace {
+
+std::vector<std::pair<int, int>> GenerateLambExtraAliasMapping() {
+  // Starting index of extra inputs.
+  constexpr int input_index_bias = 5;
+  // Starting index of extra outputs.
+  constexpr int output_index_bias = 1;
+  // Count of extra I/O groups. One group corresponds to a weight update.
+  constexpr int group_count = 1024;
+  // length of [w, g, m1, m2, w_mixed_precision].
+  constexpr int input_stride = 5;
+  // length of [w_new, g_new, m1_new, m2_new, w_mixed_precision_new].
+  constexpr int output_stride = 5;
+
+  std::vector<std::pair<int, int>> alias_pairs{};
+  for (int i = 0; i < group_count; ++i) {
+    const int input = input_index_bias + i * input_stride;
+    const int output = output_index_bias + i * output_stride;
+    for (int j = 0; j < input_stride; ++j) {
+      alias_pairs.emplace_back(std::make_pair(input + j, output + j));
+    }
+  }
+
+  // update_count are updated in place.
+  alias_pairs.emplace_back(std::make_pair(4, 0));
+
+  return alias_pairs;
+}
+
+// Number of elements processed by one task. A chunk never spans two weight tensors.
+constexpr int64_t lamb_chunk_size = 16384;
+
+}  // namespace
+
+#define REGISTER_LAMB_KERNEL_TYPED(T1, T2, T3, T4, T_GRAD_NORM, T_MIXED_PRECISION_FP)                  \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                                       \
+      LambOptimizer,                                                                                   \
+      kMSDomain,                                                                                       \
+      1,                                                                                               \
+      T1##_##T2##_##T3##_##T4##_##T_GRAD_NORM##_##T_MIXED_PRECISION_FP,                                \
+      kCpuExecutionProvider,                                                                           \
+      KernelDefBuilder()                                                                               \
+          .Alias(GenerateLambExtraAliasMapping())                                                      \
+          .TypeConstraint("T1", DataTypeImpl::GetTensorType<T1>())                                     \
+          .TypeConstraint("T2", DataTypeImpl::GetTensorType<T2>())                                     \
+          .TypeConstraint("T3", DataTypeImpl::GetTensorType<T3>())                                     \
+          .TypeConstraint("T4", DataTypeImpl::GetTensorType<T4>())                                     \
+          .TypeConstraint("T_MIXED_PRECISION_FP", DataTypeImpl::GetTensorType<T_MIXED_PRECISION_FP>()) \
+          .TypeConstraint("T_GRAD_NORM", DataTypeImpl::GetTensorType<T_GRAD_NORM>()),                  \
+      LambOptimizer<T1, T2, T3, T4, T_GRAD_NORM, T_MIXED_PRECISION_FP>);
+
+// fp32 master weights and momentums, with fp32 or fp16 gradients.
+REGISTER_LAMB_KERNEL_TYPED(float, float, float, float, float, MLFloat16)
+REGISTER_LAMB_KERNEL_TYPED(float, float, MLFloat16, float, MLFloat16, MLFloat16)
+REGISTER_LAMB_KERNEL_TYPED(float, float, MLFloat16, float, float, MLFloat16)
+
+template <typename T1, typename T2, typename T3, typename T4, typename T_GRAD_NORM, typename T_MIXED_PRECISION_FP>
+Status LambOptimizer<T1, T2, T3, T4, T_GRAD_NORM, T_MIXED_PRECISION_FP>::Compute(OpKernelContext* ctx) const {
+  constexpr int non_grouped_input_count = 5;
+  constexpr int input_group_size = 5;
+  constexpr int output_group_size = 5;
+  constexpr int non_grouped_output_count = 1;
+  const int grouped_input_tensor_count = ctx->InputCount() - non_grouped_input_count;
+  const int grouped_output_tensor_count = ctx->OutputCount() - non_grouped_output_count;
+
+  // In addition to the first non_grouped_input_count inputs, all inputs are repeated sequence of [w, g, m1, m2, w_mixed_precision].
+  ORT_RETURN_IF_NOT(
+      grouped_input_tensor_count > 0 && grouped_input_tensor_count % input_group_size == 0,
+      "Input count must be ", non_grouped_input_count, " + ", input_group_size,
+      " x (number of weights to optimize).");
+  // Outputs are repeated sequence of [w_new, g_new, m1_new, m2_new, w_mixed_precision_new].
+  ORT_RETURN_IF_NOT(
+      grouped_output_tensor_count % output_group_size == 0 &&
+          grouped_input_tensor_count / input_group_size == grouped_output_tensor_count / output_group_size,
+      "Input and output tensor counts are not aligned. Please check LambOptimizer's input and output lists.");
+
+  const int group_count = grouped_input_tensor_count / input_group_size;
+  ORT_RETURN_IF_NOT(alpha_.size() >= static_cast<size_t>(group_count) &&
+                        beta_.size() >= static_cast<size_t>(group_count) &&
+                        lambda_.size() >= static_cast<size_t>(group_count) &&
+                        epsilon_.size() >= static_cast<size_t>(group_count) &&
+                        max_norm_clip_.size() >= static_cast<size_t>(group_count),
+                    "LambOptimizer attributes must have one value per weight group.");
+
+  const Tensor* step_tensor = ctx->Input<Tensor>(4);
+  const int64_t step = step_tensor != nullptr ? *step_tensor->template Data<int64_t>() : 0;
+  Tensor* step_tensor_new = nullptr;
+  if (step_tensor != nullptr) {
+    step_tensor_new = ctx->Output(0, step_tensor->Shape());
+    ORT_RETURN_IF_NOT(step_tensor_new != nullptr,
+                      "Step tensor (input) and updated step tensor (output) must be specified together.");
+  }
+
+  // If the update signal is false, inputs are copied to outputs directly.
+  const Tensor* update_signal_tensor = ctx->Input<Tensor>(0);
+  const bool do_update = update_signal_tensor == nullptr || *update_signal_tensor->template Data<bool>();
+
+  std::vector<int64_t> tensor_sizes(group_count);
+  std::vector<const T2*> p_ws(group_count);
+  std::vector<const T3*> p_gs(group_count);
+  std::vector<const T4*> p_m1s(group_count);
+  std::vector<const T4*> p_m2s(group_count);
+  std::vector<T2*> p_w_news(group_count);
+  std::vector<T3*> p_g_news(group_count);
+  std::vector<T4*> p_m1_news(group_count);
+  std::vector<T4*> p_m2_news(group_count);
+  std::vector<T_MIXED_PRECISION_FP*> p_w_mixed_precision_news(group_count);
+
+  for (int group_index = 0; group_index < group_count; ++group_index) {
+    const int input_start_index = non_grouped_input_count + group_index * input_group_size;
+    const Tensor* w = ctx->Input<Tensor>(input_start_index);
+    const Tensor* g = ctx->Input<Tensor>(input_start_index + 1);
+    const Tensor* m1 = ctx->Input<Tensor>(input_start_index + 2);
+    const Tensor* m2 = ctx->Input<Tensor>(input_start_index + 3);
+    const Tensor* w_mixed_precision = ctx->Input<Tensor>(input_start_index + 4);
+    ORT_RETURN_IF_NOT(w != nullptr && g != nullptr && m1 != nullptr && m2 != nullptr,
+                      "Weight, gradient and momentum tensors of group ", group_index, " should not be null.");
+    ORT_RETURN_IF_NOT(g->Shape() == w->Shape() && m1->Shape() == w->Shape() && m2->Shape() == w->Shape(),
+                      "Weight, gradient and momentum tensors of group ", group_index, " must have the same shape.");
+
+    const int output_start_index = non_grouped_output_count + group_index * output_group_size;
+    Tensor* w_new = ctx->Output(output_start_index, w->Shape());
+    Tensor* g_new = ctx->Output(output_start_index + 1, g->Shape());
+    Tensor* m1_new = ctx->Output(output_start_index + 2, m1->Shape());
+    Tensor* m2_new = ctx->Output(output_start_index + 3, m2->Shape());
+    Tensor* w_mixed_precision_new = w_mixed_precision != nullptr ? ctx->Output(output_start_index + 4, w_mixed_precision->Shape()) : nullptr;
+    ORT_RETURN_IF_NOT(m1_new != nullptr && m2_new != nullptr,
+                      "New momentum tensors of group ", group_index, " should not be null.");
+
+    if (!do_update) {
+      if (w_new != nullptr) {
+        CopyIfNotSameBuffer<T2>(*w, *w_new);
+      }
+      if (g_new != nullptr) {
+        CopyIfNotSameBuffer<T3>(*g, *g_new);
+      }
+      CopyIfNotSameBuffer<T4>(*m1, *m1_new);
+      CopyIfNotSameBuffer<T4>(*m2, *m2_new);
+      if (w_mixed_precision_new != nullptr) {
+        CopyIfNotSameBuffer<T_MIXED_PRECISION_FP>(*w_mixed_precision, *w_mixed_precision_new);
+      }
+      continue;
+    }
+
+    tensor_sizes[group_index] = w->Shape().Size();
+    p_ws[group_index] = w->template Data<T2>();
+    p_gs[group_index] = g->template Data<T3>();
+    p_m1s[group_index] = m1->template Data<T4>();
+    p_m2s[group_index] = m2->template Data<T4>();
+    p_w_news[group_index] = w_new != nullptr ? w_new->template MutableData<T2>() : nullptr;
+    p_g_news[group_index] = g_new != nullptr ? g_new->template MutableData<T3>() : nullptr;
+    p_m1_news[group_index] = m1_new->template MutableData<T4>();
+    p_m2_news[group_index] = m2_new->template MutableData<T4>();
+    p_w_mixed_precision_news[group_index] =
+        w_mixed_precision_new != nullptr ? w_mixed_precision_new->template MutableData<T_MIXED_PRECISION_FP>() : nullptr;
+  }
+
+  if (!do_update) {
+    if (step_tensor_new != nullptr) {
+      *step_tensor_new->template MutableData<int64_t>() = step;
+    }
+    return Status::OK();
+  }
+
+  const T2* loss_scale_data = ctx->Input<Tensor>(1) != nullptr ? ctx->Input<Tensor>(1)->template Data<T2>() : nullptr;
+  const T_GRAD_NORM* g_norm_data = ctx->Input<Tensor>(2) != nullptr ? ctx->Input<Tensor>(2)->template Data<T_GRAD_NORM>() : nullptr;
+  const float eta = static_cast<float>(*ctx->Input<Tensor>(3)->template Data<T1>());
+
+  // The update directions are kept in fp32 until the trust ratios are known, so they are not rounded
+  // to the gradient type even if the gradients are fp16.
+  std::vector<int64_t> d_offsets(group_count);
+  int64_t total_size = 0;
+  for (int group_index = 0; group_index < group_count; ++group_index) {
+    d_offsets[group_index] = total_size;
+    total_size += tensor_sizes[group_index];
+  }
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&allocator));
+  auto d_buffer = IAllocator::MakeUniquePtr<float>(allocator, static_cast<size_t>(std::max<int64_t>(total_size, 1)));
+  float* d_data = d_buffer.get();
+
+  const std::vector<OptimizerChunk> chunks = SplitIntoChunks(tensor_sizes, lamb_chunk_size);
+  const auto chunk_count = static_cast<std::ptrdiff_t>(chunks.size());
+  std::vector<float> w_square_sums(chunks.size());
+  std::vector<float> d_square_sums(chunks.size());
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+
+  // Compute the new momentums and the update directions, and the partial squared norms of the
+  // weights and the directions.
+  concurrency::ThreadPool::TryBatchParallelFor(
+      tp, chunk_count,
+      [&](std::ptrdiff_t chunk_index) {
+        const OptimizerChunk& chunk = chunks[chunk_index];
+        const int group = chunk.group;
+        const int64_t offset = chunk.offset;
+        const int64_t count = chunk.count;
+
+        const float alpha = alpha_[group];
+        const float beta = beta_[group];
+        const float lambda = lambda_[group];
+        const float epsilon = epsilon_[group];
+        // Actual gradient. The scale is a product of loss' scale and
+        // global gradient norm (if the norm > 1).
+        const float g_scale = ComputeGradScale(loss_scale_data, g_norm_data, max_norm_clip_[group]);
+        // For the first iteration (indexed by 0), the update count should be 1.
+        const float alpha_correction = do_bias_correction_ ? compute_bias_correction_coefficient(alpha, step) : 1.f;
+        const float beta_correction = do_bias_correction_ ? compute_bias_correction_coefficient(beta, step) : 1.f;
+
+        std::vector<float> w_buffer, g_buffer, m1_buffer, m2_buffer, m1_new_buffer, m2_new_buffer;
+        std::vector<float> momentum_buffer(static_cast<size_t>(2 * count));
+        ConstEigenVectorArrayMap<float> w(LoadAsFloat(p_ws[group] + offset, count, w_buffer), count);
+        ConstEigenVectorArrayMap<float> g(LoadAsFloat(p_gs[group] + offset, count, g_buffer), count);
+        ConstEigenVectorArrayMap<float> m1(LoadAsFloat(p_m1s[group] + offset, count, m1_buffer), count);
+        ConstEigenVectorArrayMap<float> m2(LoadAsFloat(p_m2s[group] + offset, count, m2_buffer), count);
+        EigenVectorArrayMap<float> m1_tmp(momentum_buffer.data(), count);
+        EigenVectorArrayMap<float> m2_tmp(momentum_buffer.data() + count, count);
+        EigenVectorArrayMap<float> d(d_data + d_offsets[group] + offset, count);
+
+        m1_tmp = alpha * m1 + (1.f - alpha) * (g / g_scale);
+        m2_tmp = beta * m2 + (1.f - beta) * (g / g_scale).square();
+        d = lambda * w + (m1_tmp / alpha_correction) / ((m2_tmp / beta_correction).sqrt() + epsilon);
+
+        // Things are updated only if the direction is finite.
+        EigenVectorArrayMap<float> m1_new(OutputAsFloat(p_m1_news[group] + offset, count, m1_new_buffer), count);
+        EigenVectorArrayMap<float> m2_new(OutputAsFloat(p_m2_news[group] + offset, count, m2_new_buffer), count);
+        m1_new = d.isFinite().select(m1_tmp, m1);
+        m2_new = d.isFinite().select(m2_tmp, m2);
+        d = d.isFinite().select(d, 0.f);
+        StoreFromFloat(m1_new.data(), count, p_m1_news[group] + offset);
+        StoreFromFloat(m2_new.data(), count, p_m2_news[group] + offset);
+
+        w_square_sums[chunk_index] = w.square().sum();
+        d_square_sums[chunk_index] = d.square().sum();
+      },
+      0);
+
+  // Confidence coefficient of the update of each group.
+  std::vector<float> w_norms(group_count, 0.f);
+  std::vector<float> d_norms(group_count, 0.f);
+  for (size_t i = 0; i < chunks.size(); ++i) {
+    w_norms[chunks[i].group] += w_square_sums[i];
+    d_norms[chunks[i].group] += d_square_sums[i];
+  }
+  std::vector<float> ratios(group_count);
+  for (int group_index = 0; group_index < group_count; ++group_index) {
+    const float w_norm = w_norms[group_index];
+    const float d_norm = d_norms[group_index];
+    ratios[group_index] = (w_norm != 0.f && d_norm != 0.f)
+                              ? eta * std::max(ratio_min_, std::min(ratio_max_, std::sqrt(w_norm / d_norm)))
+                              : eta;
+  }
+
+  // Apply the update directions.
+  concurrency::ThreadPool::TryBatchParallelFor(
+      tp, chunk_count,
+      [&](std::ptrdiff_t chunk_index) {
+        const OptimizerChunk& chunk = chunks[chunk_index];
+        const int group = chunk.group;
+        const int64_t offset = chunk.offset;
+        const int64_t count = chunk.count;
+        if (p_w_news[group] == nullptr && p_g_news[group] == nullptr) {
+          return;
+        }
+
+        const float ratio = ratios[group];
+        std::vector<float> w_buffer, w_new_buffer, g_new_buffer;
+        std::vector<float> w_new_tmp_buffer(static_cast<size_t>(count));
+        ConstEigenVectorArrayMap<float> w(LoadAsFloat(p_ws[group] + offset, count, w_buffer), count);
+        ConstEigenVectorArrayMap<float> d(d_data + d_offsets[group] + offset, count);
+        EigenVectorArrayMap<float> w_new_tmp(w_new_tmp_buffer.data(), count);
+        w_new_tmp = w - ratio * d;
+
+        // The update is skipped if the new weight is not finite.
+        if (p_g_news[group] != nullptr) {
+          EigenVectorArrayMap<float> g_new(OutputAsFloat(p_g_news[group] + offset, count, g_new_buffer), count);
+          g_new = w_new_tmp.isFinite().select(-ratio * d, 0.f);
+          StoreFromFloat(g_new.data(), count, p_g_news[group] + offset);
+        }
+        if (p_w_news[group] != nullptr) {
+          EigenVectorArrayMap<float> w_new(OutputAsFloat(p_w_news[group] + offset, count, w_new_buffer), count);
+          w_new = w_new_tmp.isFinite().select(w_new_tmp, w);
+          StoreFromFloat(w_new.data(), count, p_w_news[group] + offset);
+          if (p_w_mixed_precision_news[group] != nullptr) {
+            StoreFromFloat(w_new.data(), count, p_w_mixed_precision_news[group] + offset);
+          }
+        }
+      },
+      0);
+
+  if (step_tensor_new != nullptr) {
+    *step_tensor_new->template MutableData<int64_t>() = step + 1;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
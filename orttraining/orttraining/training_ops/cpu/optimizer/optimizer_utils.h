@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/float16.h"
+#include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// A contiguous range of elements of one updated weight tensor. Optimizer kernels split all the tensors
+// they update into chunks of at most chunk_size elements and process the chunks on the thread pool, so
+// many small tensors and a few large ones are spread across the threads in the same way.
+struct OptimizerChunk {
+  int group;
+  int64_t offset;
+  int64_t count;
+};
+
+inline std::vector<OptimizerChunk> SplitIntoChunks(const std::vector<int64_t>& tensor_sizes, int64_t chunk_size) {
+  std::vector<OptimizerChunk> chunks;
+  for (int group = 0; group < static_cast<int>(tensor_sizes.size()); ++group) {
+    for (int64_t offset = 0; offset < tensor_sizes[group]; offset += chunk_size) {
+      chunks.push_back({group, offset, std::min(chunk_size, tensor_sizes[group] - offset)});
+    }
+  }
+  return chunks;
+}
+
+// Returns count elements of data as floats. Float data is returned as is, other types are converted
+// into buffer.
+inline const float* LoadAsFloat(const float* data, int64_t /*count*/, std::vector<float>& /*buffer*/) {
+  return data;
+}
+
+inline const float* LoadAsFloat(const MLFloat16* data, int64_t count, std::vector<float>& buffer) {
+  buffer.resize(static_cast<size_t>(count));
+  MlasConvertHalfToFloatBuffer(reinterpret_cast<const unsigned short*>(data), buffer.data(), static_cast<size_t>(count));
+  return buffer.data();
+}
+
+// Returns where count float results for data are computed: data itself if it is float, otherwise
+// buffer, which StoreFromFloat converts into data afterwards.
+inline float* OutputAsFloat(float* data, int64_t /*count*/, std::vector<float>& /*buffer*/) {
+  return data;
+}
+
+inline float* OutputAsFloat(MLFloat16* /*data*/, int64_t count, std::vector<float>& buffer) {
+  buffer.resize(static_cast<size_t>(count));
+  return buffer.data();
+}
+
+inline void StoreFromFloat(const float* source, int64_t count, float* data) {
+  if (source != data) {
+    std::copy_n(source, count, data);
+  }
+}
+
+inline void StoreFromFloat(const float* source, int64_t count, MLFloat16* data) {
+  for (int64_t i = 0; i < count; ++i) {
+    data[i] = MLFloat16(source[i]);
+  }
+}
+
+template <typename T>
+void CopyIfNotSameBuffer(const Tensor& source_tensor, Tensor& target_tensor) {
+  const T* source = source_tensor.template Data<T>();
+  T* target = target_tensor.template MutableData<T>();
+  if (target != source) {
+    memcpy(target, source, source_tensor.SizeInBytes());
+  }
+}
+
+// Computes the number the scaled gradients are divided by before they are used. It is the loss scale,
+// or the one that clips the unscaled gradient norm to max_g_norm if that norm is larger.
+template <typename TLossScale, typename TGradNorm>
+float ComputeGradScale(const TLossScale* loss_scale, const TGradNorm* scaled_g_norm, float max_g_norm) {
+  const float scale = loss_scale != nullptr ? static_cast<float>(*loss_scale) : 1.f;
+  if (scaled_g_norm != nullptr && static_cast<float>(*scaled_g_norm) > scale * max_g_norm) {
+    return static_cast<float>(*scaled_g_norm) / max_g_norm;
+  }
+  return scale;
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -6,10 +6,20 @@
 #include "core/framework/op_kernel.h"
 #include "core/providers/common.h"
 #include "core/providers/cpu/math/element_wise_ops.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math_cpuonly.h"
+#include "orttraining/training_ops/cpu/optimizer/optimizer_utils.h"
 
 namespace onnxruntime {
 namespace contrib {
 
+namespace {
+
+// Number of elements of the weight tensor processed by one task.
+constexpr int64_t adam_chunk_size = 16384;
+
+}  // namespace
+
 template <typename T>
 Status SGDOptimizer<T>::Compute(OpKernelContext* ctx) const {
   const Tensor& ETA = *ctx->Input<Tensor>(0);
@@ -43,102 +53,164 @@ ONNX_OPERATOR_KERNEL_EX(
         .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     SGDOptimizer<float>);
 
-template <typename T>
-Status AdamOptimizer<T>::Compute(OpKernelContext* ctx) const {
+#define REGISTER_ADAM_KERNEL_TYPED(T1, T2, T3, T4, T_GRAD, T_GRAD_NORM, T_MIXED_PRECISION_FP)          \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                                       \
+      AdamOptimizer,                                                                                   \
+      kMSDomain,                                                                                       \
+      1,                                                                                               \
+      T1##_##T2##_##T3##_##T4##_##T_GRAD##_##T_GRAD_NORM##_##T_MIXED_PRECISION_FP,                     \
+      kCpuExecutionProvider,                                                                           \
+      KernelDefBuilder()                                                                               \
+          .Alias(1, 0) /* Update step count in-place */                                                \
+          .Alias(2, 3) /* Update weights in-place */                                                   \
+          .Alias(3, 4) /* Update gradients in-place */                                                 \
+          .Alias(4, 1) /* Update moment-1 in-place */                                                  \
+          .Alias(5, 2) /* Update moment-2 in-place */                                                  \
+          .Alias(6, 5) /* Update mixed_precision weights in-place */                                   \
+          .TypeConstraint("T1", DataTypeImpl::GetTensorType<T1>())                                     \
+          .TypeConstraint("T2", DataTypeImpl::GetTensorType<T2>())                                     \
+          .TypeConstraint("T3", DataTypeImpl::GetTensorType<T3>())                                     \
+          .TypeConstraint("T4", DataTypeImpl::GetTensorType<T4>())                                     \
+          .TypeConstraint("T_GRAD", DataTypeImpl::GetTensorType<T_GRAD>())                             \
+          .TypeConstraint("T_MIXED_PRECISION_FP", DataTypeImpl::GetTensorType<T_MIXED_PRECISION_FP>()) \
+          .TypeConstraint("T_GRAD_NORM", DataTypeImpl::GetTensorType<T_GRAD_NORM>()),                  \
+      AdamOptimizer<T1, T2, T3, T4, T_GRAD, T_GRAD_NORM, T_MIXED_PRECISION_FP>);
+
+// fp32 master weights and momentums, with fp32 or fp16 gradients.
+REGISTER_ADAM_KERNEL_TYPED(float, int64_t, float, float, float, float, MLFloat16)
+REGISTER_ADAM_KERNEL_TYPED(float, int64_t, float, float, MLFloat16, MLFloat16, MLFloat16)
+REGISTER_ADAM_KERNEL_TYPED(float, int64_t, float, float, MLFloat16, float, MLFloat16)
+
+template <typename T1, typename T2, typename T3, typename T4, typename T_GRAD, typename T_GRAD_NORM, typename T_MIXED_PRECISION_FP>
+Status AdamOptimizer<T1, T2, T3, T4, T_GRAD, T_GRAD_NORM, T_MIXED_PRECISION_FP>::Compute(OpKernelContext* ctx) const {
   const Tensor& ETA = *ctx->Input<Tensor>(0);
   const Tensor& S = *ctx->Input<Tensor>(1);
   const Tensor& W = *ctx->Input<Tensor>(2);
   const Tensor& G = *ctx->Input<Tensor>(3);
   const Tensor& M1 = *ctx->Input<Tensor>(4);
   const Tensor& M2 = *ctx->Input<Tensor>(5);
+  const Tensor* W_MIXED_FP = ctx->Input<Tensor>(6);
+  const Tensor* loss_scale_tensor = ctx->Input<Tensor>(7);
+  const Tensor* gradient_norm_tensor = ctx->Input<Tensor>(8);
+  const Tensor* do_update_tensor = ctx->Input<Tensor>(9);
 
   Tensor& NS = *ctx->Output(0, S.Shape());
   Tensor& NM1 = *ctx->Output(1, M1.Shape());
   Tensor& NM2 = *ctx->Output(2, M2.Shape());
   Tensor* NW = ctx->Output(3, W.Shape());
   Tensor* NG = ctx->Output(4, G.Shape());
+  Tensor* NW_MIXED_FP = W_MIXED_FP != nullptr ? ctx->Output(5, W_MIXED_FP->Shape()) : nullptr;
 
-  const float eta = *ETA.template Data<float>();
-  const int64_t step = *S.template Data<int64_t>();
-
-  // Update exponentially-averaged historical gradient
-  MakeEigenArrayMap<T>(NM1) = alpha_ * MakeEigenArrayMap<T>(M1) + ((1 - alpha_) * MakeEigenArrayMap<T>(G));
-
-  // Update exponentially-averaged historical squared gradient
-  MakeEigenArrayMap<T>(NM2) = beta_ * MakeEigenArrayMap<T>(M2) + ((1 - beta_) * MakeEigenArrayMap<T>(G) * MakeEigenArrayMap<T>(G));
-
-  const float alpha_correction = do_bias_correction_ ?
-    compute_bias_correction_coefficient(alpha_, step) : 1.f;
-  const float beta_correction = do_bias_correction_ ?
-    compute_bias_correction_coefficient(beta_, step) : 1.f;
-
-  // Currently two modes of Adamw are supported:
-  // Mode 0: Pytorch https://pytorch.org/docs/stable/_modules/torch/optim/adamw.html#AdamW,
-  //         bias correction is applied on m and v individually,
-  //         weight decay is applied before weight is updated.
-  // Mode 1: Huggingface https://huggingface.co/transformers/_modules/transformers/optimization.html#AdamW.,
-  //         bias correction is applied on learning rate,
-  //         weight decay is applied after weight is updated.
-  if(weight_decay_mode_ == 0) {
-    // Compute weight update.
-    const auto& denom = (MakeEigenArrayMap<T>(NM2) / beta_correction).sqrt() + epsilon_;
-    const auto& update = ( (MakeEigenArrayMap<T>(NM1) / alpha_correction) / denom) + (lambda_ * MakeEigenArrayMap<T>(W));
-    const auto& delta = -eta * update;
-
-    // Weight, gradient, and step update.
-    if (NG != nullptr) {
-      MakeEigenArrayMap<T>(*NG) = delta;
-    }
+  const T2* S_in = S.template Data<T2>();
+  T2* S_out = NS.template MutableData<T2>();
+
+  if (do_update_tensor != nullptr && !*do_update_tensor->template Data<bool>()) {
+    CopyIfNotSameBuffer<T4>(M1, NM1);
+    CopyIfNotSameBuffer<T4>(M2, NM2);
     if (NW != nullptr) {
-      MakeEigenArrayMap<T>(*NW) = MakeEigenArrayMap<T>(W) + delta;
+      CopyIfNotSameBuffer<T3>(W, *NW);
     }
-  }
-  else if (weight_decay_mode_ == 1) {
-    const auto& denom = MakeEigenArrayMap<T>(NM2).sqrt() + epsilon_;
-    const auto& step_size = eta * std::sqrt(beta_correction) / alpha_correction;
-
-    // Huggingface updates weights in the following logic:
-    // param' = param - step_size * m1o / denom
-    // param_out = param' - original_lr * lambda * param'
-    // then param_out = param - step_size * m1o / denom - original_lr * lambda * (param - step_size * m1o / denom)
-    // so delta = -step_size * m1o / denom - original_lr * lambda * (param - step_size * m1o / denom)
-    const auto& delta = -step_size * MakeEigenArrayMap<T>(NM1) / denom
-                        - eta * lambda_ * (MakeEigenArrayMap<T>(W) - step_size * MakeEigenArrayMap<T>(NM1) / denom);
-
-    // Weight, gradient, and step update.
     if (NG != nullptr) {
-      MakeEigenArrayMap<T>(*NG) = delta;
+      CopyIfNotSameBuffer<T_GRAD>(G, *NG);
     }
-    if (NW != nullptr) {
-      MakeEigenArrayMap<T>(*NW) = MakeEigenArrayMap<T>(W) + delta;
+    if (NW_MIXED_FP != nullptr) {
+      CopyIfNotSameBuffer<T_MIXED_PRECISION_FP>(*W_MIXED_FP, *NW_MIXED_FP);
     }
-  }
-  else {
-    // Shouldn't reach here
-    ORT_THROW("Unsupported Adamw optimizer mode.");
+    *S_out = *S_in;
+    return Status::OK();
   }
 
-  *NS.template MutableData<int64_t>() = step + 1;
+  const float eta = static_cast<float>(*ETA.template Data<T1>());
+  const T2 step = *S_in;
+
+  // Gradient scaling/clipping.
+  const float grad_scale = ComputeGradScale(
+      loss_scale_tensor != nullptr ? loss_scale_tensor->template Data<T3>() : nullptr,
+      gradient_norm_tensor != nullptr ? gradient_norm_tensor->template Data<T_GRAD_NORM>() : nullptr,
+      max_norm_clip_);
+
+  const float alpha_correction = do_bias_correction_ ? compute_bias_correction_coefficient(alpha_, step) : 1.f;
+  const float beta_correction = do_bias_correction_ ? compute_bias_correction_coefficient(beta_, step) : 1.f;
+
+  const T3* weights = W.template Data<T3>();
+  const T_GRAD* grads = G.template Data<T_GRAD>();
+  const T4* moment_1 = M1.template Data<T4>();
+  const T4* moment_2 = M2.template Data<T4>();
+  T4* moment_1_out = NM1.template MutableData<T4>();
+  T4* moment_2_out = NM2.template MutableData<T4>();
+  T3* weights_out = NW != nullptr ? NW->template MutableData<T3>() : nullptr;
+  T_GRAD* grads_out = NG != nullptr ? NG->template MutableData<T_GRAD>() : nullptr;
+  T_MIXED_PRECISION_FP* mixed_precision_weights_out =
+      NW_MIXED_FP != nullptr ? NW_MIXED_FP->template MutableData<T_MIXED_PRECISION_FP>() : nullptr;
+
+  const int64_t size = W.Shape().Size();
+  const int64_t task_count = (size + adam_chunk_size - 1) / adam_chunk_size;
+
+  concurrency::ThreadPool::TryBatchParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(task_count),
+      [&](std::ptrdiff_t task_idx) {
+        const int64_t offset = task_idx * adam_chunk_size;
+        const int64_t count = std::min(adam_chunk_size, size - offset);
+
+        std::vector<float> w_buffer, g_buffer, m1_buffer, m2_buffer, m1_new_buffer, m2_new_buffer, w_new_buffer;
+        std::vector<float> delta_buffer(static_cast<size_t>(count));
+        ConstEigenVectorArrayMap<float> w(LoadAsFloat(weights + offset, count, w_buffer), count);
+        ConstEigenVectorArrayMap<float> g(LoadAsFloat(grads + offset, count, g_buffer), count);
+        ConstEigenVectorArrayMap<float> m1(LoadAsFloat(moment_1 + offset, count, m1_buffer), count);
+        ConstEigenVectorArrayMap<float> m2(LoadAsFloat(moment_2 + offset, count, m2_buffer), count);
+        EigenVectorArrayMap<float> m1o(OutputAsFloat(moment_1_out + offset, count, m1_new_buffer), count);
+        EigenVectorArrayMap<float> m2o(OutputAsFloat(moment_2_out + offset, count, m2_new_buffer), count);
+        EigenVectorArrayMap<float> delta(delta_buffer.data(), count);
+
+        // Update exponentially-averaged historical gradient
+        m1o = alpha_ * m1 + (1 - alpha_) * (g / grad_scale);
+
+        // Update exponentially-averaged historical squared gradient
+        m2o = beta_ * m2 + (1 - beta_) * (g / grad_scale).square();
+
+        // Currently two modes of Adamw are supported:
+        // Mode 0: Pytorch https://pytorch.org/docs/stable/_modules/torch/optim/adamw.html#AdamW,
+        //         bias correction is applied on m and v individually,
+        //         weight decay is applied before weight is updated.
+        // Mode 1: Huggingface https://huggingface.co/transformers/_modules/transformers/optimization.html#AdamW.,
+        //         bias correction is applied on learning rate,
+        //         weight decay is applied after weight is updated.
+        if (weight_decay_mode_ == 0) {
+          // Compute weight update.
+          delta = -eta * ((m1o / alpha_correction) / ((m2o / beta_correction).sqrt() + epsilon_) + lambda_ * w);
+        } else {
+          const float step_size = eta * std::sqrt(beta_correction) / alpha_correction;
+
+          // Huggingface updates weights in the following logic:
+          // param' = param - step_size * m1o / denom
+          // param_out = param' - original_lr * lambda * param'
+          // then param_out = param - step_size * m1o / denom - original_lr * lambda * (param - step_size * m1o / denom)
+          // so delta = -step_size * m1o / denom - original_lr * lambda * (param - step_size * m1o / denom)
+          delta = step_size * m1o / (m2o.sqrt() + epsilon_);
+          delta = -delta - eta * lambda_ * (w - delta);
+        }
+
+        StoreFromFloat(m1o.data(), count, moment_1_out + offset);
+        StoreFromFloat(m2o.data(), count, moment_2_out + offset);
+
+        // Weight, gradient, and step update.
+        if (grads_out != nullptr) {
+          StoreFromFloat(delta.data(), count, grads_out + offset);
+        }
+        if (weights_out != nullptr) {
+          EigenVectorArrayMap<float> w_new(OutputAsFloat(weights_out + offset, count, w_new_buffer), count);
+          w_new = w + delta;
+          StoreFromFloat(w_new.data(), count, weights_out + offset);
+          if (mixed_precision_weights_out != nullptr) {
+            StoreFromFloat(w_new.data(), count, mixed_precision_weights_out + offset);
+          }
+        }
+      },
+      0);
+
+  *S_out = *S_in + 1;
   return Status::OK();
 }
 
-ONNX_OPERATOR_KERNEL_EX(
-    AdamOptimizer,
-    kMSDomain,
-    1,
-    kCpuExecutionProvider,
-    KernelDefBuilder()
-        .Alias(1, 0)  // Update step count in-place
-        .Alias(2, 3)  // Update weights in-place
-        .Alias(3, 4)  // Update gradients in-place
-        .Alias(4, 1)  // Update moment-1 in-place
-        .Alias(5, 2)  // Update moment-2 in-place
-        .Alias(6, 5)  // Update fp16 weights in-place
-        .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())
-        .TypeConstraint("T2", DataTypeImpl::GetTensorType<int64_t>())
-        .TypeConstraint("T3", DataTypeImpl::GetTensorType<float>())
-        .TypeConstraint("T4", DataTypeImpl::GetTensorType<float>())
-        .TypeConstraint("T_GRAD", DataTypeImpl::GetTensorType<float>()),
-    AdamOptimizer<float>);
 }  // namespace contrib
 }  // namespace onnxruntime
\ No newline at end of file
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include <memory>
+#include <sstream>
 #include "environment.h"
 #include "onnxruntime_cxx_api.h"
 
@@ -93,6 +94,42 @@ void ServerEnvironment::InitializeModel(const std::string& model_path, const std
     (iterator->second).output_names.push_back(name);
     allocator.Free(name);
   }
+
+  if (queue_options_.Enabled()) {
+    (iterator->second).batcher = std::make_unique<RequestBatcher>((iterator->second).session, queue_options_, severity_, (iterator->second).metrics);
+  }
+}
+
+RequestBatcher* ServerEnvironment::GetRequestBatcher(const std::string& model_name, const std::string& model_version) const {
+  auto identifier = std::make_pair(model_name, model_version);
+  auto it = sessions_.find(identifier);
+  if (it == sessions_.end()) {
+    throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
+  }
+
+  return it->second.batcher.get();
+}
+
+ModelMetrics& ServerEnvironment::GetModelMetrics(const std::string& model_name, const std::string& model_version) const {
+  auto identifier = std::make_pair(model_name, model_version);
+  auto it = sessions_.find(identifier);
+  if (it == sessions_.end()) {
+    throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
+  }
+
+  return it->second.metrics;
+}
+
+std::string ServerEnvironment::GetMetrics() const {
+  std::ostringstream out;
+  for (const auto& session : sessions_) {
+    session.second.metrics.Write(out, session.first.first, session.first.second);
+  }
+  return out.str();
+}
+
+void ServerEnvironment::SetRequestQueueOptions(const RequestQueueOptions& options) {
+  queue_options_ = options;
 }
 
 const std::vector<std::string>& ServerEnvironment::GetModelOutputNames(const std::string& model_name, const std::string& model_version) const {
@@ -7,6 +7,8 @@
 #include <vector>
 
 #include "onnxruntime_cxx_api.h"
+#include "metrics.h"
+#include "request_batcher.h"
 #include <spdlog/spdlog.h>
 #include <unordered_map>
 #include <boost/functional/hash.hpp>
@@ -25,6 +27,13 @@ class ServerEnvironment {
   const Ort::Session& GetSession(const std::string& model_name, const std::string& model_version) const;
   void InitializeModel(const std::string& model_path, const std::string& model_name, const std::string& model_version);
   const std::vector<std::string>& GetModelOutputNames(const std::string& model_name, const std::string& model_version) const;
+  // Returns the request queue of the model, or nullptr if requests are run directly on the calling thread.
+  RequestBatcher* GetRequestBatcher(const std::string& model_name, const std::string& model_version) const;
+  ModelMetrics& GetModelMetrics(const std::string& model_name, const std::string& model_version) const;
+  // Returns the metrics of all loaded models in the Prometheus text format.
+  std::string GetMetrics() const;
+  // Sets the request queue options for the models initialized afterwards.
+  void SetRequestQueueOptions(const RequestQueueOptions& options);
   std::shared_ptr<spdlog::logger> GetLogger(const std::string& request_id) const;
   std::shared_ptr<spdlog::logger> GetAppLogger() const;
   void UnloadModel(const std::string& model_name, const std::string& model_version);
@@ -38,10 +47,14 @@ class ServerEnvironment {
 
   Ort::Env runtime_environment_;
   Ort::SessionOptions options_;
+  RequestQueueOptions queue_options_;
 
   struct SessionHolder {
     Ort::Session session;
     std::vector<std::string> output_names;
+    mutable ModelMetrics metrics;
+    // Declared last so the worker threads stop before the session is released.
+    std::unique_ptr<RequestBatcher> batcher;
     explicit SessionHolder(Ort::Env& env, std::string path, const Ort::SessionOptions& options) : session(nullptr) {
       session = Ort::Session(env, path.c_str(), options);
     };
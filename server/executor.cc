@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include <stdio.h>
+#include <chrono>
 #include "serializing/mem_buffer.h"
 #include "serializing/tensorprotoutils.h"
 
@@ -101,8 +102,6 @@ protobufutil::Status Executor::Predict(const std::string& model_name,
                                        const std::string& model_version,
                                        const onnxruntime::server::PredictRequest& request,
                                        /* out */ onnxruntime::server::PredictResponse& response) {
-  auto logger = env_->GetLogger(request_id_);
-
   // Convert PredictRequest to NameMLValMap
   MemBufferArray buffer_array;
   std::vector<std::string> input_names;
@@ -112,30 +111,27 @@ protobufutil::Status Executor::Predict(const std::string& model_name,
     return conversion_status;
   }
 
-  Ort::RunOptions run_options{};
-  run_options.SetRunLogVerbosityLevel(static_cast<int>(env_->GetLogSeverity()));
-  run_options.SetRunTag(request_id_.c_str());
-
   // Prepare the output names
   std::vector<std::string> output_names;
-
-  if (!request.output_filter().empty()) {
-    output_names.reserve(request.output_filter_size());
-    for (const auto& name : request.output_filter()) {
-      output_names.push_back(name);
-    }
-  } else {
-    output_names = env_->GetModelOutputNames(model_name, model_version);
+  output_names.reserve(request.output_filter_size());
+  for (const auto& name : request.output_filter()) {
+    output_names.push_back(name);
   }
 
   std::vector<Ort::Value> outputs;
-  try {
-    outputs = Run(env_->GetSession(model_name, model_version), run_options, input_names, input_values, output_names);
-  } catch (const Ort::Exception& e) {
-    return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
+  auto run_status = Predict(model_name, model_version, input_names, input_values, output_names, outputs);
+  if (run_status != protobufutil::Status::OK) {
+    return run_status;
   }
 
-  // Build the response
+  return GenerateResponse(output_names, outputs, response);
+}
+
+protobufutil::Status Executor::GenerateResponse(const std::vector<std::string>& output_names,
+                                                std::vector<Ort::Value>& outputs,
+                                                /* out */ onnxruntime::server::PredictResponse& response) {
+  auto logger = env_->GetLogger(request_id_);
+
   for (size_t i = 0, sz = outputs.size(); i < sz; ++i) {
     onnx::TensorProto output_tensor{};
     try {
@@ -157,5 +153,38 @@ protobufutil::Status Executor::Predict(const std::string& model_name,
   return protobufutil::Status::OK;
 }
 
+protobufutil::Status Executor::Predict(const std::string& model_name,
+                                       const std::string& model_version,
+                                       const std::vector<std::string>& input_names,
+                                       const std::vector<Ort::Value>& input_values,
+                                       /* in, out */ std::vector<std::string>& output_names,
+                                       /* out */ std::vector<Ort::Value>& outputs) {
+  Ort::RunOptions run_options{};
+  run_options.SetRunLogVerbosityLevel(static_cast<int>(env_->GetLogSeverity()));
+  run_options.SetRunTag(request_id_.c_str());
+
+  try {
+    if (output_names.empty()) {
+      output_names = env_->GetModelOutputNames(model_name, model_version);
+    }
+
+    // Requests are merged with other requests for the model when a request queue is configured
+    auto* batcher = env_->GetRequestBatcher(model_name, model_version);
+    if (batcher != nullptr) {
+      return batcher->Run(request_id_, input_names, input_values, output_names, outputs);
+    }
+
+    auto& metrics = env_->GetModelMetrics(model_name, model_version);
+    auto start = std::chrono::steady_clock::now();
+    outputs = Run(env_->GetSession(model_name, model_version), run_options, input_names, input_values, output_names);
+    metrics.requests++;
+    metrics.compute_latency.Observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+  } catch (const Ort::Exception& e) {
+    return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
+  }
+
+  return protobufutil::Status::OK;
+}
+
 }  // namespace server
 }  // namespace onnxruntime
@@ -25,6 +25,20 @@ class Executor {
                                          const onnxruntime::server::PredictRequest& request,
                                          /* out */ onnxruntime::server::PredictResponse& response);
 
+  // Prediction method for inputs that are already Ort::Value tensors, such as requests in the
+  // binary tensor format. All model outputs are returned if output_names is empty.
+  google::protobuf::util::Status Predict(const std::string& model_name,
+                                         const std::string& model_version,
+                                         const std::vector<std::string>& input_names,
+                                         const std::vector<Ort::Value>& input_values,
+                                         /* in, out */ std::vector<std::string>& output_names,
+                                         /* out */ std::vector<Ort::Value>& outputs);
+
+  // Converts the outputs of a prediction to a PredictResponse.
+  google::protobuf::util::Status GenerateResponse(const std::vector<std::string>& output_names,
+                                                  std::vector<Ort::Value>& outputs,
+                                                  /* out */ onnxruntime::server::PredictResponse& response);
+
  private:
   ServerEnvironment* env_;
   const std::string request_id_;
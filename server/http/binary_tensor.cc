@@ -0,0 +1,218 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cstring>
+#include <limits>
+
+#include "binary_tensor.h"
+#include "../util.h"
+
+namespace onnxruntime {
+namespace server {
+
+namespace protobufutil = google::protobuf::util;
+
+namespace {
+
+constexpr char kMagic[4] = {'O', 'R', 'T', 'B'};
+constexpr uint32_t kVersion = 1;
+constexpr size_t kDataAlignment = 8;
+
+// Bounds checked sequential reader over the request payload.
+class PayloadReader {
+ public:
+  explicit PayloadReader(std::string& payload) : payload_(payload), offset_(0) {}
+
+  template <typename T>
+  bool Read(T& value) {
+    if (payload_.size() - offset_ < sizeof(T)) {
+      return false;
+    }
+    memcpy(&value, payload_.data() + offset_, sizeof(T));
+    offset_ += sizeof(T);
+    return true;
+  }
+
+  bool ReadString(std::string& value) {
+    uint32_t length;
+    if (!Read(length) || payload_.size() - offset_ < length) {
+      return false;
+    }
+    value.assign(payload_.data() + offset_, length);
+    offset_ += length;
+    return true;
+  }
+
+  // Skips the padding and returns a pointer to the next length bytes of the payload.
+  char* ReadAlignedData(uint64_t length) {
+    size_t aligned_offset = (offset_ + kDataAlignment - 1) & ~(kDataAlignment - 1);
+    if (aligned_offset > payload_.size() || payload_.size() - aligned_offset < length) {
+      return nullptr;
+    }
+    offset_ = aligned_offset + static_cast<size_t>(length);
+    return &payload_[aligned_offset];
+  }
+
+  size_t Remaining() const { return payload_.size() - offset_; }
+
+  bool AtEnd() const { return offset_ == payload_.size(); }
+
+ private:
+  std::string& payload_;
+  size_t offset_;
+};
+
+template <typename T>
+void Append(std::string& payload, const T& value) {
+  payload.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void AppendString(std::string& payload, const std::string& value) {
+  Append(payload, static_cast<uint32_t>(value.size()));
+  payload.append(value);
+}
+
+protobufutil::Status InvalidPayload(const std::string& message) {
+  return protobufutil::Status(protobufutil::error::Code::INVALID_ARGUMENT, "Invalid binary tensor payload: " + message);
+}
+
+}  // namespace
+
+protobufutil::Status DecodeBinaryTensorRequest(std::string& payload,
+                                               std::vector<std::string>& input_names,
+                                               std::vector<Ort::Value>& input_values,
+                                               std::vector<std::string>& output_filter) {
+  static const Ort::MemoryInfo cpu_memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+
+  if (reinterpret_cast<uintptr_t>(payload.data()) % kDataAlignment != 0) {
+    return protobufutil::Status(protobufutil::error::Code::INTERNAL, "Binary tensor payload is not aligned");
+  }
+
+  PayloadReader reader(payload);
+  char magic[4];
+  uint32_t version;
+  uint32_t tensor_count;
+  uint32_t output_filter_count;
+  if (!reader.Read(magic) || memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+    return InvalidPayload("bad magic");
+  }
+  if (!reader.Read(version) || version != kVersion) {
+    return InvalidPayload("unsupported version");
+  }
+  if (!reader.Read(tensor_count) || !reader.Read(output_filter_count)) {
+    return InvalidPayload("truncated header");
+  }
+
+  for (uint32_t i = 0; i < output_filter_count; ++i) {
+    std::string name;
+    if (!reader.ReadString(name)) {
+      return InvalidPayload("truncated output filter");
+    }
+    output_filter.push_back(std::move(name));
+  }
+
+  input_names.reserve(tensor_count);
+  input_values.reserve(tensor_count);
+  for (uint32_t i = 0; i < tensor_count; ++i) {
+    std::string name;
+    int32_t data_type;
+    uint32_t rank;
+    if (!reader.ReadString(name) || !reader.Read(data_type) || !reader.Read(rank)) {
+      return InvalidPayload("truncated tensor header");
+    }
+
+    // The rank comes from the client, so check that the dims are present before allocating them.
+    if (rank > reader.Remaining() / sizeof(int64_t)) {
+      return InvalidPayload("truncated dims for input '" + name + "'");
+    }
+
+    auto element_type = static_cast<ONNXTensorElementDataType>(data_type);
+    size_t element_size = GetTensorElementSize(element_type);
+    if (element_size == 0) {
+      return InvalidPayload("unsupported data type for input '" + name + "'");
+    }
+
+    // Accumulates the data length in bytes, which can be no larger than the payload for a valid request.
+    std::vector<int64_t> dims(rank);
+    uint64_t expected_length = element_size;
+    for (auto& dim : dims) {
+      if (!reader.Read(dim) || dim < 0) {
+        return InvalidPayload("invalid dims for input '" + name + "'");
+      }
+      if (dim != 0 && expected_length > std::numeric_limits<uint64_t>::max() / static_cast<uint64_t>(dim)) {
+        return InvalidPayload("dims of input '" + name + "' are too large");
+      }
+      expected_length *= static_cast<uint64_t>(dim);
+    }
+
+    uint64_t data_length;
+    if (!reader.Read(data_length) || data_length != expected_length) {
+      return InvalidPayload("data length does not match the dims for input '" + name + "'");
+    }
+
+    char* data = reader.ReadAlignedData(data_length);
+    if (data == nullptr) {
+      return InvalidPayload("truncated data for input '" + name + "'");
+    }
+
+    // The tensor uses the payload memory directly.
+    try {
+      input_values.push_back(Ort::Value::CreateTensor(cpu_memory_info, data, static_cast<size_t>(data_length),
+                                                      dims.data(), dims.size(), element_type));
+    } catch (const Ort::Exception& e) {
+      return protobufutil::Status(protobufutil::error::Code::INVALID_ARGUMENT, e.what());
+    }
+    input_names.push_back(std::move(name));
+  }
+
+  if (!reader.AtEnd()) {
+    return InvalidPayload("unexpected trailing data");
+  }
+
+  return protobufutil::Status::OK;
+}
+
+protobufutil::Status EncodeBinaryTensorResponse(const std::vector<std::string>& output_names,
+                                                std::vector<Ort::Value>& output_values,
+                                                std::string& payload) {
+  payload.clear();
+  payload.append(kMagic, sizeof(kMagic));
+  Append(payload, kVersion);
+  Append(payload, static_cast<uint32_t>(output_values.size()));
+  Append(payload, static_cast<uint32_t>(0));
+
+  for (size_t i = 0; i < output_values.size(); ++i) {
+    auto& value = output_values[i];
+    if (!value.IsTensor()) {
+      return protobufutil::Status(protobufutil::error::Code::UNIMPLEMENTED,
+                                  "Output '" + output_names[i] + "' is not a tensor");
+    }
+
+    auto info = value.GetTensorTypeAndShapeInfo();
+    auto element_type = info.GetElementType();
+    size_t element_size = GetTensorElementSize(element_type);
+    if (element_size == 0) {
+      return protobufutil::Status(protobufutil::error::Code::UNIMPLEMENTED,
+                                  "Output '" + output_names[i] + "' has a data type that is not supported by " +
+                                      kBinaryTensorContentType);
+    }
+
+    auto dims = info.GetShape();
+    uint64_t data_length = static_cast<uint64_t>(info.GetElementCount()) * element_size;
+
+    AppendString(payload, output_names[i]);
+    Append(payload, static_cast<int32_t>(element_type));
+    Append(payload, static_cast<uint32_t>(dims.size()));
+    for (auto dim : dims) {
+      Append(payload, dim);
+    }
+    Append(payload, data_length);
+    payload.append((kDataAlignment - payload.size() % kDataAlignment) % kDataAlignment, '\0');
+    payload.append(value.GetTensorMutableData<char>(), static_cast<size_t>(data_length));
+  }
+
+  return protobufutil::Status::OK;
+}
+
+}  // namespace server
+}  // namespace onnxruntime
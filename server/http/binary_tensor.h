@@ -0,0 +1,46 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <google/protobuf/stubs/status.h>
+
+#include "onnxruntime_cxx_api.h"
+
+namespace onnxruntime {
+namespace server {
+
+// Content type of the binary tensor format.
+constexpr const char* kBinaryTensorContentType = "application/x-onnxruntime-tensor";
+
+// The binary tensor format carries numeric tensors as raw little endian data, so that a request
+// can be mapped onto Ort::Value tensors without parsing or copying the tensor data:
+//
+//   header:        char magic[4] = "ORTB", uint32 version, uint32 tensor_count, uint32 output_filter_count
+//   output filter: output_filter_count x (uint32 name_length, char name[name_length])
+//   tensors:       tensor_count x (uint32 name_length, char name[name_length],
+//                                  int32 data_type, uint32 rank, int64 dims[rank], uint64 data_length,
+//                                  zero padding to a multiple of 8 bytes from the start of the payload,
+//                                  data[data_length])
+//
+// data_type is an onnx::TensorProto_DataType value. String tensors are not supported. Responses use
+// the same layout with an empty output filter. Large requests can be streamed with chunked transfer
+// encoding, as the payload is only decoded once the body is complete.
+
+// Decodes a request in the binary tensor format. The returned tensors point into the payload, which
+// must outlive them and must start at an 8 byte aligned address.
+google::protobuf::util::Status DecodeBinaryTensorRequest(std::string& payload,
+                                                         /* out */ std::vector<std::string>& input_names,
+                                                         /* out */ std::vector<Ort::Value>& input_values,
+                                                         /* out */ std::vector<std::string>& output_filter);
+
+// Encodes the outputs of a prediction in the binary tensor format.
+google::protobuf::util::Status EncodeBinaryTensorResponse(const std::vector<std::string>& output_names,
+                                                          std::vector<Ort::Value>& output_values,
+                                                          /* out */ std::string& payload);
+
+}  // namespace server
+}  // namespace onnxruntime
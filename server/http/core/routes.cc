@@ -62,7 +62,13 @@ http::status Routes::ParseUrl(http::verb method,
 
   bool found_match = false;
   for (const auto& pattern : func_table) {
-    if (re2::RE2::FullMatch(url, pattern.first, &model_name, &model_version, &action)) {
+    // A pattern either captures the model name, version and action or, for routes that are not about a model,
+    // captures nothing.
+    re2::RE2 regex(pattern.first);
+    bool matched = regex.NumberOfCapturingGroups() == 0
+                       ? re2::RE2::FullMatch(url, regex)
+                       : re2::RE2::FullMatch(url, regex, &model_name, &model_version, &action);
+    if (matched) {
       func = pattern.second;
 
       found_match = true;
@@ -17,6 +17,7 @@ using ErrorFn = std::function<void(HttpContext&)>;
 
 // This class maintains two lists of regex -> function lists. One for POST requests and one for GET requests
 // If the incoming URL could match more than one regex, the first one will win.
+// A regex either has three capture groups, for the model name, version and action, or none.
 class Routes {
  public:
   Routes() = default;
@@ -17,6 +17,11 @@ HttpSession::HttpSession(const Routes& routes, tcp::socket socket)
 void HttpSession::DoRead() {
   req_.emplace();
 
+  // Hand the buffer of the previous request to the parser. The parser appends
+  // the body, including chunked bodies, into the existing capacity.
+  body_buffer_.clear();
+  req_->get().body() = std::move(body_buffer_);
+
   // TODO: make the max request size configable.
   req_->body_limit(25 * 1024 * 1024);  // Max request size: 25 MiB
 
@@ -109,6 +114,10 @@ void HttpSession::HandleRequest(http::request<Body, http::basic_fields<Allocator
 
   context.response.keep_alive(context.request.keep_alive());
   context.response.prepare_payload();
+
+  // Keep the request body storage for the next request on this connection
+  body_buffer_ = std::move(context.request.body());
+
   return Send(std::move(context.response));
 }
 
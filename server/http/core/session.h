@@ -40,6 +40,10 @@ class HttpSession : public std::enable_shared_from_this<HttpSession> {
   net::strand<net::io_context::executor_type> strand_;
   beast::flat_buffer buffer_;
   boost::optional<http::request_parser<http::string_body>> req_;
+
+  // Request body storage that is reused across the requests of this connection,
+  // so that large payloads do not need a new allocation for every request
+  std::string body_buffer_;
   std::shared_ptr<void> res_{nullptr};
 
   // Writes the message asynchronously back to the socket
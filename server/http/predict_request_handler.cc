@@ -3,6 +3,7 @@
 
 #include <google/protobuf/stubs/status.h>
 
+#include "binary_tensor.h"
 #include "environment.h"
 #include "http_server.h"
 #include "json_handling.h"
@@ -53,30 +54,71 @@ void Predict(const std::string& name,
     GenerateErrorResponse(logger, http::status::bad_request, "Unknown 'Accept' header field in the request", context);
   }
 
-  // Deserialize the payload
-  auto body = context.request.body();
-  PredictRequest predict_request{};
-  http::status error_code;
-  std::string error_message;
-  bool parse_succeeded = ParseRequestPayload(context, request_type, predict_request, error_code, error_message);
-  if (!parse_succeeded) {
-    GenerateErrorResponse(logger, error_code, error_message, context);
-    return;
+  // Binary tensor requests are answered in the same format unless another format is requested
+  if (request_type == SupportedContentType::BinaryTensor && context.request.find("Accept") == context.request.end()) {
+    response_type = SupportedContentType::BinaryTensor;
   }
 
-  // Run Prediction
   Executor executor(env.get(), context.request_id);
   PredictResponse predict_response{};
-  auto status = executor.Predict(effective_name, effective_version, predict_request, predict_response);
-  if (!status.ok()) {
-    GenerateErrorResponse(logger, GetHttpStatusCode((status)), status.error_message(), context);
-    return;
+  std::string response_body{};
+
+  if (request_type == SupportedContentType::BinaryTensor) {
+    // The input tensors point into the request body, so it must not be modified until the run completes
+    std::vector<std::string> input_names;
+    std::vector<Ort::Value> input_values;
+    std::vector<std::string> output_names;
+    auto status = DecodeBinaryTensorRequest(context.request.body(), input_names, input_values, output_names);
+    if (!status.ok()) {
+      GenerateErrorResponse(logger, GetHttpStatusCode(status), status.error_message(), context);
+      return;
+    }
+
+    std::vector<Ort::Value> outputs;
+    status = executor.Predict(effective_name, effective_version, input_names, input_values, output_names, outputs);
+    if (!status.ok()) {
+      GenerateErrorResponse(logger, GetHttpStatusCode((status)), status.error_message(), context);
+      return;
+    }
+
+    if (response_type == SupportedContentType::BinaryTensor) {
+      status = EncodeBinaryTensorResponse(output_names, outputs, response_body);
+    } else {
+      status = executor.GenerateResponse(output_names, outputs, predict_response);
+    }
+    if (!status.ok()) {
+      GenerateErrorResponse(logger, GetHttpStatusCode(status), status.error_message(), context);
+      return;
+    }
+  } else {
+    if (response_type == SupportedContentType::BinaryTensor) {
+      GenerateErrorResponse(logger, http::status::bad_request, "Binary tensor responses require a binary tensor request", context);
+      return;
+    }
+
+    // Deserialize the payload
+    PredictRequest predict_request{};
+    http::status error_code;
+    std::string error_message;
+    bool parse_succeeded = ParseRequestPayload(context, request_type, predict_request, error_code, error_message);
+    if (!parse_succeeded) {
+      GenerateErrorResponse(logger, error_code, error_message, context);
+      return;
+    }
+
+    // Run Prediction
+    auto status = executor.Predict(effective_name, effective_version, predict_request, predict_response);
+    if (!status.ok()) {
+      GenerateErrorResponse(logger, GetHttpStatusCode((status)), status.error_message(), context);
+      return;
+    }
   }
 
   // Serialize to proper output format
-  std::string response_body{};
-  if (response_type == SupportedContentType::Json) {
-    status = GenerateResponseInJson(predict_response, response_body);
+  if (response_type == SupportedContentType::BinaryTensor) {
+    context.response.set(http::field::content_type, kBinaryTensorContentType);
+  } else if (response_type == SupportedContentType::Json) {
+    auto status = GenerateResponseInJson(predict_response, response_body);
     if (!status.ok()) {
       GenerateErrorResponse(logger, http::status::internal_server_error, status.error_message(), context);
       return;
@@ -96,12 +138,12 @@ void Predict(const std::string& name,
   if (!context.client_request_id.empty()) {
     context.response.insert(util::MS_CLIENT_REQUEST_ID_HEADER, context.client_request_id);
   }
-  context.response.body() = response_body;
+  context.response.body() = std::move(response_body);
   context.response.result(http::status::ok);
 };
 
 static bool ParseRequestPayload(const HttpContext& context, SupportedContentType request_type, PredictRequest& predictRequest, http::status& error_code, std::string& error_message) {
-  auto body = context.request.body();
+  const auto& body = context.request.body();
   protobufutil::Status status;
   switch (request_type) {
     case SupportedContentType::Json: {
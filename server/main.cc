@@ -64,6 +64,13 @@ int main(int argc, char* argv[]) {
   logger->info("Model name: {}", config.model_name);
   logger->info("Model version: {}", config.model_version);
 
+  server::RequestQueueOptions queue_options{};
+  queue_options.max_batch_size = config.max_batch_size;
+  queue_options.max_queue_delay_us = config.max_queue_delay_us;
+  queue_options.max_concurrent_runs = config.max_concurrent_runs;
+  queue_options.max_queue_size = config.max_queue_size;
+  env->SetRequestQueueOptions(queue_options);
+
   try {
     env->InitializeModel(config.model_path, config.model_name, config.model_version);
     logger->debug("Initialize Model Successfully!");
@@ -118,6 +125,14 @@ int main(int argc, char* argv[]) {
       }
   );
 
+  app.RegisterGet(
+      "/metrics",
+      [&env](const auto& /*name*/, const auto& /*version*/, const auto& /*action*/, auto& context) -> void {
+        context.response.result(http::status::ok);
+        context.response.set(http::field::content_type, "text/plain; version=0.0.4");
+        context.response.body() = env->GetMetrics();
+      });
+
   app.Bind(boost_address, config.http_port)
       .NumThreads(config.num_http_threads)
       .Run();
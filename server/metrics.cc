@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+
+#include "metrics.h"
+
+namespace onnxruntime {
+namespace server {
+
+Histogram::Histogram(std::vector<double> bounds) : bounds_(std::move(bounds)), counts_(bounds_.size() + 1, 0) {}
+
+void Histogram::Observe(double value) {
+  auto bucket = std::lower_bound(bounds_.begin(), bounds_.end(), value) - bounds_.begin();
+  std::lock_guard<std::mutex> lock(mutex_);
+  counts_[bucket]++;
+  count_++;
+  sum_ += value;
+}
+
+void Histogram::Write(std::ostream& out, const std::string& name, const std::string& labels) const {
+  const std::string separator = labels.empty() ? "" : ",";
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  uint64_t cumulative = 0;
+  for (size_t i = 0; i < bounds_.size(); ++i) {
+    cumulative += counts_[i];
+    out << name << "_bucket{" << labels << separator << "le=\"" << bounds_[i] << "\"} " << cumulative << "\n";
+  }
+  out << name << "_bucket{" << labels << separator << "le=\"+Inf\"} " << count_ << "\n";
+  out << name << "_sum{" << labels << "} " << sum_ << "\n";
+  out << name << "_count{" << labels << "} " << count_ << "\n";
+}
+
+ModelMetrics::ModelMetrics()
+    : batch_size({1, 2, 4, 8, 16, 32, 64, 128, 256}),
+      queue_latency({0.0001, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1}),
+      compute_latency({0.0001, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5}) {}
+
+void ModelMetrics::Write(std::ostream& out, const std::string& model_name, const std::string& model_version) const {
+  const std::string labels = "model=\"" + model_name + "\",version=\"" + model_version + "\"";
+
+  out << "onnxruntime_server_queue_depth{" << labels << "} " << queue_depth.load() << "\n";
+  out << "onnxruntime_server_requests_total{" << labels << "} " << requests.load() << "\n";
+  out << "onnxruntime_server_rejected_requests_total{" << labels << "} " << rejected_requests.load() << "\n";
+  out << "onnxruntime_server_batches_total{" << labels << "} " << batches.load() << "\n";
+  batch_size.Write(out, "onnxruntime_server_batch_size", labels);
+  queue_latency.Write(out, "onnxruntime_server_queue_latency_seconds", labels);
+  compute_latency.Write(out, "onnxruntime_server_compute_latency_seconds", labels);
+}
+
+}  // namespace server
+}  // namespace onnxruntime
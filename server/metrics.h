@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace onnxruntime {
+namespace server {
+
+// A cumulative histogram with fixed bucket upper bounds, written in the Prometheus text format.
+class Histogram {
+ public:
+  explicit Histogram(std::vector<double> bounds);
+
+  void Observe(double value);
+
+  // Writes the <name>_bucket, <name>_sum and <name>_count series. labels is a comma separated
+  // list of label pairs without braces, which may be empty.
+  void Write(std::ostream& out, const std::string& name, const std::string& labels) const;
+
+ private:
+  const std::vector<double> bounds_;
+  mutable std::mutex mutex_;
+  std::vector<uint64_t> counts_;
+  uint64_t count_ = 0;
+  double sum_ = 0;
+};
+
+// Request queue and execution statistics of a single model.
+struct ModelMetrics {
+  ModelMetrics();
+
+  std::atomic<int64_t> queue_depth{0};
+  std::atomic<uint64_t> requests{0};
+  std::atomic<uint64_t> rejected_requests{0};
+  std::atomic<uint64_t> batches{0};
+
+  // Number of rows (the size of dimension 0) in each batch taken from the request queue.
+  Histogram batch_size;
+  // Seconds a request waited in the request queue before its batch started running.
+  Histogram queue_latency;
+  // Seconds spent in each Run call.
+  Histogram compute_latency;
+
+  void Write(std::ostream& out, const std::string& model_name, const std::string& model_version) const;
+};
+
+}  // namespace server
+}  // namespace onnxruntime
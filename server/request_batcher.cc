@@ -0,0 +1,438 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <numeric>
+#include <sstream>
+
+#include "request_batcher.h"
+#include "util.h"
+
+namespace onnxruntime {
+namespace server {
+
+namespace protobufutil = google::protobuf::util;
+
+struct RequestBatcher::Request {
+  Request(const std::string& request_id,
+          const std::vector<std::string>& input_names,
+          const std::vector<Ort::Value>& input_values,
+          const std::vector<std::string>& output_names,
+          std::vector<Ort::Value>& outputs)
+      : request_id(request_id), input_names(input_names), input_values(input_values), output_names(output_names), outputs(outputs) {}
+
+  // Fills in the input order, signature and rows if the request can be merged with others.
+  void SetBatchSignature();
+
+  const std::string& request_id;
+  const std::vector<std::string>& input_names;
+  const std::vector<Ort::Value>& input_values;
+  const std::vector<std::string>& output_names;
+  std::vector<Ort::Value>& outputs;
+
+  // Indices of the inputs ordered by name, so that requests listing the inputs in a different order can be merged.
+  std::vector<size_t> input_order;
+  // Requests with the same non-empty signature can be merged. Empty if the request is run on its own.
+  std::string signature;
+  int64_t rows = 1;
+  std::chrono::steady_clock::time_point enqueue_time;
+  std::promise<protobufutil::Status> done;
+};
+
+namespace {
+
+bool HasDynamicBatchDimension(const Ort::TypeInfo& type_info) {
+  if (type_info.GetONNXType() != ONNX_TYPE_TENSOR) {
+    return false;
+  }
+
+  auto shape = type_info.GetTensorTypeAndShapeInfo().GetShape();
+  return !shape.empty() && shape[0] < 0;
+}
+
+}  // namespace
+
+RequestBatcher::RequestBatcher(const Ort::Session& session, const RequestQueueOptions& options,
+                               OrtLoggingLevel severity, ModelMetrics& metrics)
+    : session_(const_cast<Ort::Session&>(session)),
+      options_(options),
+      severity_(severity),
+      metrics_(metrics),
+      model_supports_batching_(options.max_batch_size > 1) {
+  for (size_t i = 0, count = session_.GetInputCount(); i < count && model_supports_batching_; ++i) {
+    model_supports_batching_ = HasDynamicBatchDimension(session_.GetInputTypeInfo(i));
+  }
+  for (size_t i = 0, count = session_.GetOutputCount(); i < count && model_supports_batching_; ++i) {
+    model_supports_batching_ = HasDynamicBatchDimension(session_.GetOutputTypeInfo(i));
+  }
+
+  auto worker_count = std::max(options_.max_concurrent_runs, 1);
+  workers_.reserve(worker_count);
+  for (int i = 0; i < worker_count; ++i) {
+    workers_.emplace_back([this] { WorkerLoop(); });
+  }
+}
+
+RequestBatcher::~RequestBatcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  queue_changed_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+
+  for (auto* request : queue_) {
+    request->done.set_value(protobufutil::Status(protobufutil::error::Code::UNAVAILABLE, "The model is being unloaded"));
+  }
+}
+
+protobufutil::Status RequestBatcher::Run(const std::string& request_id,
+                                         const std::vector<std::string>& input_names,
+                                         const std::vector<Ort::Value>& input_values,
+                                         const std::vector<std::string>& output_names,
+                                         /* out */ std::vector<Ort::Value>& outputs) {
+  Request request(request_id, input_names, input_values, output_names, outputs);
+  if (model_supports_batching_) {
+    request.SetBatchSignature();
+  }
+  auto result = request.done.get_future();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (shutdown_) {
+      return protobufutil::Status(protobufutil::error::Code::UNAVAILABLE, "The model is being unloaded");
+    }
+    if (options_.max_queue_size > 0 && queue_.size() >= static_cast<size_t>(options_.max_queue_size)) {
+      metrics_.rejected_requests++;
+      return protobufutil::Status(protobufutil::error::Code::UNAVAILABLE, "The request queue is full");
+    }
+
+    request.enqueue_time = std::chrono::steady_clock::now();
+    queue_.push_back(&request);
+    metrics_.queue_depth++;
+    metrics_.requests++;
+  }
+  queue_changed_.notify_all();
+
+  return result.get();
+}
+
+void RequestBatcher::WorkerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!shutdown_) {
+    if (queue_.empty()) {
+      queue_changed_.wait(lock);
+      continue;
+    }
+
+    if (!BatchReady(std::chrono::steady_clock::now())) {
+      queue_changed_.wait_until(lock, queue_.front()->enqueue_time + std::chrono::microseconds(options_.max_queue_delay_us));
+      continue;
+    }
+
+    auto batch = TakeBatch();
+    lock.unlock();
+    RunBatch(batch);
+    lock.lock();
+  }
+}
+
+bool RequestBatcher::BatchReady(std::chrono::steady_clock::time_point now) const {
+  const auto* front = queue_.front();
+  if (front->signature.empty() || now >= front->enqueue_time + std::chrono::microseconds(options_.max_queue_delay_us)) {
+    return true;
+  }
+
+  int64_t rows = 0;
+  for (const auto* request : queue_) {
+    if (request->signature == front->signature) {
+      rows += request->rows;
+      if (rows >= options_.max_batch_size) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+std::vector<RequestBatcher::Request*> RequestBatcher::TakeBatch() {
+  std::vector<Request*> batch{queue_.front()};
+  queue_.pop_front();
+
+  const auto* front = batch[0];
+  if (!front->signature.empty()) {
+    int64_t rows = front->rows;
+    for (auto it = queue_.begin(); it != queue_.end() && rows < options_.max_batch_size;) {
+      if ((*it)->signature == front->signature && rows + (*it)->rows <= options_.max_batch_size) {
+        rows += (*it)->rows;
+        batch.push_back(*it);
+        it = queue_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  metrics_.queue_depth -= static_cast<int64_t>(batch.size());
+  auto now = std::chrono::steady_clock::now();
+  for (const auto* request : batch) {
+    metrics_.queue_latency.Observe(std::chrono::duration<double>(now - request->enqueue_time).count());
+  }
+
+  return batch;
+}
+
+void RequestBatcher::RunBatch(std::vector<Request*>& batch) {
+  int64_t rows = 0;
+  for (const auto* request : batch) {
+    rows += request->rows;
+  }
+  metrics_.batch_size.Observe(static_cast<double>(rows));
+  metrics_.batches++;
+
+  // Every request must be completed, or its client waits forever, so exceptions are turned into errors.
+  std::vector<protobufutil::Status> results;
+  try {
+    results = ExecuteBatch(batch);
+  } catch (const std::exception& e) {
+    results.assign(batch.size(), protobufutil::Status(protobufutil::error::Code::INTERNAL, e.what()));
+  }
+
+  // The request is owned by the client, so it can't be used once its promise is set.
+  for (size_t i = 0; i < batch.size(); ++i) {
+    batch[i]->done.set_value(results[i]);
+  }
+}
+
+std::vector<protobufutil::Status> RequestBatcher::ExecuteBatch(std::vector<Request*>& batch) {
+  if (batch.size() == 1) {
+    return {RunRequest(*batch[0])};
+  }
+
+  Ort::AllocatorWithDefaultOptions allocator;
+  const auto& first = *batch[0];
+
+  std::vector<int64_t> rows;
+  std::string tag;
+  for (const auto* request : batch) {
+    rows.push_back(request->rows);
+    tag += (tag.empty() ? "" : ",") + request->request_id;
+  }
+
+  // Merge the inputs in name order
+  std::vector<std::string> input_names;
+  std::vector<Ort::Value> input_values;
+  protobufutil::Status status;
+  for (size_t i = 0; i < first.input_order.size() && status.ok(); ++i) {
+    std::vector<const Ort::Value*> parts;
+    for (const auto* request : batch) {
+      parts.push_back(&request->input_values[request->input_order[i]]);
+    }
+
+    Ort::Value merged{nullptr};
+    status = ConcatenateTensors(parts, allocator, merged);
+    input_names.push_back(first.input_names[first.input_order[i]]);
+    input_values.push_back(std::move(merged));
+  }
+
+  std::vector<Ort::Value> outputs;
+  if (status.ok()) {
+    status = Execute(tag, input_names, input_values, first.output_names, outputs);
+    if (!status.ok()) {
+      return std::vector<protobufutil::Status>(batch.size(), status);
+    }
+  }
+
+  // Split the outputs back into the rows of each request
+  std::vector<std::vector<Ort::Value>> request_outputs(batch.size());
+  for (size_t i = 0; i < outputs.size() && status.ok(); ++i) {
+    std::vector<Ort::Value> parts;
+    status = SplitTensor(outputs[i], rows, allocator, parts);
+    for (size_t j = 0; j < parts.size(); ++j) {
+      request_outputs[j].push_back(std::move(parts[j]));
+    }
+  }
+
+  // A model whose outputs don't follow the batch dimension can't be split, so run the requests on their own
+  std::vector<protobufutil::Status> results;
+  results.reserve(batch.size());
+  if (!status.ok()) {
+    for (auto* request : batch) {
+      results.push_back(RunRequest(*request));
+    }
+    return results;
+  }
+
+  for (size_t i = 0; i < batch.size(); ++i) {
+    batch[i]->outputs = std::move(request_outputs[i]);
+    results.push_back(protobufutil::Status::OK);
+  }
+  return results;
+}
+
+protobufutil::Status RequestBatcher::RunRequest(Request& request) {
+  return Execute(request.request_id, request.input_names, request.input_values, request.output_names,
+                 request.outputs);
+}
+
+protobufutil::Status RequestBatcher::Execute(const std::string& tag,
+                                             const std::vector<std::string>& input_names,
+                                             const std::vector<Ort::Value>& input_values,
+                                             const std::vector<std::string>& output_names,
+                                             /* out */ std::vector<Ort::Value>& outputs) {
+  Ort::RunOptions run_options{};
+  run_options.SetRunLogVerbosityLevel(static_cast<int>(severity_));
+  run_options.SetRunTag(tag.c_str());
+
+  std::vector<const char*> input_ptrs;
+  input_ptrs.reserve(input_names.size());
+  for (const auto& name : input_names) {
+    input_ptrs.push_back(name.c_str());
+  }
+  std::vector<const char*> output_ptrs;
+  output_ptrs.reserve(output_names.size());
+  for (const auto& name : output_names) {
+    output_ptrs.push_back(name.c_str());
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  try {
+    outputs = session_.Run(run_options, input_ptrs.data(), const_cast<Ort::Value*>(input_values.data()), input_values.size(),
+                           output_ptrs.data(), output_ptrs.size());
+  } catch (const Ort::Exception& e) {
+    return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
+  }
+
+  metrics_.compute_latency.Observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+  return protobufutil::Status::OK;
+}
+
+void RequestBatcher::Request::SetBatchSignature() {
+  std::vector<size_t> order(input_names.size());
+  std::iota(order.begin(), order.end(), size_t{0});
+  std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+    return input_names[a] < input_names[b];
+  });
+
+  std::ostringstream signature;
+  int64_t rows = -1;
+  for (auto index : order) {
+    const auto& value = input_values[index];
+    if (!value.IsTensor()) {
+      return;
+    }
+
+    auto info = value.GetTensorTypeAndShapeInfo();
+    auto shape = info.GetShape();
+    if (GetTensorElementSize(info.GetElementType()) == 0 || shape.empty() || shape[0] <= 0 ||
+        (rows >= 0 && shape[0] != rows)) {
+      return;
+    }
+    rows = shape[0];
+
+    signature << input_names[index] << ':' << info.GetElementType();
+    for (size_t i = 1; i < shape.size(); ++i) {
+      signature << ',' << shape[i];
+    }
+    signature << ';';
+  }
+
+  if (rows < 0) {
+    return;
+  }
+
+  signature << '|';
+  for (const auto& name : output_names) {
+    signature << name << ';';
+  }
+
+  input_order = std::move(order);
+  this->signature = signature.str();
+  this->rows = rows;
+}
+
+protobufutil::Status ConcatenateTensors(const std::vector<const Ort::Value*>& values,
+                                        OrtAllocator* allocator,
+                                        /* out */ Ort::Value& result) {
+  auto first_info = values[0]->GetTensorTypeAndShapeInfo();
+  auto element_type = first_info.GetElementType();
+  auto element_size = GetTensorElementSize(element_type);
+  auto shape = first_info.GetShape();
+  if (element_size == 0 || shape.empty()) {
+    return protobufutil::Status(protobufutil::error::Code::INVALID_ARGUMENT, "Only numeric tensors with at least one dimension can be concatenated");
+  }
+
+  int64_t rows = 0;
+  for (const auto* value : values) {
+    auto info = value->GetTensorTypeAndShapeInfo();
+    auto value_shape = info.GetShape();
+    if (info.GetElementType() != element_type || value_shape.size() != shape.size() ||
+        !std::equal(value_shape.begin() + 1, value_shape.end(), shape.begin() + 1)) {
+      return protobufutil::Status(protobufutil::error::Code::INVALID_ARGUMENT, "Tensors must have the same element type and trailing dimensions to be concatenated");
+    }
+    rows += value_shape[0];
+  }
+
+  shape[0] = rows;
+  try {
+    result = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), element_type);
+  } catch (const Ort::Exception& e) {
+    return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
+  }
+
+  auto* destination = result.GetTensorMutableData<char>();
+  for (const auto* value : values) {
+    auto length = value->GetTensorTypeAndShapeInfo().GetElementCount() * element_size;
+    memcpy(destination, value->GetTensorData<char>(), length);
+    destination += length;
+  }
+
+  return protobufutil::Status::OK;
+}
+
+protobufutil::Status SplitTensor(const Ort::Value& value,
+                                 const std::vector<int64_t>& rows,
+                                 OrtAllocator* allocator,
+                                 /* out */ std::vector<Ort::Value>& results) {
+  if (!value.IsTensor()) {
+    return protobufutil::Status(protobufutil::error::Code::INVALID_ARGUMENT, "Only tensors can be split");
+  }
+
+  auto info = value.GetTensorTypeAndShapeInfo();
+  auto element_type = info.GetElementType();
+  auto element_size = GetTensorElementSize(element_type);
+  auto shape = info.GetShape();
+  if (element_size == 0 || shape.empty() || shape[0] != std::accumulate(rows.begin(), rows.end(), int64_t{0})) {
+    return protobufutil::Status(protobufutil::error::Code::INVALID_ARGUMENT, "Dimension 0 of the tensor does not match the rows to split it into");
+  }
+
+  size_t row_length = element_size;
+  for (size_t i = 1; i < shape.size(); ++i) {
+    row_length *= static_cast<size_t>(shape[i]);
+  }
+
+  const auto* source = value.GetTensorData<char>();
+  results.reserve(rows.size());
+  for (auto count : rows) {
+    shape[0] = count;
+    try {
+      results.push_back(Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), element_type));
+    } catch (const Ort::Exception& e) {
+      return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
+    }
+
+    auto length = row_length * static_cast<size_t>(count);
+    memcpy(results.back().GetTensorMutableData<char>(), source, length);
+    source += length;
+  }
+
+  return protobufutil::Status::OK;
+}
+
+}  // namespace server
+}  // namespace onnxruntime
@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <google/protobuf/stubs/status.h>
+
+#include "metrics.h"
+#include "onnxruntime_cxx_api.h"
+
+namespace onnxruntime {
+namespace server {
+
+struct RequestQueueOptions {
+  // Maximum number of rows (the sum of dimension 0 of the inputs) merged into one Run call.
+  // A value of 1 disables batching.
+  int max_batch_size = 1;
+  // Maximum time in microseconds the oldest queued request waits for more requests to batch with.
+  int max_queue_delay_us = 0;
+  // Maximum number of Run calls in flight for a model. A value of 0 runs requests directly on the
+  // calling thread unless batching is enabled, in which case one Run call is in flight at a time.
+  int max_concurrent_runs = 0;
+  // Maximum number of requests waiting in the queue before new requests are rejected. 0 is unbounded.
+  int max_queue_size = 0;
+
+  bool Enabled() const { return max_batch_size > 1 || max_concurrent_runs > 0; }
+};
+
+// Queues the requests for a single model and runs them on a fixed set of worker threads.
+//
+// Requests are batched when the model takes and produces tensors with a dynamic dimension 0, and
+// they agree on the input names, element types and the remaining dimensions and on the requested
+// outputs. The inputs of a batch are concatenated along dimension 0, run with a single Run call,
+// and the outputs are split back into the rows of each request.
+class RequestBatcher {
+ public:
+  RequestBatcher(const Ort::Session& session, const RequestQueueOptions& options,
+                 OrtLoggingLevel severity, ModelMetrics& metrics);
+  ~RequestBatcher();
+  RequestBatcher(const RequestBatcher&) = delete;
+  RequestBatcher& operator=(const RequestBatcher&) = delete;
+
+  // Queues a request and blocks until its outputs are available.
+  google::protobuf::util::Status Run(const std::string& request_id,
+                                     const std::vector<std::string>& input_names,
+                                     const std::vector<Ort::Value>& input_values,
+                                     const std::vector<std::string>& output_names,
+                                     /* out */ std::vector<Ort::Value>& outputs);
+
+ private:
+  struct Request;
+
+  void WorkerLoop();
+  // Returns true when the request at the front of the queue should be dispatched.
+  bool BatchReady(std::chrono::steady_clock::time_point now) const;
+  // Removes the request at the front of the queue and the compatible requests that fit in its batch.
+  std::vector<Request*> TakeBatch();
+  // Runs the batch and completes each of its requests.
+  void RunBatch(std::vector<Request*>& batch);
+  // Runs the batch and returns the status of each request, without completing them.
+  std::vector<google::protobuf::util::Status> ExecuteBatch(std::vector<Request*>& batch);
+  google::protobuf::util::Status RunRequest(Request& request);
+  google::protobuf::util::Status Execute(const std::string& tag,
+                                         const std::vector<std::string>& input_names,
+                                         const std::vector<Ort::Value>& input_values,
+                                         const std::vector<std::string>& output_names,
+                                         /* out */ std::vector<Ort::Value>& outputs);
+
+  Ort::Session& session_;
+  const RequestQueueOptions options_;
+  const OrtLoggingLevel severity_;
+  ModelMetrics& metrics_;
+  bool model_supports_batching_;
+
+  std::mutex mutex_;
+  std::condition_variable queue_changed_;
+  std::deque<Request*> queue_;
+  bool shutdown_ = false;
+  std::vector<std::thread> workers_;
+};
+
+// Concatenates tensors with the same element type and trailing dimensions along dimension 0.
+google::protobuf::util::Status ConcatenateTensors(const std::vector<const Ort::Value*>& values,
+                                                  OrtAllocator* allocator,
+                                                  /* out */ Ort::Value& result);
+
+// Splits a tensor along dimension 0 into tensors with the given numbers of rows.
+google::protobuf::util::Status SplitTensor(const Ort::Value& value,
+                                           const std::vector<int64_t>& rows,
+                                           OrtAllocator* allocator,
+                                           /* out */ std::vector<Ort::Value>& results);
+
+}  // namespace server
+}  // namespace onnxruntime
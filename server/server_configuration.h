@@ -45,6 +45,10 @@ class ServerConfiguration {
   unsigned short http_port = 8001;
   unsigned short grpc_port = 50051;
   int num_http_threads = std::thread::hardware_concurrency();
+  int max_batch_size = 1;
+  int max_queue_delay_us = 0;
+  int max_concurrent_runs = 0;
+  int max_queue_size = 0;
   OrtLoggingLevel logging_level{};
 
   ServerConfiguration() {
@@ -57,6 +61,10 @@ class ServerConfiguration {
     desc.add_options()("http_port", po::value(&http_port)->default_value(http_port), "HTTP port to listen to requests");
     desc.add_options()("num_http_threads", po::value(&num_http_threads)->default_value(num_http_threads), "Number of http threads");
     desc.add_options()("grpc_port", po::value(&grpc_port)->default_value(grpc_port), "GRPC port to listen to requests");
+    desc.add_options()("max_batch_size", po::value(&max_batch_size)->default_value(max_batch_size), "Maximum number of rows merged from queued requests into one run. 1 disables batching");
+    desc.add_options()("max_queue_delay_us", po::value(&max_queue_delay_us)->default_value(max_queue_delay_us), "Maximum time in microseconds a queued request waits for other requests to batch with");
+    desc.add_options()("max_concurrent_runs", po::value(&max_concurrent_runs)->default_value(max_concurrent_runs), "Maximum number of concurrent runs per model. 0 runs requests on the http threads when batching is disabled");
+    desc.add_options()("max_queue_size", po::value(&max_queue_size)->default_value(max_queue_size), "Maximum number of queued requests per model before requests are rejected. 0 is unbounded");
   }
 
   // Parses argc and argv and sets the values for the class
@@ -103,6 +111,12 @@ class ServerConfiguration {
     } else if (num_http_threads <= 0) {
       PrintHelp(std::cerr, "num_http_threads must be greater than 0");
       return Result::ExitFailure;
+    } else if (max_batch_size <= 0) {
+      PrintHelp(std::cerr, "max_batch_size must be greater than 0");
+      return Result::ExitFailure;
+    } else if (max_queue_delay_us < 0 || max_concurrent_runs < 0 || max_queue_size < 0) {
+      PrintHelp(std::cerr, "max_queue_delay_us, max_concurrent_runs and max_queue_size must not be negative");
+      return Result::ExitFailure;
     } else if (!file_exists(model_path)) {
       PrintHelp(std::cerr, "model_path must be the location of a valid file");
       return Result::ExitFailure;
@@ -0,0 +1,174 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cstring>
+#include <google/protobuf/stubs/status.h>
+
+#include "gtest/gtest.h"
+
+#include "http/binary_tensor.h"
+
+namespace onnxruntime {
+namespace server {
+namespace test {
+
+namespace protobufutil = google::protobuf::util;
+
+namespace {
+
+template <typename T>
+void Append(std::string& payload, const T& value) {
+  payload.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void AppendString(std::string& payload, const std::string& value) {
+  Append(payload, static_cast<uint32_t>(value.size()));
+  payload.append(value);
+}
+
+std::string MakeRequest(const std::vector<float>& data, const std::vector<int64_t>& dims, uint64_t data_length) {
+  std::string payload("ORTB");
+  Append(payload, static_cast<uint32_t>(1));
+  Append(payload, static_cast<uint32_t>(1));
+  Append(payload, static_cast<uint32_t>(1));
+  AppendString(payload, "Y");
+  AppendString(payload, "X");
+  Append(payload, static_cast<int32_t>(ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT));
+  Append(payload, static_cast<uint32_t>(dims.size()));
+  for (auto dim : dims) {
+    Append(payload, dim);
+  }
+  Append(payload, data_length);
+  payload.append((8 - payload.size() % 8) % 8, '\0');
+  payload.append(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(float));
+  return payload;
+}
+
+}  // namespace
+
+TEST(BinaryTensorTests, DecodeMapsPayload) {
+  std::vector<float> data{1.f, 2.f, 3.f, 4.f, 5.f, 6.f};
+  std::string payload = MakeRequest(data, {2, 3}, data.size() * sizeof(float));
+
+  std::vector<std::string> input_names;
+  std::vector<Ort::Value> input_values;
+  std::vector<std::string> output_filter;
+  auto status = DecodeBinaryTensorRequest(payload, input_names, input_values, output_filter);
+  ASSERT_TRUE(status.ok()) << status.error_message();
+
+  ASSERT_EQ(output_filter.size(), 1u);
+  EXPECT_EQ(output_filter[0], "Y");
+  ASSERT_EQ(input_names.size(), 1u);
+  EXPECT_EQ(input_names[0], "X");
+
+  auto info = input_values[0].GetTensorTypeAndShapeInfo();
+  EXPECT_EQ(info.GetElementType(), ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT);
+  EXPECT_EQ(info.GetShape(), std::vector<int64_t>({2, 3}));
+
+  // The tensor uses the payload memory rather than a copy.
+  const float* tensor_data = input_values[0].GetTensorMutableData<float>();
+  EXPECT_GE(reinterpret_cast<const char*>(tensor_data), payload.data());
+  EXPECT_LT(reinterpret_cast<const char*>(tensor_data), payload.data() + payload.size());
+  EXPECT_EQ(0, memcmp(tensor_data, data.data(), data.size() * sizeof(float)));
+}
+
+TEST(BinaryTensorTests, EncodeDecodeRoundTrip) {
+  std::vector<float> data{1.f, -2.f, 3.f};
+  std::string request = MakeRequest(data, {3}, data.size() * sizeof(float));
+
+  std::vector<std::string> names;
+  std::vector<Ort::Value> values;
+  std::vector<std::string> output_filter;
+  ASSERT_TRUE(DecodeBinaryTensorRequest(request, names, values, output_filter).ok());
+
+  std::string response;
+  auto status = EncodeBinaryTensorResponse(names, values, response);
+  ASSERT_TRUE(status.ok()) << status.error_message();
+
+  std::vector<std::string> decoded_names;
+  std::vector<Ort::Value> decoded_values;
+  std::vector<std::string> decoded_filter;
+  status = DecodeBinaryTensorRequest(response, decoded_names, decoded_values, decoded_filter);
+  ASSERT_TRUE(status.ok()) << status.error_message();
+
+  EXPECT_TRUE(decoded_filter.empty());
+  ASSERT_EQ(decoded_names, names);
+  EXPECT_EQ(decoded_values[0].GetTensorTypeAndShapeInfo().GetShape(), std::vector<int64_t>({3}));
+  EXPECT_EQ(0, memcmp(decoded_values[0].GetTensorMutableData<float>(), data.data(), data.size() * sizeof(float)));
+}
+
+TEST(BinaryTensorTests, DecodeRejectsMismatchedLength) {
+  std::vector<float> data{1.f, 2.f, 3.f, 4.f};
+  std::string payload = MakeRequest(data, {2, 3}, data.size() * sizeof(float));
+
+  std::vector<std::string> input_names;
+  std::vector<Ort::Value> input_values;
+  std::vector<std::string> output_filter;
+  auto status = DecodeBinaryTensorRequest(payload, input_names, input_values, output_filter);
+  EXPECT_EQ(protobufutil::error::INVALID_ARGUMENT, status.error_code());
+}
+
+TEST(BinaryTensorTests, DecodeRejectsTruncatedPayload) {
+  std::vector<float> data{1.f, 2.f, 3.f, 4.f, 5.f, 6.f};
+  std::string payload = MakeRequest(data, {2, 3}, data.size() * sizeof(float));
+  payload.resize(payload.size() - 4);
+
+  std::vector<std::string> input_names;
+  std::vector<Ort::Value> input_values;
+  std::vector<std::string> output_filter;
+  auto status = DecodeBinaryTensorRequest(payload, input_names, input_values, output_filter);
+  EXPECT_EQ(protobufutil::error::INVALID_ARGUMENT, status.error_code());
+}
+
+TEST(BinaryTensorTests, DecodeRejectsBadMagic) {
+  std::string payload("JSON and then some more bytes");
+
+  std::vector<std::string> input_names;
+  std::vector<Ort::Value> input_values;
+  std::vector<std::string> output_filter;
+  auto status = DecodeBinaryTensorRequest(payload, input_names, input_values, output_filter);
+  EXPECT_EQ(protobufutil::error::INVALID_ARGUMENT, status.error_code());
+}
+
+TEST(BinaryTensorTests, DecodeRejectsRankLargerThanPayload) {
+  std::vector<float> data{1.f, 2.f};
+  std::string payload = MakeRequest(data, {2}, data.size() * sizeof(float));
+
+  // Overwrite the rank, which follows the magic, the three header counts, the two names and the data type.
+  const size_t rank_offset = 4 + 3 * sizeof(uint32_t) + 2 * (sizeof(uint32_t) + 1) + sizeof(int32_t);
+  const uint32_t rank = 0x40000000;
+  memcpy(&payload[rank_offset], &rank, sizeof(rank));
+
+  std::vector<std::string> input_names;
+  std::vector<Ort::Value> input_values;
+  std::vector<std::string> output_filter;
+  auto status = DecodeBinaryTensorRequest(payload, input_names, input_values, output_filter);
+  EXPECT_EQ(protobufutil::error::INVALID_ARGUMENT, status.error_code());
+}
+
+TEST(BinaryTensorTests, DecodeRejectsNegativeDim) {
+  std::vector<float> data{1.f, 2.f};
+  std::string payload = MakeRequest(data, {-1, -2}, data.size() * sizeof(float));
+
+  std::vector<std::string> input_names;
+  std::vector<Ort::Value> input_values;
+  std::vector<std::string> output_filter;
+  auto status = DecodeBinaryTensorRequest(payload, input_names, input_values, output_filter);
+  EXPECT_EQ(protobufutil::error::INVALID_ARGUMENT, status.error_code());
+}
+
+TEST(BinaryTensorTests, DecodeRejectsOverflowingDims) {
+  // 2^32 * 2^30 float elements wraps to 0 bytes in 64 bits, matching an empty data section.
+  std::vector<float> data;
+  std::string payload = MakeRequest(data, {int64_t{1} << 32, int64_t{1} << 30}, 0);
+
+  std::vector<std::string> input_names;
+  std::vector<Ort::Value> input_values;
+  std::vector<std::string> output_filter;
+  auto status = DecodeBinaryTensorRequest(payload, input_names, input_values, output_filter);
+  EXPECT_EQ(protobufutil::error::INVALID_ARGUMENT, status.error_code());
+}
+
+}  // namespace test
+}  // namespace server
+}  // namespace onnxruntime
@@ -87,6 +87,15 @@ TEST(HttpRouteTests, PostRouteSpecialMethodTest){
   run_route(R"(/score()()())", http::verb::post, actions, true);
 }
 
+TEST(HttpRouteTests, GetRouteWithoutCapturesTest) {
+  std::vector<test_data> actions{
+      std::make_tuple(http::verb::get, "/metrics", "", "", "", http::status::ok),
+      std::make_tuple(http::verb::get, "/metrics/foo", "", "", "", http::status::not_found),
+      std::make_tuple(http::verb::get, "/v1/metrics", "", "", "", http::status::not_found)};
+
+  run_route("/metrics", http::verb::get, actions, true);
+}
+
 void run_route(const std::string& pattern, http::verb method, const std::vector<test_data>& data, bool does_validate_data) {
   Routes routes;
   EXPECT_TRUE(routes.RegisterController(method, pattern, do_something));
@@ -0,0 +1,206 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <sstream>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "request_batcher.h"
+#include "test_server_environment.h"
+
+namespace onnxruntime {
+namespace server {
+namespace test {
+
+namespace protobufutil = google::protobuf::util;
+
+namespace {
+
+Ort::Value MakeTensor(std::vector<float>& data, const std::vector<int64_t>& dims) {
+  static const Ort::MemoryInfo cpu_memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+  return Ort::Value::CreateTensor<float>(cpu_memory_info, data.data(), data.size(), dims.data(), dims.size());
+}
+
+std::vector<float> GetData(Ort::Value& value) {
+  const auto* data = value.GetTensorMutableData<float>();
+  return std::vector<float>(data, data + value.GetTensorTypeAndShapeInfo().GetElementCount());
+}
+
+}  // namespace
+
+TEST(RequestBatcherTests, ConcatenateAndSplit) {
+  Ort::AllocatorWithDefaultOptions allocator;
+  std::vector<float> a{1.f, 2.f};
+  std::vector<float> b{3.f, 4.f, 5.f, 6.f};
+  auto tensor_a = MakeTensor(a, {1, 2});
+  auto tensor_b = MakeTensor(b, {2, 2});
+
+  Ort::Value merged{nullptr};
+  auto status = ConcatenateTensors({&tensor_a, &tensor_b}, allocator, merged);
+  ASSERT_TRUE(status.ok()) << status.error_message();
+  EXPECT_EQ(merged.GetTensorTypeAndShapeInfo().GetShape(), std::vector<int64_t>({3, 2}));
+  EXPECT_EQ(GetData(merged), std::vector<float>({1.f, 2.f, 3.f, 4.f, 5.f, 6.f}));
+
+  std::vector<Ort::Value> parts;
+  status = SplitTensor(merged, {1, 2}, allocator, parts);
+  ASSERT_TRUE(status.ok()) << status.error_message();
+  ASSERT_EQ(parts.size(), 2u);
+  EXPECT_EQ(parts[0].GetTensorTypeAndShapeInfo().GetShape(), std::vector<int64_t>({1, 2}));
+  EXPECT_EQ(GetData(parts[0]), a);
+  EXPECT_EQ(parts[1].GetTensorTypeAndShapeInfo().GetShape(), std::vector<int64_t>({2, 2}));
+  EXPECT_EQ(GetData(parts[1]), b);
+}
+
+TEST(RequestBatcherTests, ConcatenateRejectsMismatchedDims) {
+  Ort::AllocatorWithDefaultOptions allocator;
+  std::vector<float> a{1.f, 2.f};
+  std::vector<float> b{3.f, 4.f, 5.f};
+  auto tensor_a = MakeTensor(a, {1, 2});
+  auto tensor_b = MakeTensor(b, {1, 3});
+
+  Ort::Value merged{nullptr};
+  auto status = ConcatenateTensors({&tensor_a, &tensor_b}, allocator, merged);
+  EXPECT_EQ(protobufutil::error::INVALID_ARGUMENT, status.error_code());
+}
+
+TEST(RequestBatcherTests, SplitRejectsMismatchedRows) {
+  Ort::AllocatorWithDefaultOptions allocator;
+  std::vector<float> data{1.f, 2.f, 3.f, 4.f};
+  auto tensor = MakeTensor(data, {2, 2});
+
+  std::vector<Ort::Value> parts;
+  auto status = SplitTensor(tensor, {1, 2}, allocator, parts);
+  EXPECT_EQ(protobufutil::error::INVALID_ARGUMENT, status.error_code());
+}
+
+TEST(RequestBatcherTests, HistogramWrite) {
+  Histogram histogram({1, 4});
+  histogram.Observe(1);
+  histogram.Observe(3);
+  histogram.Observe(8);
+
+  std::ostringstream out;
+  histogram.Write(out, "batch_size", "model=\"m\"");
+  EXPECT_EQ(out.str(),
+            "batch_size_bucket{model=\"m\",le=\"1\"} 1\n"
+            "batch_size_bucket{model=\"m\",le=\"4\"} 2\n"
+            "batch_size_bucket{model=\"m\",le=\"+Inf\"} 3\n"
+            "batch_size_sum{model=\"m\"} 12\n"
+            "batch_size_count{model=\"m\"} 3\n");
+}
+
+TEST(RequestBatcherTests, RunsQueuedRequests) {
+  auto* env = ServerEnv();
+  env->InitializeModel("testdata/mul_1.onnx", "Batcher", "1");
+
+  {
+    // mul_1 has a fixed batch dimension, so the requests are queued and run on their own.
+    RequestQueueOptions options{};
+    options.max_batch_size = 8;
+    options.max_queue_delay_us = 1000;
+    options.max_concurrent_runs = 2;
+    ModelMetrics metrics;
+    RequestBatcher batcher(env->GetSession("Batcher", "1"), options, ORT_LOGGING_LEVEL_WARNING, metrics);
+
+    const std::vector<std::string> input_names{"X"};
+    const std::vector<std::string> output_names{"Y"};
+    std::vector<std::thread> clients;
+    std::vector<protobufutil::Status> results(4);
+    std::vector<std::vector<float>> outputs(4);
+    for (size_t i = 0; i < results.size(); ++i) {
+      clients.emplace_back([&, i] {
+        std::vector<float> data(6, static_cast<float>(i + 1));
+        std::vector<Ort::Value> input_values;
+        input_values.push_back(MakeTensor(data, {3, 2}));
+        std::vector<Ort::Value> output_values;
+        results[i] = batcher.Run("RequestId", input_names, input_values, output_names, output_values);
+        if (results[i].ok()) {
+          outputs[i] = GetData(output_values[0]);
+        }
+      });
+    }
+    for (auto& client : clients) {
+      client.join();
+    }
+
+    for (size_t i = 0; i < results.size(); ++i) {
+      ASSERT_TRUE(results[i].ok()) << results[i].error_message();
+      float expected = static_cast<float>(i + 1);
+      for (size_t j = 0; j < outputs[i].size(); ++j) {
+        EXPECT_EQ(outputs[i][j], expected * static_cast<float>(j + 1));
+      }
+    }
+
+    EXPECT_EQ(metrics.requests, 4u);
+    EXPECT_EQ(metrics.batches, 4u);
+    EXPECT_EQ(metrics.queue_depth, 0);
+  }
+
+  env->UnloadModel("Batcher", "1");
+}
+
+TEST(RequestBatcherTests, BatchesConcurrentRequests) {
+  auto* env = ServerEnv();
+  env->InitializeModel("testdata/mul_dynamic_batch.onnx", "DynamicBatcher", "1");
+
+  {
+    // The model multiplies X(N, 2) by {1, 2}, so four requests of two rows fill one batch of eight rows. The queue
+    // delay is long enough that the batch only runs once all of them have arrived.
+    RequestQueueOptions options{};
+    options.max_batch_size = 8;
+    options.max_queue_delay_us = 10 * 1000 * 1000;
+    options.max_concurrent_runs = 1;
+    ModelMetrics metrics;
+    RequestBatcher batcher(env->GetSession("DynamicBatcher", "1"), options, ORT_LOGGING_LEVEL_WARNING, metrics);
+
+    const std::vector<std::string> input_names{"X"};
+    const std::vector<std::string> output_names{"Y"};
+    std::vector<std::thread> clients;
+    std::vector<protobufutil::Status> results(4);
+    std::vector<std::vector<int64_t>> shapes(4);
+    std::vector<std::vector<float>> outputs(4);
+    for (size_t i = 0; i < results.size(); ++i) {
+      clients.emplace_back([&, i] {
+        std::vector<float> data(4);
+        for (size_t j = 0; j < data.size(); ++j) {
+          data[j] = static_cast<float>(10 * i + j);
+        }
+        std::vector<Ort::Value> input_values;
+        input_values.push_back(MakeTensor(data, {2, 2}));
+        std::vector<Ort::Value> output_values;
+        results[i] = batcher.Run("RequestId", input_names, input_values, output_names, output_values);
+        if (results[i].ok()) {
+          shapes[i] = output_values[0].GetTensorTypeAndShapeInfo().GetShape();
+          outputs[i] = GetData(output_values[0]);
+        }
+      });
+    }
+    for (auto& client : clients) {
+      client.join();
+    }
+
+    for (size_t i = 0; i < results.size(); ++i) {
+      ASSERT_TRUE(results[i].ok()) << results[i].error_message();
+      EXPECT_EQ(shapes[i], std::vector<int64_t>({2, 2}));
+      ASSERT_EQ(outputs[i].size(), 4u);
+      for (size_t j = 0; j < outputs[i].size(); ++j) {
+        EXPECT_EQ(outputs[i][j], static_cast<float>(10 * i + j) * static_cast<float>(j % 2 + 1));
+      }
+    }
+
+    EXPECT_EQ(metrics.requests, 4u);
+    EXPECT_EQ(metrics.batches, 1u);
+    EXPECT_EQ(metrics.queue_depth, 0);
+
+    std::ostringstream out;
+    metrics.batch_size.Write(out, "batch_size", "");
+    EXPECT_NE(out.str().find("batch_size_sum{} 8\n"), std::string::npos) << out.str();
+  }
+
+  env->UnloadModel("DynamicBatcher", "1");
+}
+
+}  // namespace test
+}  // namespace server
+}  // namespace onnxruntime
@@ -41,6 +41,9 @@ class MemBufferArray {
 
 google::protobuf::util::Status GenerateProtobufStatus(const int& onnx_status, const std::string& message);
 
+// Returns the element size of a numeric tensor type, or 0 if the type is not supported.
+size_t GetTensorElementSize(ONNXTensorElementDataType type);
+
 
 }  // namespace server
 }  // namespace onnxruntime
@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License.
+
+import argparse
+import json
+import sys
+
+# Google Benchmark time units, in nanoseconds
+TIME_UNITS = {'ns': 1, 'us': 1e3, 'ms': 1e6, 's': 1e9}
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description='Compares the JSON output of a Google Benchmark program, e.g. onnxruntime_benchmark run with '
+                    '--benchmark_out=<file> --benchmark_out_format=json, with the output of a baseline run. '
+                    'Exits with a non-zero code if a benchmark got slower than the threshold.')
+    parser.add_argument('baseline', help='benchmark results of the baseline')
+    parser.add_argument('results', help='benchmark results to check')
+    parser.add_argument('--threshold', type=float, default=10.0,
+                        help='slow down, in percent, above which a benchmark is reported as a regression. '
+                             'Default: %(default)s')
+    parser.add_argument('--filter', default='', help='only compare the benchmarks whose names contain this string')
+    return parser.parse_args()
+
+
+def load_times(path, name_filter):
+    '''Returns the real time of each benchmark in nanoseconds.
+    When the benchmarks were run with --benchmark_repetitions, the medians of the repetitions are used.'''
+    with open(path) as f:
+        benchmarks = json.load(f)['benchmarks']
+
+    has_medians = any(b.get('aggregate_name') == 'median' for b in benchmarks)
+    times = {}
+    for b in benchmarks:
+        if b.get('error_occurred'):
+            continue
+        if has_medians:
+            if b.get('aggregate_name') != 'median':
+                continue
+            name = b['run_name']
+        else:
+            name = b['name']
+        if name_filter in name:
+            times[name] = b['real_time'] * TIME_UNITS[b.get('time_unit', 'ns')]
+    return times
+
+
+def main():
+    args = parse_args()
+    baseline = load_times(args.baseline, args.filter)
+    results = load_times(args.results, args.filter)
+
+    regressions = []
+    name_width = max([len(name) for name in results] + [len('Benchmark')])
+    print('{:<{}} {:>14} {:>14} {:>9}'.format('Benchmark', name_width, 'Baseline (ns)', 'Result (ns)', 'Change'))
+    for name, time in results.items():
+        if name not in baseline:
+            print('{:<{}} {:>14} {:>14.0f} {:>9}'.format(name, name_width, '-', time, 'new'))
+            continue
+        change = (time / baseline[name] - 1) * 100
+        print('{:<{}} {:>14.0f} {:>14.0f} {:>+8.1f}%'.format(name, name_width, baseline[name], time, change))
+        if change > args.threshold:
+            regressions.append((name, change))
+
+    missing = [name for name in baseline if name not in results]
+    if missing:
+        print('\nBenchmarks in the baseline without result (failed or removed):')
+        for name in missing:
+            print('  ' + name)
+
+    if regressions:
+        print('\n{} benchmark(s) are more than {}% slower than the baseline:'.format(len(regressions), args.threshold))
+        for name, change in regressions:
+            print('  {}: {:+.1f}%'.format(name, change))
+        return 1
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())